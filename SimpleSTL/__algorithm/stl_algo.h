@@ -0,0 +1,289 @@
+/**
+ * Created by 史进 on 2023/6/23.
+ *
+ * 常用算法：for_each、transform，线性查找 find、find_if、count、min_element、max_element，
+ * 以及有序区间上的 lower_bound、upper_bound
+ *  - 线性查找在区间为元素是标量的连续迭代器时，换成原生指针走 stl_simd.h 的内核
+ *  - find_if 的谓词为 bind1st、bind2nd 绑定的 equal_to、not_equal_to 时按值查找，同样可以向量化
+ */
+#ifndef SIMPLESTL_STL_ALGO_H
+#define SIMPLESTL_STL_ALGO_H
+
+#include <cstddef>
+
+#include "stl_simd.h"
+#include "../iterator.h"
+#include "../type_traits.h"
+#include "../__functional/stl_function.h"
+
+namespace simple_stl{
+
+    /** for_each：对区间内每个元素调用 f，返回 f */
+    template<class InputIterator, class Function>
+    inline Function for_each(InputIterator first, InputIterator last, Function f){
+        for ( ; first != last; ++first)
+            f(*first);
+        return f;
+    }
+
+    /** transform：把 op 作用于每个元素（或两个区间的对应元素）的结果写到 result 起始处 */
+    template<class InputIterator, class OutputIterator, class UnaryOperation>
+    inline OutputIterator transform(InputIterator first, InputIterator last,
+                                    OutputIterator result, UnaryOperation op){
+        for ( ; first != last; ++first, ++result)
+            *result = op(*first);
+        return result;
+    }
+
+    template<class InputIterator1, class InputIterator2, class OutputIterator, class BinaryOperation>
+    inline OutputIterator transform(InputIterator1 first1, InputIterator1 last1, InputIterator2 first2,
+                                    OutputIterator result, BinaryOperation op){
+        for ( ; first1 != last1; ++first1, ++first2, ++result)
+            *result = op(*first1, *first2);
+        return result;
+    }
+
+    /** find：第一个等于 value 的位置 */
+    // equal 为 false 时查找第一个不等于 value 的位置，供 find_if 使用
+    template<class InputIterator, class T>
+    inline InputIterator __find(InputIterator first, InputIterator last, const T& value, bool equal, __false_type_s){
+        while (first != last && (*first == value) != equal)
+            ++first;
+        return first;
+    }
+
+    template<class ContiguousIterator, class T>
+    inline ContiguousIterator __find(ContiguousIterator first, ContiguousIterator last, const T& value,
+                                     bool equal, __true_type_s){
+        typedef typename iterator_traits<ContiguousIterator>::value_type V;
+        if (!simple_stl::__simd_value_fits<V>(value))
+            return simple_stl::__find(first, last, value, equal, __false_type_s());
+        const V* p = simple_stl::to_address(first);
+        return first + (simple_stl::__simd_find<V>(p, p + (last - first), static_cast<V>(value), equal) - p);
+    }
+
+    template<class InputIterator, class T>
+    inline InputIterator find(InputIterator first, InputIterator last, const T& value){
+        return simple_stl::__find(first, last, value, true, __simd_value_search<InputIterator, T>());
+    }
+
+    /** find_if：第一个使 pred 为真的位置 */
+    template<class InputIterator, class Predicate>
+    inline InputIterator __find_if_loop(InputIterator first, InputIterator last, Predicate& pred){
+        while (first != last && !pred(*first))
+            ++first;
+        return first;
+    }
+
+    // 谓词比较的类型就是元素类型时，按值查找与逐个调用谓词的结果相同
+    template<class Iterator, class T,
+            bool = __simd_contiguous<Iterator>::value>
+    struct __find_if_by_value : __false_type_s {};
+
+    template<class Iterator, class T>
+    struct __find_if_by_value<Iterator, T, true>
+            : bool_constant_s<std::is_same<typename iterator_traits<Iterator>::value_type, T>::value> {};
+
+    template<class InputIterator, class Predicate, class T>
+    inline InputIterator __find_bound(InputIterator first, InputIterator last, Predicate&,
+                                      const T& value, bool equal, __true_type_s){
+        return simple_stl::__find(first, last, value, equal, __true_type_s());
+    }
+
+    template<class InputIterator, class Predicate, class T>
+    inline InputIterator __find_bound(InputIterator first, InputIterator last, Predicate& pred,
+                                      const T&, bool, __false_type_s){
+        return simple_stl::__find_if_loop(first, last, pred);
+    }
+
+    template<class InputIterator, class Predicate>
+    inline InputIterator __find_if(InputIterator first, InputIterator last, Predicate& pred){
+        return simple_stl::__find_if_loop(first, last, pred);
+    }
+
+    template<class InputIterator, class T>
+    inline InputIterator __find_if(InputIterator first, InputIterator last, binder1st<equal_to<T> >& pred){
+        return simple_stl::__find_bound(first, last, pred, pred.value(), true, __find_if_by_value<InputIterator, T>());
+    }
+
+    template<class InputIterator, class T>
+    inline InputIterator __find_if(InputIterator first, InputIterator last, binder2nd<equal_to<T> >& pred){
+        return simple_stl::__find_bound(first, last, pred, pred.value(), true, __find_if_by_value<InputIterator, T>());
+    }
+
+    template<class InputIterator, class T>
+    inline InputIterator __find_if(InputIterator first, InputIterator last, binder1st<not_equal_to<T> >& pred){
+        return simple_stl::__find_bound(first, last, pred, pred.value(), false, __find_if_by_value<InputIterator, T>());
+    }
+
+    template<class InputIterator, class T>
+    inline InputIterator __find_if(InputIterator first, InputIterator last, binder2nd<not_equal_to<T> >& pred){
+        return simple_stl::__find_bound(first, last, pred, pred.value(), false, __find_if_by_value<InputIterator, T>());
+    }
+
+    template<class InputIterator, class Predicate>
+    inline InputIterator find_if(InputIterator first, InputIterator last, Predicate pred){
+        return simple_stl::__find_if(first, last, pred);
+    }
+
+    /** count：等于 value 的元素个数 */
+    template<class InputIterator, class T>
+    inline typename iterator_traits<InputIterator>::difference_type
+    __count(InputIterator first, InputIterator last, const T& value, __false_type_s){
+        typename iterator_traits<InputIterator>::difference_type n = 0;
+        for ( ; first != last; ++first)
+            if (*first == value)
+                ++n;
+        return n;
+    }
+
+    template<class ContiguousIterator, class T>
+    inline typename iterator_traits<ContiguousIterator>::difference_type
+    __count(ContiguousIterator first, ContiguousIterator last, const T& value, __true_type_s){
+        typedef typename iterator_traits<ContiguousIterator>::value_type V;
+        typedef typename iterator_traits<ContiguousIterator>::difference_type Distance;
+        if (!simple_stl::__simd_value_fits<V>(value))
+            return simple_stl::__count(first, last, value, __false_type_s());
+        const V* p = simple_stl::to_address(first);
+        return static_cast<Distance>(simple_stl::__simd_count<V>(p, p + (last - first), static_cast<V>(value)));
+    }
+
+    template<class InputIterator, class T>
+    inline typename iterator_traits<InputIterator>::difference_type
+    count(InputIterator first, InputIterator last, const T& value){
+        return simple_stl::__count(first, last, value, __simd_value_search<InputIterator, T>());
+    }
+
+    /** min_element、max_element：第一个最小（最大）元素的位置 */
+    template<class ForwardIterator>
+    ForwardIterator __min_element(ForwardIterator first, ForwardIterator last, __false_type_s){
+        if (first == last)
+            return first;
+        ForwardIterator result = first;
+        while (++first != last)
+            if (*first < *result)
+                result = first;
+        return result;
+    }
+
+    // 整数先向量化求出最值，再向量化查找它第一次出现的位置
+    template<class ContiguousIterator>
+    inline ContiguousIterator __min_element(ContiguousIterator first, ContiguousIterator last, __true_type_s){
+        typedef typename iterator_traits<ContiguousIterator>::value_type V;
+        if (first == last)
+            return first;
+        const V* p = simple_stl::to_address(first);
+        const V* q = p + (last - first);
+        const V m = simple_stl::__simd_extreme<V>(p, q, false);
+        return first + (simple_stl::__simd_find<V>(p, q, m, true) - p);
+    }
+
+    template<class ForwardIterator>
+    inline ForwardIterator min_element(ForwardIterator first, ForwardIterator last){
+        return simple_stl::__min_element(first, last, __simd_integral_contiguous<ForwardIterator>());
+    }
+
+    template<class ForwardIterator, class Compare>
+    ForwardIterator min_element(ForwardIterator first, ForwardIterator last, Compare comp){
+        if (first == last)
+            return first;
+        ForwardIterator result = first;
+        while (++first != last)
+            if (comp(*first, *result))
+                result = first;
+        return result;
+    }
+
+    template<class ForwardIterator>
+    ForwardIterator __max_element(ForwardIterator first, ForwardIterator last, __false_type_s){
+        if (first == last)
+            return first;
+        ForwardIterator result = first;
+        while (++first != last)
+            if (*result < *first)
+                result = first;
+        return result;
+    }
+
+    template<class ContiguousIterator>
+    inline ContiguousIterator __max_element(ContiguousIterator first, ContiguousIterator last, __true_type_s){
+        typedef typename iterator_traits<ContiguousIterator>::value_type V;
+        if (first == last)
+            return first;
+        const V* p = simple_stl::to_address(first);
+        const V* q = p + (last - first);
+        const V m = simple_stl::__simd_extreme<V>(p, q, true);
+        return first + (simple_stl::__simd_find<V>(p, q, m, true) - p);
+    }
+
+    template<class ForwardIterator>
+    inline ForwardIterator max_element(ForwardIterator first, ForwardIterator last){
+        return simple_stl::__max_element(first, last, __simd_integral_contiguous<ForwardIterator>());
+    }
+
+    template<class ForwardIterator, class Compare>
+    ForwardIterator max_element(ForwardIterator first, ForwardIterator last, Compare comp){
+        if (first == last)
+            return first;
+        ForwardIterator result = first;
+        while (++first != last)
+            if (comp(*result, *first))
+                result = first;
+        return result;
+    }
+
+    /** lower_bound：第一个不小于 value 的位置 */
+    template<class ForwardIterator, class T, class Compare>
+    ForwardIterator lower_bound(ForwardIterator first, ForwardIterator last, const T& value, Compare comp){
+        typedef typename iterator_traits<ForwardIterator>::difference_type Distance;
+        Distance len = simple_stl::distance(first, last);
+        while (len > 0){
+            const Distance half = len / 2;
+            ForwardIterator middle = first;
+            simple_stl::advance(middle, half);
+            if (comp(*middle, value)){
+                first = ++middle;
+                len -= half + 1;
+            }
+            else{
+                len = half;
+            }
+        }
+        return first;
+    }
+
+    template<class ForwardIterator, class T>
+    inline ForwardIterator lower_bound(ForwardIterator first, ForwardIterator last, const T& value){
+        return simple_stl::lower_bound(first, last, value,
+                                       less<typename iterator_traits<ForwardIterator>::value_type>());
+    }
+
+    /** upper_bound：第一个大于 value 的位置 */
+    template<class ForwardIterator, class T, class Compare>
+    ForwardIterator upper_bound(ForwardIterator first, ForwardIterator last, const T& value, Compare comp){
+        typedef typename iterator_traits<ForwardIterator>::difference_type Distance;
+        Distance len = simple_stl::distance(first, last);
+        while (len > 0){
+            const Distance half = len / 2;
+            ForwardIterator middle = first;
+            simple_stl::advance(middle, half);
+            if (comp(value, *middle)){
+                len = half;
+            }
+            else{
+                first = ++middle;
+                len -= half + 1;
+            }
+        }
+        return first;
+    }
+
+    template<class ForwardIterator, class T>
+    inline ForwardIterator upper_bound(ForwardIterator first, ForwardIterator last, const T& value){
+        return simple_stl::upper_bound(first, last, value,
+                                       less<typename iterator_traits<ForwardIterator>::value_type>());
+    }
+
+}   // simple_stl
+
+#endif //SIMPLESTL_STL_ALGO_H
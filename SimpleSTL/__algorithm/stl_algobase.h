@@ -0,0 +1,685 @@
+/**
+ * Created by 史进 on 2023/6/23.
+ *
+ * 基本算法：copy、copy_n、copy_backward、move、move_backward、fill、fill_n，
+ * 以及比较两个区间的 mismatch、equal、lexicographical_compare
+ *  - 搬移算法在两个区间都是连续迭代器、元素类型相同且赋值平凡时用 memmove 整段搬移；
+ *    填充算法在元素为算术类型、值的各字节相同时用 memset；其余情况随机访问迭代器用计数循环
+ *  - 源区间或目标区间为分段迭代器（如 deque）时逐段处理，每段都是原生指针区间，仍可走上述批量路径
+ *  - 比较算法在两个区间都是元素为同一标量类型的连续迭代器时，换成原生指针走 stl_simd.h 的内核
+ */
+#ifndef SIMPLESTL_STL_ALGOBASE_H
+#define SIMPLESTL_STL_ALGOBASE_H
+
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+#include "stl_simd.h"
+#include "../iterator.h"
+#include "../type_traits.h"
+#include "../utility.h"
+
+namespace simple_stl{
+
+    /** 搬移与填充的分派 */
+    // 两个区间都是连续迭代器、元素类型相同（源区间可为 const）且拷贝赋值平凡时，可按字节整段搬移；
+    // 经 reference 判断以排除 volatile 元素与代理引用
+    template<class InputIterator, class OutputIterator,
+            bool = is_contiguous_iterator<InputIterator>::value && is_contiguous_iterator<OutputIterator>::value>
+    struct __copy_use_memmove : __false_type_s {};
+
+    template<class In, class Out>
+    struct __trivially_assignable_pair
+            : bool_constant_s<std::is_same<typename std::remove_const<In>::type, Out>::value &&
+                              !std::is_volatile<In>::value &&
+                              __type_traits_s<Out>::have_trivial_assignment_operator::value> {};
+
+    template<class InputIterator, class OutputIterator>
+    struct __copy_use_memmove<InputIterator, OutputIterator, true>
+            : __trivially_assignable_pair<
+                    typename remove_reference<typename iterator_traits<InputIterator>::reference>::type,
+                    typename remove_reference<typename iterator_traits<OutputIterator>::reference>::type> {};
+
+    // 移动赋值还要求移动赋值也是平凡的
+    template<class InputIterator, class OutputIterator>
+    struct __move_use_memmove
+            : bool_constant_s<__copy_use_memmove<InputIterator, OutputIterator>::value &&
+                              std::is_trivially_move_assignable<typename iterator_traits<OutputIterator>::value_type>::value> {};
+
+    // 元素为算术类型的连续迭代器，值的各字节相同时可以用 memset 填充
+    template<class ForwardIterator,
+            bool = is_contiguous_iterator<ForwardIterator>::value>
+    struct __fill_use_memset : __false_type_s {};
+
+    template<class T>
+    struct __memset_fillable
+            : bool_constant_s<std::is_arithmetic<T>::value && !std::is_const<T>::value &&
+                              !std::is_volatile<T>::value> {};
+
+    template<class ForwardIterator>
+    struct __fill_use_memset<ForwardIterator, true>
+            : __memset_fillable<typename remove_reference<typename iterator_traits<ForwardIterator>::reference>::type> {};
+
+    // 源区间分段时按源区间的段处理；否则目标区间分段且源区间可随机访问时按目标区间的段处理
+    struct __unsegmented_tag {};
+    struct __segmented_input_tag {};
+    struct __segmented_output_tag {};
+
+    template<class InputIterator, class OutputIterator>
+    struct __segment_dispatch{
+        typedef typename std::conditional<is_segmented_iterator<InputIterator>::value,
+                __segmented_input_tag,
+                typename std::conditional<is_segmented_iterator<OutputIterator>::value &&
+                                          is_random_access_iterator<InputIterator>::value,
+                        __segmented_output_tag, __unsegmented_tag>::type>::type type;
+    };
+
+    /** 原生指针的整段搬移，源区间与目标区间可以重叠 */
+    template<class T, class Distance>
+    inline T* __copy_memmove(const T* first, Distance n, T* result){
+        if (n > 0)
+            std::memmove(static_cast<void*>(result), static_cast<const void*>(first), sizeof(T) * n);
+        return result + n;
+    }
+
+    // result 为目标区间的尾后位置，返回目标区间的起始位置
+    template<class T, class Distance>
+    inline T* __copy_backward_memmove(const T* first, Distance n, T* result){
+        if (n > 0){
+            result -= n;
+            std::memmove(static_cast<void*>(result), static_cast<const void*>(first), sizeof(T) * n);
+        }
+        return result;
+    }
+
+    /** copy：将 [first, last) 依次赋值到 result 起始的区间，返回目标区间的尾后位置 */
+    template<class InputIterator, class OutputIterator>
+    inline OutputIterator copy(InputIterator first, InputIterator last, OutputIterator result);
+
+    template<class InputIterator, class OutputIterator>
+    inline OutputIterator __copy_loop(InputIterator first, InputIterator last, OutputIterator result,
+                                      input_iterator_tag){
+        for ( ; first != last; ++first, ++result)
+            *result = *first;
+        return result;
+    }
+
+    // random_access_iterator_tag版，转为计数循环，便于编译器向量化
+    template<class RandomAccessIterator, class OutputIterator>
+    inline OutputIterator __copy_loop(RandomAccessIterator first, RandomAccessIterator last, OutputIterator result,
+                                      random_access_iterator_tag){
+        typedef typename iterator_traits<RandomAccessIterator>::difference_type Distance;
+        for (Distance n = last - first; n > 0; --n, ++first, ++result)
+            *result = *first;
+        return result;
+    }
+
+    template<class InputIterator, class OutputIterator>
+    inline OutputIterator __copy_aux(InputIterator first, InputIterator last, OutputIterator result, __false_type_s){
+        return simple_stl::__copy_loop(first, last, result, iterator_category(first));
+    }
+
+    template<class ContiguousIterator1, class ContiguousIterator2>
+    inline ContiguousIterator2 __copy_aux(ContiguousIterator1 first, ContiguousIterator1 last,
+                                          ContiguousIterator2 result, __true_type_s){
+        return simple_stl::__rewrap_iter(result, simple_stl::__copy_memmove(simple_stl::to_address(first), last - first,
+                                                                            simple_stl::to_address(result)));
+    }
+
+    template<class InputIterator, class OutputIterator>
+    inline OutputIterator __copy_seg(InputIterator first, InputIterator last, OutputIterator result,
+                                     __unsegmented_tag){
+        return simple_stl::__copy_aux(first, last, result, __copy_use_memmove<InputIterator, OutputIterator>());
+    }
+
+    template<class SegmentedIterator, class OutputIterator>
+    inline OutputIterator __copy_seg(SegmentedIterator first, SegmentedIterator last, OutputIterator result,
+                                     __segmented_input_tag){
+        typedef segmented_iterator_traits<SegmentedIterator> traits;
+        typename traits::segment_iterator sf = traits::segment(first);
+        typename traits::segment_iterator sl = traits::segment(last);
+        if (sf == sl)
+            return simple_stl::copy(traits::local(first), traits::local(last), result);
+        result = simple_stl::copy(traits::local(first), traits::end(sf), result);
+        for (++sf; sf != sl; ++sf)
+            result = simple_stl::copy(traits::begin(sf), traits::end(sf), result);
+        return simple_stl::copy(traits::begin(sl), traits::local(last), result);
+    }
+
+    // 目标区间分段：每段填满后转到下一段的开头
+    template<class RandomAccessIterator, class SegmentedIterator>
+    inline SegmentedIterator __copy_seg(RandomAccessIterator first, RandomAccessIterator last, SegmentedIterator result,
+                                        __segmented_output_tag){
+        typedef segmented_iterator_traits<SegmentedIterator> traits;
+        typedef typename iterator_traits<RandomAccessIterator>::difference_type Distance;
+        Distance n = last - first;
+        // 空区间不触碰目标的分段，目标可能是尚未配置任何分段的空容器
+        if (n <= 0)
+            return result;
+        typename traits::segment_iterator s = traits::segment(result);
+        typename traits::local_iterator l = traits::local(result);
+        for (Distance room = traits::end(s) - l; n >= room && n > 0; room = traits::end(s) - l){
+            simple_stl::copy(first, first + room, l);
+            first += room;
+            n -= room;
+            ++s;
+            l = traits::begin(s);
+        }
+        l = simple_stl::copy(first, last, l);
+        return traits::compose(s, l);
+    }
+
+    template<class InputIterator, class OutputIterator>
+    inline OutputIterator copy(InputIterator first, InputIterator last, OutputIterator result){
+        typedef typename __segment_dispatch<InputIterator, OutputIterator>::type segment_tag;
+        return simple_stl::__copy_seg(first, last, result, segment_tag());
+    }
+
+    /** copy_n：将 [first, first + n) 依次赋值到 result 起始的区间，返回目标区间的尾后位置 */
+    template<class InputIterator, class Size, class OutputIterator>
+    inline OutputIterator __copy_n(InputIterator first, Size n, OutputIterator result, input_iterator_tag){
+        for ( ; n > 0; --n, ++first, ++result)
+            *result = *first;
+        return result;
+    }
+
+    // 随机访问迭代器可直接求出尾后位置，转为 copy()
+    template<class RandomAccessIterator, class Size, class OutputIterator>
+    inline OutputIterator __copy_n(RandomAccessIterator first, Size n, OutputIterator result,
+                                   random_access_iterator_tag){
+        if (n <= 0)
+            return result;
+        return simple_stl::copy(first, first + n, result);
+    }
+
+    template<class InputIterator, class Size, class OutputIterator>
+    inline OutputIterator copy_n(InputIterator first, Size n, OutputIterator result){
+        return simple_stl::__copy_n(first, n, result, iterator_category(first));
+    }
+
+    /** copy_backward：将 [first, last) 从后往前赋值到以 result 为尾后位置的区间，返回目标区间的起始位置 */
+    template<class BidirectionalIterator1, class BidirectionalIterator2>
+    inline BidirectionalIterator2 copy_backward(BidirectionalIterator1 first, BidirectionalIterator1 last,
+                                                BidirectionalIterator2 result);
+
+    template<class BidirectionalIterator1, class BidirectionalIterator2>
+    inline BidirectionalIterator2 __copy_backward_loop(BidirectionalIterator1 first, BidirectionalIterator1 last,
+                                                       BidirectionalIterator2 result, bidirectional_iterator_tag){
+        while (first != last)
+            *--result = *--last;
+        return result;
+    }
+
+    template<class RandomAccessIterator, class BidirectionalIterator>
+    inline BidirectionalIterator __copy_backward_loop(RandomAccessIterator first, RandomAccessIterator last,
+                                                      BidirectionalIterator result, random_access_iterator_tag){
+        typedef typename iterator_traits<RandomAccessIterator>::difference_type Distance;
+        for (Distance n = last - first; n > 0; --n)
+            *--result = *--last;
+        return result;
+    }
+
+    template<class BidirectionalIterator1, class BidirectionalIterator2>
+    inline BidirectionalIterator2 __copy_backward_aux(BidirectionalIterator1 first, BidirectionalIterator1 last,
+                                                      BidirectionalIterator2 result, __false_type_s){
+        return simple_stl::__copy_backward_loop(first, last, result, iterator_category(first));
+    }
+
+    template<class ContiguousIterator1, class ContiguousIterator2>
+    inline ContiguousIterator2 __copy_backward_aux(ContiguousIterator1 first, ContiguousIterator1 last,
+                                                   ContiguousIterator2 result, __true_type_s){
+        return simple_stl::__rewrap_iter(result, simple_stl::__copy_backward_memmove(simple_stl::to_address(first),
+                                                                                     last - first,
+                                                                                     simple_stl::to_address(result)));
+    }
+
+    template<class BidirectionalIterator1, class BidirectionalIterator2>
+    inline BidirectionalIterator2 __copy_backward_seg(BidirectionalIterator1 first, BidirectionalIterator1 last,
+                                                      BidirectionalIterator2 result, __unsegmented_tag){
+        typedef __copy_use_memmove<BidirectionalIterator1, BidirectionalIterator2> use_memmove;
+        return simple_stl::__copy_backward_aux(first, last, result, use_memmove());
+    }
+
+    template<class SegmentedIterator, class BidirectionalIterator>
+    inline BidirectionalIterator __copy_backward_seg(SegmentedIterator first, SegmentedIterator last,
+                                                     BidirectionalIterator result, __segmented_input_tag){
+        typedef segmented_iterator_traits<SegmentedIterator> traits;
+        typename traits::segment_iterator sf = traits::segment(first);
+        typename traits::segment_iterator sl = traits::segment(last);
+        if (sf == sl)
+            return simple_stl::copy_backward(traits::local(first), traits::local(last), result);
+        result = simple_stl::copy_backward(traits::begin(sl), traits::local(last), result);
+        for (--sl; sl != sf; --sl)
+            result = simple_stl::copy_backward(traits::begin(sl), traits::end(sl), result);
+        return simple_stl::copy_backward(traits::local(first), traits::end(sf), result);
+    }
+
+    // 目标区间分段：从 result 所在段往前逐段填满，result 恰在段首时先退到上一段的末尾
+    template<class RandomAccessIterator, class SegmentedIterator>
+    inline SegmentedIterator __copy_backward_seg(RandomAccessIterator first, RandomAccessIterator last,
+                                                 SegmentedIterator result, __segmented_output_tag){
+        typedef segmented_iterator_traits<SegmentedIterator> traits;
+        typedef typename iterator_traits<RandomAccessIterator>::difference_type Distance;
+        Distance n = last - first;
+        if (n <= 0)
+            return result;
+        typename traits::segment_iterator s = traits::segment(result);
+        typename traits::local_iterator l = traits::local(result);
+        while (n > 0){
+            Distance room = l - traits::begin(s);
+            if (room == 0){
+                --s;
+                l = traits::end(s);
+                continue;
+            }
+            const Distance k = n < room ? n : room;
+            l = simple_stl::copy_backward(last - k, last, l);
+            last -= k;
+            n -= k;
+        }
+        return traits::compose(s, l);
+    }
+
+    template<class BidirectionalIterator1, class BidirectionalIterator2>
+    inline BidirectionalIterator2 copy_backward(BidirectionalIterator1 first, BidirectionalIterator1 last,
+                                                BidirectionalIterator2 result){
+        typedef typename __segment_dispatch<BidirectionalIterator1, BidirectionalIterator2>::type segment_tag;
+        return simple_stl::__copy_backward_seg(first, last, result, segment_tag());
+    }
+
+    /** move：将 [first, last) 依次移动赋值到 result 起始的区间，返回目标区间的尾后位置 */
+    template<class InputIterator, class OutputIterator>
+    inline OutputIterator move(InputIterator first, InputIterator last, OutputIterator result);
+
+    template<class InputIterator, class OutputIterator>
+    inline OutputIterator __move_loop(InputIterator first, InputIterator last, OutputIterator result,
+                                      input_iterator_tag){
+        for ( ; first != last; ++first, ++result)
+            *result = simple_stl::move(*first);
+        return result;
+    }
+
+    template<class RandomAccessIterator, class OutputIterator>
+    inline OutputIterator __move_loop(RandomAccessIterator first, RandomAccessIterator last, OutputIterator result,
+                                      random_access_iterator_tag){
+        typedef typename iterator_traits<RandomAccessIterator>::difference_type Distance;
+        for (Distance n = last - first; n > 0; --n, ++first, ++result)
+            *result = simple_stl::move(*first);
+        return result;
+    }
+
+    template<class InputIterator, class OutputIterator>
+    inline OutputIterator __move_aux(InputIterator first, InputIterator last, OutputIterator result, __false_type_s){
+        return simple_stl::__move_loop(first, last, result, iterator_category(first));
+    }
+
+    // 平凡类型的移动即拷贝
+    template<class ContiguousIterator1, class ContiguousIterator2>
+    inline ContiguousIterator2 __move_aux(ContiguousIterator1 first, ContiguousIterator1 last,
+                                          ContiguousIterator2 result, __true_type_s){
+        return simple_stl::__copy_aux(first, last, result, __true_type_s());
+    }
+
+    template<class InputIterator, class OutputIterator>
+    inline OutputIterator __move_seg(InputIterator first, InputIterator last, OutputIterator result,
+                                     __unsegmented_tag){
+        return simple_stl::__move_aux(first, last, result, __move_use_memmove<InputIterator, OutputIterator>());
+    }
+
+    template<class SegmentedIterator, class OutputIterator>
+    inline OutputIterator __move_seg(SegmentedIterator first, SegmentedIterator last, OutputIterator result,
+                                     __segmented_input_tag){
+        typedef segmented_iterator_traits<SegmentedIterator> traits;
+        typename traits::segment_iterator sf = traits::segment(first);
+        typename traits::segment_iterator sl = traits::segment(last);
+        if (sf == sl)
+            return simple_stl::move(traits::local(first), traits::local(last), result);
+        result = simple_stl::move(traits::local(first), traits::end(sf), result);
+        for (++sf; sf != sl; ++sf)
+            result = simple_stl::move(traits::begin(sf), traits::end(sf), result);
+        return simple_stl::move(traits::begin(sl), traits::local(last), result);
+    }
+
+    template<class RandomAccessIterator, class SegmentedIterator>
+    inline SegmentedIterator __move_seg(RandomAccessIterator first, RandomAccessIterator last, SegmentedIterator result,
+                                        __segmented_output_tag){
+        typedef segmented_iterator_traits<SegmentedIterator> traits;
+        typedef typename iterator_traits<RandomAccessIterator>::difference_type Distance;
+        Distance n = last - first;
+        // 空区间不触碰目标的分段，目标可能是尚未配置任何分段的空容器
+        if (n <= 0)
+            return result;
+        typename traits::segment_iterator s = traits::segment(result);
+        typename traits::local_iterator l = traits::local(result);
+        for (Distance room = traits::end(s) - l; n >= room && n > 0; room = traits::end(s) - l){
+            simple_stl::move(first, first + room, l);
+            first += room;
+            n -= room;
+            ++s;
+            l = traits::begin(s);
+        }
+        l = simple_stl::move(first, last, l);
+        return traits::compose(s, l);
+    }
+
+    template<class InputIterator, class OutputIterator>
+    inline OutputIterator move(InputIterator first, InputIterator last, OutputIterator result){
+        typedef typename __segment_dispatch<InputIterator, OutputIterator>::type segment_tag;
+        return simple_stl::__move_seg(first, last, result, segment_tag());
+    }
+
+    /** move_backward：将 [first, last) 从后往前移动赋值到以 result 为尾后位置的区间，返回目标区间的起始位置 */
+    template<class BidirectionalIterator1, class BidirectionalIterator2>
+    inline BidirectionalIterator2 move_backward(BidirectionalIterator1 first, BidirectionalIterator1 last,
+                                                BidirectionalIterator2 result);
+
+    template<class BidirectionalIterator1, class BidirectionalIterator2>
+    inline BidirectionalIterator2 __move_backward_loop(BidirectionalIterator1 first, BidirectionalIterator1 last,
+                                                       BidirectionalIterator2 result, bidirectional_iterator_tag){
+        while (first != last)
+            *--result = simple_stl::move(*--last);
+        return result;
+    }
+
+    template<class RandomAccessIterator, class BidirectionalIterator>
+    inline BidirectionalIterator __move_backward_loop(RandomAccessIterator first, RandomAccessIterator last,
+                                                      BidirectionalIterator result, random_access_iterator_tag){
+        typedef typename iterator_traits<RandomAccessIterator>::difference_type Distance;
+        for (Distance n = last - first; n > 0; --n)
+            *--result = simple_stl::move(*--last);
+        return result;
+    }
+
+    template<class BidirectionalIterator1, class BidirectionalIterator2>
+    inline BidirectionalIterator2 __move_backward_aux(BidirectionalIterator1 first, BidirectionalIterator1 last,
+                                                      BidirectionalIterator2 result, __false_type_s){
+        return simple_stl::__move_backward_loop(first, last, result, iterator_category(first));
+    }
+
+    template<class ContiguousIterator1, class ContiguousIterator2>
+    inline ContiguousIterator2 __move_backward_aux(ContiguousIterator1 first, ContiguousIterator1 last,
+                                                   ContiguousIterator2 result, __true_type_s){
+        return simple_stl::__copy_backward_aux(first, last, result, __true_type_s());
+    }
+
+    template<class BidirectionalIterator1, class BidirectionalIterator2>
+    inline BidirectionalIterator2 __move_backward_seg(BidirectionalIterator1 first, BidirectionalIterator1 last,
+                                                      BidirectionalIterator2 result, __unsegmented_tag){
+        typedef __move_use_memmove<BidirectionalIterator1, BidirectionalIterator2> use_memmove;
+        return simple_stl::__move_backward_aux(first, last, result, use_memmove());
+    }
+
+    template<class SegmentedIterator, class BidirectionalIterator>
+    inline BidirectionalIterator __move_backward_seg(SegmentedIterator first, SegmentedIterator last,
+                                                     BidirectionalIterator result, __segmented_input_tag){
+        typedef segmented_iterator_traits<SegmentedIterator> traits;
+        typename traits::segment_iterator sf = traits::segment(first);
+        typename traits::segment_iterator sl = traits::segment(last);
+        if (sf == sl)
+            return simple_stl::move_backward(traits::local(first), traits::local(last), result);
+        result = simple_stl::move_backward(traits::begin(sl), traits::local(last), result);
+        for (--sl; sl != sf; --sl)
+            result = simple_stl::move_backward(traits::begin(sl), traits::end(sl), result);
+        return simple_stl::move_backward(traits::local(first), traits::end(sf), result);
+    }
+
+    template<class RandomAccessIterator, class SegmentedIterator>
+    inline SegmentedIterator __move_backward_seg(RandomAccessIterator first, RandomAccessIterator last,
+                                                 SegmentedIterator result, __segmented_output_tag){
+        typedef segmented_iterator_traits<SegmentedIterator> traits;
+        typedef typename iterator_traits<RandomAccessIterator>::difference_type Distance;
+        Distance n = last - first;
+        if (n <= 0)
+            return result;
+        typename traits::segment_iterator s = traits::segment(result);
+        typename traits::local_iterator l = traits::local(result);
+        while (n > 0){
+            Distance room = l - traits::begin(s);
+            if (room == 0){
+                --s;
+                l = traits::end(s);
+                continue;
+            }
+            const Distance k = n < room ? n : room;
+            l = simple_stl::move_backward(last - k, last, l);
+            last -= k;
+            n -= k;
+        }
+        return traits::compose(s, l);
+    }
+
+    template<class BidirectionalIterator1, class BidirectionalIterator2>
+    inline BidirectionalIterator2 move_backward(BidirectionalIterator1 first, BidirectionalIterator1 last,
+                                                BidirectionalIterator2 result){
+        typedef typename __segment_dispatch<BidirectionalIterator1, BidirectionalIterator2>::type segment_tag;
+        return simple_stl::__move_backward_seg(first, last, result, segment_tag());
+    }
+
+    /** fill_n：将 [first, first + n) 内的元素都赋值为 value，返回 first + n */
+    template<class OutputIterator, class Size, class T>
+    inline OutputIterator fill_n(OutputIterator first, Size n, const T& value);
+
+    template<class OutputIterator, class Size, class T>
+    inline OutputIterator __fill_n_aux(OutputIterator first, Size n, const T& value, __false_type_s){
+        for ( ; n > 0; --n, ++first)
+            *first = value;
+        return first;
+    }
+
+    // 值的各字节相同（如 0、-1、单字节类型的任意值）时可以用 memset 填充
+    template<class T>
+    inline bool __fill_repeated_byte(const T& value, unsigned char& byte){
+        unsigned char bytes[sizeof(T)];
+        std::memcpy(bytes, &value, sizeof(T));
+        for (size_t i = 1; i < sizeof(T); ++i)
+            if (bytes[i] != bytes[0])
+                return false;
+        byte = bytes[0];
+        return true;
+    }
+
+    // 先将 value 换成元素类型的局部变量，避免其与目标区间别名而阻碍向量化
+    template<class ContiguousIterator, class Size, class T>
+    inline ContiguousIterator __fill_n_aux(ContiguousIterator first, Size n, const T& value, __true_type_s){
+        typedef typename iterator_traits<ContiguousIterator>::value_type value_type;
+        if (n <= 0)
+            return first;
+        const value_type tmp = value;
+        value_type* p = simple_stl::to_address(first);
+        unsigned char byte;
+        if (simple_stl::__fill_repeated_byte(tmp, byte))
+            std::memset(static_cast<void*>(p), byte, sizeof(value_type) * n);
+        else
+            for (Size i = n; i > 0; --i, ++p)
+                *p = tmp;
+        return first + n;
+    }
+
+    template<class OutputIterator, class Size, class T>
+    inline OutputIterator __fill_n_seg(OutputIterator first, Size n, const T& value, __false_type_s){
+        return simple_stl::__fill_n_aux(first, n, value, __fill_use_memset<OutputIterator>());
+    }
+
+    // 分段迭代器：每段填满后转到下一段的开头
+    template<class SegmentedIterator, class Size, class T>
+    inline SegmentedIterator __fill_n_seg(SegmentedIterator first, Size count, const T& value, __true_type_s){
+        typedef segmented_iterator_traits<SegmentedIterator> traits;
+        typedef typename iterator_traits<SegmentedIterator>::difference_type Distance;
+        if (count <= 0)
+            return first;
+        Distance n = static_cast<Distance>(count);
+        typename traits::segment_iterator s = traits::segment(first);
+        typename traits::local_iterator l = traits::local(first);
+        for (Distance room = traits::end(s) - l; n >= room && n > 0; room = traits::end(s) - l){
+            simple_stl::fill_n(l, room, value);
+            n -= room;
+            ++s;
+            l = traits::begin(s);
+        }
+        l = simple_stl::fill_n(l, n, value);
+        return traits::compose(s, l);
+    }
+
+    template<class OutputIterator, class Size, class T>
+    inline OutputIterator fill_n(OutputIterator first, Size n, const T& value){
+        return simple_stl::__fill_n_seg(first, n, value, is_segmented_iterator<OutputIterator>());
+    }
+
+    /** fill：将 [first, last) 内的元素都赋值为 value */
+    template<class ForwardIterator, class T>
+    inline void fill(ForwardIterator first, ForwardIterator last, const T& value);
+
+    template<class ForwardIterator, class T>
+    inline void __fill(ForwardIterator first, ForwardIterator last, const T& value, forward_iterator_tag){
+        for ( ; first != last; ++first)
+            *first = value;
+    }
+
+    // random_access_iterator_tag版，求出长度后转为 fill_n()
+    template<class RandomAccessIterator, class T>
+    inline void __fill(RandomAccessIterator first, RandomAccessIterator last, const T& value,
+                       random_access_iterator_tag){
+        simple_stl::fill_n(first, last - first, value);
+    }
+
+    template<class ForwardIterator, class T>
+    inline void __fill_seg(ForwardIterator first, ForwardIterator last, const T& value, __false_type_s){
+        simple_stl::__fill(first, last, value, iterator_category(first));
+    }
+
+    template<class SegmentedIterator, class T>
+    inline void __fill_seg(SegmentedIterator first, SegmentedIterator last, const T& value, __true_type_s){
+        typedef segmented_iterator_traits<SegmentedIterator> traits;
+        typename traits::segment_iterator sf = traits::segment(first);
+        typename traits::segment_iterator sl = traits::segment(last);
+        if (sf == sl){
+            simple_stl::fill(traits::local(first), traits::local(last), value);
+            return;
+        }
+        simple_stl::fill(traits::local(first), traits::end(sf), value);
+        for (++sf; sf != sl; ++sf)
+            simple_stl::fill(traits::begin(sf), traits::end(sf), value);
+        simple_stl::fill(traits::begin(sl), traits::local(last), value);
+    }
+
+    template<class ForwardIterator, class T>
+    inline void fill(ForwardIterator first, ForwardIterator last, const T& value){
+        simple_stl::__fill_seg(first, last, value, is_segmented_iterator<ForwardIterator>());
+    }
+
+    /** mismatch：两个区间第一个不相等的位置 */
+    template<class InputIterator1, class InputIterator2>
+    inline pair<InputIterator1, InputIterator2>
+    __mismatch(InputIterator1 first1, InputIterator1 last1, InputIterator2 first2, __false_type_s){
+        while (first1 != last1 && *first1 == *first2){
+            ++first1;
+            ++first2;
+        }
+        return pair<InputIterator1, InputIterator2>(first1, first2);
+    }
+
+    template<class ContiguousIterator1, class ContiguousIterator2>
+    inline pair<ContiguousIterator1, ContiguousIterator2>
+    __mismatch(ContiguousIterator1 first1, ContiguousIterator1 last1, ContiguousIterator2 first2, __true_type_s){
+        typedef typename iterator_traits<ContiguousIterator1>::value_type T;
+        const size_t i = simple_stl::__simd_mismatch<T>(simple_stl::to_address(first1), simple_stl::to_address(first2),
+                                                        static_cast<size_t>(last1 - first1));
+        return pair<ContiguousIterator1, ContiguousIterator2>(first1 + i, first2 + i);
+    }
+
+    template<class InputIterator1, class InputIterator2>
+    inline pair<InputIterator1, InputIterator2>
+    mismatch(InputIterator1 first1, InputIterator1 last1, InputIterator2 first2){
+        return simple_stl::__mismatch(first1, last1, first2, __simd_contiguous_pair<InputIterator1, InputIterator2>());
+    }
+
+    template<class InputIterator1, class InputIterator2, class BinaryPredicate>
+    inline pair<InputIterator1, InputIterator2>
+    mismatch(InputIterator1 first1, InputIterator1 last1, InputIterator2 first2, BinaryPredicate pred){
+        while (first1 != last1 && pred(*first1, *first2)){
+            ++first1;
+            ++first2;
+        }
+        return pair<InputIterator1, InputIterator2>(first1, first2);
+    }
+
+    /** equal：[first1, last1) 与 first2 起始的等长区间逐个相等 */
+    template<class InputIterator1, class InputIterator2>
+    inline bool __equal(InputIterator1 first1, InputIterator1 last1, InputIterator2 first2, __false_type_s){
+        for ( ; first1 != last1; ++first1, ++first2)
+            if (!(*first1 == *first2))
+                return false;
+        return true;
+    }
+
+    template<class ContiguousIterator1, class ContiguousIterator2>
+    inline bool __equal(ContiguousIterator1 first1, ContiguousIterator1 last1, ContiguousIterator2 first2, __true_type_s){
+        typedef typename iterator_traits<ContiguousIterator1>::value_type T;
+        const size_t n = static_cast<size_t>(last1 - first1);
+        return simple_stl::__simd_mismatch<T>(simple_stl::to_address(first1), simple_stl::to_address(first2), n) == n;
+    }
+
+    template<class InputIterator1, class InputIterator2>
+    inline bool equal(InputIterator1 first1, InputIterator1 last1, InputIterator2 first2){
+        return simple_stl::__equal(first1, last1, first2, __simd_contiguous_pair<InputIterator1, InputIterator2>());
+    }
+
+    template<class InputIterator1, class InputIterator2, class BinaryPredicate>
+    inline bool equal(InputIterator1 first1, InputIterator1 last1, InputIterator2 first2, BinaryPredicate pred){
+        for ( ; first1 != last1; ++first1, ++first2)
+            if (!pred(*first1, *first2))
+                return false;
+        return true;
+    }
+
+    /** lexicographical_compare：第一个区间按字典序小于第二个区间 */
+    template<class InputIterator1, class InputIterator2>
+    bool __lexicographical_compare(InputIterator1 first1, InputIterator1 last1,
+                                   InputIterator2 first2, InputIterator2 last2, __false_type_s){
+        for ( ; first1 != last1 && first2 != last2; ++first1, ++first2){
+            if (*first1 < *first2)
+                return true;
+            if (*first2 < *first1)
+                return false;
+        }
+        return first1 == last1 && first2 != last2;
+    }
+
+    // 整数没有不可比较的值，先找第一个不等位置再比较该处；浮点数的 NaN 会让两者结果不同，不走这里
+    template<class ContiguousIterator1, class ContiguousIterator2>
+    inline bool __lexicographical_compare(ContiguousIterator1 first1, ContiguousIterator1 last1,
+                                          ContiguousIterator2 first2, ContiguousIterator2 last2, __true_type_s){
+        typedef typename iterator_traits<ContiguousIterator1>::value_type T;
+        const T* p1 = simple_stl::to_address(first1);
+        const T* p2 = simple_stl::to_address(first2);
+        const size_t n1 = static_cast<size_t>(last1 - first1);
+        const size_t n2 = static_cast<size_t>(last2 - first2);
+        const size_t n = n1 < n2 ? n1 : n2;
+        const size_t i = simple_stl::__simd_mismatch<T>(p1, p2, n);
+        return i < n ? p1[i] < p2[i] : n1 < n2;
+    }
+
+    template<class InputIterator1, class InputIterator2>
+    inline bool lexicographical_compare(InputIterator1 first1, InputIterator1 last1,
+                                        InputIterator2 first2, InputIterator2 last2){
+        return simple_stl::__lexicographical_compare(first1, last1, first2, last2,
+                bool_constant_s<__simd_contiguous_pair<InputIterator1, InputIterator2>::value &&
+                                __simd_integral_contiguous<InputIterator1>::value>());
+    }
+
+    template<class InputIterator1, class InputIterator2, class Compare>
+    bool lexicographical_compare(InputIterator1 first1, InputIterator1 last1,
+                                 InputIterator2 first2, InputIterator2 last2, Compare comp){
+        for ( ; first1 != last1 && first2 != last2; ++first1, ++first2){
+            if (comp(*first1, *first2))
+                return true;
+            if (comp(*first2, *first1))
+                return false;
+        }
+        return first1 == last1 && first2 != last2;
+    }
+
+}   // simple_stl
+
+#endif //SIMPLESTL_STL_ALGOBASE_H
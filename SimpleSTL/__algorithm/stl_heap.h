@@ -0,0 +1,137 @@
+/**
+ * Created by 史进 on 2023/6/21.
+ *
+ * 堆算法：make_heap、push_heap、pop_heap、sort_heap，只接受随机访问迭代器
+ *  - 以 comp 为准的大根堆，堆顶为 comp 意义下最大的元素
+ *  - 下沉时先沿较大的孩子一路挪到叶子，再上浮回正确位置，比逐层比较少一半的比较
+ */
+#ifndef SIMPLESTL_STL_HEAP_H
+#define SIMPLESTL_STL_HEAP_H
+
+#include "../iterator.h"
+#include "../utility.h"
+#include "../__functional/stl_function.h"
+
+namespace simple_stl{
+
+    // 把 value 从洞 hole 上浮，不越过 top
+    template<class RandomAccessIterator, class Distance, class T, class Compare>
+    void __push_heap(RandomAccessIterator first, Distance hole, Distance top, T value, Compare& comp){
+        Distance parent = (hole - 1) / 2;
+        while (hole > top && comp(*(first + parent), value)){
+            *(first + hole) = simple_stl::move(*(first + parent));
+            hole = parent;
+            parent = (hole - 1) / 2;
+        }
+        *(first + hole) = simple_stl::move(value);
+    }
+
+    // 洞 hole 沿较大的孩子下沉到叶子，再把 value 放回并上浮
+    template<class RandomAccessIterator, class Distance, class T, class Compare>
+    void __adjust_heap(RandomAccessIterator first, Distance hole, Distance len, T value, Compare& comp){
+        const Distance top = hole;
+        Distance child = 2 * hole + 2;
+        while (child < len){
+            if (comp(*(first + child), *(first + (child - 1))))
+                --child;
+            *(first + hole) = simple_stl::move(*(first + child));
+            hole = child;
+            child = 2 * child + 2;
+        }
+        if (child == len){
+            *(first + hole) = simple_stl::move(*(first + (child - 1)));
+            hole = child - 1;
+        }
+        simple_stl::__push_heap(first, hole, top, simple_stl::move(value), comp);
+    }
+
+    // 堆顶移到 result，result 原先的元素重新入堆 [first, last)
+    template<class RandomAccessIterator, class Compare>
+    inline void __pop_heap(RandomAccessIterator first, RandomAccessIterator last,
+                           RandomAccessIterator result, Compare& comp){
+        typedef typename iterator_traits<RandomAccessIterator>::value_type      T;
+        typedef typename iterator_traits<RandomAccessIterator>::difference_type Distance;
+        T value = simple_stl::move(*result);
+        *result = simple_stl::move(*first);
+        simple_stl::__adjust_heap(first, Distance(0), Distance(last - first), simple_stl::move(value), comp);
+    }
+
+    template<class RandomAccessIterator, class Compare>
+    void __make_heap(RandomAccessIterator first, RandomAccessIterator last, Compare& comp){
+        typedef typename iterator_traits<RandomAccessIterator>::value_type      T;
+        typedef typename iterator_traits<RandomAccessIterator>::difference_type Distance;
+        const Distance len = last - first;
+        if (len < 2)
+            return;
+        for (Distance parent = (len - 2) / 2; ; --parent){
+            T value = simple_stl::move(*(first + parent));
+            simple_stl::__adjust_heap(first, parent, len, simple_stl::move(value), comp);
+            if (parent == 0)
+                return;
+        }
+    }
+
+    template<class RandomAccessIterator, class Compare>
+    void __sort_heap(RandomAccessIterator first, RandomAccessIterator last, Compare& comp){
+        while (last - first > 1){
+            --last;
+            simple_stl::__pop_heap(first, last, last, comp);
+        }
+    }
+
+
+    /** 建堆 */
+    template<class RandomAccessIterator, class Compare>
+    inline void make_heap(RandomAccessIterator first, RandomAccessIterator last, Compare comp){
+        simple_stl::__make_heap(first, last, comp);
+    }
+
+    template<class RandomAccessIterator>
+    inline void make_heap(RandomAccessIterator first, RandomAccessIterator last){
+        simple_stl::make_heap(first, last, less<typename iterator_traits<RandomAccessIterator>::value_type>());
+    }
+
+    /** 入堆：新元素位于 last - 1 */
+    template<class RandomAccessIterator, class Compare>
+    inline void push_heap(RandomAccessIterator first, RandomAccessIterator last, Compare comp){
+        typedef typename iterator_traits<RandomAccessIterator>::value_type      T;
+        typedef typename iterator_traits<RandomAccessIterator>::difference_type Distance;
+        if (last - first < 2)
+            return;
+        T value = simple_stl::move(*(last - 1));
+        simple_stl::__push_heap(first, Distance((last - first) - 1), Distance(0), simple_stl::move(value), comp);
+    }
+
+    template<class RandomAccessIterator>
+    inline void push_heap(RandomAccessIterator first, RandomAccessIterator last){
+        simple_stl::push_heap(first, last, less<typename iterator_traits<RandomAccessIterator>::value_type>());
+    }
+
+    /** 出堆：堆顶移到 last - 1 */
+    template<class RandomAccessIterator, class Compare>
+    inline void pop_heap(RandomAccessIterator first, RandomAccessIterator last, Compare comp){
+        if (last - first < 2)
+            return;
+        --last;
+        simple_stl::__pop_heap(first, last, last, comp);
+    }
+
+    template<class RandomAccessIterator>
+    inline void pop_heap(RandomAccessIterator first, RandomAccessIterator last){
+        simple_stl::pop_heap(first, last, less<typename iterator_traits<RandomAccessIterator>::value_type>());
+    }
+
+    /** 堆排序：[first, last) 须已是堆 */
+    template<class RandomAccessIterator, class Compare>
+    inline void sort_heap(RandomAccessIterator first, RandomAccessIterator last, Compare comp){
+        simple_stl::__sort_heap(first, last, comp);
+    }
+
+    template<class RandomAccessIterator>
+    inline void sort_heap(RandomAccessIterator first, RandomAccessIterator last){
+        simple_stl::sort_heap(first, last, less<typename iterator_traits<RandomAccessIterator>::value_type>());
+    }
+
+}   // simple_stl
+
+#endif //SIMPLESTL_STL_HEAP_H
@@ -0,0 +1,98 @@
+/**
+ * Created by 史进 on 2023/6/23.
+ *
+ * 数值算法：accumulate、reduce、transform_reduce、inclusive_scan
+ *  - accumulate 严格从左到右累加；reduce 系列允许任意结合次序，op 须满足结合律与交换律，并行版本依赖这一点
+ */
+#ifndef SIMPLESTL_STL_NUMERIC_H
+#define SIMPLESTL_STL_NUMERIC_H
+
+#include "../iterator.h"
+#include "../utility.h"
+#include "../__functional/stl_function.h"
+
+namespace simple_stl{
+
+    /** accumulate */
+    template<class InputIterator, class T, class BinaryOperation>
+    inline T accumulate(InputIterator first, InputIterator last, T init, BinaryOperation op){
+        for ( ; first != last; ++first)
+            init = op(simple_stl::move(init), *first);
+        return init;
+    }
+
+    template<class InputIterator, class T>
+    inline T accumulate(InputIterator first, InputIterator last, T init){
+        return simple_stl::accumulate(first, last, simple_stl::move(init), plus<T>());
+    }
+
+    /** reduce */
+    template<class InputIterator, class T, class BinaryOperation>
+    inline T reduce(InputIterator first, InputIterator last, T init, BinaryOperation op){
+        for ( ; first != last; ++first)
+            init = op(simple_stl::move(init), *first);
+        return init;
+    }
+
+    template<class InputIterator, class T>
+    inline T reduce(InputIterator first, InputIterator last, T init){
+        return simple_stl::reduce(first, last, simple_stl::move(init), plus<T>());
+    }
+
+    template<class InputIterator>
+    inline typename iterator_traits<InputIterator>::value_type reduce(InputIterator first, InputIterator last){
+        typedef typename iterator_traits<InputIterator>::value_type T;
+        return simple_stl::reduce(first, last, T(), plus<T>());
+    }
+
+    /** transform_reduce：先变换再归约；双区间版本默认为内积 */
+    template<class InputIterator, class T, class BinaryOperation, class UnaryOperation>
+    inline T transform_reduce(InputIterator first, InputIterator last, T init,
+                              BinaryOperation reduce_op, UnaryOperation transform_op){
+        for ( ; first != last; ++first)
+            init = reduce_op(simple_stl::move(init), transform_op(*first));
+        return init;
+    }
+
+    template<class InputIterator1, class InputIterator2, class T, class BinaryOperation1, class BinaryOperation2>
+    inline T transform_reduce(InputIterator1 first1, InputIterator1 last1, InputIterator2 first2, T init,
+                              BinaryOperation1 reduce_op, BinaryOperation2 transform_op){
+        for ( ; first1 != last1; ++first1, ++first2)
+            init = reduce_op(simple_stl::move(init), transform_op(*first1, *first2));
+        return init;
+    }
+
+    template<class InputIterator1, class InputIterator2, class T>
+    inline T transform_reduce(InputIterator1 first1, InputIterator1 last1, InputIterator2 first2, T init){
+        return simple_stl::transform_reduce(first1, last1, first2, simple_stl::move(init), plus<T>(), multiplies<T>());
+    }
+
+    /** inclusive_scan：第 i 个输出为前 i + 1 个元素（及 init）的归约，result 可以等于 first */
+    template<class InputIterator, class OutputIterator, class BinaryOperation, class T>
+    OutputIterator inclusive_scan(InputIterator first, InputIterator last, OutputIterator result,
+                                  BinaryOperation op, T init){
+        for ( ; first != last; ++first, ++result){
+            init = op(simple_stl::move(init), *first);
+            *result = init;
+        }
+        return result;
+    }
+
+    template<class InputIterator, class OutputIterator, class BinaryOperation>
+    OutputIterator inclusive_scan(InputIterator first, InputIterator last, OutputIterator result, BinaryOperation op){
+        if (first == last)
+            return result;
+        typename iterator_traits<InputIterator>::value_type sum = *first;
+        *result = sum;
+        return simple_stl::inclusive_scan(++first, last, ++result, op, simple_stl::move(sum));
+    }
+
+    template<class InputIterator, class OutputIterator>
+    inline OutputIterator inclusive_scan(InputIterator first, InputIterator last, OutputIterator result){
+        return simple_stl::inclusive_scan(first, last, result,
+                                          plus<typename iterator_traits<InputIterator>::value_type>());
+    }
+
+}   // simple_stl
+
+#endif //SIMPLESTL_STL_NUMERIC_H
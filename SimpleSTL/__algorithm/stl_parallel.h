@@ -0,0 +1,457 @@
+/**
+ * Created by 史进 on 2023/6/23.
+ *
+ * 并行算法：带执行策略的 for_each、transform、fill、reduce、transform_reduce、inclusive_scan、sort
+ *  - seq 直接调用顺序版本；par、par_unseq 对随机访问区间用 distance 求长度，
+ *    按块数均分后用 advance 定位各块起点，交给 thread_pool 执行，其他迭代器退回顺序版本
+ *  - 每块不少于 __parallel_grain 个元素，块数至多为并发数的 4 倍，留出余量给工作窃取均衡负载
+ *  - reduce、transform_reduce 先各块归约，再按块的次序合并，op 须满足结合律与交换律
+ *  - inclusive_scan 两趟：先求各块的归约，串行求出各块的前缀，再各块带着前缀扫描
+ *  - sort 把元素移入暂存区后各块用 pdqsort 排序，再两两归并 log2(块数) 轮，
+ *    每轮的每对归并按左段均分、在右段二分查找分界，切成多个任务并行
+ */
+#ifndef SIMPLESTL_STL_PARALLEL_H
+#define SIMPLESTL_STL_PARALLEL_H
+
+#include "stl_algo.h"
+#include "stl_algobase.h"
+#include "stl_numeric.h"
+#include "stl_sort.h"
+#include "../iterator.h"
+#include "../utility.h"
+#include "../__container/stl_vector.h"
+#include "../__execution/stl_execution_policy.h"
+#include "../__execution/stl_thread_pool.h"
+#include "../__memory/stl_allocator.h"
+#include "../__memory/stl_construct.h"
+#include "../__memory/stl_uninitialized.h"
+
+namespace simple_stl{
+
+    // 每块至少处理的元素个数
+    const size_t __parallel_grain = 4096;
+    // 并行排序每块至少的元素个数
+    const size_t __parallel_sort_grain = 16384;
+
+    inline thread_pool* __policy_pool(const execution::sequenced_policy&) { return nullptr; }
+    inline thread_pool* __policy_pool(const execution::parallel_policy& p) { return &p.pool(); }
+    inline thread_pool* __policy_pool(const execution::parallel_unsequenced_policy& p) { return &p.pool(); }
+
+    // 长度为 n 的区间切成的块数；返回 1 时直接走顺序版本
+    inline size_t __parallel_chunks(thread_pool* pool, size_t n, size_t grain){
+        if (pool == nullptr || pool->size() == 0)
+            return 1;
+        const size_t by_grain = n / grain;
+        const size_t limit = pool->concurrency() * 4;
+        return by_grain == 0 ? 1 : (by_grain < limit ? by_grain : limit);
+    }
+
+    // 第 i 块的起始下标
+    inline size_t __chunk_begin(size_t n, size_t chunks, size_t i){
+        return static_cast<size_t>(static_cast<unsigned long long>(n) * i / chunks);
+    }
+
+    // 对第 i 块 [lo, hi) 调用 f(i, lo_iterator, hi_iterator)
+    template<class RandomAccessIterator, class Function>
+    void __parallel_for_chunks(thread_pool* pool, RandomAccessIterator first, size_t n, size_t chunks, Function f){
+        auto body = [&](size_t i){
+            RandomAccessIterator lo = first;
+            simple_stl::advance(lo, __chunk_begin(n, chunks, i));
+            RandomAccessIterator hi = lo;
+            simple_stl::advance(hi, __chunk_begin(n, chunks, i + 1) - __chunk_begin(n, chunks, i));
+            f(i, lo, hi);
+        };
+        pool->parallel_for(chunks, body);
+    }
+
+    // 各块用 chunk_fn(lo, hi) 求出部分结果，再与 init 按块的次序合并
+    template<class RandomAccessIterator, class T, class BinaryOperation, class ChunkFunction>
+    T __parallel_reduce_chunks(thread_pool* pool, RandomAccessIterator first, size_t n, size_t chunks,
+                               T init, BinaryOperation& op, ChunkFunction chunk_fn){
+        vector<T> partial(chunks, init);
+        simple_stl::__parallel_for_chunks(pool, first, n, chunks,
+                [&](size_t i, RandomAccessIterator lo, RandomAccessIterator hi){
+                    partial[i] = chunk_fn(lo, hi);
+                });
+        for (size_t i = 0; i < chunks; ++i)
+            init = op(simple_stl::move(init), simple_stl::move(partial[i]));
+        return init;
+    }
+
+
+    /** for_each */
+    template<class ExecutionPolicy, class ForwardIterator, class Function>
+    typename __enable_if_execution_policy<ExecutionPolicy, void>::type
+    for_each(ExecutionPolicy&& policy, ForwardIterator first, ForwardIterator last, Function f){
+        thread_pool* pool = __policy_pool(policy);
+        if (!is_random_access_iterator<ForwardIterator>::value){
+            simple_stl::for_each(first, last, f);
+            return;
+        }
+        const size_t n = static_cast<size_t>(simple_stl::distance(first, last));
+        const size_t chunks = __parallel_chunks(pool, n, __parallel_grain);
+        if (chunks == 1){
+            simple_stl::for_each(first, last, f);
+            return;
+        }
+        simple_stl::__parallel_for_chunks(pool, first, n, chunks,
+                [&](size_t, ForwardIterator lo, ForwardIterator hi){
+                    for ( ; lo != hi; ++lo)
+                        f(*lo);
+                });
+    }
+
+    /** transform */
+    template<class ExecutionPolicy, class ForwardIterator1, class ForwardIterator2, class UnaryOperation>
+    typename __enable_if_execution_policy<ExecutionPolicy, ForwardIterator2>::type
+    transform(ExecutionPolicy&& policy, ForwardIterator1 first, ForwardIterator1 last,
+              ForwardIterator2 result, UnaryOperation op){
+        thread_pool* pool = __policy_pool(policy);
+        if (!is_random_access_iterator<ForwardIterator1>::value || !is_random_access_iterator<ForwardIterator2>::value)
+            return simple_stl::transform(first, last, result, op);
+        const size_t n = static_cast<size_t>(simple_stl::distance(first, last));
+        const size_t chunks = __parallel_chunks(pool, n, __parallel_grain);
+        if (chunks == 1)
+            return simple_stl::transform(first, last, result, op);
+        simple_stl::__parallel_for_chunks(pool, first, n, chunks,
+                [&](size_t i, ForwardIterator1 lo, ForwardIterator1 hi){
+                    ForwardIterator2 out = result;
+                    simple_stl::advance(out, __chunk_begin(n, chunks, i));
+                    simple_stl::transform(lo, hi, out, op);
+                });
+        simple_stl::advance(result, n);
+        return result;
+    }
+
+    template<class ExecutionPolicy, class ForwardIterator1, class ForwardIterator2, class ForwardIterator3,
+             class BinaryOperation>
+    typename __enable_if_execution_policy<ExecutionPolicy, ForwardIterator3>::type
+    transform(ExecutionPolicy&& policy, ForwardIterator1 first1, ForwardIterator1 last1,
+              ForwardIterator2 first2, ForwardIterator3 result, BinaryOperation op){
+        thread_pool* pool = __policy_pool(policy);
+        if (!is_random_access_iterator<ForwardIterator1>::value || !is_random_access_iterator<ForwardIterator2>::value ||
+            !is_random_access_iterator<ForwardIterator3>::value)
+            return simple_stl::transform(first1, last1, first2, result, op);
+        const size_t n = static_cast<size_t>(simple_stl::distance(first1, last1));
+        const size_t chunks = __parallel_chunks(pool, n, __parallel_grain);
+        if (chunks == 1)
+            return simple_stl::transform(first1, last1, first2, result, op);
+        simple_stl::__parallel_for_chunks(pool, first1, n, chunks,
+                [&](size_t i, ForwardIterator1 lo, ForwardIterator1 hi){
+                    ForwardIterator2 in2 = first2;
+                    ForwardIterator3 out = result;
+                    simple_stl::advance(in2, __chunk_begin(n, chunks, i));
+                    simple_stl::advance(out, __chunk_begin(n, chunks, i));
+                    simple_stl::transform(lo, hi, in2, out, op);
+                });
+        simple_stl::advance(result, n);
+        return result;
+    }
+
+    /** fill */
+    template<class ExecutionPolicy, class ForwardIterator, class T>
+    typename __enable_if_execution_policy<ExecutionPolicy, void>::type
+    fill(ExecutionPolicy&& policy, ForwardIterator first, ForwardIterator last, const T& value){
+        thread_pool* pool = __policy_pool(policy);
+        if (!is_random_access_iterator<ForwardIterator>::value){
+            simple_stl::fill(first, last, value);
+            return;
+        }
+        const size_t n = static_cast<size_t>(simple_stl::distance(first, last));
+        const size_t chunks = __parallel_chunks(pool, n, __parallel_grain);
+        if (chunks == 1){
+            simple_stl::fill(first, last, value);
+            return;
+        }
+        simple_stl::__parallel_for_chunks(pool, first, n, chunks,
+                [&](size_t, ForwardIterator lo, ForwardIterator hi){
+                    simple_stl::fill(lo, hi, value);
+                });
+    }
+
+    /** reduce */
+    template<class ExecutionPolicy, class ForwardIterator, class T, class BinaryOperation>
+    typename __enable_if_execution_policy<ExecutionPolicy, T>::type
+    reduce(ExecutionPolicy&& policy, ForwardIterator first, ForwardIterator last, T init, BinaryOperation op){
+        thread_pool* pool = __policy_pool(policy);
+        if (!is_random_access_iterator<ForwardIterator>::value)
+            return simple_stl::reduce(first, last, simple_stl::move(init), op);
+        const size_t n = static_cast<size_t>(simple_stl::distance(first, last));
+        const size_t chunks = __parallel_chunks(pool, n, __parallel_grain);
+        if (chunks == 1)
+            return simple_stl::reduce(first, last, simple_stl::move(init), op);
+        return simple_stl::__parallel_reduce_chunks(pool, first, n, chunks, simple_stl::move(init), op,
+                [&](ForwardIterator lo, ForwardIterator hi){
+                    T acc = *lo;
+                    return simple_stl::reduce(++lo, hi, simple_stl::move(acc), op);
+                });
+    }
+
+    template<class ExecutionPolicy, class ForwardIterator, class T>
+    inline typename __enable_if_execution_policy<ExecutionPolicy, T>::type
+    reduce(ExecutionPolicy&& policy, ForwardIterator first, ForwardIterator last, T init){
+        return simple_stl::reduce(simple_stl::forward<ExecutionPolicy>(policy), first, last,
+                                  simple_stl::move(init), plus<T>());
+    }
+
+    template<class ExecutionPolicy, class ForwardIterator>
+    inline typename __enable_if_execution_policy<ExecutionPolicy,
+            typename iterator_traits<ForwardIterator>::value_type>::type
+    reduce(ExecutionPolicy&& policy, ForwardIterator first, ForwardIterator last){
+        typedef typename iterator_traits<ForwardIterator>::value_type T;
+        return simple_stl::reduce(simple_stl::forward<ExecutionPolicy>(policy), first, last, T(), plus<T>());
+    }
+
+    /** transform_reduce */
+    template<class ExecutionPolicy, class ForwardIterator, class T, class BinaryOperation, class UnaryOperation>
+    typename __enable_if_execution_policy<ExecutionPolicy, T>::type
+    transform_reduce(ExecutionPolicy&& policy, ForwardIterator first, ForwardIterator last, T init,
+                     BinaryOperation reduce_op, UnaryOperation transform_op){
+        thread_pool* pool = __policy_pool(policy);
+        if (!is_random_access_iterator<ForwardIterator>::value)
+            return simple_stl::transform_reduce(first, last, simple_stl::move(init), reduce_op, transform_op);
+        const size_t n = static_cast<size_t>(simple_stl::distance(first, last));
+        const size_t chunks = __parallel_chunks(pool, n, __parallel_grain);
+        if (chunks == 1)
+            return simple_stl::transform_reduce(first, last, simple_stl::move(init), reduce_op, transform_op);
+        return simple_stl::__parallel_reduce_chunks(pool, first, n, chunks, simple_stl::move(init), reduce_op,
+                [&](ForwardIterator lo, ForwardIterator hi){
+                    T acc = transform_op(*lo);
+                    return simple_stl::transform_reduce(++lo, hi, simple_stl::move(acc), reduce_op, transform_op);
+                });
+    }
+
+    template<class ExecutionPolicy, class ForwardIterator1, class ForwardIterator2, class T,
+             class BinaryOperation1, class BinaryOperation2>
+    typename __enable_if_execution_policy<ExecutionPolicy, T>::type
+    transform_reduce(ExecutionPolicy&& policy, ForwardIterator1 first1, ForwardIterator1 last1,
+                     ForwardIterator2 first2, T init, BinaryOperation1 reduce_op, BinaryOperation2 transform_op){
+        thread_pool* pool = __policy_pool(policy);
+        if (!is_random_access_iterator<ForwardIterator1>::value || !is_random_access_iterator<ForwardIterator2>::value)
+            return simple_stl::transform_reduce(first1, last1, first2, simple_stl::move(init), reduce_op, transform_op);
+        const size_t n = static_cast<size_t>(simple_stl::distance(first1, last1));
+        const size_t chunks = __parallel_chunks(pool, n, __parallel_grain);
+        if (chunks == 1)
+            return simple_stl::transform_reduce(first1, last1, first2, simple_stl::move(init), reduce_op, transform_op);
+        return simple_stl::__parallel_reduce_chunks(pool, first1, n, chunks, simple_stl::move(init), reduce_op,
+                [&](ForwardIterator1 lo, ForwardIterator1 hi){
+                    ForwardIterator2 in2 = first2;
+                    simple_stl::advance(in2, simple_stl::distance(first1, lo));
+                    T acc = transform_op(*lo, *in2);
+                    return simple_stl::transform_reduce(++lo, hi, ++in2, simple_stl::move(acc), reduce_op, transform_op);
+                });
+    }
+
+    template<class ExecutionPolicy, class ForwardIterator1, class ForwardIterator2, class T>
+    inline typename __enable_if_execution_policy<ExecutionPolicy, T>::type
+    transform_reduce(ExecutionPolicy&& policy, ForwardIterator1 first1, ForwardIterator1 last1,
+                     ForwardIterator2 first2, T init){
+        return simple_stl::transform_reduce(simple_stl::forward<ExecutionPolicy>(policy), first1, last1, first2,
+                                            simple_stl::move(init), plus<T>(), multiplies<T>());
+    }
+
+    /** inclusive_scan */
+    // has_init 为 false 时第一块不带前缀，init 仅作占位
+    template<class ForwardIterator1, class ForwardIterator2, class BinaryOperation, class T>
+    ForwardIterator2 __parallel_inclusive_scan(thread_pool* pool, ForwardIterator1 first, ForwardIterator1 last,
+                                               ForwardIterator2 result, BinaryOperation& op, T init, bool has_init){
+        const size_t n = static_cast<size_t>(simple_stl::distance(first, last));
+        const size_t chunks = __parallel_chunks(pool, n, __parallel_grain);
+        if (chunks == 1){
+            if (has_init)
+                return simple_stl::inclusive_scan(first, last, result, op, simple_stl::move(init));
+            return simple_stl::inclusive_scan(first, last, result, op);
+        }
+
+        // 第一趟：各块的归约
+        vector<T> carry(chunks, init);
+        simple_stl::__parallel_for_chunks(pool, first, n, chunks,
+                [&](size_t i, ForwardIterator1 lo, ForwardIterator1 hi){
+                    T acc = *lo;
+                    carry[i] = simple_stl::reduce(++lo, hi, simple_stl::move(acc), op);
+                });
+        // 串行求前缀：carry[i] 变为前 i 块（及 init）的归约
+        T sum = simple_stl::move(init);
+        for (size_t i = 0; i < chunks; ++i){
+            T next = (i == 0 && !has_init) ? carry[0] : op(sum, carry[i]);
+            carry[i] = simple_stl::move(sum);
+            sum = simple_stl::move(next);
+        }
+        // 第二趟：各块带前缀扫描
+        simple_stl::__parallel_for_chunks(pool, first, n, chunks,
+                [&](size_t i, ForwardIterator1 lo, ForwardIterator1 hi){
+                    ForwardIterator2 out = result;
+                    simple_stl::advance(out, __chunk_begin(n, chunks, i));
+                    if (i == 0 && !has_init)
+                        simple_stl::inclusive_scan(lo, hi, out, op);
+                    else
+                        simple_stl::inclusive_scan(lo, hi, out, op, carry[i]);
+                });
+        simple_stl::advance(result, n);
+        return result;
+    }
+
+    template<class ExecutionPolicy, class ForwardIterator1, class ForwardIterator2, class BinaryOperation, class T>
+    typename __enable_if_execution_policy<ExecutionPolicy, ForwardIterator2>::type
+    inclusive_scan(ExecutionPolicy&& policy, ForwardIterator1 first, ForwardIterator1 last,
+                   ForwardIterator2 result, BinaryOperation op, T init){
+        if (!is_random_access_iterator<ForwardIterator1>::value || !is_random_access_iterator<ForwardIterator2>::value)
+            return simple_stl::inclusive_scan(first, last, result, op, simple_stl::move(init));
+        return simple_stl::__parallel_inclusive_scan(__policy_pool(policy), first, last, result, op,
+                                                     simple_stl::move(init), true);
+    }
+
+    template<class ExecutionPolicy, class ForwardIterator1, class ForwardIterator2, class BinaryOperation>
+    typename __enable_if_execution_policy<ExecutionPolicy, ForwardIterator2>::type
+    inclusive_scan(ExecutionPolicy&& policy, ForwardIterator1 first, ForwardIterator1 last,
+                   ForwardIterator2 result, BinaryOperation op){
+        typedef typename iterator_traits<ForwardIterator1>::value_type T;
+        if (first == last)
+            return result;
+        if (!is_random_access_iterator<ForwardIterator1>::value || !is_random_access_iterator<ForwardIterator2>::value)
+            return simple_stl::inclusive_scan(first, last, result, op);
+        return simple_stl::__parallel_inclusive_scan(__policy_pool(policy), first, last, result, op, T(*first), false);
+    }
+
+    template<class ExecutionPolicy, class ForwardIterator1, class ForwardIterator2>
+    inline typename __enable_if_execution_policy<ExecutionPolicy, ForwardIterator2>::type
+    inclusive_scan(ExecutionPolicy&& policy, ForwardIterator1 first, ForwardIterator1 last, ForwardIterator2 result){
+        return simple_stl::inclusive_scan(simple_stl::forward<ExecutionPolicy>(policy), first, last, result,
+                                          plus<typename iterator_traits<ForwardIterator1>::value_type>());
+    }
+
+    /** sort */
+    // 归并 [a, a_last) 与 [b, b_last) 到 out，相等时先取左段
+    template<class InputIterator, class OutputIterator, class Compare>
+    void __parallel_merge_part(InputIterator a, InputIterator a_last, InputIterator b, InputIterator b_last,
+                               OutputIterator out, Compare& comp){
+        while (a != a_last && b != b_last){
+            if (comp(*b, *a)){
+                *out = simple_stl::move(*b);
+                ++b;
+            }
+            else{
+                *out = simple_stl::move(*a);
+                ++a;
+            }
+            ++out;
+        }
+        for ( ; a != a_last; ++a, ++out)
+            *out = simple_stl::move(*a);
+        for ( ; b != b_last; ++b, ++out)
+            *out = simple_stl::move(*b);
+    }
+
+    // 一轮归并：src 中每 width 块为一段有序区间，相邻两段归并到 dst 的相同位置
+    // 每对归并切成 2 * width 个任务：左段均分，右段的分界由二分查找确定
+    // 移动赋值会改写源元素，分界须在任何任务开始移动之前全部求出
+    template<class Source, class Destination, class Compare>
+    void __parallel_merge_round(thread_pool* pool, Source src, Destination dst, size_t n,
+                                size_t chunks, size_t width, Compare& comp){
+        const size_t parts = 2 * width;
+        // split[t] 为第 t 个任务左段起点在右段中对应的位置
+        vector<size_t> split(chunks, 0);
+        for (size_t t = 0; t < chunks; ++t){
+            const size_t pair = t / parts;
+            const size_t part = t % parts;
+            const size_t a0 = __chunk_begin(n, chunks, pair * parts);
+            const size_t b0 = __chunk_begin(n, chunks, pair * parts + width);
+            const size_t b1 = __chunk_begin(n, chunks, (pair + 1) * parts);
+            const size_t a_lo = a0 + (b0 - a0) * part / parts;
+            split[t] = part == 0 ? b0 : static_cast<size_t>(
+                    simple_stl::lower_bound(src + b0, src + b1, *(src + a_lo), comp) - src);
+        }
+        auto body = [&](size_t t){
+            const size_t pair = t / parts;
+            const size_t part = t % parts;
+            const size_t a0 = __chunk_begin(n, chunks, pair * parts);
+            const size_t b0 = __chunk_begin(n, chunks, pair * parts + width);
+            const size_t b1 = __chunk_begin(n, chunks, (pair + 1) * parts);
+            const size_t a_lo = a0 + (b0 - a0) * part / parts;
+            const size_t a_hi = a0 + (b0 - a0) * (part + 1) / parts;
+            const size_t b_lo = split[t];
+            const size_t b_hi = part + 1 == parts ? b1 : split[t + 1];
+            simple_stl::__parallel_merge_part(src + a_lo, src + a_hi, src + b_lo, src + b_hi,
+                                              dst + (a_lo + (b_lo - b0)), comp);
+        };
+        pool->parallel_for(chunks, body);
+    }
+
+    template<class RandomAccessIterator, class Compare>
+    void __parallel_sort(thread_pool* pool, RandomAccessIterator first, RandomAccessIterator last, Compare& comp){
+        typedef typename iterator_traits<RandomAccessIterator>::value_type T;
+        const size_t n = static_cast<size_t>(simple_stl::distance(first, last));
+        // 块数取 2 的幂，归并轮次两两配对
+        size_t chunks = 1;
+        const size_t target = pool == nullptr ? 1 : pool->concurrency();
+        while (chunks < target && pool->size() != 0 && n / (chunks * 2) >= __parallel_sort_grain)
+            chunks *= 2;
+        if (chunks == 1){
+            simple_stl::sort(first, last, comp);
+            return;
+        }
+
+        // 元素先移入暂存区，此后各轮都是对已构造对象的赋值
+        allocator<T> a;
+        T* buf = a.allocate(n);
+        vector<char> moved(chunks, 0);
+        try{
+            simple_stl::__parallel_for_chunks(pool, first, n, chunks,
+                    [&](size_t i, RandomAccessIterator lo, RandomAccessIterator hi){
+                        T* out = buf + __chunk_begin(n, chunks, i);
+                        simple_stl::uninitialized_move(lo, hi, out);
+                        moved[i] = 1;
+                        simple_stl::sort(out, out + (hi - lo), comp);
+                    });
+        }
+        catch (...){
+            for (size_t i = 0; i < chunks; ++i)
+                if (moved[i])
+                    simple_stl::destroy(buf + __chunk_begin(n, chunks, i), buf + __chunk_begin(n, chunks, i + 1));
+            a.deallocate(buf, n);
+            throw;
+        }
+
+        try{
+            bool in_buf = true;
+            for (size_t width = 1; width < chunks; width *= 2){
+                if (in_buf)
+                    simple_stl::__parallel_merge_round(pool, buf, first, n, chunks, width, comp);
+                else
+                    simple_stl::__parallel_merge_round(pool, first, buf, n, chunks, width, comp);
+                in_buf = !in_buf;
+            }
+            if (in_buf){
+                simple_stl::__parallel_for_chunks(pool, first, n, chunks,
+                        [&](size_t i, RandomAccessIterator lo, RandomAccessIterator hi){
+                            for (T* p = buf + __chunk_begin(n, chunks, i); lo != hi; ++lo, ++p)
+                                *lo = simple_stl::move(*p);
+                        });
+            }
+        }
+        catch (...){
+            simple_stl::destroy(buf, buf + n);
+            a.deallocate(buf, n);
+            throw;
+        }
+        simple_stl::destroy(buf, buf + n);
+        a.deallocate(buf, n);
+    }
+
+    template<class ExecutionPolicy, class RandomAccessIterator, class Compare>
+    typename __enable_if_execution_policy<ExecutionPolicy, void>::type
+    sort(ExecutionPolicy&& policy, RandomAccessIterator first, RandomAccessIterator last, Compare comp){
+        static_assert(is_random_access_iterator<RandomAccessIterator>::value, "sort requires random access iterators");
+        simple_stl::__parallel_sort(__policy_pool(policy), first, last, comp);
+    }
+
+    template<class ExecutionPolicy, class RandomAccessIterator>
+    inline typename __enable_if_execution_policy<ExecutionPolicy, void>::type
+    sort(ExecutionPolicy&& policy, RandomAccessIterator first, RandomAccessIterator last){
+        simple_stl::sort(simple_stl::forward<ExecutionPolicy>(policy), first, last,
+                         less<typename iterator_traits<RandomAccessIterator>::value_type>());
+    }
+
+}   // simple_stl
+
+#endif //SIMPLESTL_STL_PARALLEL_H
@@ -0,0 +1,201 @@
+/**
+ * Created by 史进 on 2023/6/22.
+ *
+ * radix_sort：按整数或浮点数键的最低有效字节优先（LSD）基数排序，稳定，只接受随机访问迭代器
+ *  - key 从元素中取出键，默认算术类型取元素本身，pair 取 first
+ *  - 键先变换为无符号整数，使其按位比较的次序与原类型一致：
+ *    有符号整数翻转符号位；浮点数为负时全部取反，否则只翻转符号位
+ *  - 一趟遍历同时统计各字节的直方图，所有键在某字节上取值相同时跳过该趟
+ *  - 每趟按前缀和把元素分派到暂存区，暂存区与原区间交替作为源与目的，暂存区向 allocator 申请
+ *  - 元素较少时直接按变换后的键做 stable_sort
+ */
+#ifndef SIMPLESTL_STL_RADIX_SORT_H
+#define SIMPLESTL_STL_RADIX_SORT_H
+
+#include <cstring>
+#include <cstdint>
+
+#include "stl_sort.h"
+#include "../iterator.h"
+#include "../utility.h"
+#include "../type_traits.h"
+#include "../__functional/stl_function.h"
+#include "../__memory/stl_allocator.h"
+#include "../__memory/stl_construct.h"
+#include "../__memory/stl_uninitialized.h"
+
+namespace simple_stl{
+
+    // 元素个数低于此值时改用 stable_sort
+    const ptrdiff_t __radix_sort_threshold = 256;
+
+    // 默认的键：算术类型取元素本身，pair 取 first
+    template<class T>
+    struct __radix_default_key : identity<T> {};
+
+    template<class T1, class T2>
+    struct __radix_default_key<pair<T1, T2> > : select1st<pair<T1, T2> > {};
+
+    template<size_t Size> struct __radix_unsigned;
+    template<> struct __radix_unsigned<1> { typedef uint8_t  type; };
+    template<> struct __radix_unsigned<2> { typedef uint16_t type; };
+    template<> struct __radix_unsigned<4> { typedef uint32_t type; };
+    template<> struct __radix_unsigned<8> { typedef uint64_t type; };
+
+    // 把键变换为次序相同的无符号整数
+    template<class Key, bool = std::is_floating_point<Key>::value, bool = std::is_signed<Key>::value>
+    struct __radix_key_traits;
+
+    template<class Key>
+    struct __radix_key_traits<Key, false, false>{
+        typedef typename __radix_unsigned<sizeof(Key)>::type unsigned_type;
+
+        static unsigned_type encode(Key k) { return static_cast<unsigned_type>(k); }
+    };
+
+    template<class Key>
+    struct __radix_key_traits<Key, false, true>{
+        typedef typename __radix_unsigned<sizeof(Key)>::type unsigned_type;
+
+        static unsigned_type encode(Key k){
+            return static_cast<unsigned_type>(k) ^ (unsigned_type(1) << (sizeof(Key) * 8 - 1));
+        }
+    };
+
+    template<class Key>
+    struct __radix_key_traits<Key, true, true>{
+        typedef typename __radix_unsigned<sizeof(Key)>::type unsigned_type;
+
+        static unsigned_type encode(Key k){
+            unsigned_type u;
+            std::memcpy(&u, &k, sizeof(Key));
+            const unsigned_type sign = unsigned_type(1) << (sizeof(Key) * 8 - 1);
+            return (u & sign) ? ~u : (u | sign);
+        }
+    };
+
+    // 按变换后的键比较，小区间的 stable_sort 与基数排序的次序一致
+    template<class KeyOf>
+    struct __radix_less{
+        KeyOf key;
+
+        template<class T>
+        bool operator()(const T& x, const T& y) const{
+            typedef typename std::decay<decltype(key(x))>::type key_type;
+            return __radix_key_traits<key_type>::encode(key(x)) < __radix_key_traits<key_type>::encode(key(y));
+        }
+    };
+
+    // 按第 shift 位起的字节把 [first, last) 分派到 result，offsets 为各取值的起始下标
+    template<class InputIterator, class OutputIterator, class KeyOf, class Traits>
+    void __radix_scatter(InputIterator first, InputIterator last, OutputIterator result,
+                         size_t* offsets, unsigned shift, KeyOf& key, Traits){
+        for ( ; first != last; ++first){
+            const size_t byte = static_cast<size_t>((Traits::encode(key(*first)) >> shift) & 0xff);
+            *(result + offsets[byte]++) = simple_stl::move(*first);
+        }
+    }
+
+    // 平凡可拷贝的元素可以直接赋值到未初始化的暂存区，返回 false 表示元素仍在原区间；
+    // 否则先把元素移入暂存区，此后各趟都是对已构造对象的赋值
+    template<class RandomAccessIterator, class T>
+    inline bool __radix_prepare_buffer(RandomAccessIterator, RandomAccessIterator, T*, __true_type_s){
+        return false;
+    }
+
+    template<class RandomAccessIterator, class T>
+    inline bool __radix_prepare_buffer(RandomAccessIterator first, RandomAccessIterator last, T* buf, __false_type_s){
+        simple_stl::uninitialized_move(first, last, buf);
+        return true;
+    }
+
+    template<class RandomAccessIterator, class KeyOf>
+    void __radix_sort(RandomAccessIterator first, RandomAccessIterator last, KeyOf& key, random_access_iterator_tag){
+        typedef typename iterator_traits<RandomAccessIterator>::value_type      T;
+        typedef typename std::decay<decltype(key(*first))>::type                key_type;
+        typedef __radix_key_traits<key_type>                                    traits;
+        typedef typename traits::unsigned_type                                  unsigned_type;
+        static_assert(std::is_arithmetic<key_type>::value, "radix_sort requires an integral or floating-point key");
+        const size_t bytes = sizeof(unsigned_type);
+
+        const ptrdiff_t len = last - first;
+        if (len < __radix_sort_threshold){
+            simple_stl::stable_sort(first, last, __radix_less<KeyOf>{key});
+            return;
+        }
+
+        // 一趟统计全部字节的直方图
+        size_t counts[bytes][256];
+        std::memset(counts, 0, sizeof(counts));
+        for (RandomAccessIterator it = first; it != last; ++it){
+            const unsigned_type u = traits::encode(key(*it));
+            for (size_t b = 0; b < bytes; ++b)
+                ++counts[b][(u >> (b * 8)) & 0xff];
+        }
+
+        // 所有键在该字节上取值相同时跳过，其余转为前缀和
+        unsigned passes[bytes];
+        size_t num_passes = 0;
+        for (size_t b = 0; b < bytes; ++b){
+            const unsigned_type first_byte = (traits::encode(key(*first)) >> (b * 8)) & 0xff;
+            if (counts[b][first_byte] == static_cast<size_t>(len))
+                continue;
+            size_t sum = 0;
+            for (size_t i = 0; i < 256; ++i){
+                const size_t c = counts[b][i];
+                counts[b][i] = sum;
+                sum += c;
+            }
+            passes[num_passes++] = static_cast<unsigned>(b);
+        }
+        if (num_passes == 0)
+            return;
+
+        typedef bool_constant_s<std::is_trivially_copyable<T>::value> trivial;
+        allocator<T> a;
+        T* buf = a.allocate(static_cast<size_t>(len));
+        bool buf_constructed = false;
+        try{
+            buf_constructed = simple_stl::__radix_prepare_buffer(first, last, buf, trivial());
+            // 元素在原区间与暂存区之间来回分派
+            bool in_buf = buf_constructed;
+            for (size_t p = 0; p < num_passes; ++p){
+                const unsigned b = passes[p];
+                if (in_buf)
+                    simple_stl::__radix_scatter(buf, buf + len, first, counts[b], b * 8, key, traits());
+                else
+                    simple_stl::__radix_scatter(first, last, buf, counts[b], b * 8, key, traits());
+                in_buf = !in_buf;
+            }
+            if (in_buf){
+                RandomAccessIterator out = first;
+                for (T* p = buf; p != buf + len; ++p, ++out)
+                    *out = simple_stl::move(*p);
+            }
+        }
+        catch (...){
+            if (buf_constructed)
+                simple_stl::destroy(buf, buf + len);
+            a.deallocate(buf, static_cast<size_t>(len));
+            throw;
+        }
+        if (buf_constructed)
+            simple_stl::destroy(buf, buf + len);
+        a.deallocate(buf, static_cast<size_t>(len));
+    }
+
+    /** 按 key 取出的整数或浮点数键排序，稳定 */
+    template<class RandomAccessIterator, class KeyOf>
+    inline void radix_sort(RandomAccessIterator first, RandomAccessIterator last, KeyOf key){
+        simple_stl::__radix_sort(first, last, key, iterator_category(first));
+    }
+
+    template<class RandomAccessIterator>
+    inline void radix_sort(RandomAccessIterator first, RandomAccessIterator last){
+        simple_stl::radix_sort(first, last,
+                               __radix_default_key<typename iterator_traits<RandomAccessIterator>::value_type>());
+    }
+
+}   // simple_stl
+
+#endif //SIMPLESTL_STL_RADIX_SORT_H
@@ -0,0 +1,634 @@
+/**
+ * Created by 史进 on 2023/6/24.
+ *
+ * 连续标量区间上的 SIMD 内核：查找、反向查找、计数、首个不等位置，以及整数区间的最小、最大值；
+ * 单字节区间另有查找字符集合中任一字符（find_first_of）的内核
+ *  - 只处理元素为 1、2、4、8 字节算术类型（bool 除外）的连续迭代器，各算法先换成原生指针再调用内核，
+ *    其余情况走普通循环
+ *  - x86 上以 SSE2 为基线；GCC、Clang 下另按函数编译一份 AVX2 版本，首次调用时按 CPU 支持情况选用
+ *  - 比较结果统一取字节掩码：元素为 S 字节时每个元素占 S 位，最低置位的位置除以 S 即元素下标
+ *  - 浮点数用浮点比较指令，NaN 不等于自身、+0 等于 -0，与逐个 == 的结果一致；最值只对整数向量化
+ */
+#ifndef SIMPLESTL_STL_SIMD_H
+#define SIMPLESTL_STL_SIMD_H
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define SIMPLESTL_HAVE_SSE2 1
+#else
+#define SIMPLESTL_HAVE_SSE2 0
+#endif
+
+// 编译器支持按函数指定目标指令集时才编译 AVX2 版本
+#if SIMPLESTL_HAVE_SSE2 && (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define SIMPLESTL_HAVE_AVX2_DISPATCH 1
+#define SIMPLESTL_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define SIMPLESTL_HAVE_AVX2_DISPATCH 0
+#endif
+
+#include "../iterator.h"
+#include "../type_traits.h"
+
+namespace simple_stl{
+
+    // 可向量化的元素类型
+    template<class T>
+    struct __simd_scalar
+            : bool_constant_s<std::is_arithmetic<T>::value && !std::is_volatile<T>::value &&
+                              !std::is_same<T, bool>::value &&
+                              (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8)> {};
+
+    // 元素类型可向量化的连续迭代器；经 reference 判断以排除 volatile 元素
+    template<class Iterator,
+            bool = is_contiguous_iterator<Iterator>::value>
+    struct __simd_contiguous : __false_type_s {};
+
+    template<class Iterator>
+    struct __simd_contiguous<Iterator, true>
+            : __simd_scalar<typename std::remove_reference<typename iterator_traits<Iterator>::reference>::type> {};
+
+    // 在 Iterator 区间中按 == 查找 T 类型的值：整数元素配整数值，浮点元素只配同类型的值
+    template<class Iterator, class T,
+            bool = __simd_contiguous<Iterator>::value>
+    struct __simd_value_search : __false_type_s {};
+
+    template<class Iterator, class T>
+    struct __simd_value_search<Iterator, T, true>
+            : bool_constant_s<std::is_integral<typename iterator_traits<Iterator>::value_type>::value
+                              ? std::is_integral<T>::value && !std::is_same<T, bool>::value
+                              : std::is_same<typename iterator_traits<Iterator>::value_type, T>::value> {};
+
+    // 两个区间的元素类型相同且可向量化
+    template<class Iterator1, class Iterator2,
+            bool = __simd_contiguous<Iterator1>::value && __simd_contiguous<Iterator2>::value>
+    struct __simd_contiguous_pair : __false_type_s {};
+
+    template<class Iterator1, class Iterator2>
+    struct __simd_contiguous_pair<Iterator1, Iterator2, true>
+            : bool_constant_s<std::is_same<typename iterator_traits<Iterator1>::value_type,
+                                           typename iterator_traits<Iterator2>::value_type>::value> {};
+
+    // 元素为可向量化整数类型的连续迭代器，用于最值与字典序比较
+    template<class Iterator,
+            bool = __simd_contiguous<Iterator>::value>
+    struct __simd_integral_contiguous : __false_type_s {};
+
+    template<class Iterator>
+    struct __simd_integral_contiguous<Iterator, true>
+            : bool_constant_s<std::is_integral<typename iterator_traits<Iterator>::value_type>::value> {};
+
+    // 元素 u 与 value 的 == 在两者的公共类型上进行，value 换成元素类型再换回公共类型不变时，
+    // 才能改为在元素类型上比较；否则没有元素等于 value，交给普通循环即可
+    template<class V, class T>
+    inline bool __simd_value_fits(const T& value){
+        typedef decltype(V() + T()) Common;
+        return static_cast<Common>(static_cast<V>(value)) == static_cast<Common>(value);
+    }
+
+    // 最低位的 1 的位置，x 不为 0
+    inline unsigned __simd_ctz(uint32_t x) noexcept{
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<unsigned>(__builtin_ctz(x));
+#else
+        unsigned n = 0;
+        for ( ; (x & 1u) == 0; x >>= 1)
+            ++n;
+        return n;
+#endif
+    }
+
+    // 最高位的 1 的位置，x 不为 0
+    inline unsigned __simd_msb(uint32_t x) noexcept{
+#if defined(__GNUC__) || defined(__clang__)
+        return 31u - static_cast<unsigned>(__builtin_clz(x));
+#else
+        unsigned n = 0;
+        for ( ; x >>= 1; )
+            ++n;
+        return n;
+#endif
+    }
+
+    /** 标量版本，处理短区间与向量循环剩下的尾部 */
+    // equal 为 false 时查找第一个不等于 value 的元素
+    template<class T>
+    inline const T* __find_scalar(const T* first, const T* last, T value, bool equal){
+        for ( ; first != last; ++first)
+            if ((*first == value) == equal)
+                return first;
+        return last;
+    }
+
+    // 最后一个等于 value 的元素，没有时返回 none
+    template<class T>
+    inline const T* __rfind_scalar(const T* first, const T* last, T value, const T* none){
+        while (last != first)
+            if (*--last == value)
+                return last;
+        return none;
+    }
+
+    // 第一个属于（equal 为 true）或不属于字符集合 [set, set + set_n) 的元素
+    template<class T>
+    inline const T* __find_of_scalar(const T* first, const T* last, const T* set, size_t set_n, bool equal){
+        for ( ; first != last; ++first){
+            bool in = false;
+            for (size_t i = 0; i < set_n && !in; ++i)
+                in = *first == set[i];
+            if (in == equal)
+                return first;
+        }
+        return last;
+    }
+
+    // 集合较大时先建 256 项的表，每个元素查一次表；只用于单字节类型
+    template<class T>
+    inline const T* __find_of_table(const T* first, const T* last, const T* set, size_t set_n, bool equal){
+        bool table[256] = {};
+        for (size_t i = 0; i < set_n; ++i)
+            table[static_cast<unsigned char>(set[i])] = true;
+        for ( ; first != last; ++first)
+            if (table[static_cast<unsigned char>(*first)] == equal)
+                return first;
+        return last;
+    }
+
+    template<class T>
+    inline size_t __count_scalar(const T* first, const T* last, T value){
+        size_t n = 0;
+        for ( ; first != last; ++first)
+            if (*first == value)
+                ++n;
+        return n;
+    }
+
+    template<class T>
+    inline size_t __mismatch_scalar(const T* first1, const T* first2, size_t i, size_t n){
+        for ( ; i < n; ++i)
+            if (!(first1[i] == first2[i]))
+                return i;
+        return n;
+    }
+
+    template<class T>
+    inline T __extreme_scalar(const T* first, const T* last, T m, bool max){
+        for ( ; first != last; ++first)
+            if (max ? m < *first : *first < m)
+                m = *first;
+        return m;
+    }
+
+#if SIMPLESTL_HAVE_SSE2
+    /** SSE2 */
+    template<class T, size_t Size = sizeof(T), bool Float = std::is_floating_point<T>::value>
+    struct __sse2_lane;
+
+    template<class T>
+    struct __sse2_lane<T, 1, false>{
+        static __m128i set1(T v) { return _mm_set1_epi8(static_cast<char>(v)); }
+        static __m128i eq(__m128i a, __m128i b) { return _mm_cmpeq_epi8(a, b); }
+        static __m128i gt_signed(__m128i a, __m128i b) { return _mm_cmpgt_epi8(a, b); }
+    };
+
+    template<class T>
+    struct __sse2_lane<T, 2, false>{
+        static __m128i set1(T v) { return _mm_set1_epi16(static_cast<short>(v)); }
+        static __m128i eq(__m128i a, __m128i b) { return _mm_cmpeq_epi16(a, b); }
+        static __m128i gt_signed(__m128i a, __m128i b) { return _mm_cmpgt_epi16(a, b); }
+    };
+
+    template<class T>
+    struct __sse2_lane<T, 4, false>{
+        static __m128i set1(T v) { return _mm_set1_epi32(static_cast<int>(v)); }
+        static __m128i eq(__m128i a, __m128i b) { return _mm_cmpeq_epi32(a, b); }
+        static __m128i gt_signed(__m128i a, __m128i b) { return _mm_cmpgt_epi32(a, b); }
+    };
+
+    // SSE2 没有 64 位整数比较：两半 32 位都相等才相等；不提供大小比较
+    template<class T>
+    struct __sse2_lane<T, 8, false>{
+        static __m128i set1(T v) { return _mm_set1_epi64x(static_cast<long long>(v)); }
+        static __m128i eq(__m128i a, __m128i b){
+            const __m128i c = _mm_cmpeq_epi32(a, b);
+            return _mm_and_si128(c, _mm_shuffle_epi32(c, _MM_SHUFFLE(2, 3, 0, 1)));
+        }
+    };
+
+    template<class T>
+    struct __sse2_lane<T, 4, true>{
+        static __m128i set1(T v) { return _mm_castps_si128(_mm_set1_ps(static_cast<float>(v))); }
+        static __m128i eq(__m128i a, __m128i b){
+            return _mm_castps_si128(_mm_cmpeq_ps(_mm_castsi128_ps(a), _mm_castsi128_ps(b)));
+        }
+    };
+
+    template<class T>
+    struct __sse2_lane<T, 8, true>{
+        static __m128i set1(T v) { return _mm_castpd_si128(_mm_set1_pd(static_cast<double>(v))); }
+        static __m128i eq(__m128i a, __m128i b){
+            return _mm_castpd_si128(_mm_cmpeq_pd(_mm_castsi128_pd(a), _mm_castsi128_pd(b)));
+        }
+    };
+
+    template<class T>
+    inline __m128i __sse2_load(const T* p) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+
+    // 整数的 a > b；无符号数先翻转符号位再按有符号比较
+    template<class T>
+    inline __m128i __sse2_gt(__m128i a, __m128i b){
+        typedef __sse2_lane<T> lane;
+        if (!std::is_signed<T>::value){
+            const __m128i sign = lane::set1(static_cast<T>(static_cast<T>(1) << (sizeof(T) * 8 - 1)));
+            a = _mm_xor_si128(a, sign);
+            b = _mm_xor_si128(b, sign);
+        }
+        return lane::gt_signed(a, b);
+    }
+
+    template<class T>
+    const T* __find_sse2(const T* first, const T* last, T value, bool equal){
+        typedef __sse2_lane<T> lane;
+        const size_t step = 16 / sizeof(T);
+        const __m128i v = lane::set1(value);
+        const uint32_t flip = equal ? 0u : 0xFFFFu;
+        for ( ; static_cast<size_t>(last - first) >= step; first += step){
+            const uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(lane::eq(__sse2_load(first), v))) ^ flip;
+            if (mask != 0)
+                return first + __simd_ctz(mask) / sizeof(T);
+        }
+        return simple_stl::__find_scalar(first, last, value, equal);
+    }
+
+    // 从尾部往前逐个向量比较，取最高置位
+    template<class T>
+    const T* __rfind_sse2(const T* first, const T* last, T value){
+        typedef __sse2_lane<T> lane;
+        const size_t step = 16 / sizeof(T);
+        const __m128i v = lane::set1(value);
+        const T* const none = last;
+        for ( ; static_cast<size_t>(last - first) >= step; last -= step){
+            const uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(lane::eq(__sse2_load(last - step), v)));
+            if (mask != 0)
+                return last - step + __simd_msb(mask) / sizeof(T);
+        }
+        return simple_stl::__rfind_scalar(first, last, value, none);
+    }
+
+    // 集合中每个字符广播成一个向量，逐个比较后按位或；set_n 不超过 __simd_find_of_max
+    template<class T>
+    const T* __find_of_sse2(const T* first, const T* last, const T* set, size_t set_n, bool equal){
+        __m128i v[16];
+        for (size_t i = 0; i < set_n; ++i)
+            v[i] = _mm_set1_epi8(static_cast<char>(set[i]));
+        const uint32_t flip = equal ? 0u : 0xFFFFu;
+        for ( ; last - first >= 16; first += 16){
+            const __m128i x = __sse2_load(first);
+            __m128i hit = _mm_setzero_si128();
+            for (size_t i = 0; i < set_n; ++i)
+                hit = _mm_or_si128(hit, _mm_cmpeq_epi8(x, v[i]));
+            const uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(hit)) ^ flip;
+            if (mask != 0)
+                return first + __simd_ctz(mask);
+        }
+        return simple_stl::__find_of_scalar(first, last, set, set_n, equal);
+    }
+
+    // 相等时比较结果为 -1，逐字节相减即计数；字节计数器每 255 轮汇总一次
+    template<class T>
+    size_t __count_sse2(const T* first, const T* last, T value){
+        typedef __sse2_lane<T> lane;
+        const size_t step = 16 / sizeof(T);
+        const __m128i v = lane::set1(value);
+        const __m128i zero = _mm_setzero_si128();
+        size_t bytes = 0;
+        while (static_cast<size_t>(last - first) >= step){
+            size_t rounds = static_cast<size_t>(last - first) / step;
+            if (rounds > 255)
+                rounds = 255;
+            __m128i acc = zero;
+            for (size_t i = 0; i < rounds; ++i, first += step)
+                acc = _mm_sub_epi8(acc, lane::eq(__sse2_load(first), v));
+            const __m128i sum = _mm_sad_epu8(acc, zero);
+            bytes += static_cast<size_t>(_mm_cvtsi128_si32(sum)) +
+                     static_cast<size_t>(_mm_cvtsi128_si32(_mm_unpackhi_epi64(sum, sum)));
+        }
+        return bytes / sizeof(T) + simple_stl::__count_scalar(first, last, value);
+    }
+
+    template<class T>
+    size_t __mismatch_sse2(const T* first1, const T* first2, size_t n){
+        typedef __sse2_lane<T> lane;
+        const size_t step = 16 / sizeof(T);
+        size_t i = 0;
+        for ( ; n - i >= step; i += step){
+            const uint32_t mask = static_cast<uint32_t>(
+                    _mm_movemask_epi8(lane::eq(__sse2_load(first1 + i), __sse2_load(first2 + i)))) ^ 0xFFFFu;
+            if (mask != 0)
+                return i + __simd_ctz(mask) / sizeof(T);
+        }
+        return simple_stl::__mismatch_scalar(first1, first2, i, n);
+    }
+
+    // 区间长度不少于一个向量
+    template<class T>
+    T __extreme_sse2(const T* first, const T* last, bool max){
+        const size_t step = 16 / sizeof(T);
+        __m128i acc = __sse2_load(first);
+        for (first += step; static_cast<size_t>(last - first) >= step; first += step){
+            const __m128i x = __sse2_load(first);
+            const __m128i take = max ? __sse2_gt<T>(x, acc) : __sse2_gt<T>(acc, x);
+            acc = _mm_or_si128(_mm_and_si128(take, x), _mm_andnot_si128(take, acc));
+        }
+        T lanes[16 / sizeof(T)];
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), acc);
+        const T m = simple_stl::__extreme_scalar(lanes + 1, lanes + step, lanes[0], max);
+        return simple_stl::__extreme_scalar(first, last, m, max);
+    }
+#endif
+
+#if SIMPLESTL_HAVE_AVX2_DISPATCH
+    /** AVX2 */
+    template<class T, size_t Size = sizeof(T), bool Float = std::is_floating_point<T>::value>
+    struct __avx2_lane;
+
+    template<class T>
+    struct __avx2_lane<T, 1, false>{
+        SIMPLESTL_TARGET_AVX2 static __m256i set1(T v) { return _mm256_set1_epi8(static_cast<char>(v)); }
+        SIMPLESTL_TARGET_AVX2 static __m256i eq(__m256i a, __m256i b) { return _mm256_cmpeq_epi8(a, b); }
+        SIMPLESTL_TARGET_AVX2 static __m256i gt_signed(__m256i a, __m256i b) { return _mm256_cmpgt_epi8(a, b); }
+    };
+
+    template<class T>
+    struct __avx2_lane<T, 2, false>{
+        SIMPLESTL_TARGET_AVX2 static __m256i set1(T v) { return _mm256_set1_epi16(static_cast<short>(v)); }
+        SIMPLESTL_TARGET_AVX2 static __m256i eq(__m256i a, __m256i b) { return _mm256_cmpeq_epi16(a, b); }
+        SIMPLESTL_TARGET_AVX2 static __m256i gt_signed(__m256i a, __m256i b) { return _mm256_cmpgt_epi16(a, b); }
+    };
+
+    template<class T>
+    struct __avx2_lane<T, 4, false>{
+        SIMPLESTL_TARGET_AVX2 static __m256i set1(T v) { return _mm256_set1_epi32(static_cast<int>(v)); }
+        SIMPLESTL_TARGET_AVX2 static __m256i eq(__m256i a, __m256i b) { return _mm256_cmpeq_epi32(a, b); }
+        SIMPLESTL_TARGET_AVX2 static __m256i gt_signed(__m256i a, __m256i b) { return _mm256_cmpgt_epi32(a, b); }
+    };
+
+    template<class T>
+    struct __avx2_lane<T, 8, false>{
+        SIMPLESTL_TARGET_AVX2 static __m256i set1(T v) { return _mm256_set1_epi64x(static_cast<long long>(v)); }
+        SIMPLESTL_TARGET_AVX2 static __m256i eq(__m256i a, __m256i b) { return _mm256_cmpeq_epi64(a, b); }
+        SIMPLESTL_TARGET_AVX2 static __m256i gt_signed(__m256i a, __m256i b) { return _mm256_cmpgt_epi64(a, b); }
+    };
+
+    template<class T>
+    struct __avx2_lane<T, 4, true>{
+        SIMPLESTL_TARGET_AVX2 static __m256i set1(T v) { return _mm256_castps_si256(_mm256_set1_ps(static_cast<float>(v))); }
+        SIMPLESTL_TARGET_AVX2 static __m256i eq(__m256i a, __m256i b){
+            return _mm256_castps_si256(_mm256_cmp_ps(_mm256_castsi256_ps(a), _mm256_castsi256_ps(b), _CMP_EQ_OQ));
+        }
+    };
+
+    template<class T>
+    struct __avx2_lane<T, 8, true>{
+        SIMPLESTL_TARGET_AVX2 static __m256i set1(T v) { return _mm256_castpd_si256(_mm256_set1_pd(static_cast<double>(v))); }
+        SIMPLESTL_TARGET_AVX2 static __m256i eq(__m256i a, __m256i b){
+            return _mm256_castpd_si256(_mm256_cmp_pd(_mm256_castsi256_pd(a), _mm256_castsi256_pd(b), _CMP_EQ_OQ));
+        }
+    };
+
+    template<class T>
+    SIMPLESTL_TARGET_AVX2 inline __m256i __avx2_load(const T* p){
+        return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+    }
+
+    template<class T>
+    SIMPLESTL_TARGET_AVX2 inline __m256i __avx2_gt(__m256i a, __m256i b){
+        typedef __avx2_lane<T> lane;
+        if (!std::is_signed<T>::value){
+            const __m256i sign = lane::set1(static_cast<T>(static_cast<T>(1) << (sizeof(T) * 8 - 1)));
+            a = _mm256_xor_si256(a, sign);
+            b = _mm256_xor_si256(b, sign);
+        }
+        return lane::gt_signed(a, b);
+    }
+
+    template<class T>
+    SIMPLESTL_TARGET_AVX2 const T* __find_avx2(const T* first, const T* last, T value, bool equal){
+        typedef __avx2_lane<T> lane;
+        const size_t step = 32 / sizeof(T);
+        const __m256i v = lane::set1(value);
+        const uint32_t flip = equal ? 0u : 0xFFFFFFFFu;
+        for ( ; static_cast<size_t>(last - first) >= step; first += step){
+            const uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(lane::eq(__avx2_load(first), v))) ^ flip;
+            if (mask != 0)
+                return first + __simd_ctz(mask) / sizeof(T);
+        }
+        return simple_stl::__find_scalar(first, last, value, equal);
+    }
+
+    template<class T>
+    SIMPLESTL_TARGET_AVX2 const T* __rfind_avx2(const T* first, const T* last, T value){
+        typedef __avx2_lane<T> lane;
+        const size_t step = 32 / sizeof(T);
+        const __m256i v = lane::set1(value);
+        const T* const none = last;
+        for ( ; static_cast<size_t>(last - first) >= step; last -= step){
+            const uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(lane::eq(__avx2_load(last - step), v)));
+            if (mask != 0)
+                return last - step + __simd_msb(mask) / sizeof(T);
+        }
+        return simple_stl::__rfind_scalar(first, last, value, none);
+    }
+
+    template<class T>
+    SIMPLESTL_TARGET_AVX2 const T* __find_of_avx2(const T* first, const T* last, const T* set, size_t set_n,
+                                                  bool equal){
+        __m256i v[16];
+        for (size_t i = 0; i < set_n; ++i)
+            v[i] = _mm256_set1_epi8(static_cast<char>(set[i]));
+        const uint32_t flip = equal ? 0u : 0xFFFFFFFFu;
+        for ( ; last - first >= 32; first += 32){
+            const __m256i x = __avx2_load(first);
+            __m256i hit = _mm256_setzero_si256();
+            for (size_t i = 0; i < set_n; ++i)
+                hit = _mm256_or_si256(hit, _mm256_cmpeq_epi8(x, v[i]));
+            const uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(hit)) ^ flip;
+            if (mask != 0)
+                return first + __simd_ctz(mask);
+        }
+        return simple_stl::__find_of_scalar(first, last, set, set_n, equal);
+    }
+
+    template<class T>
+    SIMPLESTL_TARGET_AVX2 size_t __count_avx2(const T* first, const T* last, T value){
+        typedef __avx2_lane<T> lane;
+        const size_t step = 32 / sizeof(T);
+        const __m256i v = lane::set1(value);
+        const __m256i zero = _mm256_setzero_si256();
+        size_t bytes = 0;
+        while (static_cast<size_t>(last - first) >= step){
+            size_t rounds = static_cast<size_t>(last - first) / step;
+            if (rounds > 255)
+                rounds = 255;
+            __m256i acc = zero;
+            for (size_t i = 0; i < rounds; ++i, first += step)
+                acc = _mm256_sub_epi8(acc, lane::eq(__avx2_load(first), v));
+            const __m256i sad = _mm256_sad_epu8(acc, zero);
+            const __m128i sum = _mm_add_epi64(_mm256_castsi256_si128(sad), _mm256_extracti128_si256(sad, 1));
+            bytes += static_cast<size_t>(_mm_cvtsi128_si32(sum)) +
+                     static_cast<size_t>(_mm_cvtsi128_si32(_mm_unpackhi_epi64(sum, sum)));
+        }
+        return bytes / sizeof(T) + simple_stl::__count_scalar(first, last, value);
+    }
+
+    template<class T>
+    SIMPLESTL_TARGET_AVX2 size_t __mismatch_avx2(const T* first1, const T* first2, size_t n){
+        typedef __avx2_lane<T> lane;
+        const size_t step = 32 / sizeof(T);
+        size_t i = 0;
+        for ( ; n - i >= step; i += step){
+            const uint32_t mask = static_cast<uint32_t>(
+                    _mm256_movemask_epi8(lane::eq(__avx2_load(first1 + i), __avx2_load(first2 + i)))) ^ 0xFFFFFFFFu;
+            if (mask != 0)
+                return i + __simd_ctz(mask) / sizeof(T);
+        }
+        return simple_stl::__mismatch_scalar(first1, first2, i, n);
+    }
+
+    template<class T>
+    SIMPLESTL_TARGET_AVX2 T __extreme_avx2(const T* first, const T* last, bool max){
+        const size_t step = 32 / sizeof(T);
+        __m256i acc = __avx2_load(first);
+        for (first += step; static_cast<size_t>(last - first) >= step; first += step){
+            const __m256i x = __avx2_load(first);
+            const __m256i take = max ? __avx2_gt<T>(x, acc) : __avx2_gt<T>(acc, x);
+            acc = _mm256_blendv_epi8(acc, x, take);
+        }
+        T lanes[32 / sizeof(T)];
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes), acc);
+        const T m = simple_stl::__extreme_scalar(lanes + 1, lanes + step, lanes[0], max);
+        return simple_stl::__extreme_scalar(first, last, m, max);
+    }
+#endif
+
+    // 首次调用时检测一次 CPU 是否支持 AVX2
+    inline bool __simd_use_avx2(){
+#if defined(__AVX2__)
+        return true;
+#elif SIMPLESTL_HAVE_AVX2_DISPATCH
+        static const bool avx2 = (__builtin_cpu_init(), __builtin_cpu_supports("avx2") != 0);
+        return avx2;
+#else
+        return false;
+#endif
+    }
+
+    /** 对外的内核入口：短于一个 SSE2 向量的区间直接逐个处理 */
+    template<class T>
+    inline const T* __simd_find(const T* first, const T* last, T value, bool equal){
+#if SIMPLESTL_HAVE_AVX2_DISPATCH
+        if (static_cast<size_t>(last - first) >= 32 / sizeof(T) && simple_stl::__simd_use_avx2())
+            return simple_stl::__find_avx2(first, last, value, equal);
+#endif
+#if SIMPLESTL_HAVE_SSE2
+        if (static_cast<size_t>(last - first) >= 16 / sizeof(T))
+            return simple_stl::__find_sse2(first, last, value, equal);
+#endif
+        return simple_stl::__find_scalar(first, last, value, equal);
+    }
+
+    // 最后一个等于 value 的元素，没有时返回 last
+    template<class T>
+    inline const T* __simd_rfind(const T* first, const T* last, T value){
+#if SIMPLESTL_HAVE_AVX2_DISPATCH
+        if (static_cast<size_t>(last - first) >= 32 / sizeof(T) && simple_stl::__simd_use_avx2())
+            return simple_stl::__rfind_avx2(first, last, value);
+#endif
+#if SIMPLESTL_HAVE_SSE2
+        if (static_cast<size_t>(last - first) >= 16 / sizeof(T))
+            return simple_stl::__rfind_sse2(first, last, value);
+#endif
+        return simple_stl::__rfind_scalar(first, last, value, last);
+    }
+
+    // 向量版本每个集合字符要多一次比较，集合更大时改为查表
+    static const size_t __simd_find_of_max = 16;
+
+    // 单字节区间中第一个属于（equal 为 true）或不属于字符集合 [set, set + set_n) 的元素，没有时返回 last
+    template<class T>
+    inline const T* __simd_find_of(const T* first, const T* last, const T* set, size_t set_n, bool equal){
+        static_assert(sizeof(T) == 1, "__simd_find_of only handles single-byte elements");
+        if (set_n > __simd_find_of_max)
+            return simple_stl::__find_of_table(first, last, set, set_n, equal);
+#if SIMPLESTL_HAVE_AVX2_DISPATCH
+        if (last - first >= 32 && simple_stl::__simd_use_avx2())
+            return simple_stl::__find_of_avx2(first, last, set, set_n, equal);
+#endif
+#if SIMPLESTL_HAVE_SSE2
+        if (last - first >= 16)
+            return simple_stl::__find_of_sse2(first, last, set, set_n, equal);
+#endif
+        return simple_stl::__find_of_scalar(first, last, set, set_n, equal);
+    }
+
+    template<class T>
+    inline size_t __simd_count(const T* first, const T* last, T value){
+#if SIMPLESTL_HAVE_AVX2_DISPATCH
+        if (static_cast<size_t>(last - first) >= 32 / sizeof(T) && simple_stl::__simd_use_avx2())
+            return simple_stl::__count_avx2(first, last, value);
+#endif
+#if SIMPLESTL_HAVE_SSE2
+        if (static_cast<size_t>(last - first) >= 16 / sizeof(T))
+            return simple_stl::__count_sse2(first, last, value);
+#endif
+        return simple_stl::__count_scalar(first, last, value);
+    }
+
+    // 返回第一个不等位置的下标，全部相等时返回 n
+    template<class T>
+    inline size_t __simd_mismatch(const T* first1, const T* first2, size_t n){
+#if SIMPLESTL_HAVE_AVX2_DISPATCH
+        if (n >= 32 / sizeof(T) && simple_stl::__simd_use_avx2())
+            return simple_stl::__mismatch_avx2(first1, first2, n);
+#endif
+#if SIMPLESTL_HAVE_SSE2
+        if (n >= 16 / sizeof(T))
+            return simple_stl::__mismatch_sse2(first1, first2, n);
+#endif
+        return simple_stl::__mismatch_scalar(first1, first2, 0, n);
+    }
+
+#if SIMPLESTL_HAVE_SSE2
+    template<class T>
+    inline T __simd_extreme_sse2(const T* first, const T* last, bool max, __true_type_s){
+        return simple_stl::__extreme_sse2(first, last, max);
+    }
+#endif
+
+    template<class T, class Tag>
+    inline T __simd_extreme_sse2(const T* first, const T* last, bool max, Tag){
+        return simple_stl::__extreme_scalar(first + 1, last, *first, max);
+    }
+
+    // 整数区间的最小值（max 为 false）或最大值，区间非空
+    template<class T>
+    inline T __simd_extreme(const T* first, const T* last, bool max){
+#if SIMPLESTL_HAVE_AVX2_DISPATCH
+        if (static_cast<size_t>(last - first) >= 32 / sizeof(T) && simple_stl::__simd_use_avx2())
+            return simple_stl::__extreme_avx2(first, last, max);
+#endif
+        // SSE2 没有 64 位整数比较
+        if (static_cast<size_t>(last - first) >= 16 / sizeof(T))
+            return simple_stl::__simd_extreme_sse2(first, last, max,
+                                                   bool_constant_s<SIMPLESTL_HAVE_SSE2 && sizeof(T) <= 4>());
+        return simple_stl::__extreme_scalar(first + 1, last, *first, max);
+    }
+
+}   // simple_stl
+
+#endif //SIMPLESTL_STL_SIMD_H
@@ -0,0 +1,650 @@
+/**
+ * Created by 史进 on 2023/6/21.
+ *
+ * 排序算法：sort、stable_sort、partial_sort、nth_element、is_sorted、is_sorted_until
+ *  - 排序类算法按 iterator_category 分派，只提供随机访问迭代器的版本
+ *  - sort 为 pattern-defeating quicksort：
+ *      1. 小区间直接插入排序；
+ *      2. 三数取中，区间较大时取九数中位数（ninther）作枢轴；
+ *      3. 算术类型配 less/greater 时用分块的无分支划分，比较结果写进偏移缓冲区再成批交换，消除难以预测的跳转；
+ *      4. 划分严重失衡时打乱若干元素以破坏恶意模式，失衡次数超过 log2(n) 次则改用堆排序，最坏 O(nlogn)；
+ *      5. 划分时未发生交换说明区间可能已经有序，尝试有限次数的插入排序，成功则直接返回，有序、逆序输入为 O(n)；
+ *      6. 与左侧枢轴相等的区间整体划到左侧后跳过，大量重复元素时趋于 O(n)
+ *  - 插入排序遇到比首元素还小的元素时整段后移，原生指针配平凡可拷贝类型用 memmove 成段搬移，
+ *    其余情况首元素充当哨兵，内层循环省去边界判断
+ *  - stable_sort 为归并排序，暂存区向 allocator 申请，只需一半长度
+ */
+#ifndef SIMPLESTL_STL_SORT_H
+#define SIMPLESTL_STL_SORT_H
+
+#include <cstring>
+
+#include "stl_heap.h"
+#include "../iterator.h"
+#include "../utility.h"
+#include "../type_traits.h"
+#include "../__functional/stl_function.h"
+#include "../__memory/stl_allocator.h"
+#include "../__memory/stl_construct.h"
+#include "../__memory/stl_uninitialized.h"
+
+namespace simple_stl{
+
+    // 元素个数低于此值时改用插入排序
+    const ptrdiff_t __sort_insertion_threshold = 24;
+    // 元素个数高于此值时取九数中位数作枢轴
+    const ptrdiff_t __sort_ninther_threshold = 128;
+    // 尝试插入排序时允许挪动的元素总数，超过即放弃
+    const ptrdiff_t __sort_partial_insertion_limit = 8;
+    // 无分支划分每块处理的元素个数，偏移量存在 unsigned char 中，不能超过 256
+    const ptrdiff_t __sort_block_size = 64;
+    // 元素个数不低于此值时才用无分支划分，小区间上分块的固定开销抵不过分支预测失败的代价
+    const ptrdiff_t __sort_branchless_threshold = 256;
+    // stable_sort 的归并从此长度的有序段开始
+    const ptrdiff_t __stable_sort_chunk = 32;
+
+    // 连续迭代器指向平凡可拷贝的类型时，成段挪动元素可以用 memmove
+    template<class RandomAccessIterator>
+    struct __sort_use_memmove
+            : bool_constant_s<is_contiguous_iterator<RandomAccessIterator>::value &&
+                              std::is_trivially_copyable<
+                                      typename iterator_traits<RandomAccessIterator>::value_type>::value> {};
+
+    // 比较廉价且没有副作用时才用无分支划分，否则多出的比较得不偿失
+    template<class T, class Compare>
+    struct __sort_use_branchless
+            : bool_constant_s<std::is_arithmetic<T>::value &&
+                              (std::is_same<Compare, less<T> >::value ||
+                               std::is_same<Compare, greater<T> >::value)> {};
+
+    template<class Size>
+    inline int __sort_log2(Size n){
+        int k = 0;
+        while (n >>= 1)
+            ++k;
+        return k;
+    }
+
+    template<class RandomAccessIterator, class Compare>
+    inline void __sort2(RandomAccessIterator a, RandomAccessIterator b, Compare& comp){
+        if (comp(*b, *a))
+            simple_stl::swap(*a, *b);
+    }
+
+    // 三者排好序后，中位数位于 b
+    template<class RandomAccessIterator, class Compare>
+    inline void __sort3(RandomAccessIterator a, RandomAccessIterator b, RandomAccessIterator c, Compare& comp){
+        simple_stl::__sort2(a, b, comp);
+        simple_stl::__sort2(b, c, comp);
+        simple_stl::__sort2(a, b, comp);
+    }
+
+
+    /** 插入排序 */
+    // [first, last) 整段后移一格；原生指针配平凡可拷贝类型时长度已知，用 memmove 成段搬移
+    template<class RandomAccessIterator>
+    inline void __sort_shift_right(RandomAccessIterator first, RandomAccessIterator last, __false_type_s){
+        while (last != first){
+            *last = simple_stl::move(*(last - 1));
+            --last;
+        }
+    }
+
+    template<class RandomAccessIterator>
+    inline void __sort_shift_right(RandomAccessIterator first, RandomAccessIterator last, __true_type_s){
+        typedef typename iterator_traits<RandomAccessIterator>::value_type T;
+        T* p = simple_stl::to_address(first);
+        std::memmove(p + 1, p, (last - first) * sizeof(T));
+    }
+
+    // 把 *i 插入其左侧的有序段，要求左侧存在不大于 *i 的元素，内层循环省去边界判断，返回其最终位置
+    template<class RandomAccessIterator, class Compare>
+    inline RandomAccessIterator __sort_unguarded_insert(RandomAccessIterator i, Compare& comp){
+        typename iterator_traits<RandomAccessIterator>::value_type tmp = simple_stl::move(*i);
+        RandomAccessIterator k = i;
+        --k;
+        while (comp(tmp, *k)){
+            *i = simple_stl::move(*k);
+            i = k;
+            --k;
+        }
+        *i = simple_stl::move(tmp);
+        return i;
+    }
+
+    // 把 *i 插入有序区间 [first, i)，返回其最终位置
+    // 比 *first 还小时整段后移，否则 *first 即为哨兵，走无边界判断的插入
+    template<class RandomAccessIterator, class Compare>
+    inline RandomAccessIterator __sort_guarded_insert(RandomAccessIterator first, RandomAccessIterator i, Compare& comp){
+        if (comp(*i, *first)){
+            typename iterator_traits<RandomAccessIterator>::value_type tmp = simple_stl::move(*i);
+            simple_stl::__sort_shift_right(first, i, __sort_use_memmove<RandomAccessIterator>());
+            *first = simple_stl::move(tmp);
+            return first;
+        }
+        return comp(*i, *(i - 1)) ? simple_stl::__sort_unguarded_insert(i, comp) : i;
+    }
+
+    template<class RandomAccessIterator, class Compare>
+    void __insertion_sort(RandomAccessIterator first, RandomAccessIterator last, Compare& comp){
+        if (first == last)
+            return;
+        for (RandomAccessIterator i = first + 1; i != last; ++i)
+            simple_stl::__sort_guarded_insert(first, i, comp);
+    }
+
+    // 要求 *(first - 1) 不大于区间内任何元素
+    template<class RandomAccessIterator, class Compare>
+    void __unguarded_insertion_sort(RandomAccessIterator first, RandomAccessIterator last, Compare& comp){
+        if (first == last)
+            return;
+        for (RandomAccessIterator i = first + 1; i != last; ++i)
+            if (comp(*i, *(i - 1)))
+                simple_stl::__sort_unguarded_insert(i, comp);
+    }
+
+    // 挪动的元素总数超过 __sort_partial_insertion_limit 时放弃并返回 false，区间此时部分有序
+    template<class RandomAccessIterator, class Compare>
+    bool __partial_insertion_sort(RandomAccessIterator first, RandomAccessIterator last, Compare& comp){
+        if (first == last)
+            return true;
+        ptrdiff_t moved = 0;
+        for (RandomAccessIterator i = first + 1; i != last; ++i){
+            moved += i - simple_stl::__sort_guarded_insert(first, i, comp);
+            if (moved > __sort_partial_insertion_limit)
+                return false;
+        }
+        return true;
+    }
+
+
+    /** 划分 */
+    // 以 *first 为枢轴，小于枢轴者在左，其余在右，返回枢轴的最终位置，以及划分前区间是否已经划分好
+    // 要求枢轴由三数取中选出，右侧必有不小于枢轴的元素，左扫描因此无需边界判断
+    template<class RandomAccessIterator, class Compare>
+    pair<RandomAccessIterator, bool>
+    __partition_right(RandomAccessIterator begin, RandomAccessIterator end, Compare& comp, __false_type_s){
+        typedef typename iterator_traits<RandomAccessIterator>::value_type T;
+        T pivot(simple_stl::move(*begin));
+        RandomAccessIterator first = begin;
+        RandomAccessIterator last = end;
+
+        while (comp(*++first, pivot));
+        // 左侧没有越过任何元素时，右扫描可能一路退回 first，需判断边界
+        if (first - 1 == begin)
+            while (first < last && !comp(*--last, pivot));
+        else
+            while (!comp(*--last, pivot));
+
+        const bool already_partitioned = first >= last;
+        while (first < last){
+            simple_stl::swap(*first, *last);
+            while (comp(*++first, pivot));
+            while (!comp(*--last, pivot));
+        }
+
+        RandomAccessIterator pivot_pos = first - 1;
+        *begin = simple_stl::move(*pivot_pos);
+        *pivot_pos = simple_stl::move(pivot);
+        return pair<RandomAccessIterator, bool>(pivot_pos, already_partitioned);
+    }
+
+    // 成对交换 first + offsets_l[i] 与 last - offsets_r[i]；两侧个数不等时改为一条轮换链，每个元素只搬一次
+    template<class RandomAccessIterator>
+    inline void __swap_offsets(RandomAccessIterator first, RandomAccessIterator last,
+                               const unsigned char* offsets_l, const unsigned char* offsets_r,
+                               ptrdiff_t num, bool use_swaps){
+        typedef typename iterator_traits<RandomAccessIterator>::value_type T;
+        if (use_swaps){
+            for (ptrdiff_t i = 0; i < num; ++i)
+                simple_stl::swap(*(first + offsets_l[i]), *(last - offsets_r[i]));
+        }
+        else if (num > 0){
+            RandomAccessIterator l = first + offsets_l[0];
+            RandomAccessIterator r = last - offsets_r[0];
+            T tmp(simple_stl::move(*l));
+            *l = simple_stl::move(*r);
+            for (ptrdiff_t i = 1; i < num; ++i){
+                l = first + offsets_l[i];
+                *r = simple_stl::move(*l);
+                r = last - offsets_r[i];
+                *l = simple_stl::move(*r);
+            }
+            *r = simple_stl::move(tmp);
+        }
+    }
+
+    // 无分支划分（BlockQuicksort）：两侧各取一块，把放错边的元素的偏移写进缓冲区，
+    // 写入无条件进行，只有计数随比较结果增加，再把两侧的错位元素成批交换
+    template<class RandomAccessIterator, class Compare>
+    pair<RandomAccessIterator, bool>
+    __partition_right(RandomAccessIterator begin, RandomAccessIterator end, Compare& comp, __true_type_s){
+        typedef typename iterator_traits<RandomAccessIterator>::value_type T;
+        T pivot(simple_stl::move(*begin));
+        RandomAccessIterator first = begin;
+        RandomAccessIterator last = end;
+
+        while (comp(*++first, pivot));
+        if (first - 1 == begin)
+            while (first < last && !comp(*--last, pivot));
+        else
+            while (!comp(*--last, pivot));
+
+        const bool already_partitioned = first >= last;
+        if (!already_partitioned){
+            simple_stl::swap(*first, *last);
+            ++first;
+
+            alignas(64) unsigned char offsets_l[__sort_block_size];
+            alignas(64) unsigned char offsets_r[__sort_block_size];
+            RandomAccessIterator offsets_l_base = first;
+            RandomAccessIterator offsets_r_base = last;
+            ptrdiff_t num_l = 0, num_r = 0, start_l = 0, start_r = 0;
+
+            while (first < last){
+                // 剩余不足两块时，按两侧缓冲区的空缺分配剩余元素
+                const ptrdiff_t num_unknown = last - first;
+                const ptrdiff_t left_split = num_l == 0 ? (num_r == 0 ? num_unknown / 2 : num_unknown) : 0;
+                const ptrdiff_t right_split = num_r == 0 ? (num_unknown - left_split) : 0;
+
+                if (left_split >= __sort_block_size){
+                    for (ptrdiff_t i = 0; i < __sort_block_size; ++i){
+                        offsets_l[num_l] = static_cast<unsigned char>(i);
+                        num_l += !comp(*first, pivot);
+                        ++first;
+                    }
+                }
+                else{
+                    for (ptrdiff_t i = 0; i < left_split; ++i){
+                        offsets_l[num_l] = static_cast<unsigned char>(i);
+                        num_l += !comp(*first, pivot);
+                        ++first;
+                    }
+                }
+
+                if (right_split >= __sort_block_size){
+                    for (ptrdiff_t i = 0; i < __sort_block_size; ){
+                        offsets_r[num_r] = static_cast<unsigned char>(++i);
+                        num_r += comp(*--last, pivot);
+                    }
+                }
+                else{
+                    for (ptrdiff_t i = 0; i < right_split; ){
+                        offsets_r[num_r] = static_cast<unsigned char>(++i);
+                        num_r += comp(*--last, pivot);
+                    }
+                }
+
+                const ptrdiff_t num = num_l < num_r ? num_l : num_r;
+                simple_stl::__swap_offsets(offsets_l_base, offsets_r_base,
+                                           offsets_l + start_l, offsets_r + start_r, num, num_l == num_r);
+                num_l -= num;
+                num_r -= num;
+                start_l += num;
+                start_r += num;
+                if (num_l == 0){
+                    start_l = 0;
+                    offsets_l_base = first;
+                }
+                if (num_r == 0){
+                    start_r = 0;
+                    offsets_r_base = last;
+                }
+            }
+
+            // 一侧缓冲区还有剩余，逐个换到分界处
+            if (num_l){
+                const unsigned char* offsets = offsets_l + start_l;
+                while (num_l--)
+                    simple_stl::swap(*(offsets_l_base + offsets[num_l]), *--last);
+                first = last;
+            }
+            if (num_r){
+                const unsigned char* offsets = offsets_r + start_r;
+                while (num_r--){
+                    simple_stl::swap(*(offsets_r_base - offsets[num_r]), *first);
+                    ++first;
+                }
+                last = first;
+            }
+        }
+
+        RandomAccessIterator pivot_pos = first - 1;
+        *begin = simple_stl::move(*pivot_pos);
+        *pivot_pos = simple_stl::move(pivot);
+        return pair<RandomAccessIterator, bool>(pivot_pos, already_partitioned);
+    }
+
+    // 按区间大小选择划分方式，Branchless 为 __false_type_s 时总是用逐个交换的划分
+    template<class RandomAccessIterator, class Compare>
+    inline pair<RandomAccessIterator, bool>
+    __sort_partition(RandomAccessIterator begin, RandomAccessIterator end, Compare& comp, __true_type_s){
+        if (end - begin >= __sort_branchless_threshold)
+            return simple_stl::__partition_right(begin, end, comp, __true_type_s());
+        return simple_stl::__partition_right(begin, end, comp, __false_type_s());
+    }
+
+    template<class RandomAccessIterator, class Compare>
+    inline pair<RandomAccessIterator, bool>
+    __sort_partition(RandomAccessIterator begin, RandomAccessIterator end, Compare& comp, __false_type_s){
+        return simple_stl::__partition_right(begin, end, comp, __false_type_s());
+    }
+
+    // 与 __partition_right 相反，等于枢轴者归入左侧，返回枢轴的最终位置
+    // 用于枢轴与左侧相邻区间的枢轴相等时，把重复元素一次划走
+    template<class RandomAccessIterator, class Compare>
+    RandomAccessIterator __partition_left(RandomAccessIterator begin, RandomAccessIterator end, Compare& comp){
+        typedef typename iterator_traits<RandomAccessIterator>::value_type T;
+        T pivot(simple_stl::move(*begin));
+        RandomAccessIterator first = begin;
+        RandomAccessIterator last = end;
+
+        while (comp(pivot, *--last));
+        if (last + 1 == end)
+            while (first < last && !comp(pivot, *++first));
+        else
+            while (!comp(pivot, *++first));
+
+        while (first < last){
+            simple_stl::swap(*first, *last);
+            while (comp(pivot, *--last));
+            while (!comp(pivot, *++first));
+        }
+
+        RandomAccessIterator pivot_pos = last;
+        *begin = simple_stl::move(*pivot_pos);
+        *pivot_pos = simple_stl::move(pivot);
+        return pivot_pos;
+    }
+
+    // 选出枢轴并换到 *begin
+    template<class RandomAccessIterator, class Compare>
+    inline void __sort_choose_pivot(RandomAccessIterator begin, RandomAccessIterator end, Compare& comp){
+        const ptrdiff_t size = end - begin;
+        const ptrdiff_t s2 = size / 2;
+        if (size > __sort_ninther_threshold){
+            simple_stl::__sort3(begin, begin + s2, end - 1, comp);
+            simple_stl::__sort3(begin + 1, begin + (s2 - 1), end - 2, comp);
+            simple_stl::__sort3(begin + 2, begin + (s2 + 1), end - 3, comp);
+            simple_stl::__sort3(begin + (s2 - 1), begin + s2, begin + (s2 + 1), comp);
+            simple_stl::swap(*begin, *(begin + s2));
+        }
+        else{
+            simple_stl::__sort3(begin + s2, begin, end - 1, comp);
+        }
+    }
+
+
+    /** pdqsort 主循环 */
+    // leftmost 为 false 时 *(begin - 1) 是左侧区间的枢轴，不大于本区间任何元素
+    // 对较小的一侧递归，较大的一侧循环处理
+    template<class RandomAccessIterator, class Compare, class Branchless>
+    void __pdqsort_loop(RandomAccessIterator begin, RandomAccessIterator end, Compare& comp,
+                        int bad_allowed, bool leftmost, Branchless branchless){
+        while (true){
+            const ptrdiff_t size = end - begin;
+            if (size < __sort_insertion_threshold){
+                if (leftmost)
+                    simple_stl::__insertion_sort(begin, end, comp);
+                else
+                    simple_stl::__unguarded_insertion_sort(begin, end, comp);
+                return;
+            }
+
+            simple_stl::__sort_choose_pivot(begin, end, comp);
+
+            // 枢轴等于左侧枢轴，本区间不会有更小的元素，把等于枢轴者全部划走
+            if (!leftmost && !comp(*(begin - 1), *begin)){
+                begin = simple_stl::__partition_left(begin, end, comp) + 1;
+                continue;
+            }
+
+            pair<RandomAccessIterator, bool> part = simple_stl::__sort_partition(begin, end, comp, branchless);
+            RandomAccessIterator pivot_pos = part.first;
+            const ptrdiff_t l_size = pivot_pos - begin;
+            const ptrdiff_t r_size = end - (pivot_pos + 1);
+            const bool highly_unbalanced = l_size < size / 8 || r_size < size / 8;
+
+            if (highly_unbalanced){
+                // 失衡次数过多，改用堆排序兜底
+                if (--bad_allowed == 0){
+                    simple_stl::__make_heap(begin, end, comp);
+                    simple_stl::__sort_heap(begin, end, comp);
+                    return;
+                }
+                // 交换几个固定位置的元素，打乱导致失衡的输入模式
+                if (l_size >= __sort_insertion_threshold){
+                    simple_stl::swap(*begin, *(begin + l_size / 4));
+                    simple_stl::swap(*(pivot_pos - 1), *(pivot_pos - l_size / 4));
+                    if (l_size > __sort_ninther_threshold){
+                        simple_stl::swap(*(begin + 1), *(begin + (l_size / 4 + 1)));
+                        simple_stl::swap(*(begin + 2), *(begin + (l_size / 4 + 2)));
+                        simple_stl::swap(*(pivot_pos - 2), *(pivot_pos - (l_size / 4 + 1)));
+                        simple_stl::swap(*(pivot_pos - 3), *(pivot_pos - (l_size / 4 + 2)));
+                    }
+                }
+                if (r_size >= __sort_insertion_threshold){
+                    simple_stl::swap(*(pivot_pos + 1), *(pivot_pos + (1 + r_size / 4)));
+                    simple_stl::swap(*(end - 1), *(end - r_size / 4));
+                    if (r_size > __sort_ninther_threshold){
+                        simple_stl::swap(*(pivot_pos + 2), *(pivot_pos + (2 + r_size / 4)));
+                        simple_stl::swap(*(pivot_pos + 3), *(pivot_pos + (3 + r_size / 4)));
+                        simple_stl::swap(*(end - 2), *(end - (1 + r_size / 4)));
+                        simple_stl::swap(*(end - 3), *(end - (2 + r_size / 4)));
+                    }
+                }
+            }
+            else if (part.second &&
+                     simple_stl::__partial_insertion_sort(begin, pivot_pos, comp) &&
+                     simple_stl::__partial_insertion_sort(pivot_pos + 1, end, comp)){
+                // 划分前已经有序或接近有序，插入排序收尾即可
+                return;
+            }
+
+            if (l_size < r_size){
+                simple_stl::__pdqsort_loop(begin, pivot_pos, comp, bad_allowed, leftmost, branchless);
+                begin = pivot_pos + 1;
+                leftmost = false;
+            }
+            else{
+                // 右侧的左邻是枢轴，递归时 leftmost 为 false；左侧保留原来的 leftmost
+                simple_stl::__pdqsort_loop(pivot_pos + 1, end, comp, bad_allowed, false, branchless);
+                end = pivot_pos;
+            }
+        }
+    }
+
+    template<class RandomAccessIterator, class Compare>
+    inline void __sort(RandomAccessIterator first, RandomAccessIterator last, Compare& comp, random_access_iterator_tag){
+        typedef typename iterator_traits<RandomAccessIterator>::value_type T;
+        if (last - first < 2)
+            return;
+        simple_stl::__pdqsort_loop(first, last, comp, __sort_log2(last - first), true,
+                                   __sort_use_branchless<T, Compare>());
+    }
+
+    template<class RandomAccessIterator, class Compare>
+    inline void sort(RandomAccessIterator first, RandomAccessIterator last, Compare comp){
+        simple_stl::__sort(first, last, comp, iterator_category(first));
+    }
+
+    template<class RandomAccessIterator>
+    inline void sort(RandomAccessIterator first, RandomAccessIterator last){
+        simple_stl::sort(first, last, less<typename iterator_traits<RandomAccessIterator>::value_type>());
+    }
+
+
+    /** stable_sort */
+    // 左半部分移入暂存区 buf 后与右半部分归并回原处；两半已经首尾有序时跳过归并
+    template<class RandomAccessIterator, class T, class Compare>
+    void __merge_sort_with_buffer(RandomAccessIterator first, RandomAccessIterator last, T* buf, Compare& comp){
+        if (last - first <= __stable_sort_chunk){
+            simple_stl::__insertion_sort(first, last, comp);
+            return;
+        }
+        RandomAccessIterator mid = first + (last - first) / 2;
+        simple_stl::__merge_sort_with_buffer(first, mid, buf, comp);
+        simple_stl::__merge_sort_with_buffer(mid, last, buf, comp);
+        if (!comp(*mid, *(mid - 1)))
+            return;
+
+        T* a = buf;
+        T* a_last = simple_stl::uninitialized_move(first, mid, buf);
+        try{
+            RandomAccessIterator b = mid;
+            RandomAccessIterator out = first;
+            // 右半部分的元素严格小于时才先取，相等的元素保持原来的先后次序
+            while (a != a_last && b != last){
+                if (comp(*b, *a)){
+                    *out = simple_stl::move(*b);
+                    ++b;
+                }
+                else{
+                    *out = simple_stl::move(*a);
+                    ++a;
+                }
+                ++out;
+            }
+            for ( ; a != a_last; ++a, ++out)
+                *out = simple_stl::move(*a);
+        }
+        catch (...){
+            simple_stl::destroy(buf, a_last);
+            throw;
+        }
+        simple_stl::destroy(buf, a_last);
+    }
+
+    template<class RandomAccessIterator, class Compare>
+    void __stable_sort(RandomAccessIterator first, RandomAccessIterator last, Compare& comp, random_access_iterator_tag){
+        typedef typename iterator_traits<RandomAccessIterator>::value_type T;
+        const ptrdiff_t len = last - first;
+        if (len <= __stable_sort_chunk){
+            simple_stl::__insertion_sort(first, last, comp);
+            return;
+        }
+        // 每层归并只暂存左半部分，最多 len / 2 个元素
+        allocator<T> a;
+        const size_t buf_len = static_cast<size_t>(len / 2);
+        T* buf = a.allocate(buf_len);
+        try{
+            simple_stl::__merge_sort_with_buffer(first, last, buf, comp);
+        }
+        catch (...){
+            a.deallocate(buf, buf_len);
+            throw;
+        }
+        a.deallocate(buf, buf_len);
+    }
+
+    template<class RandomAccessIterator, class Compare>
+    inline void stable_sort(RandomAccessIterator first, RandomAccessIterator last, Compare comp){
+        simple_stl::__stable_sort(first, last, comp, iterator_category(first));
+    }
+
+    template<class RandomAccessIterator>
+    inline void stable_sort(RandomAccessIterator first, RandomAccessIterator last){
+        simple_stl::stable_sort(first, last, less<typename iterator_traits<RandomAccessIterator>::value_type>());
+    }
+
+
+    /** partial_sort：使 [first, middle) 为整个区间中最小的若干元素且有序 */
+    // [first, middle) 建成大根堆，其后的元素比堆顶小则替换堆顶，最后对堆排序
+    template<class RandomAccessIterator, class Compare>
+    void __partial_sort(RandomAccessIterator first, RandomAccessIterator middle, RandomAccessIterator last,
+                        Compare& comp, random_access_iterator_tag){
+        if (first == middle)
+            return;
+        simple_stl::__make_heap(first, middle, comp);
+        for (RandomAccessIterator i = middle; i < last; ++i)
+            if (comp(*i, *first))
+                simple_stl::__pop_heap(first, middle, i, comp);
+        simple_stl::__sort_heap(first, middle, comp);
+    }
+
+    template<class RandomAccessIterator, class Compare>
+    inline void partial_sort(RandomAccessIterator first, RandomAccessIterator middle,
+                             RandomAccessIterator last, Compare comp){
+        simple_stl::__partial_sort(first, middle, last, comp, iterator_category(first));
+    }
+
+    template<class RandomAccessIterator>
+    inline void partial_sort(RandomAccessIterator first, RandomAccessIterator middle, RandomAccessIterator last){
+        simple_stl::partial_sort(first, middle, last,
+                                 less<typename iterator_traits<RandomAccessIterator>::value_type>());
+    }
+
+
+    /** nth_element：使 *nth 为排序后应处于该位置的元素，其左不大于它，其右不小于它 */
+    // 与 sort 相同的枢轴选取与划分，只进入包含 nth 的一侧；划分次数超过 2log2(n) 时改用堆选择
+    template<class RandomAccessIterator, class Compare>
+    void __nth_element(RandomAccessIterator first, RandomAccessIterator nth, RandomAccessIterator last,
+                       Compare& comp, random_access_iterator_tag){
+        typedef typename iterator_traits<RandomAccessIterator>::value_type T;
+        if (nth == last)
+            return;
+        int depth = 2 * __sort_log2(last - first);
+        while (last - first > __sort_insertion_threshold){
+            if (depth-- == 0){
+                simple_stl::__partial_sort(first, nth + 1, last, comp, random_access_iterator_tag());
+                return;
+            }
+            simple_stl::__sort_choose_pivot(first, last, comp);
+            RandomAccessIterator cut =
+                    simple_stl::__sort_partition(first, last, comp, __sort_use_branchless<T, Compare>()).first;
+            if (nth < cut)
+                last = cut;
+            else if (cut < nth)
+                first = cut + 1;
+            else
+                return;
+        }
+        simple_stl::__insertion_sort(first, last, comp);
+    }
+
+    template<class RandomAccessIterator, class Compare>
+    inline void nth_element(RandomAccessIterator first, RandomAccessIterator nth,
+                            RandomAccessIterator last, Compare comp){
+        simple_stl::__nth_element(first, nth, last, comp, iterator_category(first));
+    }
+
+    template<class RandomAccessIterator>
+    inline void nth_element(RandomAccessIterator first, RandomAccessIterator nth, RandomAccessIterator last){
+        simple_stl::nth_element(first, nth, last,
+                                less<typename iterator_traits<RandomAccessIterator>::value_type>());
+    }
+
+
+    /** is_sorted_until：返回第一个比前一元素小的位置 */
+    template<class ForwardIterator, class Compare>
+    ForwardIterator is_sorted_until(ForwardIterator first, ForwardIterator last, Compare comp){
+        if (first == last)
+            return last;
+        ForwardIterator next = first;
+        while (++next != last){
+            if (comp(*next, *first))
+                return next;
+            first = next;
+        }
+        return last;
+    }
+
+    template<class ForwardIterator>
+    inline ForwardIterator is_sorted_until(ForwardIterator first, ForwardIterator last){
+        return simple_stl::is_sorted_until(first, last,
+                                           less<typename iterator_traits<ForwardIterator>::value_type>());
+    }
+
+    template<class ForwardIterator, class Compare>
+    inline bool is_sorted(ForwardIterator first, ForwardIterator last, Compare comp){
+        return simple_stl::is_sorted_until(first, last, comp) == last;
+    }
+
+    template<class ForwardIterator>
+    inline bool is_sorted(ForwardIterator first, ForwardIterator last){
+        return simple_stl::is_sorted_until(first, last) == last;
+    }
+
+}   // simple_stl
+
+#endif //SIMPLESTL_STL_SORT_H
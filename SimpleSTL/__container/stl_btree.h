@@ -0,0 +1,872 @@
+/**
+ * Created by 史进 on 2023/6/19.
+ *
+ * btree：btree_map、btree_set 的底层 B 树，键互不相同
+ *  - 每个节点约 256 字节（四个缓存行），连续存放多个元素；叶子节点不含孩子指针。
+ *    整数键配合 less / greater 时节点内做无分支的线性计数查找，便于向量化；其它情况二分查找
+ *  - 叶子与内部节点分别经 rebind 后的配置器配置，默认走带线程缓存的内存池
+ *  - 节点中存放 Slot，以 Value 的引用交给使用者，两者布局相同。btree_map 的 Slot 为 pair<Key, T>，
+ *    以 pair<const Key, T> 的引用交出，节点内外搬移元素时移动键而不是拷贝键
+ *  - 节点内元素的搬移按重定位处理：可平凡重定位的类型直接 memmove，否则移动构造后析构；
+ *    搬移不能中途失败，Slot 的移动构造应当不抛异常
+ *  - 顺序追加时分裂偏向保留满节点，有序数据建成的树几乎没有空位
+ *  - 插入、删除会移动同一节点及相邻节点中的元素，使所有迭代器失效
+ */
+#ifndef SIMPLESTL_STL_BTREE_H
+#define SIMPLESTL_STL_BTREE_H
+
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+#include "../iterator.h"
+#include "../type_traits.h"
+#include "../utility.h"
+#include "../__functional/stl_function.h"
+#include "../__memory/stl_allocator.h"
+#include "../__memory/stl_allocator_traits.h"
+#include "../__memory/stl_construct.h"
+
+namespace simple_stl{
+
+    enum { __btree_target_node_size = 256 };
+
+    template<class Value>
+    struct __btree_node{
+        enum {
+            __fit_values = (__btree_target_node_size - sizeof(void*) - 2 * sizeof(unsigned short) - sizeof(bool))
+                           / sizeof(Value),
+            node_values = __fit_values < 3 ? 3 : (__fit_values > 255 ? 255 : __fit_values)
+        };
+
+        __btree_node* parent_;
+        unsigned short position_;   // 在父节点中是第几个孩子
+        unsigned short count_;
+        bool leaf_;
+        typename std::aligned_storage<sizeof(Value), alignof(Value)>::type values_[node_values];
+
+        Value* values() noexcept { return reinterpret_cast<Value*>(values_); }
+        const Value* values() const noexcept { return reinterpret_cast<const Value*>(values_); }
+        Value& value(int i) noexcept { return values()[i]; }
+        const Value& value(int i) const noexcept { return values()[i]; }
+    };
+
+    // 内部节点在叶子节点的布局之后追加孩子指针
+    template<class Value>
+    struct __btree_internal_node : public __btree_node<Value>{
+        __btree_node<Value>* children_[__btree_node<Value>::node_values + 1];
+    };
+
+    template<class Value>
+    inline __btree_node<Value>*& __btree_child(__btree_node<Value>* x, int i) noexcept{
+        return static_cast<__btree_internal_node<Value>*>(x)->children_[i];
+    }
+
+    // 中序后继：叶子内右移一位，到头时沿父节点上行；内部节点转到右侧子树的最左叶子。
+    // 最后一个元素的后继为最右叶子的尾后位置，即 end()
+    template<class Value>
+    inline void __btree_increment(__btree_node<Value>*& x, int& pos) noexcept{
+        if (x->leaf_){
+            if (++pos < x->count_)
+                return;
+            __btree_node<Value>* save = x;
+            const int save_pos = pos;
+            while (pos == x->count_ && x->parent_ != nullptr){
+                pos = x->position_;
+                x = x->parent_;
+            }
+            if (pos == x->count_){
+                x = save;
+                pos = save_pos;
+            }
+        }else{
+            x = __btree_child(x, pos + 1);
+            while (!x->leaf_)
+                x = __btree_child(x, 0);
+            pos = 0;
+        }
+    }
+
+    template<class Value>
+    inline void __btree_decrement(__btree_node<Value>*& x, int& pos) noexcept{
+        if (x->leaf_){
+            if (--pos >= 0)
+                return;
+            while (pos < 0 && x->parent_ != nullptr){
+                pos = x->position_ - 1;
+                x = x->parent_;
+            }
+        }else{
+            x = __btree_child(x, pos);
+            while (!x->leaf_)
+                x = __btree_child(x, x->count_);
+            pos = x->count_ - 1;
+        }
+    }
+
+    template<class Value, class Slot, class Ref, class Ptr>
+    struct __btree_iterator{
+        typedef __btree_iterator<Value, Slot, Value&, Value*>               iterator;
+        typedef __btree_iterator<Value, Slot, const Value&, const Value*>   const_iterator;
+        typedef __btree_iterator                                            self;
+
+        typedef bidirectional_iterator_tag  iterator_category;
+        typedef Value                       value_type;
+        typedef Ptr                         pointer;
+        typedef Ref                         reference;
+        typedef ptrdiff_t                   difference_type;
+        typedef __btree_node<Slot>*         node_ptr;
+
+        node_ptr node_;
+        int position_;
+
+        __btree_iterator() noexcept : node_(nullptr), position_(0) {}
+        __btree_iterator(node_ptr x, int pos) noexcept : node_(x), position_(pos) {}
+
+        // iterator 可转换为 const_iterator
+        __btree_iterator(const iterator& other) noexcept : node_(other.node_), position_(other.position_) {}
+
+        __btree_iterator& operator=(const __btree_iterator&) = default;
+
+        reference operator*() const { return *reinterpret_cast<Value*>(&node_->value(position_)); }
+        pointer operator->() const { return reinterpret_cast<Value*>(&node_->value(position_)); }
+
+        self& operator++(){
+            __btree_increment(node_, position_);
+            return *this;
+        }
+
+        self operator++(int){
+            self tmp = *this;
+            __btree_increment(node_, position_);
+            return tmp;
+        }
+
+        self& operator--(){
+            __btree_decrement(node_, position_);
+            return *this;
+        }
+
+        self operator--(int){
+            self tmp = *this;
+            __btree_decrement(node_, position_);
+            return tmp;
+        }
+
+        template<class R, class P>
+        bool operator==(const __btree_iterator<Value, Slot, R, P>& x) const{
+            return node_ == x.node_ && position_ == x.position_;
+        }
+
+        template<class R, class P>
+        bool operator!=(const __btree_iterator<Value, Slot, R, P>& x) const { return !(*this == x); }
+    };
+
+    // 整数键按 less / greater 比较时，节点内用线性计数代替二分查找
+    template<class Key, class Compare>
+    struct __btree_use_linear_search
+            : bool_constant_s<std::is_arithmetic<Key>::value &&
+                              (std::is_same<Compare, less<Key> >::value ||
+                               std::is_same<Compare, greater<Key> >::value)> {};
+
+
+    // KeyOfValue 须同时能从 Value 与 Slot 中取出键
+    template<class Key, class Value, class Slot, class KeyOfValue, class Compare, class Alloc = allocator<Value> >
+    class btree{
+    public:
+        typedef Key                                             key_type;
+        typedef Value                                           value_type;
+        typedef Compare                                         key_compare;
+        typedef Alloc                                           allocator_type;
+        typedef size_t                                          size_type;
+        typedef ptrdiff_t                                       difference_type;
+        typedef value_type&                                     reference;
+        typedef const value_type&                               const_reference;
+        typedef value_type*                                     pointer;
+        typedef const value_type*                               const_pointer;
+        typedef __btree_iterator<Value, Slot, Value&, Value*>               iterator;
+        typedef __btree_iterator<Value, Slot, const Value&, const Value*>   const_iterator;
+
+    private:
+        typedef __btree_node<Slot>                                                          node;
+        typedef __btree_internal_node<Slot>                                                 internal_node;
+        typedef typename allocator_traits<Alloc>::template rebind_alloc<node>               leaf_allocator;
+        typedef allocator_traits<leaf_allocator>                                            leaf_traits;
+        typedef typename allocator_traits<Alloc>::template rebind_alloc<internal_node>      internal_allocator;
+        typedef allocator_traits<internal_allocator>                                        internal_traits;
+
+        enum {
+            __node_values = node::node_values,
+            __min_node_values = __node_values / 2
+        };
+
+        // 继承叶子节点配置器以便无状态配置器不占空间；内部节点配置器需要时由其转换得到
+        struct __btree_impl : public leaf_allocator{
+            Compare comp_;
+            node* root_;
+            node* leftmost_;
+            node* rightmost_;
+            size_type size_;
+
+            __btree_impl(const Compare& comp, const leaf_allocator& a)
+            : leaf_allocator(a), comp_(comp) { __reset(); }
+
+            void __reset() noexcept{
+                root_ = leftmost_ = rightmost_ = nullptr;
+                size_ = 0;
+            }
+        };
+
+        __btree_impl impl_;
+
+        leaf_allocator& __leaf_alloc() noexcept { return impl_; }
+        const leaf_allocator& __leaf_alloc() const noexcept { return impl_; }
+
+        template<class V>
+        static const Key& __key(const V& v) { return KeyOfValue()(v); }
+        static node*& __child(node* x, int i) noexcept { return __btree_child(x, i); }
+        static node* __child(const node* x, int i) noexcept { return __btree_child(const_cast<node*>(x), i); }
+
+    public:
+        /** 构造、析构 */
+        explicit btree(const Compare& comp = Compare(), const Alloc& a = Alloc())
+        : impl_(comp, leaf_allocator(a)) {}
+
+        btree(const btree& other)
+        : impl_(other.impl_.comp_, leaf_traits::select_on_container_copy_construction(other.__leaf_alloc())){
+            __copy_from(other);
+        }
+
+        btree(const btree& other, const Alloc& a) : impl_(other.impl_.comp_, leaf_allocator(a)){
+            __copy_from(other);
+        }
+
+        btree(btree&& other) noexcept
+        : impl_(other.impl_.comp_, simple_stl::move(other.__leaf_alloc())){
+            __steal(other);
+        }
+
+        ~btree(){
+            clear();
+        }
+
+        /** 赋值 */
+        btree& operator=(const btree& other){
+            if (this != &other){
+                clear();
+                __copy_assign_alloc(other, typename leaf_traits::propagate_on_container_copy_assignment());
+                impl_.comp_ = other.impl_.comp_;
+                __copy_from(other);
+            }
+            return *this;
+        }
+
+        btree& operator=(btree&& other) noexcept(
+                leaf_traits::propagate_on_container_move_assignment::value ||
+                leaf_traits::is_always_equal::value){
+            if (this != &other)
+                __move_assign(other, bool_constant_s<
+                        leaf_traits::propagate_on_container_move_assignment::value ||
+                        leaf_traits::is_always_equal::value>());
+            return *this;
+        }
+
+        allocator_type get_allocator() const { return allocator_type(__leaf_alloc()); }
+        key_compare key_comp() const { return impl_.comp_; }
+
+        /** 迭代器 */
+        iterator begin() noexcept { return iterator(impl_.leftmost_, 0); }
+        const_iterator begin() const noexcept { return const_iterator(impl_.leftmost_, 0); }
+        iterator end() noexcept { return iterator(impl_.rightmost_, impl_.rightmost_ ? impl_.rightmost_->count_ : 0); }
+        const_iterator end() const noexcept{
+            return const_iterator(impl_.rightmost_, impl_.rightmost_ ? impl_.rightmost_->count_ : 0);
+        }
+
+        /** 容量 */
+        bool empty() const noexcept { return impl_.size_ == 0; }
+        size_type size() const noexcept { return impl_.size_; }
+        size_type max_size() const noexcept { return leaf_traits::max_size(__leaf_alloc()) * __node_values; }
+
+        // 每个节点最多容纳的元素个数
+        static constexpr size_type node_values() noexcept { return __node_values; }
+
+        /** 插入 */
+        // 按键 k 查找，不存在时在叶子中腾出位置并调用 construct_fn(Slot*) 构造元素
+        template<class ConstructFn>
+        pair<iterator, bool> emplace_key_with(const key_type& k, ConstructFn construct_fn){
+            if (impl_.root_ == nullptr)
+                impl_.root_ = impl_.leftmost_ = impl_.rightmost_ = __new_leaf();
+            node* x = impl_.root_;
+            int pos;
+            while (true){
+                pos = __node_lower_bound(x, k);
+                if (pos < x->count_ && !impl_.comp_(k, __key(x->value(pos))))
+                    return pair<iterator, bool>(iterator(x, pos), false);
+                if (x->leaf_)
+                    break;
+                x = __child(x, pos);
+            }
+            return pair<iterator, bool>(__insert_leaf(x, pos, construct_fn), true);
+        }
+
+        template<class... Args>
+        pair<iterator, bool> emplace_key_args(const key_type& k, Args&&... args){
+            return emplace_key_with(k, [&](Slot* p){
+                simple_stl::construct(p, simple_stl::forward<Args>(args)...);
+            });
+        }
+
+        template<class V>
+        pair<iterator, bool> insert_unique(V&& v){
+            return emplace_key_args(__key(v), simple_stl::forward<V>(v));
+        }
+
+        // 提示位置为 end() 且键大于现有的最大键时直接追加到最右叶子，有序构建时每次插入 O(1) 均摊
+        template<class V>
+        iterator insert_hint_unique(const_iterator hint, V&& v){
+            if (hint == end() && impl_.rightmost_ != nullptr &&
+                impl_.comp_(__key(impl_.rightmost_->value(impl_.rightmost_->count_ - 1)), __key(v))){
+                return __insert_leaf(impl_.rightmost_, impl_.rightmost_->count_, [&](Slot* p){
+                    simple_stl::construct(p, simple_stl::forward<V>(v));
+                });
+            }
+            return insert_unique(simple_stl::forward<V>(v)).first;
+        }
+
+        // 键只能从构造好的元素中取得，先在临时对象中构造，再移入节点
+        template<class... Args>
+        pair<iterator, bool> emplace_unique(Args&&... args){
+            Slot tmp(simple_stl::forward<Args>(args)...);
+            return insert_unique(simple_stl::move(tmp));
+        }
+
+        template<class... Args>
+        iterator emplace_hint_unique(const_iterator hint, Args&&... args){
+            Slot tmp(simple_stl::forward<Args>(args)...);
+            return insert_hint_unique(hint, simple_stl::move(tmp));
+        }
+
+        template<class InputIterator>
+        void insert_range_unique(InputIterator first, InputIterator last){
+            for ( ; first != last; ++first)
+                insert_hint_unique(end(), *first);
+        }
+
+        /** 删除 */
+        // 内部节点的元素先与前驱（左子树的最大元素）交换位置，删除总是发生在叶子中；
+        // 随后自下而上合并或借位，并跟踪后继元素的位置作为返回值
+        iterator erase(const_iterator pos){
+            node* x = pos.node_;
+            const int p = pos.position_;
+            iterator next;
+            simple_stl::destroy(&x->value(p));
+            if (!x->leaf_){
+                node* leaf = __child(x, p);
+                while (!leaf->leaf_)
+                    leaf = __child(leaf, leaf->count_);
+                __relocate_n(&leaf->value(leaf->count_ - 1), 1, &x->value(p));
+                --leaf->count_;
+                next = iterator(x, p);
+                ++next;
+                x = leaf;
+            }else{
+                __relocate_n(x->values() + p + 1, x->count_ - p - 1, x->values() + p);
+                --x->count_;
+                next = __normalize(x, p);
+            }
+            --impl_.size_;
+            __rebalance_after_erase(x, next);
+            return next.node_ == nullptr ? end() : next;
+        }
+
+        iterator erase(const_iterator first, const_iterator last){
+            if (first == begin() && last == end()){
+                clear();
+                return end();
+            }
+            // 逐个删除，last 会因搬移而失效，按剩余个数计数
+            size_type n = static_cast<size_type>(simple_stl::distance(first, last));
+            iterator it(first.node_, first.position_);
+            for ( ; n > 0; --n)
+                it = erase(it);
+            return it;
+        }
+
+        size_type erase(const key_type& k){
+            iterator it = find(k);
+            if (it == end())
+                return 0;
+            erase(it);
+            return 1;
+        }
+
+        void clear() noexcept{
+            if (impl_.root_ != nullptr)
+                __destroy_subtree(impl_.root_);
+            impl_.__reset();
+        }
+
+        void swap(btree& other) noexcept{
+            __swap_alloc(other, typename leaf_traits::propagate_on_container_swap());
+            simple_stl::swap(impl_.comp_, other.impl_.comp_);
+            simple_stl::swap(impl_.root_, other.impl_.root_);
+            simple_stl::swap(impl_.leftmost_, other.impl_.leftmost_);
+            simple_stl::swap(impl_.rightmost_, other.impl_.rightmost_);
+            simple_stl::swap(impl_.size_, other.impl_.size_);
+        }
+
+        /** 查找 */
+        iterator find(const key_type& k){
+            iterator it = lower_bound(k);
+            return it != end() && !impl_.comp_(k, __key(*it)) ? it : end();
+        }
+
+        const_iterator find(const key_type& k) const{
+            const_iterator it = lower_bound(k);
+            return it != end() && !impl_.comp_(k, __key(*it)) ? it : end();
+        }
+
+        bool contains(const key_type& k) const { return find(k) != end(); }
+
+        // 自根向下，记录沿途第一个不小于 k 的元素，越往下越接近
+        iterator lower_bound(const key_type& k){
+            iterator result = end();
+            node* x = impl_.root_;
+            while (x != nullptr){
+                const int pos = __node_lower_bound(x, k);
+                if (pos < x->count_)
+                    result = iterator(x, pos);
+                x = x->leaf_ ? nullptr : __child(x, pos);
+            }
+            return result;
+        }
+
+        const_iterator lower_bound(const key_type& k) const { return const_cast<btree*>(this)->lower_bound(k); }
+
+        iterator upper_bound(const key_type& k){
+            iterator result = end();
+            node* x = impl_.root_;
+            while (x != nullptr){
+                const int pos = __node_upper_bound(x, k);
+                if (pos < x->count_)
+                    result = iterator(x, pos);
+                x = x->leaf_ ? nullptr : __child(x, pos);
+            }
+            return result;
+        }
+
+        const_iterator upper_bound(const key_type& k) const { return const_cast<btree*>(this)->upper_bound(k); }
+
+        pair<iterator, iterator> equal_range(const key_type& k){
+            iterator first = lower_bound(k);
+            iterator last = first;
+            if (last != end() && !impl_.comp_(k, __key(*last)))
+                ++last;
+            return pair<iterator, iterator>(first, last);
+        }
+
+        pair<const_iterator, const_iterator> equal_range(const key_type& k) const{
+            pair<iterator, iterator> r = const_cast<btree*>(this)->equal_range(k);
+            return pair<const_iterator, const_iterator>(r.first, r.second);
+        }
+
+    private:
+        /** 节点内查找 */
+        int __node_lower_bound(const node* x, const key_type& k) const{
+            return __node_lower_bound(x, k, __btree_use_linear_search<Key, Compare>());
+        }
+
+        // 数出小于 k 的元素个数，循环没有提前退出的分支，整数键可以向量化
+        int __node_lower_bound(const node* x, const key_type& k, __true_type_s) const{
+            int n = 0;
+            for (int i = 0; i < x->count_; ++i)
+                n += impl_.comp_(__key(x->value(i)), k);
+            return n;
+        }
+
+        int __node_lower_bound(const node* x, const key_type& k, __false_type_s) const{
+            int lo = 0, hi = x->count_;
+            while (lo < hi){
+                const int mid = (lo + hi) / 2;
+                if (impl_.comp_(__key(x->value(mid)), k))
+                    lo = mid + 1;
+                else
+                    hi = mid;
+            }
+            return lo;
+        }
+
+        int __node_upper_bound(const node* x, const key_type& k) const{
+            return __node_upper_bound(x, k, __btree_use_linear_search<Key, Compare>());
+        }
+
+        int __node_upper_bound(const node* x, const key_type& k, __true_type_s) const{
+            int n = 0;
+            for (int i = 0; i < x->count_; ++i)
+                n += !impl_.comp_(k, __key(x->value(i)));
+            return n;
+        }
+
+        int __node_upper_bound(const node* x, const key_type& k, __false_type_s) const{
+            int lo = 0, hi = x->count_;
+            while (lo < hi){
+                const int mid = (lo + hi) / 2;
+                if (impl_.comp_(k, __key(x->value(mid))))
+                    hi = mid;
+                else
+                    lo = mid + 1;
+            }
+            return lo;
+        }
+
+        /** 节点的配置与释放 */
+        node* __new_leaf(){
+            node* x = leaf_traits::allocate(__leaf_alloc(), 1);
+            x->parent_ = nullptr;
+            x->position_ = 0;
+            x->count_ = 0;
+            x->leaf_ = true;
+            return x;
+        }
+
+        node* __new_internal(){
+            internal_allocator a(__leaf_alloc());
+            internal_node* x = internal_traits::allocate(a, 1);
+            x->parent_ = nullptr;
+            x->position_ = 0;
+            x->count_ = 0;
+            x->leaf_ = false;
+            x->children_[0] = nullptr;
+            return x;
+        }
+
+        void __delete_node(node* x) noexcept{
+            if (x->leaf_){
+                leaf_traits::deallocate(__leaf_alloc(), x, 1);
+            }else{
+                internal_allocator a(__leaf_alloc());
+                internal_traits::deallocate(a, static_cast<internal_node*>(x), 1);
+            }
+        }
+
+        void __destroy_subtree(node* x) noexcept{
+            if (!x->leaf_)
+                for (int i = 0; i <= x->count_; ++i)
+                    if (__child(x, i) != nullptr)
+                        __destroy_subtree(__child(x, i));
+            simple_stl::destroy(x->values(), x->values() + x->count_);
+            __delete_node(x);
+        }
+
+        /** 元素搬移 */
+        // 把 [first, first + n) 重定位到未初始化的 result 处，两区间可以重叠
+        static void __relocate_n(Slot* first, int n, Slot* result) noexcept{
+            if (n > 0 && first != result)
+                __relocate_n_aux(first, n, result, bool_constant_s<is_trivially_relocatable<Slot>::value>());
+        }
+
+        static void __relocate_n_aux(Slot* first, int n, Slot* result, __true_type_s) noexcept{
+            std::memmove(static_cast<void*>(result), static_cast<const void*>(first), n * sizeof(Slot));
+        }
+
+        static void __relocate_n_aux(Slot* first, int n, Slot* result, __false_type_s) noexcept{
+            if (result < first){
+                for (int i = 0; i < n; ++i){
+                    simple_stl::construct(result + i, simple_stl::move(first[i]));
+                    simple_stl::destroy(first + i);
+                }
+            }else{
+                for (int i = n; i-- > 0; ){
+                    simple_stl::construct(result + i, simple_stl::move(first[i]));
+                    simple_stl::destroy(first + i);
+                }
+            }
+        }
+
+        // 孩子 c 放到 x 的第 i 个孩子位置
+        static void __set_child(node* x, int i, node* c) noexcept{
+            __child(x, i) = c;
+            c->parent_ = x;
+            c->position_ = static_cast<unsigned short>(i);
+        }
+
+        /** 插入 */
+        // 在叶子 x 的 pos 处插入；x 已满时先分裂
+        template<class ConstructFn>
+        iterator __insert_leaf(node* x, int pos, ConstructFn construct_fn){
+            if (x->count_ == __node_values){
+                __split(x, pos);
+                if (pos > x->count_){
+                    pos -= x->count_ + 1;
+                    x = __child(x->parent_, x->position_ + 1);
+                }
+            }
+            __relocate_n(x->values() + pos, x->count_ - pos, x->values() + pos + 1);
+            try {
+                construct_fn(&x->value(pos));
+            }catch(...){
+                __relocate_n(x->values() + pos + 1, x->count_ - pos, x->values() + pos);
+                throw;
+            }
+            ++x->count_;
+            ++impl_.size_;
+            return iterator(x, pos);
+        }
+
+        // 分裂已满的节点 x，pos 为随后要插入的位置：
+        // 在末尾插入时左侧保留 N - 1 个元素，在开头插入时左侧只留 1 个，使顺序插入的节点保持满载；
+        // 否则对半分。中间元素上移到父节点，父节点已满时先分裂父节点
+        void __split(node* x, int pos){
+            const int keep = pos == __node_values ? __node_values - 1 : (pos == 0 ? 1 : __node_values / 2);
+            if (x->parent_ == nullptr){
+                node* r = __new_internal();
+                __set_child(r, 0, x);
+                impl_.root_ = r;
+            }else if (x->parent_->count_ == __node_values){
+                __split(x->parent_, x->position_);
+            }
+            node* parent = x->parent_;
+            const int i = x->position_;
+            node* y = x->leaf_ ? __new_leaf() : __new_internal();
+            y->count_ = static_cast<unsigned short>(__node_values - keep - 1);
+            __relocate_n(x->values() + keep + 1, y->count_, y->values());
+            if (!x->leaf_)
+                for (int j = 0; j <= y->count_; ++j)
+                    __set_child(y, j, __child(x, keep + 1 + j));
+            // 中间元素放到父节点的第 i 位，y 成为其第 i + 1 个孩子
+            __relocate_n(parent->values() + i, parent->count_ - i, parent->values() + i + 1);
+            for (int j = parent->count_; j > i; --j)
+                __set_child(parent, j + 1, __child(parent, j));
+            __relocate_n(x->values() + keep, 1, parent->values() + i);
+            __set_child(parent, i + 1, y);
+            ++parent->count_;
+            x->count_ = static_cast<unsigned short>(keep);
+            if (x == impl_.rightmost_)
+                impl_.rightmost_ = y;
+        }
+
+        /** 删除 */
+        // 叶子 x 中 pos 处的元素刚被删除，返回其后继的位置，没有后继时 node_ 为空
+        static iterator __normalize(node* x, int pos) noexcept{
+            while (pos == x->count_ && x->parent_ != nullptr){
+                pos = x->position_;
+                x = x->parent_;
+            }
+            return pos == x->count_ ? iterator() : iterator(x, pos);
+        }
+
+        // 元素不足一半的节点与兄弟合并，合并不下时从较多的兄弟借一个；
+        // 合并会从父节点取走一个元素，因此向上继续检查。根节点为空时树高减一
+        void __rebalance_after_erase(node* x, iterator& track){
+            while (x != impl_.root_ && x->count_ < __min_node_values){
+                node* parent = x->parent_;
+                const int i = x->position_;
+                node* left = i > 0 ? __child(parent, i - 1) : nullptr;
+                node* right = i < parent->count_ ? __child(parent, i + 1) : nullptr;
+                if (left != nullptr && left->count_ + 1 + x->count_ <= __node_values){
+                    __merge(left, track);
+                }else if (right != nullptr && x->count_ + 1 + right->count_ <= __node_values){
+                    __merge(x, track);
+                }else{
+                    if (left != nullptr && (right == nullptr || left->count_ >= right->count_))
+                        __rotate_right(left, track);
+                    else
+                        __rotate_left(x, track);
+                    break;
+                }
+                x = parent;
+            }
+            node* root = impl_.root_;
+            if (root->count_ == 0){
+                if (root->leaf_){
+                    __delete_node(root);
+                    impl_.__reset();
+                    track = iterator();
+                }else{
+                    node* r = __child(root, 0);
+                    r->parent_ = nullptr;
+                    r->position_ = 0;
+                    impl_.root_ = r;
+                    __delete_node(root);
+                }
+            }
+        }
+
+        // 把 left 右侧的兄弟连同两者间的分隔元素并入 left
+        void __merge(node* left, iterator& track){
+            node* parent = left->parent_;
+            const int i = left->position_;
+            node* right = __child(parent, i + 1);
+            const int lc = left->count_;
+            if (track.node_ == right)
+                track = iterator(left, track.position_ + lc + 1);
+            else if (track.node_ == parent && track.position_ == i)
+                track = iterator(left, lc);
+            else if (track.node_ == parent && track.position_ > i)
+                --track.position_;
+
+            __relocate_n(parent->values() + i, 1, left->values() + lc);
+            __relocate_n(right->values(), right->count_, left->values() + lc + 1);
+            if (!left->leaf_)
+                for (int j = 0; j <= right->count_; ++j)
+                    __set_child(left, lc + 1 + j, __child(right, j));
+            left->count_ = static_cast<unsigned short>(lc + 1 + right->count_);
+
+            __relocate_n(parent->values() + i + 1, parent->count_ - i - 1, parent->values() + i);
+            for (int j = i + 2; j <= parent->count_; ++j)
+                __set_child(parent, j - 1, __child(parent, j));
+            --parent->count_;
+
+            if (right == impl_.rightmost_)
+                impl_.rightmost_ = left;
+            __delete_node(right);
+        }
+
+        // 从左兄弟借一个元素给其右侧的兄弟 x：分隔元素下移到 x 的开头，左兄弟的末元素上移为分隔元素
+        void __rotate_right(node* left, iterator& track){
+            node* parent = left->parent_;
+            const int i = left->position_;
+            node* x = __child(parent, i + 1);
+            const int lc = left->count_;
+            if (track.node_ == x)
+                ++track.position_;
+            else if (track.node_ == parent && track.position_ == i)
+                track = iterator(x, 0);
+            else if (track.node_ == left && track.position_ == lc - 1)
+                track = iterator(parent, i);
+
+            __relocate_n(x->values(), x->count_, x->values() + 1);
+            if (!x->leaf_)
+                for (int j = x->count_; j >= 0; --j)
+                    __set_child(x, j + 1, __child(x, j));
+            __relocate_n(parent->values() + i, 1, x->values());
+            __relocate_n(left->values() + lc - 1, 1, parent->values() + i);
+            if (!x->leaf_)
+                __set_child(x, 0, __child(left, lc));
+            ++x->count_;
+            --left->count_;
+        }
+
+        // 从右兄弟借一个元素给 x：分隔元素下移到 x 的末尾，右兄弟的首元素上移为分隔元素
+        void __rotate_left(node* x, iterator& track){
+            node* parent = x->parent_;
+            const int i = x->position_;
+            node* right = __child(parent, i + 1);
+            const int xc = x->count_;
+            if (track.node_ == parent && track.position_ == i)
+                track = iterator(x, xc);
+            else if (track.node_ == right && track.position_ == 0)
+                track = iterator(parent, i);
+            else if (track.node_ == right)
+                --track.position_;
+
+            __relocate_n(parent->values() + i, 1, x->values() + xc);
+            __relocate_n(right->values(), 1, parent->values() + i);
+            __relocate_n(right->values() + 1, right->count_ - 1, right->values());
+            if (!x->leaf_){
+                __set_child(x, xc + 1, __child(right, 0));
+                for (int j = 0; j < right->count_; ++j)
+                    __set_child(right, j, __child(right, j + 1));
+            }
+            ++x->count_;
+            --right->count_;
+        }
+
+        /** 复制 */
+        // 结构复制；已复制的部分始终是一棵完整的子树，抛出异常时整体释放
+        node* __copy_subtree(const node* src, node* parent, int position){
+            node* x = src->leaf_ ? __new_leaf() : __new_internal();
+            x->parent_ = parent;
+            x->position_ = static_cast<unsigned short>(position);
+            try {
+                if (src->leaf_){
+                    for (int i = 0; i < src->count_; ++i){
+                        simple_stl::construct(&x->value(i), src->value(i));
+                        ++x->count_;
+                    }
+                }else{
+                    __child(x, 0) = __copy_subtree(__child(src, 0), x, 0);
+                    for (int i = 0; i < src->count_; ++i){
+                        simple_stl::construct(&x->value(i), src->value(i));
+                        try {
+                            __child(x, i + 1) = __copy_subtree(__child(src, i + 1), x, i + 1);
+                        }catch(...){
+                            simple_stl::destroy(&x->value(i));
+                            throw;
+                        }
+                        ++x->count_;
+                    }
+                }
+            }catch(...){
+                __destroy_subtree(x);
+                throw;
+            }
+            return x;
+        }
+
+        void __copy_from(const btree& other){
+            if (other.impl_.root_ == nullptr)
+                return;
+            impl_.root_ = __copy_subtree(other.impl_.root_, nullptr, 0);
+            impl_.size_ = other.impl_.size_;
+            node* x = impl_.root_;
+            while (!x->leaf_)
+                x = __child(x, 0);
+            impl_.leftmost_ = x;
+            x = impl_.root_;
+            while (!x->leaf_)
+                x = __child(x, x->count_);
+            impl_.rightmost_ = x;
+        }
+
+        void __steal(btree& other) noexcept{
+            impl_.root_ = other.impl_.root_;
+            impl_.leftmost_ = other.impl_.leftmost_;
+            impl_.rightmost_ = other.impl_.rightmost_;
+            impl_.size_ = other.impl_.size_;
+            other.impl_.__reset();
+        }
+
+        void __copy_assign_alloc(const btree& other, __true_type_s){
+            __leaf_alloc() = other.__leaf_alloc();
+        }
+
+        void __copy_assign_alloc(const btree&, __false_type_s) {}
+
+        // 可以接管对方的节点
+        void __move_assign(btree& other, __true_type_s){
+            clear();
+            __move_assign_alloc(other, typename leaf_traits::propagate_on_container_move_assignment());
+            impl_.comp_ = other.impl_.comp_;
+            __steal(other);
+        }
+
+        // 配置器不传播，相等时接管节点，否则逐一移动元素
+        void __move_assign(btree& other, __false_type_s){
+            if (__leaf_alloc() == other.__leaf_alloc()){
+                __move_assign(other, __true_type_s());
+            }else{
+                clear();
+                impl_.comp_ = other.impl_.comp_;
+                for (iterator it = other.begin(); it != other.end(); ++it)
+                    insert_hint_unique(end(), simple_stl::move(it.node_->value(it.position_)));
+                other.clear();
+            }
+        }
+
+        void __move_assign_alloc(btree& other, __true_type_s){
+            __leaf_alloc() = simple_stl::move(other.__leaf_alloc());
+        }
+
+        void __move_assign_alloc(btree&, __false_type_s) {}
+
+        void __swap_alloc(btree& other, __true_type_s){
+            simple_stl::swap(__leaf_alloc(), other.__leaf_alloc());
+        }
+
+        void __swap_alloc(btree&, __false_type_s) {}
+    };
+
+}   // simple_stl
+
+#endif //SIMPLESTL_STL_BTREE_H
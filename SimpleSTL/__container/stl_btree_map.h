@@ -0,0 +1,257 @@
+/**
+ * Created by 史进 on 2023/6/19.
+ *
+ * btree_map：以 btree 为底层的有序映射，元素为 pair<const Key, T>，接口与 map 一致（没有节点句柄）
+ *  - 节点中存放 pair<Key, T>，以 pair<const Key, T> 的引用交给使用者，节点分裂、合并时移动键而不拷贝
+ *  - 每个节点连续存放多个元素，整数键时每个元素的内存开销只有红黑树的几分之一，查找经过的缓存行也少得多
+ *  - 插入、删除使所有迭代器失效，这一点与 map 不同
+ *  - 由 sorted_unique 标记的有序区间构造时逐个追加到最右叶子，每次 O(1) 均摊
+ */
+#ifndef SIMPLESTL_STL_BTREE_MAP_H
+#define SIMPLESTL_STL_BTREE_MAP_H
+
+#include <initializer_list>
+#include <stdexcept>
+
+#include "stl_btree.h"
+#include "../__functional/stl_function.h"
+
+namespace simple_stl{
+
+    template<class Key, class T, class Compare = less<Key>, class Alloc = allocator<pair<const Key, T> > >
+    class btree_map{
+    public:
+        typedef Key                     key_type;
+        typedef T                       mapped_type;
+        typedef pair<const Key, T>      value_type;
+        typedef Compare                 key_compare;
+        typedef Alloc                   allocator_type;
+
+        // 以键比较两个元素
+        class value_compare{
+            friend class btree_map;
+        protected:
+            Compare comp_;
+            explicit value_compare(const Compare& c) : comp_(c) {}
+        public:
+            bool operator()(const value_type& x, const value_type& y) const{
+                return comp_(x.first, y.first);
+            }
+        };
+
+    private:
+        typedef pair<Key, T>    slot_type;
+        typedef btree<key_type, value_type, slot_type, __select1st_any, key_compare, Alloc> rep_type;
+        rep_type tree_;
+
+    public:
+        typedef typename rep_type::size_type            size_type;
+        typedef typename rep_type::difference_type      difference_type;
+        typedef typename rep_type::reference            reference;
+        typedef typename rep_type::const_reference      const_reference;
+        typedef typename rep_type::pointer              pointer;
+        typedef typename rep_type::const_pointer        const_pointer;
+        typedef typename rep_type::iterator             iterator;
+        typedef typename rep_type::const_iterator       const_iterator;
+
+        /** 构造 */
+        btree_map() : tree_() {}
+
+        explicit btree_map(const Compare& comp, const Alloc& a = Alloc()) : tree_(comp, a) {}
+
+        explicit btree_map(const Alloc& a) : tree_(Compare(), a) {}
+
+        template<class InputIterator, typename enable_if<
+                is_input_iterator<InputIterator>::value, int>::type = 0>
+        btree_map(InputIterator first, InputIterator last, const Compare& comp = Compare(), const Alloc& a = Alloc())
+        : tree_(comp, a){
+            tree_.insert_range_unique(first, last);
+        }
+
+        // 区间已按键排好序且键互不相同
+        template<class InputIterator, typename enable_if<
+                is_input_iterator<InputIterator>::value, int>::type = 0>
+        btree_map(sorted_unique_t, InputIterator first, InputIterator last,
+            const Compare& comp = Compare(), const Alloc& a = Alloc())
+        : tree_(comp, a){
+            tree_.insert_range_unique(first, last);
+        }
+
+        btree_map(std::initializer_list<value_type> il, const Compare& comp = Compare(), const Alloc& a = Alloc())
+        : tree_(comp, a){
+            tree_.insert_range_unique(il.begin(), il.end());
+        }
+
+        btree_map(sorted_unique_t, std::initializer_list<value_type> il,
+            const Compare& comp = Compare(), const Alloc& a = Alloc())
+        : tree_(comp, a){
+            tree_.insert_range_unique(il.begin(), il.end());
+        }
+
+        btree_map(const btree_map& other) : tree_(other.tree_) {}
+        btree_map(const btree_map& other, const Alloc& a) : tree_(other.tree_, a) {}
+        btree_map(btree_map&& other) noexcept : tree_(simple_stl::move(other.tree_)) {}
+
+        /** 赋值 */
+        btree_map& operator=(const btree_map& other){
+            tree_ = other.tree_;
+            return *this;
+        }
+
+        btree_map& operator=(btree_map&& other) noexcept(noexcept(tree_ = simple_stl::move(other.tree_))){
+            tree_ = simple_stl::move(other.tree_);
+            return *this;
+        }
+
+        btree_map& operator=(std::initializer_list<value_type> il){
+            tree_.clear();
+            tree_.insert_range_unique(il.begin(), il.end());
+            return *this;
+        }
+
+        allocator_type get_allocator() const { return tree_.get_allocator(); }
+        key_compare key_comp() const { return tree_.key_comp(); }
+        value_compare value_comp() const { return value_compare(tree_.key_comp()); }
+
+        /** 迭代器 */
+        iterator begin() noexcept { return tree_.begin(); }
+        const_iterator begin() const noexcept { return tree_.begin(); }
+        const_iterator cbegin() const noexcept { return tree_.begin(); }
+        iterator end() noexcept { return tree_.end(); }
+        const_iterator end() const noexcept { return tree_.end(); }
+        const_iterator cend() const noexcept { return tree_.end(); }
+
+        /** 容量 */
+        bool empty() const noexcept { return tree_.empty(); }
+        size_type size() const noexcept { return tree_.size(); }
+        size_type max_size() const noexcept { return tree_.max_size(); }
+        static constexpr size_type node_values() noexcept { return rep_type::node_values(); }
+
+        /** 元素访问 */
+        // 键不存在时插入值初始化的元素
+        mapped_type& operator[](const key_type& k){
+            return try_emplace(k).first->second;
+        }
+
+        mapped_type& operator[](key_type&& k){
+            return try_emplace(simple_stl::move(k)).first->second;
+        }
+
+        mapped_type& at(const key_type& k){
+            iterator it = find(k);
+            if (it == end())
+                throw std::out_of_range("btree_map::at");
+            return it->second;
+        }
+
+        const mapped_type& at(const key_type& k) const{
+            const_iterator it = find(k);
+            if (it == end())
+                throw std::out_of_range("btree_map::at");
+            return it->second;
+        }
+
+        /** 修改 */
+        pair<iterator, bool> insert(const value_type& v) { return tree_.insert_unique(v); }
+        pair<iterator, bool> insert(value_type&& v) { return tree_.insert_unique(simple_stl::move(v)); }
+
+        template<class P, typename enable_if<
+                std::is_constructible<value_type, P&&>::value, int>::type = 0>
+        pair<iterator, bool> insert(P&& p) { return tree_.emplace_unique(simple_stl::forward<P>(p)); }
+
+        iterator insert(const_iterator hint, const value_type& v) { return tree_.insert_hint_unique(hint, v); }
+        iterator insert(const_iterator hint, value_type&& v) { return tree_.insert_hint_unique(hint, simple_stl::move(v)); }
+
+        template<class P, typename enable_if<
+                std::is_constructible<value_type, P&&>::value, int>::type = 0>
+        iterator insert(const_iterator hint, P&& p){
+            return tree_.emplace_hint_unique(hint, simple_stl::forward<P>(p));
+        }
+
+        template<class InputIterator, typename enable_if<
+                is_input_iterator<InputIterator>::value, int>::type = 0>
+        void insert(InputIterator first, InputIterator last) { tree_.insert_range_unique(first, last); }
+
+        void insert(std::initializer_list<value_type> il) { tree_.insert_range_unique(il.begin(), il.end()); }
+
+        template<class... Args>
+        pair<iterator, bool> emplace(Args&&... args){
+            return tree_.emplace_unique(simple_stl::forward<Args>(args)...);
+        }
+
+        template<class... Args>
+        iterator emplace_hint(const_iterator hint, Args&&... args){
+            return tree_.emplace_hint_unique(hint, simple_stl::forward<Args>(args)...);
+        }
+
+        // 键不存在时才构造元素，键存在时 args 不被移动
+        template<class... Args>
+        pair<iterator, bool> try_emplace(const key_type& k, Args&&... args){
+            return tree_.emplace_key_with(k, [&](slot_type* p){
+                simple_stl::construct(p, k, mapped_type(simple_stl::forward<Args>(args)...));
+            });
+        }
+
+        template<class... Args>
+        pair<iterator, bool> try_emplace(key_type&& k, Args&&... args){
+            return tree_.emplace_key_with(k, [&](slot_type* p){
+                simple_stl::construct(p, simple_stl::move(k), mapped_type(simple_stl::forward<Args>(args)...));
+            });
+        }
+
+        template<class M>
+        pair<iterator, bool> insert_or_assign(const key_type& k, M&& obj){
+            pair<iterator, bool> r = tree_.emplace_key_with(k, [&](slot_type* p){
+                simple_stl::construct(p, k, simple_stl::forward<M>(obj));
+            });
+            if (!r.second)
+                r.first->second = simple_stl::forward<M>(obj);
+            return r;
+        }
+
+        iterator erase(const_iterator pos) { return tree_.erase(pos); }
+        iterator erase(iterator pos) { return tree_.erase(pos); }
+        iterator erase(const_iterator first, const_iterator last) { return tree_.erase(first, last); }
+        size_type erase(const key_type& k) { return tree_.erase(k); }
+
+        void clear() noexcept { tree_.clear(); }
+        void swap(btree_map& other) noexcept { tree_.swap(other.tree_); }
+
+        /** 查找 */
+        iterator find(const key_type& k) { return tree_.find(k); }
+        const_iterator find(const key_type& k) const { return tree_.find(k); }
+        size_type count(const key_type& k) const { return tree_.contains(k) ? 1 : 0; }
+        bool contains(const key_type& k) const { return tree_.contains(k); }
+
+        iterator lower_bound(const key_type& k) { return tree_.lower_bound(k); }
+        const_iterator lower_bound(const key_type& k) const { return tree_.lower_bound(k); }
+        iterator upper_bound(const key_type& k) { return tree_.upper_bound(k); }
+        const_iterator upper_bound(const key_type& k) const { return tree_.upper_bound(k); }
+        pair<iterator, iterator> equal_range(const key_type& k) { return tree_.equal_range(k); }
+        pair<const_iterator, const_iterator> equal_range(const key_type& k) const { return tree_.equal_range(k); }
+    };
+
+
+    template<class Key, class T, class Compare, class Alloc>
+    inline bool operator==(const btree_map<Key, T, Compare, Alloc>& x, const btree_map<Key, T, Compare, Alloc>& y){
+        if (x.size() != y.size())
+            return false;
+        for (typename btree_map<Key, T, Compare, Alloc>::const_iterator i = x.begin(), j = y.begin(); i != x.end(); ++i, ++j)
+            if (!(*i == *j))
+                return false;
+        return true;
+    }
+
+    template<class Key, class T, class Compare, class Alloc>
+    inline bool operator!=(const btree_map<Key, T, Compare, Alloc>& x, const btree_map<Key, T, Compare, Alloc>& y){
+        return !(x == y);
+    }
+
+    template<class Key, class T, class Compare, class Alloc>
+    inline void swap(btree_map<Key, T, Compare, Alloc>& x, btree_map<Key, T, Compare, Alloc>& y) noexcept{
+        x.swap(y);
+    }
+
+}   // simple_stl
+
+#endif //SIMPLESTL_STL_BTREE_MAP_H
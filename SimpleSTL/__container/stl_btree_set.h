@@ -0,0 +1,182 @@
+/**
+ * Created by 史进 on 2023/6/19.
+ *
+ * btree_set：以 btree 为底层的有序集合，接口与 set 一致（没有节点句柄）。
+ * 元素不可修改，iterator 与 const_iterator 相同；插入、删除使所有迭代器失效
+ */
+#ifndef SIMPLESTL_STL_BTREE_SET_H
+#define SIMPLESTL_STL_BTREE_SET_H
+
+#include <initializer_list>
+
+#include "stl_btree.h"
+#include "../__functional/stl_function.h"
+
+namespace simple_stl{
+
+    template<class Key, class Compare = less<Key>, class Alloc = allocator<Key> >
+    class btree_set{
+    public:
+        typedef Key         key_type;
+        typedef Key         value_type;
+        typedef Compare     key_compare;
+        typedef Compare     value_compare;
+        typedef Alloc       allocator_type;
+
+    private:
+        typedef btree<key_type, value_type, value_type, identity<value_type>, key_compare, Alloc> rep_type;
+        rep_type tree_;
+
+    public:
+        typedef typename rep_type::size_type            size_type;
+        typedef typename rep_type::difference_type      difference_type;
+        typedef typename rep_type::const_reference      reference;
+        typedef typename rep_type::const_reference      const_reference;
+        typedef typename rep_type::const_pointer        pointer;
+        typedef typename rep_type::const_pointer        const_pointer;
+        typedef typename rep_type::const_iterator       iterator;
+        typedef typename rep_type::const_iterator       const_iterator;
+
+        /** 构造 */
+        btree_set() : tree_() {}
+
+        explicit btree_set(const Compare& comp, const Alloc& a = Alloc()) : tree_(comp, a) {}
+
+        explicit btree_set(const Alloc& a) : tree_(Compare(), a) {}
+
+        template<class InputIterator, typename enable_if<
+                is_input_iterator<InputIterator>::value, int>::type = 0>
+        btree_set(InputIterator first, InputIterator last, const Compare& comp = Compare(), const Alloc& a = Alloc())
+        : tree_(comp, a){
+            tree_.insert_range_unique(first, last);
+        }
+
+        // 区间已排好序且元素互不相同
+        template<class InputIterator, typename enable_if<
+                is_input_iterator<InputIterator>::value, int>::type = 0>
+        btree_set(sorted_unique_t, InputIterator first, InputIterator last,
+            const Compare& comp = Compare(), const Alloc& a = Alloc())
+        : tree_(comp, a){
+            tree_.insert_range_unique(first, last);
+        }
+
+        btree_set(std::initializer_list<value_type> il, const Compare& comp = Compare(), const Alloc& a = Alloc())
+        : tree_(comp, a){
+            tree_.insert_range_unique(il.begin(), il.end());
+        }
+
+        btree_set(sorted_unique_t, std::initializer_list<value_type> il,
+            const Compare& comp = Compare(), const Alloc& a = Alloc())
+        : tree_(comp, a){
+            tree_.insert_range_unique(il.begin(), il.end());
+        }
+
+        btree_set(const btree_set& other) : tree_(other.tree_) {}
+        btree_set(const btree_set& other, const Alloc& a) : tree_(other.tree_, a) {}
+        btree_set(btree_set&& other) noexcept : tree_(simple_stl::move(other.tree_)) {}
+
+        /** 赋值 */
+        btree_set& operator=(const btree_set& other){
+            tree_ = other.tree_;
+            return *this;
+        }
+
+        btree_set& operator=(btree_set&& other) noexcept(noexcept(tree_ = simple_stl::move(other.tree_))){
+            tree_ = simple_stl::move(other.tree_);
+            return *this;
+        }
+
+        btree_set& operator=(std::initializer_list<value_type> il){
+            tree_.clear();
+            tree_.insert_range_unique(il.begin(), il.end());
+            return *this;
+        }
+
+        allocator_type get_allocator() const { return tree_.get_allocator(); }
+        key_compare key_comp() const { return tree_.key_comp(); }
+        value_compare value_comp() const { return tree_.key_comp(); }
+
+        /** 迭代器 */
+        iterator begin() const noexcept { return tree_.begin(); }
+        iterator cbegin() const noexcept { return tree_.begin(); }
+        iterator end() const noexcept { return tree_.end(); }
+        iterator cend() const noexcept { return tree_.end(); }
+
+        /** 容量 */
+        bool empty() const noexcept { return tree_.empty(); }
+        size_type size() const noexcept { return tree_.size(); }
+        size_type max_size() const noexcept { return tree_.max_size(); }
+        static constexpr size_type node_values() noexcept { return rep_type::node_values(); }
+
+        /** 修改 */
+        pair<iterator, bool> insert(const value_type& v){
+            pair<typename rep_type::iterator, bool> p = tree_.insert_unique(v);
+            return pair<iterator, bool>(p.first, p.second);
+        }
+
+        pair<iterator, bool> insert(value_type&& v){
+            pair<typename rep_type::iterator, bool> p = tree_.insert_unique(simple_stl::move(v));
+            return pair<iterator, bool>(p.first, p.second);
+        }
+
+        iterator insert(const_iterator hint, const value_type& v) { return tree_.insert_hint_unique(hint, v); }
+        iterator insert(const_iterator hint, value_type&& v) { return tree_.insert_hint_unique(hint, simple_stl::move(v)); }
+
+        template<class InputIterator, typename enable_if<
+                is_input_iterator<InputIterator>::value, int>::type = 0>
+        void insert(InputIterator first, InputIterator last) { tree_.insert_range_unique(first, last); }
+
+        void insert(std::initializer_list<value_type> il) { tree_.insert_range_unique(il.begin(), il.end()); }
+
+        template<class... Args>
+        pair<iterator, bool> emplace(Args&&... args){
+            pair<typename rep_type::iterator, bool> p = tree_.emplace_unique(simple_stl::forward<Args>(args)...);
+            return pair<iterator, bool>(p.first, p.second);
+        }
+
+        template<class... Args>
+        iterator emplace_hint(const_iterator hint, Args&&... args){
+            return tree_.emplace_hint_unique(hint, simple_stl::forward<Args>(args)...);
+        }
+
+        iterator erase(const_iterator pos) { return tree_.erase(pos); }
+        iterator erase(const_iterator first, const_iterator last) { return tree_.erase(first, last); }
+        size_type erase(const key_type& k) { return tree_.erase(k); }
+
+        void clear() noexcept { tree_.clear(); }
+        void swap(btree_set& other) noexcept { tree_.swap(other.tree_); }
+
+        /** 查找 */
+        iterator find(const key_type& k) const { return tree_.find(k); }
+        size_type count(const key_type& k) const { return tree_.contains(k) ? 1 : 0; }
+        bool contains(const key_type& k) const { return tree_.contains(k); }
+
+        iterator lower_bound(const key_type& k) const { return tree_.lower_bound(k); }
+        iterator upper_bound(const key_type& k) const { return tree_.upper_bound(k); }
+        pair<iterator, iterator> equal_range(const key_type& k) const { return tree_.equal_range(k); }
+    };
+
+
+    template<class Key, class Compare, class Alloc>
+    inline bool operator==(const btree_set<Key, Compare, Alloc>& x, const btree_set<Key, Compare, Alloc>& y){
+        if (x.size() != y.size())
+            return false;
+        for (typename btree_set<Key, Compare, Alloc>::const_iterator i = x.begin(), j = y.begin(); i != x.end(); ++i, ++j)
+            if (!(*i == *j))
+                return false;
+        return true;
+    }
+
+    template<class Key, class Compare, class Alloc>
+    inline bool operator!=(const btree_set<Key, Compare, Alloc>& x, const btree_set<Key, Compare, Alloc>& y){
+        return !(x == y);
+    }
+
+    template<class Key, class Compare, class Alloc>
+    inline void swap(btree_set<Key, Compare, Alloc>& x, btree_set<Key, Compare, Alloc>& y) noexcept{
+        x.swap(y);
+    }
+
+}   // simple_stl
+
+#endif //SIMPLESTL_STL_BTREE_SET_H
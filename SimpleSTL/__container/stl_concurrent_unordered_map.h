@@ -0,0 +1,486 @@
+/**
+ * Created by 史进 on 2023/6/24.
+ *
+ * concurrent_unordered_map：读取不加锁、写入按分片加锁的并发哈希表
+ *  - 键按哈希值的高位分到 2 的幂个分片，每个分片有自己的互斥量与开链桶数组，桶数为 2 的幂，以低位选桶；
+ *    分片之间填充缓存行，不同分片的写者互不争用
+ *  - 节点发布后不再修改元素：insert_or_assign 配置新节点替换旧节点，读者看到的要么是旧值要么是新值。
+ *    写者在分片锁内修改链表，以 release 写入指针；读者以 acquire 沿链表查找，不加锁、不写共享数据
+ *  - 摘除的节点与旧桶数组先挂到分片的回收列表，经 __epoch_guard（stl_epoch.h）确认没有读者可能
+ *    再访问后才释放；回收列表较长时，写者顺带推进纪元并释放可以释放的部分
+ *  - 扩容在分片锁内把节点重新链入新桶数组，不复制元素。扩容期间分片的 version_ 为奇数，
+ *    读者在旧链表上找到即可返回；没找到时若 version_ 为奇数或已变化，说明可能被迁移打断，重新查找
+ *  - 读取接口不返回引用：find 拷贝出值，visit 在保护作用域内以 const value_type& 调用函数；
+ *    for_each 逐个分片加锁遍历。size 只是近似值
+ */
+#ifndef SIMPLESTL_STL_CONCURRENT_UNORDERED_MAP_H
+#define SIMPLESTL_STL_CONCURRENT_UNORDERED_MAP_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+#include "stl_vector.h"
+#include "../type_traits.h"
+#include "../utility.h"
+#include "../__functional/stl_function.h"
+#include "../__functional/stl_hash.h"
+#include "../__memory/stl_allocator.h"
+#include "../__memory/stl_allocator_traits.h"
+#include "../__memory/stl_construct.h"
+#include "../__memory/stl_epoch.h"
+
+namespace simple_stl{
+
+    template<class Key, class T, class Hash = hash<Key>, class KeyEqual = equal_to<Key>,
+             class Alloc = allocator<pair<const Key, T> > >
+    class concurrent_unordered_map{
+    public:
+        typedef Key                 key_type;
+        typedef T                   mapped_type;
+        typedef pair<const Key, T>  value_type;
+        typedef Hash                hasher;
+        typedef KeyEqual            key_equal;
+        typedef Alloc               allocator_type;
+        typedef size_t              size_type;
+
+        enum {default_shard_count = 64};
+
+    private:
+        struct __node{
+            std::atomic<__node*> next_;
+            size_t hash_;
+            value_type value_;
+        };
+
+        struct __table{
+            std::atomic<__node*>* heads_;
+            size_type mask_;
+        };
+
+        // 待回收的对象：单个节点、桶数组、桶数组连同其中全部节点（clear 换下的）
+        enum __retired_kind {__retired_node, __retired_table, __retired_table_nodes};
+
+        struct __retired{
+            void* ptr_;
+            uint64_t epoch_;        // 摘除时的纪元
+            __retired_kind kind_;
+        };
+
+        typedef typename allocator_traits<Alloc>::template rebind_alloc<__node>                 node_allocator;
+        typedef allocator_traits<node_allocator>                                                node_traits;
+        typedef typename allocator_traits<Alloc>::template rebind_alloc<__table>                table_allocator;
+        typedef allocator_traits<table_allocator>                                               table_traits;
+        typedef typename allocator_traits<Alloc>::template rebind_alloc<std::atomic<__node*> >  head_allocator;
+        typedef allocator_traits<head_allocator>                                                head_traits;
+        typedef typename allocator_traits<Alloc>::template rebind_alloc<__retired>              retired_allocator;
+
+        struct __shard{
+            std::mutex mutex_;
+            std::atomic<__table*> table_;
+            std::atomic<size_type> version_;    // 扩容期间为奇数
+            std::atomic<size_type> size_;
+            vector<__retired, retired_allocator> retired_;
+            char padding_[__cache_line_size];
+
+            explicit __shard(const retired_allocator& a) : table_(nullptr), version_(0), size_(0), retired_(a) {}
+        };
+
+        typedef typename allocator_traits<Alloc>::template rebind_alloc<__shard>    shard_allocator;
+        typedef allocator_traits<shard_allocator>                                   shard_traits;
+
+        enum {__min_buckets = 8, __max_shards = 1 << 16, __reclaim_threshold = 64};
+
+        struct __map_impl : public node_allocator{
+            Hash hash_;
+            KeyEqual eq_;
+            __shard* shards_;
+            size_type shard_mask_;
+
+            __map_impl(const Hash& h, const KeyEqual& eq, const Alloc& a)
+            : node_allocator(a), hash_(h), eq_(eq), shards_(nullptr), shard_mask_(0) {}
+        };
+
+        __map_impl impl_;
+
+    public:
+        explicit concurrent_unordered_map(size_type shard_count = default_shard_count, const Hash& hf = Hash(),
+                                          const KeyEqual& eq = KeyEqual(), const Alloc& a = Alloc())
+        : impl_(hf, eq, a){
+            size_type n = 1;
+            while (n < shard_count && n < size_type(__max_shards))
+                n <<= 1;
+            shard_allocator sa(impl_);
+            impl_.shards_ = shard_traits::allocate(sa, n);
+            size_type i = 0;
+            try {
+                for ( ; i < n; ++i){
+                    __table* t = __allocate_table(__min_buckets);
+                    simple_stl::construct(impl_.shards_ + i, retired_allocator(impl_));
+                    impl_.shards_[i].table_.store(t, std::memory_order_relaxed);
+                }
+            }catch(...){
+                __destroy_shards(i);
+                shard_traits::deallocate(sa, impl_.shards_, n);
+                throw;
+            }
+            impl_.shard_mask_ = n - 1;
+        }
+
+        concurrent_unordered_map(const concurrent_unordered_map&) = delete;
+        concurrent_unordered_map& operator=(const concurrent_unordered_map&) = delete;
+
+        // 析构时不能有其他线程访问
+        ~concurrent_unordered_map(){
+            __destroy_shards(shard_count());
+            shard_allocator sa(impl_);
+            shard_traits::deallocate(sa, impl_.shards_, shard_count());
+        }
+
+        allocator_type get_allocator() const { return allocator_type(impl_); }
+        hasher hash_function() const { return impl_.hash_; }
+        key_equal key_eq() const { return impl_.eq_; }
+
+        size_type shard_count() const noexcept { return impl_.shard_mask_ + 1; }
+
+        // 各分片元素个数之和，并发修改时只是近似值
+        size_type size() const noexcept{
+            size_type n = 0;
+            for (size_type i = 0; i < shard_count(); ++i)
+                n += impl_.shards_[i].size_.load(std::memory_order_relaxed);
+            return n;
+        }
+
+        bool empty() const noexcept { return size() == 0; }
+
+        /** 读取，不加锁 */
+        // 找到时把值拷贝到 value
+        bool find(const key_type& k, mapped_type& value) const{
+            const size_t h = __hash(k);
+            __epoch_guard guard;
+            const __node* p = __find_node(k, h);
+            if (p == nullptr)
+                return false;
+            value = p->value_.second;
+            return true;
+        }
+
+        // 找到时以 const value_type& 调用 f，返回是否找到；f 执行期间会推迟回收，不宜耗时过长
+        template<class Function>
+        bool visit(const key_type& k, Function f) const{
+            const size_t h = __hash(k);
+            __epoch_guard guard;
+            const __node* p = __find_node(k, h);
+            if (p == nullptr)
+                return false;
+            f(p->value_);
+            return true;
+        }
+
+        bool contains(const key_type& k) const{
+            const size_t h = __hash(k);
+            __epoch_guard guard;
+            return __find_node(k, h) != nullptr;
+        }
+
+        size_type count(const key_type& k) const { return contains(k) ? 1 : 0; }
+
+        // 逐个分片加锁，以 const value_type& 调用 f；同一分片的写者在此期间等待
+        template<class Function>
+        void for_each(Function f) const{
+            for (size_type i = 0; i < shard_count(); ++i){
+                __shard& s = impl_.shards_[i];
+                std::lock_guard<std::mutex> lock(s.mutex_);
+                const __table* t = s.table_.load(std::memory_order_relaxed);
+                for (size_type b = 0; b <= t->mask_; ++b)
+                    for (const __node* p = t->heads_[b].load(std::memory_order_relaxed); p != nullptr;
+                         p = p->next_.load(std::memory_order_relaxed))
+                        f(p->value_);
+            }
+        }
+
+        /** 修改，锁住键所在的分片 */
+        // 键不存在时插入，返回是否插入
+        template<class... Args>
+        bool emplace(Args&&... args){
+            __node* z = __create_node(simple_stl::forward<Args>(args)...);
+            bool inserted;
+            try {
+                z->hash_ = __hash(z->value_.first);
+                inserted = __insert_unique(z);
+            }catch(...){
+                __destroy_node(z);
+                throw;
+            }
+            if (!inserted)
+                __destroy_node(z);
+            return inserted;
+        }
+
+        bool insert(const value_type& value) { return emplace(value); }
+
+        bool insert(value_type&& value) { return emplace(simple_stl::move(value)); }
+
+        // 键存在时以新节点替换，返回是否为新插入
+        template<class M>
+        bool insert_or_assign(const key_type& k, M&& obj){
+            __node* z = __create_node(k, simple_stl::forward<M>(obj));
+            try {
+                z->hash_ = __hash(k);
+                __shard& s = __shard_of(z->hash_);
+                std::lock_guard<std::mutex> lock(s.mutex_);
+                __table* t = s.table_.load(std::memory_order_relaxed);
+                std::atomic<__node*>* link = __find_link(t, k, z->hash_);
+                if (link == nullptr){
+                    __link_new(s, t, z);
+                    return true;
+                }
+                __reserve_retired(s);
+                __node* old = link->load(std::memory_order_relaxed);
+                z->next_.store(old->next_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+                link->store(z, std::memory_order_release);
+                __retire(s, old, __retired_node);
+                return false;
+            }catch(...){
+                __destroy_node(z);
+                throw;
+            }
+        }
+
+        size_type erase(const key_type& k){
+            const size_t h = __hash(k);
+            __shard& s = __shard_of(h);
+            std::lock_guard<std::mutex> lock(s.mutex_);
+            std::atomic<__node*>* link = __find_link(s.table_.load(std::memory_order_relaxed), k, h);
+            if (link == nullptr)
+                return 0;
+            __reserve_retired(s);
+            __node* old = link->load(std::memory_order_relaxed);
+            link->store(old->next_.load(std::memory_order_relaxed), std::memory_order_release);
+            s.size_.store(s.size_.load(std::memory_order_relaxed) - 1, std::memory_order_relaxed);
+            __retire(s, old, __retired_node);
+            return 1;
+        }
+
+        // 每个分片换上新的空桶数组，旧数组连同节点整体延迟释放
+        void clear(){
+            for (size_type i = 0; i < shard_count(); ++i){
+                __shard& s = impl_.shards_[i];
+                std::lock_guard<std::mutex> lock(s.mutex_);
+                if (s.size_.load(std::memory_order_relaxed) == 0)
+                    continue;
+                __table* fresh = __allocate_table(__min_buckets);
+                try {
+                    __reserve_retired(s);
+                }catch(...){
+                    __deallocate_table(fresh);
+                    throw;
+                }
+                __table* old = s.table_.load(std::memory_order_relaxed);
+                s.table_.store(fresh, std::memory_order_release);
+                s.size_.store(0, std::memory_order_relaxed);
+                __retire(s, old, __retired_table_nodes);
+            }
+        }
+
+    private:
+        size_t __hash(const key_type& k) const{
+            return simple_stl::__hash_finish(impl_.hash_(k), __hash_is_avalanching<Hash>());
+        }
+
+        // 分片用高 16 位以内的位，桶用低位，两者互不相关
+        __shard& __shard_of(size_t h) const noexcept{
+            return impl_.shards_[(h >> (sizeof(size_t) * 8 - 16)) & impl_.shard_mask_];
+        }
+
+        // 读者查找，须在 __epoch_guard 作用域内调用
+        const __node* __find_node(const key_type& k, size_t h) const{
+            const __shard& s = __shard_of(h);
+            for (;;){
+                const size_type v = s.version_.load(std::memory_order_acquire);
+                const __table* t = s.table_.load(std::memory_order_acquire);
+                for (const __node* p = t->heads_[h & t->mask_].load(std::memory_order_acquire); p != nullptr;
+                     p = p->next_.load(std::memory_order_acquire))
+                    if (p->hash_ == h && impl_.eq_(p->value_.first, k))
+                        return p;
+                // 期间没有扩容，才能断定不存在
+                if ((v & 1) == 0 && s.version_.load(std::memory_order_acquire) == v)
+                    return nullptr;
+                simple_stl::__cpu_relax();
+            }
+        }
+
+        // 写者查找（持有分片锁），返回指向匹配节点的链接，不存在时返回空指针
+        std::atomic<__node*>* __find_link(__table* t, const key_type& k, size_t h) const{
+            std::atomic<__node*>* link = t->heads_ + (h & t->mask_);
+            for (__node* p = link->load(std::memory_order_relaxed); p != nullptr; p = link->load(std::memory_order_relaxed)){
+                if (p->hash_ == h && impl_.eq_(p->value_.first, k))
+                    return link;
+                link = &p->next_;
+            }
+            return nullptr;
+        }
+
+        bool __insert_unique(__node* z){
+            __shard& s = __shard_of(z->hash_);
+            std::lock_guard<std::mutex> lock(s.mutex_);
+            __table* t = s.table_.load(std::memory_order_relaxed);
+            if (__find_link(t, z->value_.first, z->hash_) != nullptr)
+                return false;
+            __link_new(s, t, z);
+            return true;
+        }
+
+        // 持有分片锁，z 的键不存在；需要扩容时先扩容，失败则不做任何修改
+        void __link_new(__shard& s, __table* t, __node* z){
+            const size_type n = s.size_.load(std::memory_order_relaxed) + 1;
+            if (n > t->mask_ + 1)
+                t = __rehash(s, t);
+            std::atomic<__node*>& head = t->heads_[z->hash_ & t->mask_];
+            z->next_.store(head.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            head.store(z, std::memory_order_release);
+            s.size_.store(n, std::memory_order_relaxed);
+        }
+
+        // 桶数加倍，节点逐个重新链入新数组；新数组发布前 version_ 保持奇数
+        __table* __rehash(__shard& s, __table* old){
+            __table* t = __allocate_table((old->mask_ + 1) * 2);
+            try {
+                __reserve_retired(s);
+            }catch(...){
+                __deallocate_table(t);
+                throw;
+            }
+            const size_type v = s.version_.load(std::memory_order_relaxed);
+            s.version_.store(v + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            for (size_type b = 0; b <= old->mask_; ++b){
+                __node* p = old->heads_[b].load(std::memory_order_relaxed);
+                while (p != nullptr){
+                    __node* next = p->next_.load(std::memory_order_relaxed);
+                    std::atomic<__node*>& head = t->heads_[p->hash_ & t->mask_];
+                    p->next_.store(head.load(std::memory_order_relaxed), std::memory_order_release);
+                    head.store(p, std::memory_order_relaxed);
+                    p = next;
+                }
+            }
+            s.table_.store(t, std::memory_order_release);
+            s.version_.store(v + 2, std::memory_order_release);
+            __retire(s, old, __retired_table);
+            return t;
+        }
+
+        // 摘除之前保证回收列表有空位，摘除之后不再有可能失败的操作
+        void __reserve_retired(__shard& s){
+            if (s.retired_.size() == s.retired_.capacity())
+                s.retired_.reserve(s.retired_.capacity() < __reclaim_threshold ? size_type(__reclaim_threshold) * 2
+                                                                                 : s.retired_.capacity() * 2);
+        }
+
+        void __retire(__shard& s, void* p, __retired_kind kind) noexcept{
+            __retired r;
+            r.ptr_ = p;
+            r.epoch_ = __epoch_domain::instance().retire_epoch();
+            r.kind_ = kind;
+            s.retired_.push_back(r);
+            if (s.retired_.size() >= __reclaim_threshold)
+                __reclaim(s);
+        }
+
+        // 列表按摘除顺序排列，纪元不减，释放纪元已过两步的前缀
+        void __reclaim(__shard& s) noexcept{
+            const uint64_t e = __epoch_domain::instance().try_advance();
+            size_type k = 0;
+            while (k < s.retired_.size() && s.retired_[k].epoch_ + 2 <= e)
+                __free_retired(s.retired_[k++]);
+            if (k != 0)
+                s.retired_.erase(s.retired_.begin(), s.retired_.begin() + k);
+        }
+
+        void __free_retired(const __retired& r) noexcept{
+            switch (r.kind_){
+                case __retired_node:
+                    __destroy_node(static_cast<__node*>(r.ptr_));
+                    break;
+                case __retired_table_nodes:
+                    __destroy_nodes(static_cast<__table*>(r.ptr_));
+                    __deallocate_table(static_cast<__table*>(r.ptr_));
+                    break;
+                default:
+                    __deallocate_table(static_cast<__table*>(r.ptr_));
+                    break;
+            }
+        }
+
+        template<class... Args>
+        __node* __create_node(Args&&... args){
+            __node* p = node_traits::allocate(impl_, 1);
+            try {
+                simple_stl::construct(&p->value_, simple_stl::forward<Args>(args)...);
+            }catch(...){
+                node_traits::deallocate(impl_, p, 1);
+                throw;
+            }
+            simple_stl::construct(&p->next_, nullptr);
+            return p;
+        }
+
+        void __destroy_node(__node* p) noexcept{
+            simple_stl::destroy(&p->value_);
+            node_traits::deallocate(impl_, p, 1);
+        }
+
+        void __destroy_nodes(__table* t) noexcept{
+            for (size_type b = 0; b <= t->mask_; ++b){
+                __node* p = t->heads_[b].load(std::memory_order_relaxed);
+                while (p != nullptr){
+                    __node* next = p->next_.load(std::memory_order_relaxed);
+                    __destroy_node(p);
+                    p = next;
+                }
+            }
+        }
+
+        __table* __allocate_table(size_type count){
+            table_allocator ta(impl_);
+            head_allocator ha(impl_);
+            __table* t = table_traits::allocate(ta, 1);
+            try {
+                t->heads_ = head_traits::allocate(ha, count);
+            }catch(...){
+                table_traits::deallocate(ta, t, 1);
+                throw;
+            }
+            for (size_type b = 0; b < count; ++b)
+                simple_stl::construct(t->heads_ + b, nullptr);
+            t->mask_ = count - 1;
+            return t;
+        }
+
+        void __deallocate_table(__table* t) noexcept{
+            table_allocator ta(impl_);
+            head_allocator ha(impl_);
+            head_traits::deallocate(ha, t->heads_, t->mask_ + 1);
+            table_traits::deallocate(ta, t, 1);
+        }
+
+        // 释放前 n 个分片的全部节点、桶数组与回收列表，此时没有读者
+        void __destroy_shards(size_type n) noexcept{
+            for (size_type i = 0; i < n; ++i){
+                __shard& s = impl_.shards_[i];
+                for (size_type k = 0; k < s.retired_.size(); ++k)
+                    __free_retired(s.retired_[k]);
+                __table* t = s.table_.load(std::memory_order_relaxed);
+                if (t != nullptr){
+                    __destroy_nodes(t);
+                    __deallocate_table(t);
+                }
+                simple_stl::destroy(&s);
+            }
+        }
+    };
+
+}   // simple_stl
+
+#endif //SIMPLESTL_STL_CONCURRENT_UNORDERED_MAP_H
@@ -0,0 +1,1161 @@
+/**
+ * Created by 史进 on 2023/6/14.
+ *
+ * deque：分段连续的双端队列
+ *  - 由一块中控器（map）管理若干固定大小的缓冲区，两端插入、删除为常数时间，元素不会被搬移
+ *  - 迭代器声明为分段迭代器，uninitialized_* 与 destroy 据此逐个缓冲区处理
+ *  - 默认构造不配置任何内存，首次插入时才建立中控器
+ */
+#ifndef SIMPLESTL_STL_DEQUE_H
+#define SIMPLESTL_STL_DEQUE_H
+
+#include <cstddef>
+#include <cstring>
+#include <initializer_list>
+#include <stdexcept>
+
+#include "../iterator.h"
+#include "../type_traits.h"
+#include "../utility.h"
+#include "../__memory/stl_allocator.h"
+#include "../__memory/stl_allocator_traits.h"
+#include "../__memory/stl_construct.h"
+#include "../__memory/stl_uninitialized.h"
+#include "../__algorithm/stl_algobase.h"
+
+namespace simple_stl{
+
+    // 每个缓冲区的元素个数：元素不大于 512 字节时缓冲区为 512 字节，否则每个缓冲区只放一个元素
+    inline constexpr size_t __deque_buf_size(size_t size){
+        return size < 512 ? size_t(512 / size) : size_t(1);
+    }
+
+    template<class T, class Ref, class Ptr>
+    struct __deque_iterator{
+        typedef __deque_iterator<T, T&, T*>             iterator;
+        typedef __deque_iterator<T, const T&, const T*> const_iterator;
+        typedef __deque_iterator                        self;
+
+        typedef random_access_iterator_tag  iterator_category;
+        typedef T                           value_type;
+        typedef Ptr                         pointer;
+        typedef Ref                         reference;
+        typedef size_t                      size_type;
+        typedef ptrdiff_t                   difference_type;
+        typedef T**                         map_pointer;
+
+        // 分段迭代器：段为中控器的节点，段内为原生指针
+        typedef __true_type_s               is_segmented_iterator;
+        typedef map_pointer                 segment_iterator;
+        typedef Ptr                         local_iterator;
+
+        Ptr cur_;               // 当前元素
+        Ptr first_;             // 所在缓冲区的头
+        Ptr last_;              // 所在缓冲区的尾后
+        map_pointer node_;      // 所在缓冲区对应的中控器节点
+
+        static constexpr size_type buffer_size() { return __deque_buf_size(sizeof(T)); }
+
+        __deque_iterator() noexcept : cur_(nullptr), first_(nullptr), last_(nullptr), node_(nullptr) {}
+
+        __deque_iterator(Ptr cur, map_pointer node) noexcept
+        : cur_(cur), first_(*node), last_(*node + buffer_size()), node_(node) {}
+
+        // iterator 可转换为 const_iterator
+        __deque_iterator(const iterator& other) noexcept
+        : cur_(other.cur_), first_(other.first_), last_(other.last_), node_(other.node_) {}
+
+        __deque_iterator& operator=(const __deque_iterator&) = default;
+
+        // 跳到另一个缓冲区，cur_ 由调用者设置
+        void __set_node(map_pointer new_node) noexcept{
+            node_ = new_node;
+            first_ = *new_node;
+            last_ = first_ + difference_type(buffer_size());
+        }
+
+        reference operator*() const { return *cur_; }
+        pointer operator->() const { return cur_; }
+
+        self& operator++(){
+            if (++cur_ == last_){
+                __set_node(node_ + 1);
+                cur_ = first_;
+            }
+            return *this;
+        }
+
+        self operator++(int){
+            self tmp = *this;
+            ++*this;
+            return tmp;
+        }
+
+        self& operator--(){
+            if (cur_ == first_){
+                __set_node(node_ - 1);
+                cur_ = last_;
+            }
+            --cur_;
+            return *this;
+        }
+
+        self operator--(int){
+            self tmp = *this;
+            --*this;
+            return tmp;
+        }
+
+        // 目标仍在同一缓冲区时直接移动，否则先算出要跨越的节点数
+        self& operator+=(difference_type n){
+            const difference_type bs = difference_type(buffer_size());
+            const difference_type offset = n + (cur_ - first_);
+            if (offset >= 0 && offset < bs){
+                cur_ += n;
+            }else{
+                const difference_type node_offset = offset > 0 ? offset / bs : -((-offset - 1) / bs) - 1;
+                __set_node(node_ + node_offset);
+                cur_ = first_ + (offset - node_offset * bs);
+            }
+            return *this;
+        }
+
+        self operator+(difference_type n) const{
+            self tmp = *this;
+            return tmp += n;
+        }
+
+        self& operator-=(difference_type n) { return *this += -n; }
+
+        self operator-(difference_type n) const{
+            self tmp = *this;
+            return tmp -= n;
+        }
+
+        reference operator[](difference_type n) const { return *(*this + n); }
+
+        template<class R, class P>
+        difference_type operator-(const __deque_iterator<T, R, P>& x) const{
+            if (node_ == x.node_)
+                return cur_ - x.cur_;
+            return difference_type(buffer_size()) * (node_ - x.node_ - 1) + (cur_ - first_) + (x.last_ - x.cur_);
+        }
+
+        template<class R, class P>
+        bool operator==(const __deque_iterator<T, R, P>& x) const { return cur_ == x.cur_; }
+
+        template<class R, class P>
+        bool operator!=(const __deque_iterator<T, R, P>& x) const { return cur_ != x.cur_; }
+
+        template<class R, class P>
+        bool operator<(const __deque_iterator<T, R, P>& x) const{
+            return node_ == x.node_ ? cur_ < x.cur_ : node_ < x.node_;
+        }
+
+        template<class R, class P>
+        bool operator>(const __deque_iterator<T, R, P>& x) const { return x < *this; }
+
+        template<class R, class P>
+        bool operator<=(const __deque_iterator<T, R, P>& x) const { return !(x < *this); }
+
+        template<class R, class P>
+        bool operator>=(const __deque_iterator<T, R, P>& x) const { return !(*this < x); }
+
+        /** 供 segmented_iterator_traits 使用 */
+        static segment_iterator __segment(const self& it) { return it.node_; }
+        static local_iterator __local(const self& it) { return it.cur_; }
+        static local_iterator __begin(segment_iterator s) { return *s; }
+        static local_iterator __end(segment_iterator s) { return *s + buffer_size(); }
+
+        static self __compose(segment_iterator s, local_iterator l){
+            self it;
+            it.__set_node(s);
+            it.cur_ = l;
+            return it;
+        }
+    };
+
+    template<class T, class Ref, class Ptr>
+    inline __deque_iterator<T, Ref, Ptr>
+    operator+(ptrdiff_t n, const __deque_iterator<T, Ref, Ptr>& x){
+        return x + n;
+    }
+
+
+    template<class T, class Alloc = allocator<T> >
+    class deque{
+    public:
+        typedef T                                               value_type;
+        typedef Alloc                                           allocator_type;
+        typedef size_t                                          size_type;
+        typedef ptrdiff_t                                       difference_type;
+        typedef T&                                              reference;
+        typedef const T&                                        const_reference;
+        typedef T*                                              pointer;
+        typedef const T*                                        const_pointer;
+        typedef __deque_iterator<T, T&, T*>                     iterator;
+        typedef __deque_iterator<T, const T&, const T*>         const_iterator;
+
+    private:
+        typedef allocator_traits<Alloc>                         alloc_traits;
+        typedef typename alloc_traits::template rebind_alloc<T*> map_allocator;
+        typedef allocator_traits<map_allocator>                 map_traits;
+        typedef T**                                             map_pointer;
+
+        static constexpr size_type buffer_size() { return __deque_buf_size(sizeof(T)); }
+
+        // 中控器至少有 8 个节点
+        enum { __initial_map_size = 8 };
+
+        // 继承配置器以便无状态配置器不占空间
+        struct __deque_impl : public Alloc{
+            map_pointer map_;
+            size_type map_size_;
+            iterator start_;
+            iterator finish_;
+
+            __deque_impl() : Alloc(), map_(nullptr), map_size_(0), start_(), finish_() {}
+            explicit __deque_impl(const Alloc& a) : Alloc(a), map_(nullptr), map_size_(0), start_(), finish_() {}
+        };
+
+        __deque_impl impl_;
+
+        Alloc& __alloc() noexcept { return impl_; }
+        const Alloc& __alloc() const noexcept { return impl_; }
+
+    public:
+        /** 构造、析构 */
+        deque() : impl_() {}
+
+        explicit deque(const Alloc& a) : impl_(a) {}
+
+        explicit deque(size_type n, const Alloc& a = Alloc()) : impl_(a){
+            __create_map_and_nodes(n);
+            try {
+                __value_init(impl_.start_, impl_.finish_);
+            }catch(...){
+                __free_storage();
+                throw;
+            }
+        }
+
+        deque(size_type n, const T& value, const Alloc& a = Alloc()) : impl_(a){
+            __create_map_and_nodes(n);
+            try {
+                simple_stl::uninitialized_fill(impl_.start_, impl_.finish_, value);
+            }catch(...){
+                __free_storage();
+                throw;
+            }
+        }
+
+        template<class InputIterator, typename enable_if<
+                is_input_iterator<InputIterator>::value, int>::type = 0>
+        deque(InputIterator first, InputIterator last, const Alloc& a = Alloc()) : impl_(a){
+            __range_init(first, last, iterator_category(first));
+        }
+
+        deque(std::initializer_list<T> il, const Alloc& a = Alloc()) : impl_(a){
+            __range_init(il.begin(), il.end(), random_access_iterator_tag());
+        }
+
+        deque(const deque& other)
+        : impl_(alloc_traits::select_on_container_copy_construction(other.__alloc())){
+            __range_init(other.begin(), other.end(), random_access_iterator_tag());
+        }
+
+        deque(const deque& other, const Alloc& a) : impl_(a){
+            __range_init(other.begin(), other.end(), random_access_iterator_tag());
+        }
+
+        deque(deque&& other) noexcept : impl_(simple_stl::move(other.__alloc())){
+            __steal(other);
+        }
+
+        ~deque(){
+            __release_storage();
+        }
+
+        /** 赋值 */
+        deque& operator=(const deque& other){
+            if (this != &other){
+                __copy_assign_alloc(other,
+                        typename alloc_traits::propagate_on_container_copy_assignment());
+                assign(other.begin(), other.end());
+            }
+            return *this;
+        }
+
+        deque& operator=(deque&& other) noexcept(
+                alloc_traits::propagate_on_container_move_assignment::value ||
+                alloc_traits::is_always_equal::value){
+            if (this != &other)
+                __move_assign(other, bool_constant_s<
+                        alloc_traits::propagate_on_container_move_assignment::value ||
+                        alloc_traits::is_always_equal::value>());
+            return *this;
+        }
+
+        deque& operator=(std::initializer_list<T> il){
+            assign(il.begin(), il.end());
+            return *this;
+        }
+
+        void assign(size_type n, const T& value){
+            if (n > size()){
+                simple_stl::fill(begin(), end(), value);
+                insert(end(), n - size(), value);
+            }else{
+                erase(begin() + difference_type(n), end());
+                simple_stl::fill(begin(), end(), value);
+            }
+        }
+
+        template<class InputIterator, typename enable_if<
+                is_input_iterator<InputIterator>::value, int>::type = 0>
+        void assign(InputIterator first, InputIterator last){
+            __assign_aux(first, last, iterator_category(first));
+        }
+
+        void assign(std::initializer_list<T> il){
+            assign(il.begin(), il.end());
+        }
+
+        allocator_type get_allocator() const{
+            return __alloc();
+        }
+
+        /** 迭代器 */
+        iterator begin() noexcept { return impl_.start_; }
+        const_iterator begin() const noexcept { return impl_.start_; }
+        const_iterator cbegin() const noexcept { return impl_.start_; }
+        iterator end() noexcept { return impl_.finish_; }
+        const_iterator end() const noexcept { return impl_.finish_; }
+        const_iterator cend() const noexcept { return impl_.finish_; }
+
+        /** 容量 */
+        size_type size() const noexcept { return size_type(impl_.finish_ - impl_.start_); }
+        bool empty() const noexcept { return impl_.finish_ == impl_.start_; }
+
+        size_type max_size() const noexcept{
+            return alloc_traits::max_size(__alloc());
+        }
+
+        void resize(size_type n){
+            const size_type len = size();
+            if (n < len){
+                erase(begin() + difference_type(n), end());
+            }else if (n > len){
+                iterator new_finish = __reserve_elements_at_back(n - len);
+                try {
+                    __value_init(impl_.finish_, new_finish);
+                }catch(...){
+                    __destroy_nodes(impl_.finish_.node_ + 1, new_finish.node_ + 1);
+                    throw;
+                }
+                impl_.finish_ = new_finish;
+            }
+        }
+
+        void resize(size_type n, const T& value){
+            const size_type len = size();
+            if (n < len)
+                erase(begin() + difference_type(n), end());
+            else
+                insert(end(), n - len, value);
+        }
+
+        // 元素弹出后空闲的缓冲区已立即归还，这里只收缩中控器
+        void shrink_to_fit(){
+            if (impl_.map_ == nullptr)
+                return;
+            if (empty()){
+                __release_storage();
+                impl_.map_ = nullptr;
+                impl_.map_size_ = 0;
+                impl_.start_ = impl_.finish_ = iterator();
+                return;
+            }
+            const size_type num_nodes = size_type(impl_.finish_.node_ - impl_.start_.node_) + 1;
+            const size_type new_map_size = num_nodes + 2 > size_type(__initial_map_size)
+                                           ? num_nodes + 2 : size_type(__initial_map_size);
+            if (new_map_size < impl_.map_size_)
+                __move_map(new_map_size, num_nodes, 0, false);
+        }
+
+        /** 元素访问 */
+        reference operator[](size_type n) { return impl_.start_[difference_type(n)]; }
+        const_reference operator[](size_type n) const { return impl_.start_[difference_type(n)]; }
+
+        reference at(size_type n){
+            __range_check(n);
+            return (*this)[n];
+        }
+
+        const_reference at(size_type n) const{
+            __range_check(n);
+            return (*this)[n];
+        }
+
+        reference front() { return *impl_.start_; }
+        const_reference front() const { return *impl_.start_; }
+
+        reference back(){
+            iterator tmp = impl_.finish_;
+            --tmp;
+            return *tmp;
+        }
+
+        const_reference back() const{
+            const_iterator tmp = impl_.finish_;
+            --tmp;
+            return *tmp;
+        }
+
+        /** 修改 */
+        void push_back(const T& value){
+            emplace_back(value);
+        }
+
+        void push_back(T&& value){
+            emplace_back(simple_stl::move(value));
+        }
+
+        void push_front(const T& value){
+            emplace_front(value);
+        }
+
+        void push_front(T&& value){
+            emplace_front(simple_stl::move(value));
+        }
+
+        // 最后一个缓冲区还有至少两个空位时直接构造，否则先配置下一个缓冲区
+        template<class... Args>
+        reference emplace_back(Args&&... args){
+            if (impl_.finish_.last_ - impl_.finish_.cur_ > 1){
+                simple_stl::construct(impl_.finish_.cur_, simple_stl::forward<Args>(args)...);
+                ++impl_.finish_.cur_;
+            }else{
+                __emplace_back_aux(simple_stl::forward<Args>(args)...);
+            }
+            return back();
+        }
+
+        // 第一个缓冲区前面还有空位时直接构造，否则先配置前一个缓冲区
+        template<class... Args>
+        reference emplace_front(Args&&... args){
+            if (impl_.start_.cur_ != impl_.start_.first_){
+                simple_stl::construct(impl_.start_.cur_ - 1, simple_stl::forward<Args>(args)...);
+                --impl_.start_.cur_;
+            }else{
+                __emplace_front_aux(simple_stl::forward<Args>(args)...);
+            }
+            return front();
+        }
+
+        void pop_back(){
+            if (impl_.finish_.cur_ != impl_.finish_.first_){
+                --impl_.finish_.cur_;
+                simple_stl::destroy(impl_.finish_.cur_);
+            }else{
+                // 最后一个缓冲区已空，归还它并回到前一个缓冲区
+                __deallocate_node(impl_.finish_.first_);
+                impl_.finish_.__set_node(impl_.finish_.node_ - 1);
+                impl_.finish_.cur_ = impl_.finish_.last_ - 1;
+                simple_stl::destroy(impl_.finish_.cur_);
+            }
+        }
+
+        void pop_front(){
+            simple_stl::destroy(impl_.start_.cur_);
+            if (impl_.start_.cur_ != impl_.start_.last_ - 1){
+                ++impl_.start_.cur_;
+            }else{
+                // 第一个缓冲区只剩这一个元素，归还它并转到下一个缓冲区
+                __deallocate_node(impl_.start_.first_);
+                impl_.start_.__set_node(impl_.start_.node_ + 1);
+                impl_.start_.cur_ = impl_.start_.first_;
+            }
+        }
+
+        template<class... Args>
+        iterator emplace(const_iterator pos, Args&&... args){
+            if (pos.cur_ == impl_.start_.cur_){
+                emplace_front(simple_stl::forward<Args>(args)...);
+                return impl_.start_;
+            }
+            if (pos.cur_ == impl_.finish_.cur_){
+                emplace_back(simple_stl::forward<Args>(args)...);
+                return impl_.finish_ - 1;
+            }
+            return __emplace_aux(pos - impl_.start_, simple_stl::forward<Args>(args)...);
+        }
+
+        iterator insert(const_iterator pos, const T& value){
+            return emplace(pos, value);
+        }
+
+        iterator insert(const_iterator pos, T&& value){
+            return emplace(pos, simple_stl::move(value));
+        }
+
+        iterator insert(const_iterator pos, size_type n, const T& value){
+            const difference_type offset = pos - impl_.start_;
+            __fill_insert(offset, n, value);
+            return impl_.start_ + offset;
+        }
+
+        template<class InputIterator, typename enable_if<
+                is_input_iterator<InputIterator>::value, int>::type = 0>
+        iterator insert(const_iterator pos, InputIterator first, InputIterator last){
+            const difference_type offset = pos - impl_.start_;
+            __range_insert(offset, first, last, iterator_category(first));
+            return impl_.start_ + offset;
+        }
+
+        iterator insert(const_iterator pos, std::initializer_list<T> il){
+            return insert(pos, il.begin(), il.end());
+        }
+
+        // 移动删除点前后较短的一段
+        iterator erase(const_iterator pos){
+            iterator next = __to_mutable(pos);
+            ++next;
+            const difference_type index = pos - impl_.start_;
+            if (size_type(index) < (size() >> 1)){
+                simple_stl::move_backward(impl_.start_, __to_mutable(pos), next);
+                pop_front();
+            }else{
+                simple_stl::move(next, impl_.finish_, __to_mutable(pos));
+                pop_back();
+            }
+            return impl_.start_ + index;
+        }
+
+        iterator erase(const_iterator first, const_iterator last){
+            if (first.cur_ == impl_.start_.cur_ && last.cur_ == impl_.finish_.cur_){
+                clear();
+                return impl_.finish_;
+            }
+            const difference_type n = last - first;
+            const difference_type elems_before = first - impl_.start_;
+            if (n == 0)
+                return impl_.start_ + elems_before;
+            if (size_type(elems_before) < (size() - size_type(n)) / 2){
+                simple_stl::move_backward(impl_.start_, __to_mutable(first), __to_mutable(last));
+                iterator new_start = impl_.start_ + n;
+                simple_stl::destroy(impl_.start_, new_start);
+                __destroy_nodes(impl_.start_.node_, new_start.node_);
+                impl_.start_ = new_start;
+            }else{
+                simple_stl::move(__to_mutable(last), impl_.finish_, __to_mutable(first));
+                iterator new_finish = impl_.finish_ - n;
+                simple_stl::destroy(new_finish, impl_.finish_);
+                __destroy_nodes(new_finish.node_ + 1, impl_.finish_.node_ + 1);
+                impl_.finish_ = new_finish;
+            }
+            return impl_.start_ + elems_before;
+        }
+
+        // 只保留一个缓冲区
+        void clear() noexcept{
+            if (impl_.map_ == nullptr)
+                return;
+            simple_stl::destroy(impl_.start_, impl_.finish_);
+            __destroy_nodes(impl_.start_.node_ + 1, impl_.finish_.node_ + 1);
+            impl_.finish_ = impl_.start_;
+        }
+
+        void swap(deque& other) noexcept{
+            __swap_alloc(other, typename alloc_traits::propagate_on_container_swap());
+            simple_stl::swap(impl_.map_, other.impl_.map_);
+            simple_stl::swap(impl_.map_size_, other.impl_.map_size_);
+            simple_stl::swap(impl_.start_, other.impl_.start_);
+            simple_stl::swap(impl_.finish_, other.impl_.finish_);
+        }
+
+    private:
+        static iterator __to_mutable(const_iterator it){
+            iterator r;
+            r.cur_ = const_cast<T*>(it.cur_);
+            r.first_ = const_cast<T*>(it.first_);
+            r.last_ = const_cast<T*>(it.last_);
+            r.node_ = it.node_;
+            return r;
+        }
+
+        void __range_check(size_type n) const{
+            if (n >= size())
+                throw std::out_of_range("deque::at");
+        }
+
+        /** 缓冲区与中控器的配置 */
+        T* __allocate_node(){
+            return alloc_traits::allocate(__alloc(), buffer_size());
+        }
+
+        void __deallocate_node(T* p){
+            alloc_traits::deallocate(__alloc(), p, buffer_size());
+        }
+
+        // 归还 [first, last) 节点上的缓冲区
+        void __destroy_nodes(map_pointer first, map_pointer last) noexcept{
+            for ( ; first < last; ++first)
+                __deallocate_node(*first);
+        }
+
+        // 为 [first, last) 节点配置缓冲区，失败时归还已配置的部分
+        void __create_nodes(map_pointer first, map_pointer last){
+            map_pointer cur = first;
+            try {
+                for ( ; cur < last; ++cur)
+                    *cur = __allocate_node();
+            }catch(...){
+                __destroy_nodes(first, cur);
+                throw;
+            }
+        }
+
+        map_pointer __allocate_map(size_type n){
+            map_allocator ma(__alloc());
+            return map_traits::allocate(ma, n);
+        }
+
+        void __deallocate_map(map_pointer p, size_type n){
+            map_allocator ma(__alloc());
+            map_traits::deallocate(ma, p, n);
+        }
+
+        // 建立可容纳 n 个元素的中控器与缓冲区，使用的节点位于中控器中央，便于向两端扩展
+        void __create_map_and_nodes(size_type n){
+            const size_type num_nodes = n / buffer_size() + 1;
+            impl_.map_size_ = num_nodes + 2 > size_type(__initial_map_size)
+                              ? num_nodes + 2 : size_type(__initial_map_size);
+            impl_.map_ = __allocate_map(impl_.map_size_);
+            map_pointer nstart = impl_.map_ + (impl_.map_size_ - num_nodes) / 2;
+            map_pointer nfinish = nstart + num_nodes - 1;
+            try {
+                __create_nodes(nstart, nfinish + 1);
+            }catch(...){
+                __deallocate_map(impl_.map_, impl_.map_size_);
+                impl_.map_ = nullptr;
+                impl_.map_size_ = 0;
+                throw;
+            }
+            impl_.start_.__set_node(nstart);
+            impl_.finish_.__set_node(nfinish);
+            impl_.start_.cur_ = impl_.start_.first_;
+            impl_.finish_.cur_ = impl_.finish_.first_ + difference_type(n % buffer_size());
+        }
+
+        // 归还全部缓冲区与中控器，元素已析构或尚未构造
+        void __free_storage() noexcept{
+            if (impl_.map_ == nullptr)
+                return;
+            __destroy_nodes(impl_.start_.node_, impl_.finish_.node_ + 1);
+            __deallocate_map(impl_.map_, impl_.map_size_);
+        }
+
+        // 析构全部元素，归还全部缓冲区与中控器
+        void __release_storage() noexcept{
+            if (impl_.map_ != nullptr)
+                simple_stl::destroy(impl_.start_, impl_.finish_);
+            __free_storage();
+        }
+
+        void __ensure_map(){
+            if (impl_.map_ == nullptr)
+                __create_map_and_nodes(0);
+        }
+
+        void __steal(deque& other) noexcept{
+            impl_.map_ = other.impl_.map_;
+            impl_.map_size_ = other.impl_.map_size_;
+            impl_.start_ = other.impl_.start_;
+            impl_.finish_ = other.impl_.finish_;
+            other.impl_.map_ = nullptr;
+            other.impl_.map_size_ = 0;
+            other.impl_.start_ = other.impl_.finish_ = iterator();
+        }
+
+        // 将正在使用的 num_nodes 个节点搬到大小为 new_map_size 的新中控器中央，
+        // 并为 nodes_to_add 个新节点留出位置，add_at_front 指明新节点在前端还是后端
+        void __move_map(size_type new_map_size, size_type num_nodes, size_type nodes_to_add, bool add_at_front){
+            map_pointer new_map = __allocate_map(new_map_size);
+            map_pointer new_nstart = new_map + (new_map_size - num_nodes - nodes_to_add) / 2
+                                     + (add_at_front ? nodes_to_add : 0);
+            memcpy(new_nstart, impl_.start_.node_, num_nodes * sizeof(T*));
+            __deallocate_map(impl_.map_, impl_.map_size_);
+            impl_.map_ = new_map;
+            impl_.map_size_ = new_map_size;
+            impl_.start_.__set_node(new_nstart);
+            impl_.finish_.__set_node(new_nstart + num_nodes - 1);
+        }
+
+        // 中控器一端的节点不够时：空间仍充裕则把节点移回中央，否则配置更大的中控器
+        void __reallocate_map(size_type nodes_to_add, bool add_at_front){
+            const size_type old_num_nodes = size_type(impl_.finish_.node_ - impl_.start_.node_) + 1;
+            const size_type new_num_nodes = old_num_nodes + nodes_to_add;
+            if (impl_.map_size_ > 2 * new_num_nodes){
+                map_pointer new_nstart = impl_.map_ + (impl_.map_size_ - new_num_nodes) / 2
+                                         + (add_at_front ? nodes_to_add : 0);
+                memmove(new_nstart, impl_.start_.node_, old_num_nodes * sizeof(T*));
+                impl_.start_.__set_node(new_nstart);
+                impl_.finish_.__set_node(new_nstart + old_num_nodes - 1);
+            }else{
+                const size_type new_map_size = impl_.map_size_ +
+                        (impl_.map_size_ > nodes_to_add ? impl_.map_size_ : nodes_to_add) + 2;
+                __move_map(new_map_size, old_num_nodes, nodes_to_add, add_at_front);
+            }
+        }
+
+        void __reserve_map_at_back(size_type nodes_to_add = 1){
+            if (nodes_to_add + 1 > impl_.map_size_ - size_type(impl_.finish_.node_ - impl_.map_))
+                __reallocate_map(nodes_to_add, false);
+        }
+
+        void __reserve_map_at_front(size_type nodes_to_add = 1){
+            if (nodes_to_add > size_type(impl_.start_.node_ - impl_.map_))
+                __reallocate_map(nodes_to_add, true);
+        }
+
+        // 在头部预留 n 个未初始化的位置，返回新的起点
+        iterator __reserve_elements_at_front(size_type n){
+            __ensure_map();
+            const size_type vacancies = size_type(impl_.start_.cur_ - impl_.start_.first_);
+            if (n > vacancies){
+                const size_type new_nodes = (n - vacancies + buffer_size() - 1) / buffer_size();
+                __reserve_map_at_front(new_nodes);
+                __create_nodes(impl_.start_.node_ - new_nodes, impl_.start_.node_);
+            }
+            return impl_.start_ - difference_type(n);
+        }
+
+        // 在尾部预留 n 个未初始化的位置，返回新的终点
+        iterator __reserve_elements_at_back(size_type n){
+            __ensure_map();
+            const size_type vacancies = size_type(impl_.finish_.last_ - impl_.finish_.cur_) - 1;
+            if (n > vacancies){
+                const size_type new_nodes = (n - vacancies + buffer_size() - 1) / buffer_size();
+                __reserve_map_at_back(new_nodes);
+                __create_nodes(impl_.finish_.node_ + 1, impl_.finish_.node_ + 1 + new_nodes);
+            }
+            return impl_.finish_ + difference_type(n);
+        }
+
+        template<class... Args>
+        void __emplace_back_aux(Args&&... args){
+            __ensure_map();
+            if (impl_.finish_.last_ - impl_.finish_.cur_ > 1){
+                simple_stl::construct(impl_.finish_.cur_, simple_stl::forward<Args>(args)...);
+                ++impl_.finish_.cur_;
+                return;
+            }
+            __reserve_map_at_back();
+            *(impl_.finish_.node_ + 1) = __allocate_node();
+            try {
+                simple_stl::construct(impl_.finish_.cur_, simple_stl::forward<Args>(args)...);
+            }catch(...){
+                __deallocate_node(*(impl_.finish_.node_ + 1));
+                throw;
+            }
+            impl_.finish_.__set_node(impl_.finish_.node_ + 1);
+            impl_.finish_.cur_ = impl_.finish_.first_;
+        }
+
+        template<class... Args>
+        void __emplace_front_aux(Args&&... args){
+            __ensure_map();
+            if (impl_.start_.cur_ != impl_.start_.first_){
+                simple_stl::construct(impl_.start_.cur_ - 1, simple_stl::forward<Args>(args)...);
+                --impl_.start_.cur_;
+                return;
+            }
+            __reserve_map_at_front();
+            *(impl_.start_.node_ - 1) = __allocate_node();
+            try {
+                T* p = *(impl_.start_.node_ - 1) + difference_type(buffer_size()) - 1;
+                simple_stl::construct(p, simple_stl::forward<Args>(args)...);
+            }catch(...){
+                __deallocate_node(*(impl_.start_.node_ - 1));
+                throw;
+            }
+            impl_.start_.__set_node(impl_.start_.node_ - 1);
+            impl_.start_.cur_ = impl_.start_.last_ - 1;
+        }
+
+        // 在中间构造新元素：移动插入点前后较短的一段。新元素先构造，防止参数引用容器内的元素
+        template<class... Args>
+        iterator __emplace_aux(difference_type index, Args&&... args){
+            T tmp(simple_stl::forward<Args>(args)...);
+            if (size_type(index) < size() / 2){
+                emplace_front(simple_stl::move(front()));
+                iterator front1 = impl_.start_ + 1;
+                iterator front2 = front1 + 1;
+                iterator pos = impl_.start_ + index;
+                simple_stl::move(front2, pos + 1, front1);
+                *pos = simple_stl::move(tmp);
+                return pos;
+            }else{
+                emplace_back(simple_stl::move(back()));
+                iterator back1 = impl_.finish_ - 1;
+                iterator back2 = back1 - 1;
+                iterator pos = impl_.start_ + index;
+                simple_stl::move_backward(pos, back2, back1);
+                *pos = simple_stl::move(tmp);
+                return pos;
+            }
+        }
+
+        // 值初始化 [first, last)，平凡类型整段填充
+        void __value_init(iterator first, iterator last){
+            __value_init_aux(first, last, typename __type_traits_s<T>::have_trivial_default_constructor());
+        }
+
+        void __value_init_aux(iterator first, iterator last, __true_type_s){
+            simple_stl::uninitialized_fill(first, last, T());
+        }
+
+        void __value_init_aux(iterator first, iterator last, __false_type_s){
+            iterator cur = first;
+            try {
+                for ( ; cur != last; ++cur)
+                    simple_stl::construct(&*cur);
+            }catch(...){
+                simple_stl::destroy(first, cur);
+                throw;
+            }
+        }
+
+        template<class InputIterator>
+        void __range_init(InputIterator first, InputIterator last, input_iterator_tag){
+            try {
+                for ( ; first != last; ++first)
+                    emplace_back(*first);
+            }catch(...){
+                __release_storage();
+                throw;
+            }
+        }
+
+        // 先用 distance() 求出长度，一次建好全部缓冲区，再逐段拷贝
+        template<class ForwardIterator>
+        void __range_init(ForwardIterator first, ForwardIterator last, forward_iterator_tag){
+            const size_type n = static_cast<size_type>(simple_stl::distance(first, last));
+            __create_map_and_nodes(n);
+            try {
+                simple_stl::uninitialized_copy(first, last, impl_.start_);
+            }catch(...){
+                __free_storage();
+                throw;
+            }
+        }
+
+        void __fill_insert(difference_type index, size_type n, const T& value){
+            if (n == 0)
+                return;
+            if (index == 0){
+                // 先拷贝一份，防止 value 引用的正是容器内的元素
+                T copy = value;
+                iterator new_start = __reserve_elements_at_front(n);
+                try {
+                    simple_stl::uninitialized_fill(new_start, impl_.start_, copy);
+                }catch(...){
+                    __destroy_nodes(new_start.node_, impl_.start_.node_);
+                    throw;
+                }
+                impl_.start_ = new_start;
+            }else if (size_type(index) == size()){
+                T copy = value;
+                iterator new_finish = __reserve_elements_at_back(n);
+                try {
+                    simple_stl::uninitialized_fill(impl_.finish_, new_finish, copy);
+                }catch(...){
+                    __destroy_nodes(impl_.finish_.node_ + 1, new_finish.node_ + 1);
+                    throw;
+                }
+                impl_.finish_ = new_finish;
+            }else{
+                __fill_insert_aux(index, n, value);
+            }
+        }
+
+        // 在中间插入 n 个 value，移动插入点前后较短的一段
+        void __fill_insert_aux(difference_type elems_before, size_type n, const T& value){
+            T copy = value;
+            const difference_type dn = difference_type(n);
+            const size_type length = size();
+            if (size_type(elems_before) < length / 2){
+                iterator new_start = __reserve_elements_at_front(n);
+                iterator old_start = impl_.start_;
+                iterator pos = impl_.start_ + elems_before;
+                try {
+                    if (elems_before >= dn){
+                        iterator start_n = impl_.start_ + dn;
+                        simple_stl::uninitialized_move(impl_.start_, start_n, new_start);
+                        impl_.start_ = new_start;
+                        simple_stl::move(start_n, pos, old_start);
+                        simple_stl::fill(pos - dn, pos, copy);
+                    }else{
+                        iterator mid = simple_stl::uninitialized_move(impl_.start_, pos, new_start);
+                        try {
+                            simple_stl::uninitialized_fill(mid, impl_.start_, copy);
+                        }catch(...){
+                            simple_stl::destroy(new_start, mid);
+                            throw;
+                        }
+                        impl_.start_ = new_start;
+                        simple_stl::fill(old_start, pos, copy);
+                    }
+                }catch(...){
+                    if (impl_.start_ != new_start)
+                        __destroy_nodes(new_start.node_, impl_.start_.node_);
+                    throw;
+                }
+            }else{
+                iterator new_finish = __reserve_elements_at_back(n);
+                iterator old_finish = impl_.finish_;
+                const difference_type elems_after = difference_type(length) - elems_before;
+                iterator pos = impl_.finish_ - elems_after;
+                try {
+                    if (elems_after > dn){
+                        iterator finish_n = impl_.finish_ - dn;
+                        simple_stl::uninitialized_move(finish_n, impl_.finish_, impl_.finish_);
+                        impl_.finish_ = new_finish;
+                        simple_stl::move_backward(pos, finish_n, old_finish);
+                        simple_stl::fill(pos, pos + dn, copy);
+                    }else{
+                        iterator mid = impl_.finish_ + (dn - elems_after);
+                        simple_stl::uninitialized_fill(impl_.finish_, mid, copy);
+                        try {
+                            simple_stl::uninitialized_move(pos, impl_.finish_, mid);
+                        }catch(...){
+                            simple_stl::destroy(impl_.finish_, mid);
+                            throw;
+                        }
+                        impl_.finish_ = new_finish;
+                        simple_stl::fill(pos, old_finish, copy);
+                    }
+                }catch(...){
+                    if (impl_.finish_ != new_finish)
+                        __destroy_nodes(impl_.finish_.node_ + 1, new_finish.node_ + 1);
+                    throw;
+                }
+            }
+        }
+
+        template<class InputIterator>
+        void __range_insert(difference_type index, InputIterator first, InputIterator last, input_iterator_tag){
+            if (size_type(index) == size()){
+                for ( ; first != last; ++first)
+                    emplace_back(*first);
+            }else{
+                // 先收集到临时 deque 中，再按前向迭代器处理
+                deque tmp(first, last, __alloc());
+                __range_insert(index, simple_stl::make_move_iterator(tmp.begin()),
+                               simple_stl::make_move_iterator(tmp.end()), forward_iterator_tag());
+            }
+        }
+
+        template<class ForwardIterator>
+        void __range_insert(difference_type index, ForwardIterator first, ForwardIterator last,
+                            forward_iterator_tag){
+            const size_type n = static_cast<size_type>(simple_stl::distance(first, last));
+            if (n == 0)
+                return;
+            if (index == 0){
+                iterator new_start = __reserve_elements_at_front(n);
+                try {
+                    simple_stl::uninitialized_copy(first, last, new_start);
+                }catch(...){
+                    __destroy_nodes(new_start.node_, impl_.start_.node_);
+                    throw;
+                }
+                impl_.start_ = new_start;
+            }else if (size_type(index) == size()){
+                iterator new_finish = __reserve_elements_at_back(n);
+                try {
+                    simple_stl::uninitialized_copy(first, last, impl_.finish_);
+                }catch(...){
+                    __destroy_nodes(impl_.finish_.node_ + 1, new_finish.node_ + 1);
+                    throw;
+                }
+                impl_.finish_ = new_finish;
+            }else{
+                __range_insert_aux(index, first, last, n);
+            }
+        }
+
+        // 在中间插入 [first, last)，移动插入点前后较短的一段
+        template<class ForwardIterator>
+        void __range_insert_aux(difference_type elems_before, ForwardIterator first, ForwardIterator last,
+                                size_type n){
+            const difference_type dn = difference_type(n);
+            const size_type length = size();
+            if (size_type(elems_before) < length / 2){
+                iterator new_start = __reserve_elements_at_front(n);
+                iterator old_start = impl_.start_;
+                iterator pos = impl_.start_ + elems_before;
+                try {
+                    if (elems_before >= dn){
+                        iterator start_n = impl_.start_ + dn;
+                        simple_stl::uninitialized_move(impl_.start_, start_n, new_start);
+                        impl_.start_ = new_start;
+                        simple_stl::move(start_n, pos, old_start);
+                        simple_stl::copy(first, last, pos - dn);
+                    }else{
+                        ForwardIterator mid = first;
+                        simple_stl::advance(mid, dn - elems_before);
+                        iterator copied = simple_stl::uninitialized_move(impl_.start_, pos, new_start);
+                        try {
+                            simple_stl::uninitialized_copy(first, mid, copied);
+                        }catch(...){
+                            simple_stl::destroy(new_start, copied);
+                            throw;
+                        }
+                        impl_.start_ = new_start;
+                        simple_stl::copy(mid, last, old_start);
+                    }
+                }catch(...){
+                    if (impl_.start_ != new_start)
+                        __destroy_nodes(new_start.node_, impl_.start_.node_);
+                    throw;
+                }
+            }else{
+                iterator new_finish = __reserve_elements_at_back(n);
+                iterator old_finish = impl_.finish_;
+                const difference_type elems_after = difference_type(length) - elems_before;
+                iterator pos = impl_.finish_ - elems_after;
+                try {
+                    if (elems_after > dn){
+                        iterator finish_n = impl_.finish_ - dn;
+                        simple_stl::uninitialized_move(finish_n, impl_.finish_, impl_.finish_);
+                        impl_.finish_ = new_finish;
+                        simple_stl::move_backward(pos, finish_n, old_finish);
+                        simple_stl::copy(first, last, pos);
+                    }else{
+                        ForwardIterator mid = first;
+                        simple_stl::advance(mid, elems_after);
+                        iterator copied = simple_stl::uninitialized_copy(mid, last, impl_.finish_);
+                        try {
+                            simple_stl::uninitialized_move(pos, impl_.finish_, copied);
+                        }catch(...){
+                            simple_stl::destroy(impl_.finish_, copied);
+                            throw;
+                        }
+                        impl_.finish_ = new_finish;
+                        simple_stl::copy(first, mid, pos);
+                    }
+                }catch(...){
+                    if (impl_.finish_ != new_finish)
+                        __destroy_nodes(impl_.finish_.node_ + 1, new_finish.node_ + 1);
+                    throw;
+                }
+            }
+        }
+
+        template<class InputIterator>
+        void __assign_aux(InputIterator first, InputIterator last, input_iterator_tag){
+            iterator cur = impl_.start_;
+            for ( ; first != last && cur != impl_.finish_; ++first, ++cur)
+                *cur = *first;
+            if (first == last)
+                erase(cur, impl_.finish_);
+            else
+                for ( ; first != last; ++first)
+                    emplace_back(*first);
+        }
+
+        template<class ForwardIterator>
+        void __assign_aux(ForwardIterator first, ForwardIterator last, forward_iterator_tag){
+            const size_type n = static_cast<size_type>(simple_stl::distance(first, last));
+            if (n > size()){
+                ForwardIterator mid = first;
+                simple_stl::advance(mid, size());
+                simple_stl::copy(first, mid, impl_.start_);
+                __range_insert(difference_type(size()), mid, last, forward_iterator_tag());
+            }else{
+                erase(simple_stl::copy(first, last, impl_.start_), impl_.finish_);
+            }
+        }
+
+        void __copy_assign_alloc(const deque& other, __true_type_s){
+            if (__alloc() != other.__alloc()){
+                __release_storage();
+                impl_.map_ = nullptr;
+                impl_.map_size_ = 0;
+                impl_.start_ = impl_.finish_ = iterator();
+            }
+            __alloc() = other.__alloc();
+        }
+
+        void __copy_assign_alloc(const deque&, __false_type_s) {}
+
+        // 可以接管对方的内存
+        void __move_assign(deque& other, __true_type_s){
+            __release_storage();
+            __move_assign_alloc(other, typename alloc_traits::propagate_on_container_move_assignment());
+            __steal(other);
+        }
+
+        // 配置器不传播，相等时接管内存，否则逐一移动元素
+        void __move_assign(deque& other, __false_type_s){
+            if (__alloc() == other.__alloc()){
+                __move_assign(other, __true_type_s());
+            }else{
+                assign(simple_stl::make_move_iterator(other.begin()), simple_stl::make_move_iterator(other.end()));
+                other.clear();
+            }
+        }
+
+        void __move_assign_alloc(deque& other, __true_type_s){
+            __alloc() = simple_stl::move(other.__alloc());
+        }
+
+        void __move_assign_alloc(deque&, __false_type_s) {}
+
+        void __swap_alloc(deque& other, __true_type_s){
+            simple_stl::swap(__alloc(), other.__alloc());
+        }
+
+        void __swap_alloc(deque&, __false_type_s) {}
+    };
+
+    template<class T, class Alloc>
+    inline bool operator==(const deque<T, Alloc>& x, const deque<T, Alloc>& y){
+        if (x.size() != y.size())
+            return false;
+        typename deque<T, Alloc>::const_iterator f1 = x.begin();
+        typename deque<T, Alloc>::const_iterator f2 = y.begin();
+        for ( ; f1 != x.end(); ++f1, ++f2)
+            if (!(*f1 == *f2))
+                return false;
+        return true;
+    }
+
+    template<class T, class Alloc>
+    inline bool operator!=(const deque<T, Alloc>& x, const deque<T, Alloc>& y){
+        return !(x == y);
+    }
+
+    template<class T, class Alloc>
+    inline bool operator<(const deque<T, Alloc>& x, const deque<T, Alloc>& y){
+        typename deque<T, Alloc>::const_iterator f1 = x.begin();
+        typename deque<T, Alloc>::const_iterator f2 = y.begin();
+        for ( ; f1 != x.end() && f2 != y.end(); ++f1, ++f2) {
+            if (*f1 < *f2)
+                return true;
+            if (*f2 < *f1)
+                return false;
+        }
+        return f1 == x.end() && f2 != y.end();
+    }
+
+    template<class T, class Alloc>
+    inline void swap(deque<T, Alloc>& x, deque<T, Alloc>& y) noexcept{
+        x.swap(y);
+    }
+
+}   // simple_stl
+
+#endif //SIMPLESTL_STL_DEQUE_H
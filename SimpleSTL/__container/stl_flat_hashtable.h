@@ -0,0 +1,734 @@
+/**
+ * Created by 史进 on 2023/6/17.
+ *
+ * __flat_hashtable：unordered_flat_map、unordered_flat_set 共用的开放寻址哈希表（Swiss table）
+ *  - 元素直接存放在槽数组中，另有一个控制字节数组与槽一一对应：
+ *    空（-128）、已删除（-2）、哨兵（-1），满时存哈希值的低 7 位 H2
+ *  - 查找时以哈希值的其余位 H1 选起始位置，一次取 16 个控制字节与 H2 比较，
+ *    只对匹配的槽比较键；组内出现空槽即可断定不存在。有 SSE2 时用 SIMD 比较，否则逐字节比较
+ *  - 槽数为 2^k - 1，控制字节数组末尾是哨兵，其后复制开头的 15 个控制字节，
+ *    从任意位置取 16 个字节都不越界，也不必处理回绕
+ *  - 最大负载因子 7/8；扩容时逐个元素重新定位，元素可平凡重定位时按字节拷贝，
+ *    否则经 __uninitialized_move_if_noexcept 移动（移动可能抛异常时拷贝）
+ *  - 插入可能扩容，扩容后全部迭代器失效；删除只失效被删元素的迭代器
+ */
+#ifndef SIMPLESTL_STL_FLAT_HASHTABLE_H
+#define SIMPLESTL_STL_FLAT_HASHTABLE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "stl_vector.h"
+#include "../__algorithm/stl_simd.h"
+#include "../iterator.h"
+#include "../type_traits.h"
+#include "../utility.h"
+#include "../__functional/stl_hash.h"
+#include "../__memory/stl_allocator.h"
+#include "../__memory/stl_allocator_traits.h"
+#include "../__memory/stl_construct.h"
+
+namespace simple_stl{
+
+    typedef signed char __ctrl_t;
+
+    const __ctrl_t __ctrl_empty = -128;
+    const __ctrl_t __ctrl_deleted = -2;
+    const __ctrl_t __ctrl_sentinel = -1;
+
+    // 满槽的控制字节非负；空槽与已删除的槽小于哨兵
+    inline bool __ctrl_is_full(__ctrl_t c) noexcept { return c >= 0; }
+    inline bool __ctrl_is_empty_or_deleted(__ctrl_t c) noexcept { return c < __ctrl_sentinel; }
+
+    // 16 位掩码中最高位的 1 之前的 0 的个数，x 不为 0
+    inline unsigned __flat_clz16(uint32_t x) noexcept{
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<unsigned>(__builtin_clz(x)) - 16;
+#else
+        unsigned n = 0;
+        for (uint32_t bit = 0x8000u; (x & bit) == 0; bit >>= 1)
+            ++n;
+        return n;
+#endif
+    }
+
+    // 一组 16 个控制字节，各查询返回 16 位掩码，第 i 位对应组内第 i 个字节
+    struct __flat_group{
+        enum {width = 16};
+
+#if SIMPLESTL_HAVE_SSE2
+        __m128i ctrl_;
+
+        explicit __flat_group(const __ctrl_t* pos) noexcept
+        : ctrl_(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pos))) {}
+
+        uint32_t match(__ctrl_t h2) const noexcept{
+            return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), ctrl_)));
+        }
+
+        uint32_t mask_empty() const noexcept{
+            return match(__ctrl_empty);
+        }
+
+        uint32_t mask_empty_or_deleted() const noexcept{
+            return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(__ctrl_sentinel), ctrl_)));
+        }
+#else
+        __ctrl_t ctrl_[width];
+
+        explicit __flat_group(const __ctrl_t* pos) noexcept{
+            std::memcpy(ctrl_, pos, width);
+        }
+
+        uint32_t match(__ctrl_t h2) const noexcept{
+            uint32_t mask = 0;
+            for (int i = 0; i < width; ++i)
+                mask |= static_cast<uint32_t>(ctrl_[i] == h2) << i;
+            return mask;
+        }
+
+        uint32_t mask_empty() const noexcept{
+            return match(__ctrl_empty);
+        }
+
+        uint32_t mask_empty_or_deleted() const noexcept{
+            uint32_t mask = 0;
+            for (int i = 0; i < width; ++i)
+                mask |= static_cast<uint32_t>(ctrl_[i] < __ctrl_sentinel) << i;
+            return mask;
+        }
+#endif
+
+        // 开头连续的空槽与已删除的槽的个数
+        uint32_t count_leading_empty_or_deleted() const noexcept{
+            return __simd_ctz(mask_empty_or_deleted() + 1);
+        }
+    };
+
+    // 空表共用的控制字节：哨兵之后全空，查找在第一组即结束，begin() 即 end()
+    inline __ctrl_t* __flat_empty_group() noexcept{
+        alignas(16) static const __ctrl_t empty_group[__flat_group::width] = {
+                __ctrl_sentinel, __ctrl_empty, __ctrl_empty, __ctrl_empty,
+                __ctrl_empty, __ctrl_empty, __ctrl_empty, __ctrl_empty,
+                __ctrl_empty, __ctrl_empty, __ctrl_empty, __ctrl_empty,
+                __ctrl_empty, __ctrl_empty, __ctrl_empty, __ctrl_empty};
+        return const_cast<__ctrl_t*>(empty_group);
+    }
+
+
+    /**
+     * Slot 为槽中实际存放的类型，Value 为对外暴露的类型。map 的槽存放 pair<Key, T>，
+     * 以 pair<const Key, T> 的引用交给使用者，两者布局相同；扩容时可以移动键
+     */
+    template<class Value, class Slot, class Ref, class Ptr>
+    struct __flat_hash_iterator{
+        typedef __flat_hash_iterator<Value, Slot, Value&, Value*>               iterator;
+        typedef __flat_hash_iterator<Value, Slot, const Value&, const Value*>   const_iterator;
+        typedef __flat_hash_iterator                                            self;
+
+        typedef forward_iterator_tag    iterator_category;
+        typedef Value                   value_type;
+        typedef Ptr                     pointer;
+        typedef Ref                     reference;
+        typedef ptrdiff_t               difference_type;
+
+        __ctrl_t* ctrl_;
+        Slot* slot_;
+
+        __flat_hash_iterator() noexcept : ctrl_(nullptr), slot_(nullptr) {}
+        __flat_hash_iterator(__ctrl_t* ctrl, Slot* slot) noexcept : ctrl_(ctrl), slot_(slot) {}
+
+        // iterator 可转换为 const_iterator
+        __flat_hash_iterator(const iterator& other) noexcept : ctrl_(other.ctrl_), slot_(other.slot_) {}
+
+        __flat_hash_iterator& operator=(const __flat_hash_iterator&) = default;
+
+        reference operator*() const { return *reinterpret_cast<Value*>(slot_); }
+        pointer operator->() const { return reinterpret_cast<Value*>(slot_); }
+
+        self& operator++(){
+            ++ctrl_;
+            ++slot_;
+            __skip_empty_or_deleted();
+            return *this;
+        }
+
+        self operator++(int){
+            self tmp = *this;
+            ++*this;
+            return tmp;
+        }
+
+        // 按组跳过空槽，停在满槽或哨兵上
+        void __skip_empty_or_deleted() noexcept{
+            while (__ctrl_is_empty_or_deleted(*ctrl_)){
+                const uint32_t shift = __flat_group(ctrl_).count_leading_empty_or_deleted();
+                ctrl_ += shift;
+                slot_ += shift;
+            }
+        }
+
+        template<class R, class P>
+        bool operator==(const __flat_hash_iterator<Value, Slot, R, P>& x) const { return ctrl_ == x.ctrl_; }
+
+        template<class R, class P>
+        bool operator!=(const __flat_hash_iterator<Value, Slot, R, P>& x) const { return ctrl_ != x.ctrl_; }
+    };
+
+
+    template<class Key, class Value, class Slot, class KeyOfValue, class Hash, class KeyEqual, class Alloc>
+    class __flat_hashtable{
+    public:
+        typedef Key                                                         key_type;
+        typedef Value                                                       value_type;
+        typedef Hash                                                        hasher;
+        typedef KeyEqual                                                    key_equal;
+        typedef Alloc                                                       allocator_type;
+        typedef size_t                                                      size_type;
+        typedef ptrdiff_t                                                   difference_type;
+        typedef __flat_hash_iterator<Value, Slot, Value&, Value*>               iterator;
+        typedef __flat_hash_iterator<Value, Slot, const Value&, const Value*>   const_iterator;
+
+    private:
+        typedef typename allocator_traits<Alloc>::template rebind_alloc<Slot>       slot_allocator;
+        typedef allocator_traits<slot_allocator>                                    slot_traits;
+        typedef typename allocator_traits<Alloc>::template rebind_alloc<__ctrl_t>   ctrl_allocator;
+        typedef allocator_traits<ctrl_allocator>                                    ctrl_traits;
+
+        enum {__group_width = __flat_group::width};
+
+        // 继承槽配置器以便无状态配置器不占空间
+        struct __table_impl : public slot_allocator{
+            Hash hash_;
+            KeyEqual eq_;
+            __ctrl_t* ctrl_;
+            Slot* slots_;
+            size_type size_;
+            size_type capacity_;
+            size_type growth_left_;     // 不扩容还能占用的空槽数
+
+            __table_impl(const Hash& h, const KeyEqual& eq, const slot_allocator& a)
+            : slot_allocator(a), hash_(h), eq_(eq) { __reset(); }
+
+            void __reset() noexcept{
+                ctrl_ = __flat_empty_group();
+                slots_ = nullptr;
+                size_ = 0;
+                capacity_ = 0;
+                growth_left_ = 0;
+            }
+        };
+
+        __table_impl impl_;
+
+        slot_allocator& __slot_alloc() noexcept { return impl_; }
+        const slot_allocator& __slot_alloc() const noexcept { return impl_; }
+
+        static const Key& __key(const Slot& s) { return KeyOfValue()(s); }
+
+    public:
+        /** 构造、析构 */
+        explicit __flat_hashtable(size_type n = 0, const Hash& h = Hash(), const KeyEqual& eq = KeyEqual(),
+                                  const Alloc& a = Alloc())
+        : impl_(h, eq, slot_allocator(a)){
+            if (n > 0)
+                __resize(__capacity_for(n));
+        }
+
+        __flat_hashtable(const __flat_hashtable& other)
+        : impl_(other.impl_.hash_, other.impl_.eq_,
+                slot_traits::select_on_container_copy_construction(other.__slot_alloc())){
+            __copy_from(other);
+        }
+
+        __flat_hashtable(const __flat_hashtable& other, const Alloc& a)
+        : impl_(other.impl_.hash_, other.impl_.eq_, slot_allocator(a)){
+            __copy_from(other);
+        }
+
+        __flat_hashtable(__flat_hashtable&& other) noexcept
+        : impl_(other.impl_.hash_, other.impl_.eq_, simple_stl::move(other.__slot_alloc())){
+            __steal(other);
+        }
+
+        ~__flat_hashtable(){
+            __release();
+        }
+
+        /** 赋值 */
+        __flat_hashtable& operator=(const __flat_hashtable& other){
+            if (this != &other){
+                __release();
+                __copy_assign_alloc(other, typename slot_traits::propagate_on_container_copy_assignment());
+                impl_.hash_ = other.impl_.hash_;
+                impl_.eq_ = other.impl_.eq_;
+                __copy_from(other);
+            }
+            return *this;
+        }
+
+        __flat_hashtable& operator=(__flat_hashtable&& other) noexcept(
+                slot_traits::propagate_on_container_move_assignment::value ||
+                slot_traits::is_always_equal::value){
+            if (this != &other)
+                __move_assign(other, bool_constant_s<
+                        slot_traits::propagate_on_container_move_assignment::value ||
+                        slot_traits::is_always_equal::value>());
+            return *this;
+        }
+
+        allocator_type get_allocator() const { return allocator_type(__slot_alloc()); }
+        hasher hash_function() const { return impl_.hash_; }
+        key_equal key_eq() const { return impl_.eq_; }
+
+        /** 迭代器 */
+        iterator begin() noexcept{
+            iterator it(impl_.ctrl_, impl_.slots_);
+            it.__skip_empty_or_deleted();
+            return it;
+        }
+
+        const_iterator begin() const noexcept{
+            return const_cast<__flat_hashtable*>(this)->begin();
+        }
+
+        iterator end() noexcept { return iterator(impl_.ctrl_ + impl_.capacity_, impl_.slots_ + impl_.capacity_); }
+        const_iterator end() const noexcept { return const_cast<__flat_hashtable*>(this)->end(); }
+
+        /** 容量 */
+        size_type size() const noexcept { return impl_.size_; }
+        bool empty() const noexcept { return impl_.size_ == 0; }
+        size_type max_size() const noexcept { return slot_traits::max_size(__slot_alloc()); }
+
+        size_type bucket_count() const noexcept { return impl_.capacity_; }
+
+        float load_factor() const noexcept{
+            return impl_.capacity_ == 0 ? 0.0f : static_cast<float>(impl_.size_) / impl_.capacity_;
+        }
+
+        float max_load_factor() const noexcept { return 7.0f / 8.0f; }
+
+        // 至少能容纳 n 个元素而不扩容
+        void reserve(size_type n){
+            if (n > impl_.size_ + impl_.growth_left_)
+                __resize(__capacity_for(n));
+        }
+
+        // 槽数至少为 n 且能容纳现有元素；n 为 0 时收缩到刚好容纳现有元素
+        void rehash(size_type n){
+            size_type cap = __capacity_for(impl_.size_);
+            if (n > cap)
+                cap = __normalize_capacity(n);
+            if (cap != impl_.capacity_ || impl_.growth_left_ + impl_.size_ < __growth_for(cap))
+                __resize(cap);
+        }
+
+        /** 插入 */
+        // 按键 k 查找，不存在时调用 construct_fn(Slot*) 在槽中直接构造元素
+        template<class ConstructFn>
+        pair<iterator, bool> emplace_key_with(const key_type& k, ConstructFn construct_fn){
+            const size_t h = __hash(k);
+            size_type i = __find_index(k, h);
+            if (i != __npos())
+                return pair<iterator, bool>(__iterator_at(i), false);
+            i = __prepare_insert(h);
+            construct_fn(impl_.slots_ + i);
+            __commit_insert(i, h);
+            return pair<iterator, bool>(__iterator_at(i), true);
+        }
+
+        template<class... Args>
+        pair<iterator, bool> emplace_key_args(const key_type& k, Args&&... args){
+            return emplace_key_with(k, [&](Slot* p){
+                simple_stl::construct(p, simple_stl::forward<Args>(args)...);
+            });
+        }
+
+        template<class V>
+        pair<iterator, bool> insert_unique(V&& v){
+            return emplace_key_args(KeyOfValue()(v), simple_stl::forward<V>(v));
+        }
+
+        // 键只能从构造好的元素中取得，先在临时对象中构造，再移入槽中
+        template<class... Args>
+        pair<iterator, bool> emplace_unique(Args&&... args){
+            Slot tmp(simple_stl::forward<Args>(args)...);
+            return emplace_key_args(__key(tmp), simple_stl::move(tmp));
+        }
+
+        template<class InputIterator>
+        void insert_range_unique(InputIterator first, InputIterator last){
+            __reserve_for_range(first, last, iterator_category(first));
+            for ( ; first != last; ++first)
+                insert_unique(*first);
+        }
+
+        /** 删除 */
+        iterator erase(const_iterator pos){
+            iterator next(pos.ctrl_, pos.slot_);
+            ++next;
+            __erase_at(static_cast<size_type>(pos.slot_ - impl_.slots_));
+            return next;
+        }
+
+        iterator erase(const_iterator first, const_iterator last){
+            while (first != last)
+                first = erase(first);
+            return iterator(last.ctrl_, last.slot_);
+        }
+
+        size_type erase(const key_type& k){
+            const size_type i = __find_index(k, __hash(k));
+            if (i == __npos())
+                return 0;
+            __erase_at(i);
+            return 1;
+        }
+
+        // 保留槽数组，全部控制字节置空
+        void clear() noexcept{
+            if (impl_.capacity_ == 0)
+                return;
+            __destroy_slots(typename __type_traits_s<Slot>::have_trivial_destructor());
+            __reset_ctrl(impl_.ctrl_, impl_.capacity_);
+            impl_.size_ = 0;
+            impl_.growth_left_ = __growth_for(impl_.capacity_);
+        }
+
+        void swap(__flat_hashtable& other) noexcept{
+            __swap_alloc(other, typename slot_traits::propagate_on_container_swap());
+            simple_stl::swap(impl_.hash_, other.impl_.hash_);
+            simple_stl::swap(impl_.eq_, other.impl_.eq_);
+            simple_stl::swap(impl_.ctrl_, other.impl_.ctrl_);
+            simple_stl::swap(impl_.slots_, other.impl_.slots_);
+            simple_stl::swap(impl_.size_, other.impl_.size_);
+            simple_stl::swap(impl_.capacity_, other.impl_.capacity_);
+            simple_stl::swap(impl_.growth_left_, other.impl_.growth_left_);
+        }
+
+        /** 查找 */
+        iterator find(const key_type& k){
+            const size_type i = __find_index(k, __hash(k));
+            return i == __npos() ? end() : __iterator_at(i);
+        }
+
+        const_iterator find(const key_type& k) const{
+            return const_cast<__flat_hashtable*>(this)->find(k);
+        }
+
+        bool contains(const key_type& k) const{
+            return __find_index(k, __hash(k)) != __npos();
+        }
+
+    private:
+        static size_type __npos() noexcept { return size_type(-1); }
+
+        // 槽数为 cap 时最多容纳的元素个数。槽数小于 15 时一组就能覆盖全部槽，
+        // 且组内总有复制区之外的空字节，可以填满
+        static size_type __growth_for(size_type cap) noexcept { return cap - cap / 8; }
+
+        // 能容纳 n 个元素的最小槽数
+        static size_type __capacity_for(size_type n) noexcept{
+            if (n == 0)
+                return 0;
+            size_type cap = 1;
+            while (__growth_for(cap) < n)
+                cap = cap * 2 + 1;
+            return cap;
+        }
+
+        // 不小于 n 的 2^k - 1
+        static size_type __normalize_capacity(size_type n) noexcept{
+            size_type cap = 1;
+            while (cap < n)
+                cap = cap * 2 + 1;
+            return cap;
+        }
+
+        size_t __hash(const key_type& k) const { return __hash_finish(impl_.hash_(k), __hash_is_avalanching<Hash>()); }
+        static size_t __h1(size_t h) noexcept { return h >> 7; }
+        static __ctrl_t __h2(size_t h) noexcept { return static_cast<__ctrl_t>(h & 0x7F); }
+
+        iterator __iterator_at(size_type i) noexcept { return iterator(impl_.ctrl_ + i, impl_.slots_ + i); }
+
+        // 写控制字节，开头 15 个字节同时写到哨兵之后的复制区
+        static void __set_ctrl(__ctrl_t* ctrl, size_type cap, size_type i, __ctrl_t c) noexcept{
+            ctrl[i] = c;
+            ctrl[((i - (__group_width - 1)) & cap) + ((__group_width - 1) & cap)] = c;
+        }
+
+        static void __reset_ctrl(__ctrl_t* ctrl, size_type cap) noexcept{
+            std::memset(ctrl, static_cast<unsigned char>(__ctrl_empty), cap + __group_width);
+            ctrl[cap] = __ctrl_sentinel;
+        }
+
+        /**
+         * 探测序列：从 H1 对应的位置起按组前进，第 i 次跳过 i 组（三角数步长），
+         * 槽数为 2^k - 1 时能遍历所有的组起点
+         */
+        size_type __find_index(const key_type& k, size_t h) const{
+            const size_type mask = impl_.capacity_;
+            size_type offset = __h1(h) & mask;
+            size_type step = 0;
+            const __ctrl_t h2 = __h2(h);
+            while (true){
+                __flat_group g(impl_.ctrl_ + offset);
+                for (uint32_t m = g.match(h2); m != 0; m &= m - 1){
+                    const size_type i = (offset + __simd_ctz(m)) & mask;
+                    if (impl_.eq_(k, __key(impl_.slots_[i])))
+                        return i;
+                }
+                if (g.mask_empty() != 0)
+                    return __npos();
+                step += __group_width;
+                offset = (offset + step) & mask;
+            }
+        }
+
+        // 第一个空槽或已删除的槽
+        static size_type __find_first_non_full(const __ctrl_t* ctrl, size_type cap, size_t h) noexcept{
+            size_type offset = __h1(h) & cap;
+            size_type step = 0;
+            while (true){
+                const uint32_t m = __flat_group(ctrl + offset).mask_empty_or_deleted();
+                if (m != 0)
+                    return (offset + __simd_ctz(m)) & cap;
+                step += __group_width;
+                offset = (offset + step) & cap;
+            }
+        }
+
+        // 找到插入位置，必要时扩容；控制字节在元素构造成功后才写入
+        size_type __prepare_insert(size_t h){
+            size_type i = __find_first_non_full(impl_.ctrl_, impl_.capacity_, h);
+            if (impl_.growth_left_ == 0 && impl_.ctrl_[i] != __ctrl_deleted){
+                __grow();
+                i = __find_first_non_full(impl_.ctrl_, impl_.capacity_, h);
+            }
+            return i;
+        }
+
+        void __commit_insert(size_type i, size_t h) noexcept{
+            if (impl_.ctrl_[i] == __ctrl_empty)
+                --impl_.growth_left_;
+            __set_ctrl(impl_.ctrl_, impl_.capacity_, i, __h2(h));
+            ++impl_.size_;
+        }
+
+        // 已删除的槽占了一半以上的余量时原地重建以清除，否则槽数翻倍
+        void __grow(){
+            const size_type cap = impl_.capacity_;
+            if (cap > __group_width && impl_.size_ * 32 <= cap * 25)
+                __resize(cap);
+            else
+                __resize(cap == 0 ? 1 : cap * 2 + 1);
+        }
+
+        /**
+         * 删除后能否把槽置为空：若包含该槽的任意 16 个连续控制字节都有空槽，
+         * 则不会有探测序列因该槽满而越过它，置空不会截断其它元素的探测
+         */
+        void __erase_at(size_type i) noexcept{
+            simple_stl::destroy(impl_.slots_ + i);
+            --impl_.size_;
+            const size_type cap = impl_.capacity_;
+            bool was_never_full = cap < __group_width - 1;
+            if (!was_never_full){
+                const size_type before = (i - __group_width) & cap;
+                const uint32_t empty_after = __flat_group(impl_.ctrl_ + i).mask_empty();
+                const uint32_t empty_before = __flat_group(impl_.ctrl_ + before).mask_empty();
+                was_never_full = empty_before != 0 && empty_after != 0 &&
+                        __simd_ctz(empty_after) + __flat_clz16(empty_before) < (unsigned)__group_width;
+            }
+            __set_ctrl(impl_.ctrl_, cap, i, was_never_full ? __ctrl_empty : __ctrl_deleted);
+            if (was_never_full)
+                ++impl_.growth_left_;
+        }
+
+        __ctrl_t* __allocate_ctrl(size_type cap){
+            ctrl_allocator a(__slot_alloc());
+            __ctrl_t* ctrl = ctrl_traits::allocate(a, cap + __group_width);
+            __reset_ctrl(ctrl, cap);
+            return ctrl;
+        }
+
+        void __deallocate_arrays(__ctrl_t* ctrl, Slot* slots, size_type cap) noexcept{
+            if (cap == 0)
+                return;
+            ctrl_allocator a(__slot_alloc());
+            ctrl_traits::deallocate(a, ctrl, cap + __group_width);
+            slot_traits::deallocate(__slot_alloc(), slots, cap);
+        }
+
+        static void __destroy_full(__ctrl_t* ctrl, Slot* slots, size_type cap) noexcept{
+            for (size_type i = 0; i < cap; ++i)
+                if (__ctrl_is_full(ctrl[i]))
+                    simple_stl::destroy(slots + i);
+        }
+
+        void __destroy_slots(__true_type_s) noexcept {}
+
+        void __destroy_slots(__false_type_s) noexcept{
+            __destroy_full(impl_.ctrl_, impl_.slots_, impl_.capacity_);
+        }
+
+        // 析构全部元素并归还数组，回到空表
+        void __release() noexcept{
+            if (impl_.capacity_ == 0)
+                return;
+            __destroy_slots(typename __type_traits_s<Slot>::have_trivial_destructor());
+            __deallocate_arrays(impl_.ctrl_, impl_.slots_, impl_.capacity_);
+            impl_.__reset();
+        }
+
+        static void __relocate(Slot* from, Slot* to, __true_type_s) noexcept{
+            std::memcpy(static_cast<void*>(to), static_cast<const void*>(from), sizeof(Slot));
+        }
+
+        static void __relocate(Slot* from, Slot* to, __false_type_s){
+            simple_stl::__uninitialized_move_if_noexcept(from, from + 1, to);
+        }
+
+        // 重新散列到 new_cap 个槽中；失败时新数组全部归还，原表不变
+        void __resize(size_type new_cap){
+            typedef bool_constant_s<is_trivially_relocatable<Slot>::value> trivially_relocatable;
+            if (new_cap == 0){
+                __release();
+                return;
+            }
+            __ctrl_t* const old_ctrl = impl_.ctrl_;
+            Slot* const old_slots = impl_.slots_;
+            const size_type old_cap = impl_.capacity_;
+
+            __ctrl_t* new_ctrl = __allocate_ctrl(new_cap);
+            Slot* new_slots;
+            try {
+                new_slots = slot_traits::allocate(__slot_alloc(), new_cap);
+            }catch(...){
+                ctrl_allocator a(__slot_alloc());
+                ctrl_traits::deallocate(a, new_ctrl, new_cap + __group_width);
+                throw;
+            }
+            try {
+                for (size_type i = 0; i < old_cap; ++i){
+                    if (!__ctrl_is_full(old_ctrl[i]))
+                        continue;
+                    const size_t h = __hash(__key(old_slots[i]));
+                    const size_type j = __find_first_non_full(new_ctrl, new_cap, h);
+                    __relocate(old_slots + i, new_slots + j, trivially_relocatable());
+                    __set_ctrl(new_ctrl, new_cap, j, __h2(h));
+                }
+            }catch(...){
+                if (!trivially_relocatable::value)
+                    __destroy_full(new_ctrl, new_slots, new_cap);
+                __deallocate_arrays(new_ctrl, new_slots, new_cap);
+                throw;
+            }
+            if (!trivially_relocatable::value)
+                __destroy_full(old_ctrl, old_slots, old_cap);
+            __deallocate_arrays(old_ctrl, old_slots, old_cap);
+
+            impl_.ctrl_ = new_ctrl;
+            impl_.slots_ = new_slots;
+            impl_.capacity_ = new_cap;
+            impl_.growth_left_ = __growth_for(new_cap) - impl_.size_;
+        }
+
+        template<class InputIterator>
+        void __reserve_for_range(InputIterator, InputIterator, input_iterator_tag) {}
+
+        template<class ForwardIterator>
+        void __reserve_for_range(ForwardIterator first, ForwardIterator last, forward_iterator_tag){
+            reserve(impl_.size_ + static_cast<size_type>(simple_stl::distance(first, last)));
+        }
+
+        // 槽数与控制字节原样复制，元素逐个拷贝构造到相同位置，不需要重新散列
+        void __copy_from(const __flat_hashtable& other){
+            if (other.impl_.size_ == 0)
+                return;
+            const size_type cap = other.impl_.capacity_;
+            __ctrl_t* ctrl = __allocate_ctrl(cap);
+            Slot* slots;
+            try {
+                slots = slot_traits::allocate(__slot_alloc(), cap);
+            }catch(...){
+                ctrl_allocator a(__slot_alloc());
+                ctrl_traits::deallocate(a, ctrl, cap + __group_width);
+                throw;
+            }
+            size_type i = 0;
+            try {
+                for ( ; i < cap; ++i)
+                    if (__ctrl_is_full(other.impl_.ctrl_[i]))
+                        simple_stl::construct(slots + i, other.impl_.slots_[i]);
+            }catch(...){
+                for (size_type j = 0; j < i; ++j)
+                    if (__ctrl_is_full(other.impl_.ctrl_[j]))
+                        simple_stl::destroy(slots + j);
+                __deallocate_arrays(ctrl, slots, cap);
+                throw;
+            }
+            std::memcpy(ctrl, other.impl_.ctrl_, cap + __group_width);
+            impl_.ctrl_ = ctrl;
+            impl_.slots_ = slots;
+            impl_.capacity_ = cap;
+            impl_.size_ = other.impl_.size_;
+            impl_.growth_left_ = other.impl_.growth_left_;
+        }
+
+        void __steal(__flat_hashtable& other) noexcept{
+            impl_.ctrl_ = other.impl_.ctrl_;
+            impl_.slots_ = other.impl_.slots_;
+            impl_.size_ = other.impl_.size_;
+            impl_.capacity_ = other.impl_.capacity_;
+            impl_.growth_left_ = other.impl_.growth_left_;
+            other.impl_.__reset();
+        }
+
+        void __copy_assign_alloc(const __flat_hashtable& other, __true_type_s){
+            __slot_alloc() = other.__slot_alloc();
+        }
+
+        void __copy_assign_alloc(const __flat_hashtable&, __false_type_s) {}
+
+        // 可以接管对方的数组
+        void __move_assign(__flat_hashtable& other, __true_type_s){
+            __release();
+            __move_assign_alloc(other, typename slot_traits::propagate_on_container_move_assignment());
+            impl_.hash_ = other.impl_.hash_;
+            impl_.eq_ = other.impl_.eq_;
+            __steal(other);
+        }
+
+        // 配置器不传播，相等时接管数组，否则逐一移动元素
+        void __move_assign(__flat_hashtable& other, __false_type_s){
+            if (__slot_alloc() == other.__slot_alloc()){
+                __move_assign(other, __true_type_s());
+            }else{
+                clear();
+                impl_.hash_ = other.impl_.hash_;
+                impl_.eq_ = other.impl_.eq_;
+                reserve(other.size());
+                for (iterator it = other.begin(); it != other.end(); ++it)
+                    insert_unique(simple_stl::move(*it.slot_));
+                other.__release();
+            }
+        }
+
+        void __move_assign_alloc(__flat_hashtable& other, __true_type_s){
+            __slot_alloc() = simple_stl::move(other.__slot_alloc());
+        }
+
+        void __move_assign_alloc(__flat_hashtable&, __false_type_s) {}
+
+        void __swap_alloc(__flat_hashtable& other, __true_type_s){
+            simple_stl::swap(__slot_alloc(), other.__slot_alloc());
+        }
+
+        void __swap_alloc(__flat_hashtable&, __false_type_s) {}
+    };
+
+}   // simple_stl
+
+#endif //SIMPLESTL_STL_FLAT_HASHTABLE_H
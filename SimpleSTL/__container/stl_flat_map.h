@@ -0,0 +1,258 @@
+/**
+ * Created by 史进 on 2023/6/18.
+ *
+ * flat_map：以 __flat_tree 为底层，元素为 pair<Key, T>，按键有序地连续存放
+ *  - 适合批量构建、频繁查找的表：没有节点开销，查找用无分支的二分查找
+ *  - 批量插入请用区间版 insert，排序后一趟合并，至多重新配置一次
+ *  - 元素类型的键不是 const，通过迭代器修改键会破坏有序性，使用者不应修改
+ */
+#ifndef SIMPLESTL_STL_FLAT_MAP_H
+#define SIMPLESTL_STL_FLAT_MAP_H
+
+#include <initializer_list>
+#include <stdexcept>
+
+#include "stl_flat_tree.h"
+#include "../__functional/stl_function.h"
+
+namespace simple_stl{
+
+    template<class Key, class T, class Compare = less<Key>, class Alloc = allocator<pair<Key, T> > >
+    class flat_map{
+    public:
+        typedef Key                     key_type;
+        typedef T                       mapped_type;
+        typedef pair<Key, T>            value_type;
+        typedef Compare                 key_compare;
+        typedef Alloc                   allocator_type;
+
+    private:
+        typedef __flat_tree<key_type, value_type, select1st<value_type>, key_compare, Alloc> rep_type;
+        rep_type tree_;
+
+    public:
+        typedef typename rep_type::value_compare        value_compare;
+        typedef typename rep_type::container_type       container_type;
+        typedef typename rep_type::size_type            size_type;
+        typedef typename rep_type::difference_type      difference_type;
+        typedef value_type&                             reference;
+        typedef const value_type&                       const_reference;
+        typedef value_type*                             pointer;
+        typedef const value_type*                       const_pointer;
+        typedef typename rep_type::iterator             iterator;
+        typedef typename rep_type::const_iterator       const_iterator;
+
+        /** 构造 */
+        flat_map() : tree_() {}
+
+        explicit flat_map(const Compare& comp, const Alloc& a = Alloc()) : tree_(comp, a) {}
+
+        explicit flat_map(const Alloc& a) : tree_(Compare(), a) {}
+
+        template<class InputIterator, typename enable_if<
+                is_input_iterator<InputIterator>::value, int>::type = 0>
+        flat_map(InputIterator first, InputIterator last, const Compare& comp = Compare(), const Alloc& a = Alloc())
+        : tree_(comp, a){
+            tree_.insert_range_unique(first, last);
+        }
+
+        // 区间已按键排好序且键互不相同
+        template<class InputIterator, typename enable_if<
+                is_input_iterator<InputIterator>::value, int>::type = 0>
+        flat_map(sorted_unique_t, InputIterator first, InputIterator last,
+                 const Compare& comp = Compare(), const Alloc& a = Alloc())
+        : tree_(comp, a){
+            tree_.insert_sorted_unique(first, last);
+        }
+
+        flat_map(std::initializer_list<value_type> il, const Compare& comp = Compare(), const Alloc& a = Alloc())
+        : tree_(comp, a){
+            tree_.insert_range_unique(il.begin(), il.end());
+        }
+
+        flat_map(sorted_unique_t, std::initializer_list<value_type> il,
+                 const Compare& comp = Compare(), const Alloc& a = Alloc())
+        : tree_(comp, a){
+            tree_.insert_sorted_unique(il.begin(), il.end());
+        }
+
+        flat_map(const flat_map& other) : tree_(other.tree_) {}
+        flat_map(const flat_map& other, const Alloc& a) : tree_(other.tree_, a) {}
+        flat_map(flat_map&& other) noexcept : tree_(simple_stl::move(other.tree_)) {}
+
+        /** 赋值 */
+        flat_map& operator=(const flat_map& other){
+            tree_ = other.tree_;
+            return *this;
+        }
+
+        flat_map& operator=(flat_map&& other) noexcept(noexcept(tree_ = simple_stl::move(other.tree_))){
+            tree_ = simple_stl::move(other.tree_);
+            return *this;
+        }
+
+        flat_map& operator=(std::initializer_list<value_type> il){
+            tree_.clear();
+            tree_.insert_range_unique(il.begin(), il.end());
+            return *this;
+        }
+
+        allocator_type get_allocator() const { return tree_.get_allocator(); }
+        key_compare key_comp() const { return tree_.key_comp(); }
+        value_compare value_comp() const { return tree_.value_comp(); }
+
+        /** 迭代器 */
+        iterator begin() noexcept { return tree_.begin(); }
+        const_iterator begin() const noexcept { return tree_.begin(); }
+        const_iterator cbegin() const noexcept { return tree_.begin(); }
+        iterator end() noexcept { return tree_.end(); }
+        const_iterator end() const noexcept { return tree_.end(); }
+        const_iterator cend() const noexcept { return tree_.end(); }
+
+        /** 容量 */
+        bool empty() const noexcept { return tree_.empty(); }
+        size_type size() const noexcept { return tree_.size(); }
+        size_type max_size() const noexcept { return tree_.max_size(); }
+        size_type capacity() const noexcept { return tree_.capacity(); }
+        void reserve(size_type n) { tree_.reserve(n); }
+        void shrink_to_fit() { tree_.shrink_to_fit(); }
+
+        /** 元素访问 */
+        // 键不存在时插入值初始化的元素
+        mapped_type& operator[](const key_type& k){
+            return try_emplace(k).first->second;
+        }
+
+        mapped_type& operator[](key_type&& k){
+            return try_emplace(simple_stl::move(k)).first->second;
+        }
+
+        mapped_type& at(const key_type& k){
+            iterator it = find(k);
+            if (it == end())
+                throw std::out_of_range("flat_map::at");
+            return it->second;
+        }
+
+        const mapped_type& at(const key_type& k) const{
+            const_iterator it = find(k);
+            if (it == end())
+                throw std::out_of_range("flat_map::at");
+            return it->second;
+        }
+
+        /** 修改 */
+        pair<iterator, bool> insert(const value_type& v) { return tree_.insert_unique(v); }
+        pair<iterator, bool> insert(value_type&& v) { return tree_.insert_unique(simple_stl::move(v)); }
+
+        template<class P, typename enable_if<
+                std::is_constructible<value_type, P&&>::value, int>::type = 0>
+        pair<iterator, bool> insert(P&& p) { return tree_.emplace_unique(simple_stl::forward<P>(p)); }
+
+        iterator insert(const_iterator hint, const value_type& v) { return tree_.insert_hint_unique(hint, v); }
+
+        iterator insert(const_iterator hint, value_type&& v){
+            return tree_.insert_hint_unique(hint, simple_stl::move(v));
+        }
+
+        template<class InputIterator, typename enable_if<
+                is_input_iterator<InputIterator>::value, int>::type = 0>
+        void insert(InputIterator first, InputIterator last) { tree_.insert_range_unique(first, last); }
+
+        // 区间已按键排好序且键互不相同，省去排序
+        template<class InputIterator, typename enable_if<
+                is_input_iterator<InputIterator>::value, int>::type = 0>
+        void insert(sorted_unique_t, InputIterator first, InputIterator last){
+            tree_.insert_sorted_unique(first, last);
+        }
+
+        void insert(std::initializer_list<value_type> il) { tree_.insert_range_unique(il.begin(), il.end()); }
+
+        template<class... Args>
+        pair<iterator, bool> emplace(Args&&... args){
+            return tree_.emplace_unique(simple_stl::forward<Args>(args)...);
+        }
+
+        template<class... Args>
+        iterator emplace_hint(const_iterator hint, Args&&... args){
+            value_type tmp(simple_stl::forward<Args>(args)...);
+            return tree_.insert_hint_unique(hint, simple_stl::move(tmp));
+        }
+
+        // 键不存在时才构造元素，键存在时 args 不被移动
+        template<class... Args>
+        pair<iterator, bool> try_emplace(const key_type& k, Args&&... args){
+            iterator it = lower_bound(k);
+            if (it != end() && !key_comp()(k, it->first))
+                return pair<iterator, bool>(it, false);
+            return pair<iterator, bool>(tree_.emplace_at(it, k, mapped_type(simple_stl::forward<Args>(args)...)), true);
+        }
+
+        template<class... Args>
+        pair<iterator, bool> try_emplace(key_type&& k, Args&&... args){
+            iterator it = lower_bound(k);
+            if (it != end() && !key_comp()(k, it->first))
+                return pair<iterator, bool>(it, false);
+            return pair<iterator, bool>(tree_.emplace_at(it, simple_stl::move(k),
+                    mapped_type(simple_stl::forward<Args>(args)...)), true);
+        }
+
+        template<class M>
+        pair<iterator, bool> insert_or_assign(const key_type& k, M&& obj){
+            iterator it = lower_bound(k);
+            if (it != end() && !key_comp()(k, it->first)){
+                it->second = simple_stl::forward<M>(obj);
+                return pair<iterator, bool>(it, false);
+            }
+            return pair<iterator, bool>(tree_.emplace_at(it, k, simple_stl::forward<M>(obj)), true);
+        }
+
+        iterator erase(const_iterator pos) { return tree_.erase(pos); }
+        iterator erase(iterator pos) { return tree_.erase(pos); }
+        iterator erase(const_iterator first, const_iterator last) { return tree_.erase(first, last); }
+        size_type erase(const key_type& k) { return tree_.erase(k); }
+
+        void clear() noexcept { tree_.clear(); }
+        void swap(flat_map& other) noexcept { tree_.swap(other.tree_); }
+
+        // 取走底层数组；replace 换用已按键排好序且键互不相同的数组
+        container_type extract() { return tree_.extract(); }
+        void replace(container_type&& c) { tree_.replace(simple_stl::move(c)); }
+
+        /** 查找 */
+        iterator find(const key_type& k) { return tree_.find(k); }
+        const_iterator find(const key_type& k) const { return tree_.find(k); }
+        size_type count(const key_type& k) const { return tree_.contains(k) ? 1 : 0; }
+        bool contains(const key_type& k) const { return tree_.contains(k); }
+
+        iterator lower_bound(const key_type& k) { return tree_.lower_bound(k); }
+        const_iterator lower_bound(const key_type& k) const { return tree_.lower_bound(k); }
+        iterator upper_bound(const key_type& k) { return tree_.upper_bound(k); }
+        const_iterator upper_bound(const key_type& k) const { return tree_.upper_bound(k); }
+        pair<iterator, iterator> equal_range(const key_type& k) { return tree_.equal_range(k); }
+        pair<const_iterator, const_iterator> equal_range(const key_type& k) const { return tree_.equal_range(k); }
+    };
+
+    template<class Key, class T, class Compare, class Alloc>
+    inline bool operator==(const flat_map<Key, T, Compare, Alloc>& x, const flat_map<Key, T, Compare, Alloc>& y){
+        if (x.size() != y.size())
+            return false;
+        for (typename flat_map<Key, T, Compare, Alloc>::const_iterator i = x.begin(), j = y.begin(); i != x.end(); ++i, ++j)
+            if (!(*i == *j))
+                return false;
+        return true;
+    }
+
+    template<class Key, class T, class Compare, class Alloc>
+    inline bool operator!=(const flat_map<Key, T, Compare, Alloc>& x, const flat_map<Key, T, Compare, Alloc>& y){
+        return !(x == y);
+    }
+
+    template<class Key, class T, class Compare, class Alloc>
+    inline void swap(flat_map<Key, T, Compare, Alloc>& x, flat_map<Key, T, Compare, Alloc>& y) noexcept{
+        x.swap(y);
+    }
+
+}   // simple_stl
+
+#endif //SIMPLESTL_STL_FLAT_MAP_H
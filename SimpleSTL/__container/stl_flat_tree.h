@@ -0,0 +1,243 @@
+/**
+ * Created by 史进 on 2023/6/18.
+ *
+ * __flat_tree：flat_map、flat_set 共用的有序数组，键互不相同
+ *  - 元素按键有序地连续存放在 vector 中，没有节点开销，查找用无分支的二分查找
+ *  - 单个插入、删除借助 vector 成段移动元素，享有其平凡类型的快速路径
+ *  - 区间插入先把新元素收集到临时数组中排序、去重，再与原有元素一趟合并，至多重新配置一次
+ *  - 插入、删除会使插入点之后的迭代器与引用失效，重新配置时全部失效
+ */
+#ifndef SIMPLESTL_STL_FLAT_TREE_H
+#define SIMPLESTL_STL_FLAT_TREE_H
+
+#include "stl_vector.h"
+#include "../__algorithm/stl_sort.h"
+#include "../iterator.h"
+#include "../utility.h"
+
+namespace simple_stl{
+
+    template<class Key, class Value, class KeyOfValue, class Compare, class Alloc>
+    class __flat_tree{
+    public:
+        typedef Key                                     key_type;
+        typedef Value                                   value_type;
+        typedef Compare                                 key_compare;
+        typedef Alloc                                   allocator_type;
+        typedef vector<Value, Alloc>                    container_type;
+        typedef typename container_type::size_type      size_type;
+        typedef typename container_type::difference_type difference_type;
+        typedef typename container_type::iterator       iterator;
+        typedef typename container_type::const_iterator const_iterator;
+
+        // 按键比较两个元素
+        struct value_compare{
+            Compare comp;
+
+            bool operator()(const Value& x, const Value& y) const { return comp(KeyOfValue()(x), KeyOfValue()(y)); }
+        };
+
+    private:
+        Compare comp_;
+        container_type c_;
+
+    public:
+        /** 构造 */
+        explicit __flat_tree(const Compare& comp = Compare(), const Alloc& a = Alloc()) : comp_(comp), c_(a) {}
+
+        __flat_tree(const __flat_tree& other, const Alloc& a) : comp_(other.comp_), c_(other.c_, a) {}
+
+        key_compare key_comp() const { return comp_; }
+        value_compare value_comp() const { return value_compare{comp_}; }
+        allocator_type get_allocator() const { return c_.get_allocator(); }
+
+        /** 迭代器 */
+        iterator begin() noexcept { return c_.begin(); }
+        const_iterator begin() const noexcept { return c_.begin(); }
+        iterator end() noexcept { return c_.end(); }
+        const_iterator end() const noexcept { return c_.end(); }
+
+        /** 容量 */
+        bool empty() const noexcept { return c_.empty(); }
+        size_type size() const noexcept { return c_.size(); }
+        size_type max_size() const noexcept { return c_.max_size(); }
+        size_type capacity() const noexcept { return c_.capacity(); }
+        void reserve(size_type n) { c_.reserve(n); }
+        void shrink_to_fit() { c_.shrink_to_fit(); }
+
+        /** 插入 */
+        template<class V>
+        pair<iterator, bool> insert_unique(V&& v){
+            const key_type& k = KeyOfValue()(v);
+            iterator pos = lower_bound(k);
+            if (pos != end() && !comp_(k, KeyOfValue()(*pos)))
+                return pair<iterator, bool>(pos, false);
+            return pair<iterator, bool>(c_.insert(pos, simple_stl::forward<V>(v)), true);
+        }
+
+        // hint 恰为插入位置时省去查找
+        template<class V>
+        iterator insert_hint_unique(const_iterator hint, V&& v){
+            const key_type& k = KeyOfValue()(v);
+            if ((hint == begin() || comp_(KeyOfValue()(*(hint - 1)), k)) &&
+                (hint == end() || comp_(k, KeyOfValue()(*hint))))
+                return c_.insert(hint, simple_stl::forward<V>(v));
+            return insert_unique(simple_stl::forward<V>(v)).first;
+        }
+
+        template<class... Args>
+        pair<iterator, bool> emplace_unique(Args&&... args){
+            value_type tmp(simple_stl::forward<Args>(args)...);
+            return insert_unique(simple_stl::move(tmp));
+        }
+
+        // pos 须为新元素的键应处的位置，通常由 lower_bound 得到
+        template<class... Args>
+        iterator emplace_at(const_iterator pos, Args&&... args){
+            return c_.emplace(pos, simple_stl::forward<Args>(args)...);
+        }
+
+        template<class InputIterator>
+        void insert_range_unique(InputIterator first, InputIterator last){
+            container_type batch(first, last, c_.get_allocator());
+            __insert_batch(batch, false);
+        }
+
+        // 区间已按键排好序时省去排序
+        template<class InputIterator>
+        void insert_sorted_unique(InputIterator first, InputIterator last){
+            container_type batch(first, last, c_.get_allocator());
+            __insert_batch(batch, true);
+        }
+
+        /** 删除 */
+        iterator erase(const_iterator pos) { return c_.erase(pos); }
+        iterator erase(const_iterator first, const_iterator last) { return c_.erase(first, last); }
+
+        size_type erase(const key_type& k){
+            const_iterator pos = find(k);
+            if (pos == end())
+                return 0;
+            c_.erase(pos);
+            return 1;
+        }
+
+        void clear() noexcept { c_.clear(); }
+
+        void swap(__flat_tree& other) noexcept{
+            simple_stl::swap(comp_, other.comp_);
+            c_.swap(other.c_);
+        }
+
+        // 取走底层数组，容器随之变空
+        container_type extract(){
+            container_type c(simple_stl::move(c_));
+            c_.clear();
+            return c;
+        }
+
+        // 换用调用者给出的数组，要求其已按键排好序且键互不相同
+        void replace(container_type&& c){
+            c_ = simple_stl::move(c);
+        }
+
+        /** 查找 */
+        // 无分支的二分查找：每轮把区间缩小一半，比较结果只用来选择起点，编译器生成条件传送而非跳转
+        iterator lower_bound(const key_type& k){
+            return begin() + (__lower_bound(k) - c_.data());
+        }
+
+        const_iterator lower_bound(const key_type& k) const{
+            return __lower_bound(k);
+        }
+
+        iterator upper_bound(const key_type& k){
+            return begin() + (__upper_bound(k) - c_.data());
+        }
+
+        const_iterator upper_bound(const key_type& k) const{
+            return __upper_bound(k);
+        }
+
+        iterator find(const key_type& k){
+            iterator pos = lower_bound(k);
+            return pos != end() && !comp_(k, KeyOfValue()(*pos)) ? pos : end();
+        }
+
+        const_iterator find(const key_type& k) const{
+            const_iterator pos = lower_bound(k);
+            return pos != end() && !comp_(k, KeyOfValue()(*pos)) ? pos : end();
+        }
+
+        bool contains(const key_type& k) const { return find(k) != end(); }
+
+        pair<iterator, iterator> equal_range(const key_type& k){
+            iterator first = lower_bound(k);
+            iterator last = first;
+            if (last != end() && !comp_(k, KeyOfValue()(*last)))
+                ++last;
+            return pair<iterator, iterator>(first, last);
+        }
+
+        pair<const_iterator, const_iterator> equal_range(const key_type& k) const{
+            const_iterator first = lower_bound(k);
+            const_iterator last = first;
+            if (last != end() && !comp_(k, KeyOfValue()(*last)))
+                ++last;
+            return pair<const_iterator, const_iterator>(first, last);
+        }
+
+    private:
+        const value_type* __lower_bound(const key_type& k) const{
+            const value_type* base = c_.data();
+            size_type len = c_.size();
+            if (len == 0)
+                return base;
+            while (len > 1){
+                const size_type half = len / 2;
+                base = comp_(KeyOfValue()(base[half]), k) ? base + half : base;
+                len -= half;
+            }
+            return base + comp_(KeyOfValue()(*base), k);
+        }
+
+        const value_type* __upper_bound(const key_type& k) const{
+            const value_type* base = c_.data();
+            size_type len = c_.size();
+            if (len == 0)
+                return base;
+            while (len > 1){
+                const size_type half = len / 2;
+                base = comp_(k, KeyOfValue()(base[half])) ? base : base + half;
+                len -= half;
+            }
+            return base + !comp_(k, KeyOfValue()(*base));
+        }
+
+        // 排序后原地去重并剔除已有的键，再一趟并入
+        void __insert_batch(container_type& batch, bool sorted){
+            if (batch.empty())
+                return;
+            value_type* first = batch.data();
+            value_type* last = first + batch.size();
+            // 稳定排序保证区间中键相同的元素以先出现者为准
+            if (!sorted)
+                simple_stl::stable_sort(first, last, value_comp());
+            value_type* out = first;
+            for (value_type* it = first; it != last; ++it){
+                const key_type& k = KeyOfValue()(*it);
+                if (out != first && !comp_(KeyOfValue()(*(out - 1)), k))
+                    continue;
+                if (contains(k))
+                    continue;
+                if (out != it)
+                    *out = simple_stl::move(*it);
+                ++out;
+            }
+            c_.__merge_sorted(first, out, value_comp());
+        }
+    };
+
+}   // simple_stl
+
+#endif //SIMPLESTL_STL_FLAT_TREE_H
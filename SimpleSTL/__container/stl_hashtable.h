@@ -0,0 +1,705 @@
+/**
+ * Created by 史进 on 2023/6/18.
+ *
+ * hashtable：unordered_map、unordered_set 共用的开链哈希表
+ *  - 桶数为 2 的幂，节点缓存混合后的哈希值，迁移时不必重新计算键的哈希
+ *  - 节点经 rebind 后的配置器配置，默认的 allocator 走带线程缓存的内存池
+ *  - 渐进式扩容：负载超过上限时配置新桶数组，新旧两个桶数组同时存在，
+ *    此后每次插入最多把旧数组中 rehash_step 个桶的节点搬到新数组，
+ *    查找与删除在迁移期间两个数组都要查；全部迁移完后释放旧数组。
+ *    rehash_step 为 0（默认）时一次迁移完，与通常的哈希表相同
+ *  - 迁移只搬动节点，不配置内存也不移动元素，元素的指针与引用始终有效；
+ *    迭代器在可能触发迁移的插入之后失效
+ *  - 两个桶数组与迁移进度放在单独配置的 __hash_buckets 中，迭代器指向它而不是容器，
+ *    swap 与移动只交换指针，迭代器随元素一起转到另一个容器
+ */
+#ifndef SIMPLESTL_STL_HASHTABLE_H
+#define SIMPLESTL_STL_HASHTABLE_H
+
+#include <cstddef>
+#include <new>
+
+#include "../iterator.h"
+#include "../type_traits.h"
+#include "../utility.h"
+#include "../__functional/stl_hash.h"
+#include "../__memory/stl_allocator.h"
+#include "../__memory/stl_allocator_traits.h"
+#include "../__memory/stl_construct.h"
+
+namespace simple_stl{
+
+    struct __hash_node_base{
+        __hash_node_base* next_;
+        size_t hash_;
+    };
+
+    template<class Value>
+    struct __hash_node : public __hash_node_base{
+        Value value_;
+    };
+
+    struct __hash_bucket_array{
+        __hash_node_base** buckets_;
+        size_t count_;
+        size_t size_;
+
+        void __reset() noexcept{
+            buckets_ = nullptr;
+            count_ = 0;
+            size_ = 0;
+        }
+    };
+
+    // tables_[0] 为当前数组，迁移期间 tables_[1] 为新数组
+    struct __hash_buckets{
+        __hash_bucket_array tables_[2];
+        size_t rehash_index_;       // 旧数组中下一个待迁移的桶，不在迁移时为 npos
+
+        constexpr __hash_buckets() noexcept
+        : tables_{{nullptr, 0, 0}, {nullptr, 0, 0}}, rehash_index_(size_t(-1)) {}
+
+        bool __rehashing() const noexcept { return rehash_index_ != size_t(-1); }
+
+        size_t __size() const noexcept { return tables_[0].size_ + tables_[1].size_; }
+
+        // 从 tables_[t] 的第 b 个桶起的第一个节点，旧数组之后接着找新数组
+        __hash_node_base* __first_from(int t, size_t b) const noexcept{
+            for ( ; t < 2; ++t, b = 0){
+                const __hash_bucket_array& tb = tables_[t];
+                for ( ; b < tb.count_; ++b)
+                    if (tb.buckets_[b] != nullptr)
+                        return tb.buckets_[b];
+            }
+            return nullptr;
+        }
+
+        // 遍历顺序：旧数组的各桶，然后新数组的各桶
+        __hash_node_base* __next_node(__hash_node_base* p) const noexcept{
+            if (p->next_ != nullptr)
+                return p->next_;
+            const size_t h = p->hash_;
+            for (int t = 0; t < 2; ++t){
+                const __hash_bucket_array& tb = tables_[t];
+                if (tb.count_ == 0)
+                    continue;
+                const size_t b = h & (tb.count_ - 1);
+                for (__hash_node_base* q = tb.buckets_[b]; q != nullptr; q = q->next_)
+                    if (q == p)
+                        return __first_from(t, b + 1);
+            }
+            return nullptr;
+        }
+    };
+
+    // 尚未配置桶数组的容器共用的空状态，只读
+    inline __hash_buckets* __empty_hash_buckets() noexcept{
+        static __hash_buckets empty;
+        return &empty;
+    }
+
+    template<class Value, class Ref, class Ptr>
+    struct __hashtable_iterator{
+        typedef __hashtable_iterator<Value, Value&, Value*>             iterator;
+        typedef __hashtable_iterator<Value, const Value&, const Value*> const_iterator;
+        typedef __hashtable_iterator                                    self;
+
+        typedef forward_iterator_tag    iterator_category;
+        typedef Value                   value_type;
+        typedef Ptr                     pointer;
+        typedef Ref                     reference;
+        typedef ptrdiff_t               difference_type;
+        typedef __hash_node<Value>*     link_type;
+
+        __hash_node_base* node_;
+        const __hash_buckets* buckets_;
+
+        __hashtable_iterator() noexcept : node_(nullptr), buckets_(nullptr) {}
+        __hashtable_iterator(__hash_node_base* node, const __hash_buckets* buckets) noexcept
+        : node_(node), buckets_(buckets) {}
+
+        // iterator 可转换为 const_iterator
+        __hashtable_iterator(const iterator& other) noexcept : node_(other.node_), buckets_(other.buckets_) {}
+
+        __hashtable_iterator& operator=(const __hashtable_iterator&) = default;
+
+        reference operator*() const { return static_cast<link_type>(node_)->value_; }
+        pointer operator->() const { return &static_cast<link_type>(node_)->value_; }
+
+        self& operator++(){
+            node_ = buckets_->__next_node(node_);
+            return *this;
+        }
+
+        self operator++(int){
+            self tmp = *this;
+            node_ = buckets_->__next_node(node_);
+            return tmp;
+        }
+
+        template<class R, class P>
+        bool operator==(const __hashtable_iterator<Value, R, P>& x) const { return node_ == x.node_; }
+
+        template<class R, class P>
+        bool operator!=(const __hashtable_iterator<Value, R, P>& x) const { return node_ != x.node_; }
+    };
+
+
+    template<class Value, class Key, class KeyOfValue, class Hash, class KeyEqual, class Alloc = allocator<Value> >
+    class hashtable{
+    public:
+        typedef Key                                                                 key_type;
+        typedef Value                                                               value_type;
+        typedef Hash                                                                hasher;
+        typedef KeyEqual                                                            key_equal;
+        typedef Alloc                                                               allocator_type;
+        typedef size_t                                                              size_type;
+        typedef ptrdiff_t                                                           difference_type;
+        typedef __hashtable_iterator<Value, Value&, Value*>                         iterator;
+        typedef __hashtable_iterator<Value, const Value&, const Value*>             const_iterator;
+
+    private:
+        typedef __hash_node_base                                                        node_base;
+        typedef __hash_node<Value>                                                      node;
+        typedef typename allocator_traits<Alloc>::template rebind_alloc<node>           node_allocator;
+        typedef allocator_traits<node_allocator>                                        node_traits;
+        typedef typename allocator_traits<Alloc>::template rebind_alloc<node_base*>     bucket_allocator;
+        typedef allocator_traits<bucket_allocator>                                      bucket_traits;
+        typedef typename allocator_traits<Alloc>::template rebind_alloc<__hash_buckets> state_allocator;
+        typedef allocator_traits<state_allocator>                                       state_traits;
+        typedef __hash_bucket_array                                                     __bucket_array;
+
+        enum {__min_buckets = 8};
+        enum {__empty_visits_per_step = 10};    // 每迁移一个桶最多跳过的空桶数
+
+        // 继承节点配置器以便无状态配置器不占空间。buckets_ 在第一次需要桶数组时才配置，
+        // 此前指向共用的空状态
+        struct __hashtable_impl : public node_allocator{
+            Hash hash_;
+            KeyEqual eq_;
+            float max_load_factor_;
+            __hash_buckets* buckets_;
+            size_type rehash_step_;
+
+            __hashtable_impl(const Hash& h, const KeyEqual& eq, const node_allocator& a)
+            : node_allocator(a), hash_(h), eq_(eq), max_load_factor_(1.0f), rehash_step_(0) { __reset(); }
+
+            void __reset() noexcept { buckets_ = __empty_hash_buckets(); }
+        };
+
+        __hashtable_impl impl_;
+
+        node_allocator& __node_alloc() noexcept { return impl_; }
+        const node_allocator& __node_alloc() const noexcept { return impl_; }
+
+        static size_type __npos() noexcept { return size_type(-1); }
+        static const Key& __key(const node_base* p) { return KeyOfValue()(static_cast<const node*>(p)->value_); }
+        static size_t __node_hash(const node_base* p) noexcept { return p->hash_; }
+
+    public:
+        /** 构造、析构 */
+        explicit hashtable(size_type n = 0, const Hash& h = Hash(), const KeyEqual& eq = KeyEqual(),
+                           const Alloc& a = Alloc())
+        : impl_(h, eq, node_allocator(a)){
+            if (n > 0){
+                try {
+                    __own_buckets();
+                    impl_.buckets_->tables_[0] = __allocate_buckets(__bucket_count_for(n));
+                }catch(...){
+                    __release();
+                    throw;
+                }
+            }
+        }
+
+        hashtable(const hashtable& other)
+        : impl_(other.impl_.hash_, other.impl_.eq_,
+                node_traits::select_on_container_copy_construction(other.__node_alloc())){
+            __copy_from(other);
+        }
+
+        hashtable(const hashtable& other, const Alloc& a)
+        : impl_(other.impl_.hash_, other.impl_.eq_, node_allocator(a)){
+            __copy_from(other);
+        }
+
+        hashtable(hashtable&& other) noexcept
+        : impl_(other.impl_.hash_, other.impl_.eq_, simple_stl::move(other.__node_alloc())){
+            __steal(other);
+        }
+
+        ~hashtable(){
+            __release();
+        }
+
+        /** 赋值 */
+        hashtable& operator=(const hashtable& other){
+            if (this != &other){
+                __release();
+                __copy_assign_alloc(other, typename node_traits::propagate_on_container_copy_assignment());
+                impl_.hash_ = other.impl_.hash_;
+                impl_.eq_ = other.impl_.eq_;
+                __copy_from(other);
+            }
+            return *this;
+        }
+
+        hashtable& operator=(hashtable&& other) noexcept(
+                node_traits::propagate_on_container_move_assignment::value ||
+                node_traits::is_always_equal::value){
+            if (this != &other)
+                __move_assign(other, bool_constant_s<
+                        node_traits::propagate_on_container_move_assignment::value ||
+                        node_traits::is_always_equal::value>());
+            return *this;
+        }
+
+        allocator_type get_allocator() const { return allocator_type(__node_alloc()); }
+        hasher hash_function() const { return impl_.hash_; }
+        key_equal key_eq() const { return impl_.eq_; }
+
+        /** 迭代器 */
+        iterator begin() noexcept { return iterator(impl_.buckets_->__first_from(0, 0), impl_.buckets_); }
+        const_iterator begin() const noexcept { return const_iterator(impl_.buckets_->__first_from(0, 0), impl_.buckets_); }
+        iterator end() noexcept { return iterator(nullptr, impl_.buckets_); }
+        const_iterator end() const noexcept { return const_iterator(nullptr, impl_.buckets_); }
+
+        /** 容量 */
+        size_type size() const noexcept { return impl_.buckets_->__size(); }
+        bool empty() const noexcept { return size() == 0; }
+        size_type max_size() const noexcept { return node_traits::max_size(__node_alloc()); }
+
+        /** 插入 */
+        // 按键 k 查找，不存在时配置节点并调用 construct_fn(value_type*) 构造元素
+        template<class ConstructFn>
+        pair<iterator, bool> emplace_key_with(const key_type& k, ConstructFn construct_fn){
+            const size_t h = __hash(k);
+            node_base* p = __find_node(k, h);
+            if (p != nullptr)
+                return pair<iterator, bool>(iterator(p, impl_.buckets_), false);
+            node* z = node_traits::allocate(__node_alloc(), 1);
+            try {
+                construct_fn(&z->value_);
+            }catch(...){
+                node_traits::deallocate(__node_alloc(), z, 1);
+                throw;
+            }
+            z->hash_ = h;
+            __insert_node_or_destroy(z);
+            return pair<iterator, bool>(iterator(z, impl_.buckets_), true);
+        }
+
+        template<class... Args>
+        pair<iterator, bool> emplace_key_args(const key_type& k, Args&&... args){
+            return emplace_key_with(k, [&](value_type* p){
+                simple_stl::construct(p, simple_stl::forward<Args>(args)...);
+            });
+        }
+
+        template<class V>
+        pair<iterator, bool> insert_unique(V&& v){
+            return emplace_key_args(KeyOfValue()(v), simple_stl::forward<V>(v));
+        }
+
+        // 节点只构造一次，键已存在时销毁
+        template<class... Args>
+        pair<iterator, bool> emplace_unique(Args&&... args){
+            node* z = __create_node(simple_stl::forward<Args>(args)...);
+            node_base* p;
+            try {
+                z->hash_ = __hash(__key(z));
+                p = __find_node(__key(z), z->hash_);
+            }catch(...){
+                __destroy_node(z);
+                throw;
+            }
+            if (p != nullptr){
+                __destroy_node(z);
+                return pair<iterator, bool>(iterator(p, impl_.buckets_), false);
+            }
+            __insert_node_or_destroy(z);
+            return pair<iterator, bool>(iterator(z, impl_.buckets_), true);
+        }
+
+        template<class InputIterator>
+        void insert_range_unique(InputIterator first, InputIterator last){
+            for ( ; first != last; ++first)
+                insert_unique(*first);
+        }
+
+        /** 删除 */
+        iterator erase(const_iterator pos){
+            node_base* next = impl_.buckets_->__next_node(pos.node_);
+            __unlink_node(pos.node_);
+            __destroy_node(static_cast<node*>(pos.node_));
+            return iterator(next, impl_.buckets_);
+        }
+
+        iterator erase(const_iterator first, const_iterator last){
+            while (first != last)
+                first = erase(first);
+            return iterator(last.node_, impl_.buckets_);
+        }
+
+        size_type erase(const key_type& k){
+            const size_t h = __hash(k);
+            node_base* p = __find_node(k, h);
+            if (p == nullptr)
+                return 0;
+            __unlink_node(p);
+            __destroy_node(static_cast<node*>(p));
+            return 1;
+        }
+
+        // 释放全部节点，结束正在进行的迁移，保留当前桶数组
+        void clear() noexcept{
+            if (!__owns_buckets())
+                return;
+            for (int t = 0; t < 2; ++t){
+                __bucket_array& tb = impl_.buckets_->tables_[t];
+                for (size_type b = 0; b < tb.count_; ++b){
+                    node_base* p = tb.buckets_[b];
+                    while (p != nullptr){
+                        node_base* next = p->next_;
+                        __destroy_node(static_cast<node*>(p));
+                        p = next;
+                    }
+                    tb.buckets_[b] = nullptr;
+                }
+                tb.size_ = 0;
+            }
+            if (__rehashing()){
+                __deallocate_buckets(impl_.buckets_->tables_[1]);
+                impl_.buckets_->tables_[1].__reset();
+                impl_.buckets_->rehash_index_ = __npos();
+            }
+        }
+
+        void swap(hashtable& other) noexcept{
+            __swap_alloc(other, typename node_traits::propagate_on_container_swap());
+            simple_stl::swap(impl_.hash_, other.impl_.hash_);
+            simple_stl::swap(impl_.eq_, other.impl_.eq_);
+            simple_stl::swap(impl_.max_load_factor_, other.impl_.max_load_factor_);
+            simple_stl::swap(impl_.buckets_, other.impl_.buckets_);
+            simple_stl::swap(impl_.rehash_step_, other.impl_.rehash_step_);
+        }
+
+        /** 查找 */
+        iterator find(const key_type& k){
+            return iterator(__find_node(k, __hash(k)), impl_.buckets_);
+        }
+
+        const_iterator find(const key_type& k) const{
+            return const_iterator(__find_node(k, __hash(k)), impl_.buckets_);
+        }
+
+        bool contains(const key_type& k) const{
+            return __find_node(k, __hash(k)) != nullptr;
+        }
+
+        /** 散列策略 */
+        // 迁移期间为新数组的桶数
+        size_type bucket_count() const noexcept{
+            return impl_.buckets_->tables_[__rehashing() ? 1 : 0].count_;
+        }
+
+        float load_factor() const noexcept{
+            const size_type n = bucket_count();
+            return n == 0 ? 0.0f : static_cast<float>(size()) / n;
+        }
+
+        float max_load_factor() const noexcept { return impl_.max_load_factor_; }
+
+        void max_load_factor(float ml) noexcept { impl_.max_load_factor_ = ml > 0.0f ? ml : 1.0f; }
+
+        // 显式调用时一次完成：先结束正在进行的迁移，再重建为至少 n 个桶且满足负载上限
+        void rehash(size_type n){
+            __migrate(__npos());
+            size_type count = __bucket_count_for(size());
+            if (n > count)
+                count = __round_up_pow2(n);
+            if (count != impl_.buckets_->tables_[0].count_){
+                __start_rehash(count);
+                __migrate(__npos());
+            }
+        }
+
+        void reserve(size_type n){
+            if (__bucket_count_for(n) > bucket_count())
+                rehash(__bucket_count_for(n));
+        }
+
+        /** 渐进式扩容 */
+        // 每次插入最多迁移的桶数，0 表示扩容时一次迁移完
+        void set_rehash_step(size_type n) noexcept { impl_.rehash_step_ = n; }
+        size_type rehash_step() const noexcept { return impl_.rehash_step_; }
+
+        bool rehashing() const noexcept { return __rehashing(); }
+
+        // 主动推进迁移，最多迁移 n 个桶，返回迁移是否已完成；可在空闲时调用
+        bool migrate(size_type n){
+            __migrate(n);
+            return !__rehashing();
+        }
+
+    private:
+        bool __rehashing() const noexcept { return impl_.buckets_->__rehashing(); }
+
+        bool __owns_buckets() const noexcept { return impl_.buckets_ != __empty_hash_buckets(); }
+
+        // 需要写入桶数组之前调用，仍指向共用的空状态时配置自己的一份
+        void __own_buckets(){
+            if (__owns_buckets())
+                return;
+            state_allocator a(__node_alloc());
+            __hash_buckets* p = state_traits::allocate(a, 1);
+            impl_.buckets_ = ::new (static_cast<void*>(p)) __hash_buckets();
+        }
+
+        size_t __hash(const key_type& k) const { return __hash_finish(impl_.hash_(k), __hash_is_avalanching<Hash>()); }
+
+        static size_type __round_up_pow2(size_type n) noexcept{
+            size_type count = __min_buckets;
+            while (count < n)
+                count <<= 1;
+            return count;
+        }
+
+        // 容纳 n 个元素且不超过负载上限的桶数
+        size_type __bucket_count_for(size_type n) const noexcept{
+            return __round_up_pow2(static_cast<size_type>(static_cast<float>(n) / impl_.max_load_factor_) + 1);
+        }
+
+        // 旧数组中已迁移的桶为空，迁移期间新插入的键在新数组中，两个数组都要查
+        node_base* __find_node(const key_type& k, size_t h) const{
+            for (int t = 0; t < 2; ++t){
+                const __bucket_array& tb = impl_.buckets_->tables_[t];
+                if (tb.count_ == 0)
+                    continue;
+                for (node_base* p = tb.buckets_[h & (tb.count_ - 1)]; p != nullptr; p = p->next_)
+                    if (__node_hash(p) == h && impl_.eq_(k, __key(p)))
+                        return p;
+            }
+            return nullptr;
+        }
+
+        // 插入前推进迁移并检查负载；迁移期间插入新数组
+        void __insert_node(node* z){
+            if (__rehashing())
+                __migrate(impl_.rehash_step_ == 0 ? __npos() : impl_.rehash_step_);
+            const size_type target = __rehashing() ? 1 : 0;
+            if (static_cast<float>(size() + 1) > static_cast<float>(impl_.buckets_->tables_[target].count_) * impl_.max_load_factor_)
+                __grow();
+            __bucket_array& tb = impl_.buckets_->tables_[__rehashing() ? 1 : 0];
+            node_base*& head = tb.buckets_[z->hash_ & (tb.count_ - 1)];
+            z->next_ = head;
+            head = z;
+            ++tb.size_;
+        }
+
+        // 扩容配置桶数组失败时节点尚未挂入，销毁后重新抛出
+        void __insert_node_or_destroy(node* z){
+            try {
+                __insert_node(z);
+            }catch(...){
+                __destroy_node(z);
+                throw;
+            }
+        }
+
+        // 新数组也将超载时先完成当前迁移；随后配置翻倍的新数组，并按步长迁移
+        void __grow(){
+            __migrate(__npos());
+            const size_type count = impl_.buckets_->tables_[0].count_;
+            __start_rehash(count == 0 ? __bucket_count_for(size() + 1) : count * 2);
+            __migrate(impl_.rehash_step_ == 0 ? __npos() : impl_.rehash_step_);
+        }
+
+        // 没有旧数组时直接以新数组为当前数组
+        void __start_rehash(size_type count){
+            __own_buckets();
+            __bucket_array fresh = __allocate_buckets(count);
+            if (impl_.buckets_->tables_[0].count_ == 0){
+                impl_.buckets_->tables_[0] = fresh;
+                return;
+            }
+            impl_.buckets_->tables_[1] = fresh;
+            impl_.buckets_->rehash_index_ = 0;
+        }
+
+        // 最多迁移 n 个非空桶，跳过的空桶数也有上限，以限制单次操作的工作量
+        void __migrate(size_type n) noexcept{
+            if (!__rehashing())
+                return;
+            __bucket_array& from = impl_.buckets_->tables_[0];
+            __bucket_array& to = impl_.buckets_->tables_[1];
+            size_type empty_visits = n == __npos() ? __npos() : n * __empty_visits_per_step;
+            for ( ; n > 0 && impl_.buckets_->rehash_index_ < from.count_; --n){
+                while (impl_.buckets_->rehash_index_ < from.count_ && from.buckets_[impl_.buckets_->rehash_index_] == nullptr){
+                    ++impl_.buckets_->rehash_index_;
+                    if (--empty_visits == 0)
+                        break;
+                }
+                if (impl_.buckets_->rehash_index_ == from.count_ || empty_visits == 0)
+                    break;
+                node_base* p = from.buckets_[impl_.buckets_->rehash_index_];
+                while (p != nullptr){
+                    node_base* next = p->next_;
+                    node_base*& head = to.buckets_[__node_hash(p) & (to.count_ - 1)];
+                    p->next_ = head;
+                    head = p;
+                    --from.size_;
+                    ++to.size_;
+                    p = next;
+                }
+                from.buckets_[impl_.buckets_->rehash_index_] = nullptr;
+                ++impl_.buckets_->rehash_index_;
+            }
+            if (impl_.buckets_->rehash_index_ == from.count_){
+                __deallocate_buckets(from);
+                from = to;
+                to.__reset();
+                impl_.buckets_->rehash_index_ = __npos();
+            }
+        }
+
+        // 在节点所在的桶中找到其前驱并摘下
+        void __unlink_node(node_base* z) noexcept{
+            const size_t h = __node_hash(z);
+            for (int t = 0; t < 2; ++t){
+                __bucket_array& tb = impl_.buckets_->tables_[t];
+                if (tb.count_ == 0)
+                    continue;
+                for (node_base** link = &tb.buckets_[h & (tb.count_ - 1)]; *link != nullptr; link = &(*link)->next_){
+                    if (*link == z){
+                        *link = z->next_;
+                        --tb.size_;
+                        return;
+                    }
+                }
+            }
+        }
+
+        template<class... Args>
+        node* __create_node(Args&&... args){
+            node* p = node_traits::allocate(__node_alloc(), 1);
+            try {
+                simple_stl::construct(&p->value_, simple_stl::forward<Args>(args)...);
+            }catch(...){
+                node_traits::deallocate(__node_alloc(), p, 1);
+                throw;
+            }
+            return p;
+        }
+
+        void __destroy_node(node* p) noexcept{
+            simple_stl::destroy(&p->value_);
+            node_traits::deallocate(__node_alloc(), p, 1);
+        }
+
+        __bucket_array __allocate_buckets(size_type count){
+            bucket_allocator a(__node_alloc());
+            __bucket_array tb;
+            tb.buckets_ = bucket_traits::allocate(a, count);
+            for (size_type b = 0; b < count; ++b)
+                tb.buckets_[b] = nullptr;
+            tb.count_ = count;
+            tb.size_ = 0;
+            return tb;
+        }
+
+        void __deallocate_buckets(__bucket_array& tb) noexcept{
+            if (tb.count_ == 0)
+                return;
+            bucket_allocator a(__node_alloc());
+            bucket_traits::deallocate(a, tb.buckets_, tb.count_);
+        }
+
+        void __release() noexcept{
+            if (!__owns_buckets())
+                return;
+            clear();
+            __deallocate_buckets(impl_.buckets_->tables_[0]);
+            state_allocator a(__node_alloc());
+            state_traits::deallocate(a, impl_.buckets_, 1);
+            impl_.__reset();
+        }
+
+        // 复制到单个桶数组中，节点带着缓存的哈希值，不需要重新计算
+        void __copy_from(const hashtable& other){
+            impl_.max_load_factor_ = other.impl_.max_load_factor_;
+            impl_.rehash_step_ = other.impl_.rehash_step_;
+            if (other.empty())
+                return;
+            try {
+                __own_buckets();
+                impl_.buckets_->tables_[0] = __allocate_buckets(other.bucket_count());
+                __bucket_array& tb = impl_.buckets_->tables_[0];
+                for (const_iterator it = other.begin(); it != other.end(); ++it){
+                    node* z = __create_node(*it);
+                    z->hash_ = __node_hash(it.node_);
+                    node_base*& head = tb.buckets_[z->hash_ & (tb.count_ - 1)];
+                    z->next_ = head;
+                    head = z;
+                    ++tb.size_;
+                }
+            }catch(...){
+                __release();
+                throw;
+            }
+        }
+
+        void __steal(hashtable& other) noexcept{
+            impl_.max_load_factor_ = other.impl_.max_load_factor_;
+            impl_.rehash_step_ = other.impl_.rehash_step_;
+            impl_.buckets_ = other.impl_.buckets_;
+            other.impl_.__reset();
+        }
+
+        void __copy_assign_alloc(const hashtable& other, __true_type_s){
+            __node_alloc() = other.__node_alloc();
+        }
+
+        void __copy_assign_alloc(const hashtable&, __false_type_s) {}
+
+        // 可以接管对方的节点
+        void __move_assign(hashtable& other, __true_type_s){
+            __release();
+            __move_assign_alloc(other, typename node_traits::propagate_on_container_move_assignment());
+            impl_.hash_ = other.impl_.hash_;
+            impl_.eq_ = other.impl_.eq_;
+            __steal(other);
+        }
+
+        // 配置器不传播，相等时接管节点，否则逐一移动元素
+        void __move_assign(hashtable& other, __false_type_s){
+            if (__node_alloc() == other.__node_alloc()){
+                __move_assign(other, __true_type_s());
+            }else{
+                clear();
+                impl_.hash_ = other.impl_.hash_;
+                impl_.eq_ = other.impl_.eq_;
+                impl_.max_load_factor_ = other.impl_.max_load_factor_;
+                impl_.rehash_step_ = other.impl_.rehash_step_;
+                for (iterator it = other.begin(); it != other.end(); ++it)
+                    emplace_unique(simple_stl::move(*it));
+                other.__release();
+            }
+        }
+
+        void __move_assign_alloc(hashtable& other, __true_type_s){
+            __node_alloc() = simple_stl::move(other.__node_alloc());
+        }
+
+        void __move_assign_alloc(hashtable&, __false_type_s) {}
+
+        void __swap_alloc(hashtable& other, __true_type_s){
+            simple_stl::swap(__node_alloc(), other.__node_alloc());
+        }
+
+        void __swap_alloc(hashtable&, __false_type_s) {}
+    };
+
+}   // simple_stl
+
+#endif //SIMPLESTL_STL_HASHTABLE_H
@@ -0,0 +1,751 @@
+/**
+ * Created by 史进 on 2023/6/15.
+ *
+ * list：带哨兵节点的环状双向链表
+ *  - 节点经 rebind 后的配置器配置。默认的 allocator 走带线程缓存的内存池；
+ *    使用 node_pool_allocator 时节点来自单独的节点池，可以由一个 list 独占，也可以由多个 list 共享
+ *  - splice、merge、sort、reverse 只改动节点间的链接，不配置内存，也不拷贝元素
+ *  - 哨兵节点存放在 list 对象内，交换与移动后 end() 随对象而变
+ */
+#ifndef SIMPLESTL_STL_LIST_H
+#define SIMPLESTL_STL_LIST_H
+
+#include <cstddef>
+#include <initializer_list>
+
+#include "../iterator.h"
+#include "../type_traits.h"
+#include "../utility.h"
+#include "../__memory/stl_allocator.h"
+#include "../__memory/stl_allocator_traits.h"
+#include "../__memory/stl_construct.h"
+
+namespace simple_stl{
+
+    struct __list_node_base{
+        __list_node_base* prev_;
+        __list_node_base* next_;
+
+        // 将 [first, last) 从原位置摘下，接到本节点之前
+        void __transfer(__list_node_base* first, __list_node_base* last) noexcept{
+            if (this == last)
+                return;
+            last->prev_->next_ = this;
+            first->prev_->next_ = last;
+            prev_->next_ = first;
+            __list_node_base* tmp = prev_;
+            prev_ = last->prev_;
+            last->prev_ = first->prev_;
+            first->prev_ = tmp;
+        }
+
+        // 从链表中摘下本节点
+        void __unhook() noexcept{
+            prev_->next_ = next_;
+            next_->prev_ = prev_;
+        }
+
+        // 接到 pos 之前
+        void __hook(__list_node_base* pos) noexcept{
+            next_ = pos;
+            prev_ = pos->prev_;
+            pos->prev_->next_ = this;
+            pos->prev_ = this;
+        }
+    };
+
+    template<class T>
+    struct __list_node : public __list_node_base{
+        T data_;
+    };
+
+    template<class T, class Ref, class Ptr>
+    struct __list_iterator{
+        typedef __list_iterator<T, T&, T*>              iterator;
+        typedef __list_iterator<T, const T&, const T*>  const_iterator;
+        typedef __list_iterator                         self;
+
+        typedef bidirectional_iterator_tag  iterator_category;
+        typedef T                           value_type;
+        typedef Ptr                         pointer;
+        typedef Ref                         reference;
+        typedef ptrdiff_t                   difference_type;
+        typedef __list_node<T>*             link_type;
+
+        __list_node_base* node_;
+
+        __list_iterator() noexcept : node_(nullptr) {}
+        explicit __list_iterator(__list_node_base* node) noexcept : node_(node) {}
+
+        // iterator 可转换为 const_iterator
+        __list_iterator(const iterator& other) noexcept : node_(other.node_) {}
+
+        __list_iterator& operator=(const __list_iterator&) = default;
+
+        reference operator*() const { return static_cast<link_type>(node_)->data_; }
+        pointer operator->() const { return &static_cast<link_type>(node_)->data_; }
+
+        self& operator++(){
+            node_ = node_->next_;
+            return *this;
+        }
+
+        self operator++(int){
+            self tmp = *this;
+            node_ = node_->next_;
+            return tmp;
+        }
+
+        self& operator--(){
+            node_ = node_->prev_;
+            return *this;
+        }
+
+        self operator--(int){
+            self tmp = *this;
+            node_ = node_->prev_;
+            return tmp;
+        }
+
+        template<class R, class P>
+        bool operator==(const __list_iterator<T, R, P>& x) const { return node_ == x.node_; }
+
+        template<class R, class P>
+        bool operator!=(const __list_iterator<T, R, P>& x) const { return node_ != x.node_; }
+    };
+
+
+    template<class T, class Alloc = allocator<T> >
+    class list{
+    public:
+        typedef T                                           value_type;
+        typedef Alloc                                       allocator_type;
+        typedef size_t                                      size_type;
+        typedef ptrdiff_t                                   difference_type;
+        typedef T&                                          reference;
+        typedef const T&                                    const_reference;
+        typedef T*                                          pointer;
+        typedef const T*                                    const_pointer;
+        typedef __list_iterator<T, T&, T*>                  iterator;
+        typedef __list_iterator<T, const T&, const T*>      const_iterator;
+
+    private:
+        typedef __list_node_base                                        node_base;
+        typedef __list_node<T>                                          node;
+        typedef typename allocator_traits<Alloc>::template rebind_alloc<node> node_allocator;
+        typedef allocator_traits<node_allocator>                        node_traits;
+        typedef allocator_traits<Alloc>                                 alloc_traits;
+
+        // 继承节点配置器以便无状态配置器不占空间，哨兵节点与元素个数随对象存放
+        struct __list_impl : public node_allocator{
+            node_base head_;
+            size_type size_;
+
+            __list_impl() : node_allocator(), size_(0) { __reset(); }
+            explicit __list_impl(const node_allocator& a) : node_allocator(a), size_(0) { __reset(); }
+
+            void __reset() noexcept{
+                head_.prev_ = head_.next_ = &head_;
+                size_ = 0;
+            }
+        };
+
+        __list_impl impl_;
+
+        node_allocator& __node_alloc() noexcept { return impl_; }
+        const node_allocator& __node_alloc() const noexcept { return impl_; }
+
+        node_base* __head() noexcept { return &impl_.head_; }
+        const node_base* __head() const noexcept { return &impl_.head_; }
+
+    public:
+        /** 构造、析构 */
+        list() : impl_() {}
+
+        explicit list(const Alloc& a) : impl_(node_allocator(a)) {}
+
+        explicit list(size_type n, const Alloc& a = Alloc()) : impl_(node_allocator(a)){
+            try {
+                for ( ; n > 0; --n)
+                    emplace_back();
+            }catch(...){
+                clear();
+                throw;
+            }
+        }
+
+        list(size_type n, const T& value, const Alloc& a = Alloc()) : impl_(node_allocator(a)){
+            try {
+                insert(end(), n, value);
+            }catch(...){
+                clear();
+                throw;
+            }
+        }
+
+        template<class InputIterator, typename enable_if<
+                is_input_iterator<InputIterator>::value, int>::type = 0>
+        list(InputIterator first, InputIterator last, const Alloc& a = Alloc()) : impl_(node_allocator(a)){
+            __range_init(first, last);
+        }
+
+        list(std::initializer_list<T> il, const Alloc& a = Alloc()) : impl_(node_allocator(a)){
+            __range_init(il.begin(), il.end());
+        }
+
+        list(const list& other)
+        : impl_(node_traits::select_on_container_copy_construction(other.__node_alloc())){
+            __range_init(other.begin(), other.end());
+        }
+
+        list(const list& other, const Alloc& a) : impl_(node_allocator(a)){
+            __range_init(other.begin(), other.end());
+        }
+
+        list(list&& other) noexcept : impl_(simple_stl::move(other.__node_alloc())){
+            __steal(other);
+        }
+
+        ~list(){
+            clear();
+        }
+
+        /** 赋值 */
+        list& operator=(const list& other){
+            if (this != &other){
+                __copy_assign_alloc(other,
+                        typename node_traits::propagate_on_container_copy_assignment());
+                assign(other.begin(), other.end());
+            }
+            return *this;
+        }
+
+        list& operator=(list&& other) noexcept(
+                node_traits::propagate_on_container_move_assignment::value ||
+                node_traits::is_always_equal::value){
+            if (this != &other)
+                __move_assign(other, bool_constant_s<
+                        node_traits::propagate_on_container_move_assignment::value ||
+                        node_traits::is_always_equal::value>());
+            return *this;
+        }
+
+        list& operator=(std::initializer_list<T> il){
+            assign(il.begin(), il.end());
+            return *this;
+        }
+
+        // 复用已有节点，多删少补
+        void assign(size_type n, const T& value){
+            iterator cur = begin();
+            for ( ; cur != end() && n > 0; ++cur, --n)
+                *cur = value;
+            if (n > 0)
+                insert(end(), n, value);
+            else
+                erase(cur, end());
+        }
+
+        template<class InputIterator, typename enable_if<
+                is_input_iterator<InputIterator>::value, int>::type = 0>
+        void assign(InputIterator first, InputIterator last){
+            iterator cur = begin();
+            for ( ; cur != end() && first != last; ++cur, ++first)
+                *cur = *first;
+            if (first == last)
+                erase(cur, end());
+            else
+                insert(end(), first, last);
+        }
+
+        void assign(std::initializer_list<T> il){
+            assign(il.begin(), il.end());
+        }
+
+        allocator_type get_allocator() const{
+            return allocator_type(__node_alloc());
+        }
+
+        /** 迭代器 */
+        iterator begin() noexcept { return iterator(impl_.head_.next_); }
+        const_iterator begin() const noexcept { return const_iterator(impl_.head_.next_); }
+        const_iterator cbegin() const noexcept { return begin(); }
+        iterator end() noexcept { return iterator(__head()); }
+        const_iterator end() const noexcept { return const_iterator(const_cast<node_base*>(__head())); }
+        const_iterator cend() const noexcept { return end(); }
+
+        /** 容量 */
+        size_type size() const noexcept { return impl_.size_; }
+        bool empty() const noexcept { return impl_.size_ == 0; }
+
+        size_type max_size() const noexcept{
+            return node_traits::max_size(__node_alloc());
+        }
+
+        void resize(size_type n){
+            if (n < size()){
+                erase(__at(n), end());
+            }else{
+                for (n -= size(); n > 0; --n)
+                    emplace_back();
+            }
+        }
+
+        void resize(size_type n, const T& value){
+            if (n < size())
+                erase(__at(n), end());
+            else
+                insert(end(), n - size(), value);
+        }
+
+        /** 元素访问 */
+        reference front() { return *begin(); }
+        const_reference front() const { return *begin(); }
+        reference back() { return *iterator(impl_.head_.prev_); }
+        const_reference back() const { return *const_iterator(impl_.head_.prev_); }
+
+        /** 修改 */
+        void push_back(const T& value) { emplace_back(value); }
+        void push_back(T&& value) { emplace_back(simple_stl::move(value)); }
+        void push_front(const T& value) { emplace_front(value); }
+        void push_front(T&& value) { emplace_front(simple_stl::move(value)); }
+
+        template<class... Args>
+        reference emplace_back(Args&&... args){
+            return *emplace(end(), simple_stl::forward<Args>(args)...);
+        }
+
+        template<class... Args>
+        reference emplace_front(Args&&... args){
+            return *emplace(begin(), simple_stl::forward<Args>(args)...);
+        }
+
+        void pop_back() { erase(const_iterator(impl_.head_.prev_)); }
+        void pop_front() { erase(begin()); }
+
+        template<class... Args>
+        iterator emplace(const_iterator pos, Args&&... args){
+            node* p = __create_node(simple_stl::forward<Args>(args)...);
+            p->__hook(pos.node_);
+            ++impl_.size_;
+            return iterator(p);
+        }
+
+        iterator insert(const_iterator pos, const T& value){
+            return emplace(pos, value);
+        }
+
+        iterator insert(const_iterator pos, T&& value){
+            return emplace(pos, simple_stl::move(value));
+        }
+
+        // 先在临时链表中建好全部节点再整体接入，失败时原链表不变
+        iterator insert(const_iterator pos, size_type n, const T& value){
+            list tmp(get_allocator());
+            for ( ; n > 0; --n)
+                tmp.emplace_back(value);
+            return __splice_all(pos, tmp);
+        }
+
+        template<class InputIterator, typename enable_if<
+                is_input_iterator<InputIterator>::value, int>::type = 0>
+        iterator insert(const_iterator pos, InputIterator first, InputIterator last){
+            list tmp(get_allocator());
+            for ( ; first != last; ++first)
+                tmp.emplace_back(*first);
+            return __splice_all(pos, tmp);
+        }
+
+        iterator insert(const_iterator pos, std::initializer_list<T> il){
+            return insert(pos, il.begin(), il.end());
+        }
+
+        iterator erase(const_iterator pos){
+            node_base* next = pos.node_->next_;
+            pos.node_->__unhook();
+            __destroy_node(static_cast<node*>(pos.node_));
+            --impl_.size_;
+            return iterator(next);
+        }
+
+        iterator erase(const_iterator first, const_iterator last){
+            while (first != last)
+                first = erase(first);
+            return iterator(last.node_);
+        }
+
+        // 平凡析构的元素不逐一析构，只归还节点
+        void clear() noexcept{
+            __clear_nodes(typename __type_traits_s<T>::have_trivial_destructor());
+            impl_.__reset();
+        }
+
+        void swap(list& other) noexcept{
+            __swap_alloc(other, typename node_traits::propagate_on_container_swap());
+            __swap_links(other);
+        }
+
+        /** 链表操作：只改动链接 */
+        // 将 other 的全部节点接到 pos 之前，两者的配置器必须相等
+        void splice(const_iterator pos, list& other){
+            if (!other.empty())
+                __splice_all(pos, other);
+        }
+
+        void splice(const_iterator pos, list&& other){
+            splice(pos, other);
+        }
+
+        // 将 other 中 it 所指的节点接到 pos 之前
+        void splice(const_iterator pos, list& other, const_iterator it){
+            node_base* next = it.node_->next_;
+            if (pos.node_ == it.node_ || pos.node_ == next)
+                return;
+            pos.node_->__transfer(it.node_, next);
+            ++impl_.size_;
+            --other.impl_.size_;
+        }
+
+        void splice(const_iterator pos, list&& other, const_iterator it){
+            splice(pos, other, it);
+        }
+
+        // 将 other 中的 [first, last) 接到 pos 之前，来自另一个 list 时需要 O(n) 计数
+        void splice(const_iterator pos, list& other, const_iterator first, const_iterator last){
+            if (first == last)
+                return;
+            if (this != &other){
+                const size_type n = static_cast<size_type>(simple_stl::distance(first, last));
+                impl_.size_ += n;
+                other.impl_.size_ -= n;
+            }
+            pos.node_->__transfer(first.node_, last.node_);
+        }
+
+        void splice(const_iterator pos, list&& other, const_iterator first, const_iterator last){
+            splice(pos, other, first, last);
+        }
+
+        // 删除的节点先移到临时链表，防止 value 引用的正是被删除的元素
+        void remove(const T& value){
+            list deleted(get_allocator());
+            for (iterator first = begin(); first != end(); ){
+                iterator next = first;
+                ++next;
+                if (*first == value)
+                    deleted.splice(deleted.end(), *this, first);
+                first = next;
+            }
+        }
+
+        template<class Predicate>
+        void remove_if(Predicate pred){
+            for (iterator first = begin(); first != end(); ){
+                if (pred(*first))
+                    first = erase(first);
+                else
+                    ++first;
+            }
+        }
+
+        // 删除连续重复的元素，只保留第一个
+        void unique(){
+            unique(__equal_to());
+        }
+
+        template<class BinaryPredicate>
+        void unique(BinaryPredicate pred){
+            iterator first = begin();
+            if (first == end())
+                return;
+            iterator next = first;
+            while (++next != end()){
+                if (pred(*first, *next))
+                    erase(next);
+                else
+                    first = next;
+                next = first;
+            }
+        }
+
+        // 将有序的 other 并入有序的本链表，相等元素中本链表的在前
+        void merge(list& other){
+            merge(other, __less());
+        }
+
+        void merge(list&& other){
+            merge(other, __less());
+        }
+
+        template<class Compare>
+        void merge(list& other, Compare comp){
+            if (this == &other)
+                return;
+            node_base* first1 = impl_.head_.next_;
+            node_base* last1 = __head();
+            node_base* first2 = other.impl_.head_.next_;
+            node_base* last2 = other.__head();
+            while (first1 != last1 && first2 != last2){
+                if (comp(__value(first2), __value(first1))){
+                    // 将 other 中连续小于 *first1 的一段一次接过来
+                    node_base* next = first2->next_;
+                    while (next != last2 && comp(__value(next), __value(first1)))
+                        next = next->next_;
+                    first1->__transfer(first2, next);
+                    first2 = next;
+                }else{
+                    first1 = first1->next_;
+                }
+            }
+            if (first2 != last2)
+                last1->__transfer(first2, last2);
+            impl_.size_ += other.impl_.size_;
+            other.impl_.size_ = 0;
+        }
+
+        template<class Compare>
+        void merge(list&& other, Compare comp){
+            merge(other, comp);
+        }
+
+        void reverse() noexcept{
+            node_base* cur = __head();
+            do {
+                node_base* tmp = cur->next_;
+                cur->next_ = cur->prev_;
+                cur->prev_ = tmp;
+                cur = tmp;
+            } while (cur != __head());
+        }
+
+        void sort(){
+            sort(__less());
+        }
+
+        // 自底向上的归并排序，稳定：先断开成以 next_ 串起的单链，
+        // 第 i 个槽存放长度为 2^i 的有序段，逐个节点并入后再合并各槽，最后补回 prev_
+        template<class Compare>
+        void sort(Compare comp){
+            if (impl_.size_ < 2)
+                return;
+            node_base* bins[64] = {};
+            size_t fill = 0;
+            impl_.head_.prev_->next_ = nullptr;
+            node_base* cur = impl_.head_.next_;
+            while (cur != nullptr){
+                node_base* next = cur->next_;
+                cur->next_ = nullptr;
+                node_base* carry = cur;
+                size_t i = 0;
+                for ( ; i < fill && bins[i] != nullptr; ++i){
+                    carry = __merge_chains(bins[i], carry, comp);
+                    bins[i] = nullptr;
+                }
+                bins[i] = carry;
+                if (i == fill)
+                    ++fill;
+                cur = next;
+            }
+            node_base* result = nullptr;
+            for (size_t i = 0; i < fill; ++i)
+                if (bins[i] != nullptr)
+                    result = result == nullptr ? bins[i] : __merge_chains(bins[i], result, comp);
+
+            node_base* prev = __head();
+            for (cur = result; cur != nullptr; cur = cur->next_){
+                prev->next_ = cur;
+                cur->prev_ = prev;
+                prev = cur;
+            }
+            prev->next_ = __head();
+            impl_.head_.prev_ = prev;
+        }
+
+    private:
+        struct __less{
+            bool operator()(const T& x, const T& y) const { return x < y; }
+        };
+
+        struct __equal_to{
+            bool operator()(const T& x, const T& y) const { return x == y; }
+        };
+
+        static T& __value(node_base* p) { return static_cast<node*>(p)->data_; }
+
+        // 合并两条以 nullptr 结尾的有序单链，相等时 a 中的在前
+        template<class Compare>
+        static node_base* __merge_chains(node_base* a, node_base* b, Compare& comp){
+            node_base head;
+            node_base* tail = &head;
+            while (a != nullptr && b != nullptr){
+                if (comp(__value(b), __value(a))){
+                    tail->next_ = b;
+                    b = b->next_;
+                }else{
+                    tail->next_ = a;
+                    a = a->next_;
+                }
+                tail = tail->next_;
+            }
+            tail->next_ = a != nullptr ? a : b;
+            return head.next_;
+        }
+
+        template<class... Args>
+        node* __create_node(Args&&... args){
+            node* p = node_traits::allocate(__node_alloc(), 1);
+            try {
+                simple_stl::construct(&p->data_, simple_stl::forward<Args>(args)...);
+            }catch(...){
+                node_traits::deallocate(__node_alloc(), p, 1);
+                throw;
+            }
+            return p;
+        }
+
+        void __destroy_node(node* p) noexcept{
+            simple_stl::destroy(&p->data_);
+            node_traits::deallocate(__node_alloc(), p, 1);
+        }
+
+        void __clear_nodes(__true_type_s) noexcept{
+            node_base* cur = impl_.head_.next_;
+            while (cur != __head()){
+                node_base* next = cur->next_;
+                node_traits::deallocate(__node_alloc(), static_cast<node*>(cur), 1);
+                cur = next;
+            }
+        }
+
+        void __clear_nodes(__false_type_s) noexcept{
+            node_base* cur = impl_.head_.next_;
+            while (cur != __head()){
+                node_base* next = cur->next_;
+                __destroy_node(static_cast<node*>(cur));
+                cur = next;
+            }
+        }
+
+        iterator __at(size_type n){
+            iterator it = begin();
+            simple_stl::advance(it, n);
+            return it;
+        }
+
+        template<class InputIterator>
+        void __range_init(InputIterator first, InputIterator last){
+            try {
+                for ( ; first != last; ++first)
+                    emplace_back(*first);
+            }catch(...){
+                clear();
+                throw;
+            }
+        }
+
+        // 将 other 的全部节点接到 pos 之前，返回第一个接入的节点
+        iterator __splice_all(const_iterator pos, list& other){
+            node_base* first = other.impl_.head_.next_;
+            if (first == other.__head())
+                return iterator(pos.node_);
+            pos.node_->__transfer(first, other.__head());
+            impl_.size_ += other.impl_.size_;
+            other.impl_.size_ = 0;
+            return iterator(first);
+        }
+
+        // 接管 other 的全部节点：哨兵在对象内，首尾节点要改为指向自己的哨兵
+        void __steal(list& other) noexcept{
+            if (other.empty())
+                return;
+            impl_.head_.next_ = other.impl_.head_.next_;
+            impl_.head_.prev_ = other.impl_.head_.prev_;
+            impl_.head_.next_->prev_ = __head();
+            impl_.head_.prev_->next_ = __head();
+            impl_.size_ = other.impl_.size_;
+            other.impl_.__reset();
+        }
+
+        void __swap_links(list& other) noexcept{
+            list tmp_holder(get_allocator());
+            tmp_holder.__steal(other);
+            other.__steal(*this);
+            __steal(tmp_holder);
+        }
+
+        void __copy_assign_alloc(const list& other, __true_type_s){
+            if (__node_alloc() != other.__node_alloc())
+                clear();
+            __node_alloc() = other.__node_alloc();
+        }
+
+        void __copy_assign_alloc(const list&, __false_type_s) {}
+
+        // 可以接管对方的节点
+        void __move_assign(list& other, __true_type_s){
+            clear();
+            __move_assign_alloc(other, typename node_traits::propagate_on_container_move_assignment());
+            __steal(other);
+        }
+
+        // 配置器不传播，相等时接管节点，否则逐一移动元素
+        void __move_assign(list& other, __false_type_s){
+            if (__node_alloc() == other.__node_alloc()){
+                __move_assign(other, __true_type_s());
+            }else{
+                assign(simple_stl::make_move_iterator(other.begin()), simple_stl::make_move_iterator(other.end()));
+                other.clear();
+            }
+        }
+
+        void __move_assign_alloc(list& other, __true_type_s){
+            __node_alloc() = simple_stl::move(other.__node_alloc());
+        }
+
+        void __move_assign_alloc(list&, __false_type_s) {}
+
+        void __swap_alloc(list& other, __true_type_s){
+            simple_stl::swap(__node_alloc(), other.__node_alloc());
+        }
+
+        void __swap_alloc(list&, __false_type_s) {}
+    };
+
+    template<class T, class Alloc>
+    inline bool operator==(const list<T, Alloc>& x, const list<T, Alloc>& y){
+        if (x.size() != y.size())
+            return false;
+        typename list<T, Alloc>::const_iterator f1 = x.begin();
+        typename list<T, Alloc>::const_iterator f2 = y.begin();
+        for ( ; f1 != x.end(); ++f1, ++f2)
+            if (!(*f1 == *f2))
+                return false;
+        return true;
+    }
+
+    template<class T, class Alloc>
+    inline bool operator!=(const list<T, Alloc>& x, const list<T, Alloc>& y){
+        return !(x == y);
+    }
+
+    template<class T, class Alloc>
+    inline bool operator<(const list<T, Alloc>& x, const list<T, Alloc>& y){
+        typename list<T, Alloc>::const_iterator f1 = x.begin();
+        typename list<T, Alloc>::const_iterator f2 = y.begin();
+        for ( ; f1 != x.end() && f2 != y.end(); ++f1, ++f2) {
+            if (*f1 < *f2)
+                return true;
+            if (*f2 < *f1)
+                return false;
+        }
+        return f1 == x.end() && f2 != y.end();
+    }
+
+    template<class T, class Alloc>
+    inline void swap(list<T, Alloc>& x, list<T, Alloc>& y) noexcept{
+        x.swap(y);
+    }
+
+}   // simple_stl
+
+#endif //SIMPLESTL_STL_LIST_H
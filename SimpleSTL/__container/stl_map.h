@@ -0,0 +1,460 @@
+/**
+ * Created by 史进 on 2023/6/16.
+ *
+ * map、multimap：以 rb_tree 为底层，元素为 pair<const Key, T>，按键排序
+ *  - 由 sorted_unique / sorted_equivalent 标记的有序区间构造时线性时间建树
+ *  - extract 得到的节点句柄可以修改键后再插回，或插入另一个配置器相等的容器
+ */
+#ifndef SIMPLESTL_STL_MAP_H
+#define SIMPLESTL_STL_MAP_H
+
+#include <initializer_list>
+#include <stdexcept>
+
+#include "stl_tree.h"
+#include "../__functional/stl_function.h"
+
+namespace simple_stl{
+
+    template<class Key, class T, class Compare = less<Key>, class Alloc = allocator<pair<const Key, T> > >
+    class map{
+    public:
+        typedef Key                     key_type;
+        typedef T                       mapped_type;
+        typedef pair<const Key, T>      value_type;
+        typedef Compare                 key_compare;
+        typedef Alloc                   allocator_type;
+
+        // 以键比较两个元素
+        class value_compare{
+            friend class map;
+        protected:
+            Compare comp_;
+            explicit value_compare(const Compare& c) : comp_(c) {}
+        public:
+            bool operator()(const value_type& x, const value_type& y) const{
+                return comp_(x.first, y.first);
+            }
+        };
+
+    private:
+        typedef rb_tree<key_type, value_type, select1st<value_type>, key_compare, Alloc> rep_type;
+        rep_type tree_;
+
+    public:
+        typedef typename rep_type::size_type            size_type;
+        typedef typename rep_type::difference_type      difference_type;
+        typedef typename rep_type::reference            reference;
+        typedef typename rep_type::const_reference      const_reference;
+        typedef typename rep_type::pointer              pointer;
+        typedef typename rep_type::const_pointer        const_pointer;
+        typedef typename rep_type::iterator             iterator;
+        typedef typename rep_type::const_iterator       const_iterator;
+        typedef typename rep_type::node_type            node_type;
+        typedef typename rep_type::insert_return_type   insert_return_type;
+
+        /** 构造 */
+        map() : tree_() {}
+
+        explicit map(const Compare& comp, const Alloc& a = Alloc()) : tree_(comp, a) {}
+
+        explicit map(const Alloc& a) : tree_(Compare(), a) {}
+
+        template<class InputIterator, typename enable_if<
+                is_input_iterator<InputIterator>::value, int>::type = 0>
+        map(InputIterator first, InputIterator last, const Compare& comp = Compare(), const Alloc& a = Alloc())
+        : tree_(comp, a){
+            tree_.insert_range_unique(first, last);
+        }
+
+        // 区间已按键排好序且键互不相同
+        template<class InputIterator, typename enable_if<
+                is_input_iterator<InputIterator>::value, int>::type = 0>
+        map(sorted_unique_t, InputIterator first, InputIterator last,
+            const Compare& comp = Compare(), const Alloc& a = Alloc())
+        : tree_(comp, a){
+            tree_.assign_sorted(first, last, true);
+        }
+
+        map(std::initializer_list<value_type> il, const Compare& comp = Compare(), const Alloc& a = Alloc())
+        : tree_(comp, a){
+            tree_.insert_range_unique(il.begin(), il.end());
+        }
+
+        map(sorted_unique_t, std::initializer_list<value_type> il,
+            const Compare& comp = Compare(), const Alloc& a = Alloc())
+        : tree_(comp, a){
+            tree_.assign_sorted(il.begin(), il.end(), true);
+        }
+
+        map(const map& other) : tree_(other.tree_) {}
+        map(const map& other, const Alloc& a) : tree_(other.tree_, a) {}
+        map(map&& other) noexcept : tree_(simple_stl::move(other.tree_)) {}
+
+        /** 赋值 */
+        map& operator=(const map& other){
+            tree_ = other.tree_;
+            return *this;
+        }
+
+        map& operator=(map&& other) noexcept(noexcept(tree_ = simple_stl::move(other.tree_))){
+            tree_ = simple_stl::move(other.tree_);
+            return *this;
+        }
+
+        map& operator=(std::initializer_list<value_type> il){
+            tree_.clear();
+            tree_.insert_range_unique(il.begin(), il.end());
+            return *this;
+        }
+
+        allocator_type get_allocator() const { return tree_.get_allocator(); }
+        key_compare key_comp() const { return tree_.key_comp(); }
+        value_compare value_comp() const { return value_compare(tree_.key_comp()); }
+
+        /** 迭代器 */
+        iterator begin() noexcept { return tree_.begin(); }
+        const_iterator begin() const noexcept { return tree_.begin(); }
+        const_iterator cbegin() const noexcept { return tree_.begin(); }
+        iterator end() noexcept { return tree_.end(); }
+        const_iterator end() const noexcept { return tree_.end(); }
+        const_iterator cend() const noexcept { return tree_.end(); }
+
+        /** 容量 */
+        bool empty() const noexcept { return tree_.empty(); }
+        size_type size() const noexcept { return tree_.size(); }
+        size_type max_size() const noexcept { return tree_.max_size(); }
+
+        /** 元素访问 */
+        // 键不存在时插入值初始化的元素
+        mapped_type& operator[](const key_type& k){
+            return try_emplace(k).first->second;
+        }
+
+        mapped_type& operator[](key_type&& k){
+            return try_emplace(simple_stl::move(k)).first->second;
+        }
+
+        mapped_type& at(const key_type& k){
+            iterator it = find(k);
+            if (it == end())
+                throw std::out_of_range("map::at");
+            return it->second;
+        }
+
+        const mapped_type& at(const key_type& k) const{
+            const_iterator it = find(k);
+            if (it == end())
+                throw std::out_of_range("map::at");
+            return it->second;
+        }
+
+        /** 修改 */
+        pair<iterator, bool> insert(const value_type& v) { return tree_.insert_unique(v); }
+        pair<iterator, bool> insert(value_type&& v) { return tree_.insert_unique(simple_stl::move(v)); }
+
+        template<class P, typename enable_if<
+                std::is_constructible<value_type, P&&>::value, int>::type = 0>
+        pair<iterator, bool> insert(P&& p) { return tree_.emplace_unique(simple_stl::forward<P>(p)); }
+
+        iterator insert(const_iterator hint, const value_type& v) { return tree_.insert_unique(hint, v); }
+        iterator insert(const_iterator hint, value_type&& v) { return tree_.insert_unique(hint, simple_stl::move(v)); }
+
+        template<class P, typename enable_if<
+                std::is_constructible<value_type, P&&>::value, int>::type = 0>
+        iterator insert(const_iterator hint, P&& p){
+            return tree_.emplace_hint_unique(hint, simple_stl::forward<P>(p));
+        }
+
+        template<class InputIterator, typename enable_if<
+                is_input_iterator<InputIterator>::value, int>::type = 0>
+        void insert(InputIterator first, InputIterator last) { tree_.insert_range_unique(first, last); }
+
+        void insert(std::initializer_list<value_type> il) { tree_.insert_range_unique(il.begin(), il.end()); }
+
+        insert_return_type insert(node_type&& nh) { return tree_.insert_node_unique(simple_stl::move(nh)); }
+
+        iterator insert(const_iterator hint, node_type&& nh){
+            return tree_.insert_node_unique(hint, simple_stl::move(nh));
+        }
+
+        template<class... Args>
+        pair<iterator, bool> emplace(Args&&... args){
+            return tree_.emplace_unique(simple_stl::forward<Args>(args)...);
+        }
+
+        template<class... Args>
+        iterator emplace_hint(const_iterator hint, Args&&... args){
+            return tree_.emplace_hint_unique(hint, simple_stl::forward<Args>(args)...);
+        }
+
+        // 键不存在时才构造元素，键存在时 args 不被移动
+        template<class... Args>
+        pair<iterator, bool> try_emplace(const key_type& k, Args&&... args){
+            iterator it = lower_bound(k);
+            if (it != end() && !key_comp()(k, it->first))
+                return pair<iterator, bool>(it, false);
+            return pair<iterator, bool>(tree_.emplace_hint_unique(it, k,
+                    mapped_type(simple_stl::forward<Args>(args)...)), true);
+        }
+
+        template<class... Args>
+        pair<iterator, bool> try_emplace(key_type&& k, Args&&... args){
+            iterator it = lower_bound(k);
+            if (it != end() && !key_comp()(k, it->first))
+                return pair<iterator, bool>(it, false);
+            return pair<iterator, bool>(tree_.emplace_hint_unique(it, simple_stl::move(k),
+                    mapped_type(simple_stl::forward<Args>(args)...)), true);
+        }
+
+        template<class M>
+        pair<iterator, bool> insert_or_assign(const key_type& k, M&& obj){
+            iterator it = lower_bound(k);
+            if (it != end() && !key_comp()(k, it->first)){
+                it->second = simple_stl::forward<M>(obj);
+                return pair<iterator, bool>(it, false);
+            }
+            return pair<iterator, bool>(tree_.emplace_hint_unique(it, k, simple_stl::forward<M>(obj)), true);
+        }
+
+        iterator erase(const_iterator pos) { return tree_.erase(pos); }
+        iterator erase(iterator pos) { return tree_.erase(pos); }
+        iterator erase(const_iterator first, const_iterator last) { return tree_.erase(first, last); }
+        size_type erase(const key_type& k) { return tree_.erase(k); }
+
+        node_type extract(const_iterator pos) { return tree_.extract(pos); }
+        node_type extract(const key_type& k) { return tree_.extract(k); }
+
+        void clear() noexcept { tree_.clear(); }
+        void swap(map& other) noexcept { tree_.swap(other.tree_); }
+
+        /** 查找 */
+        iterator find(const key_type& k) { return tree_.find(k); }
+        const_iterator find(const key_type& k) const { return tree_.find(k); }
+        size_type count(const key_type& k) const { return tree_.find(k) == tree_.end() ? 0 : 1; }
+        bool contains(const key_type& k) const { return tree_.find(k) != tree_.end(); }
+
+        iterator lower_bound(const key_type& k) { return tree_.lower_bound(k); }
+        const_iterator lower_bound(const key_type& k) const { return tree_.lower_bound(k); }
+        iterator upper_bound(const key_type& k) { return tree_.upper_bound(k); }
+        const_iterator upper_bound(const key_type& k) const { return tree_.upper_bound(k); }
+        pair<iterator, iterator> equal_range(const key_type& k) { return tree_.equal_range(k); }
+        pair<const_iterator, const_iterator> equal_range(const key_type& k) const { return tree_.equal_range(k); }
+    };
+
+
+    template<class Key, class T, class Compare = less<Key>, class Alloc = allocator<pair<const Key, T> > >
+    class multimap{
+    public:
+        typedef Key                     key_type;
+        typedef T                       mapped_type;
+        typedef pair<const Key, T>      value_type;
+        typedef Compare                 key_compare;
+        typedef Alloc                   allocator_type;
+
+        class value_compare{
+            friend class multimap;
+        protected:
+            Compare comp_;
+            explicit value_compare(const Compare& c) : comp_(c) {}
+        public:
+            bool operator()(const value_type& x, const value_type& y) const{
+                return comp_(x.first, y.first);
+            }
+        };
+
+    private:
+        typedef rb_tree<key_type, value_type, select1st<value_type>, key_compare, Alloc> rep_type;
+        rep_type tree_;
+
+    public:
+        typedef typename rep_type::size_type            size_type;
+        typedef typename rep_type::difference_type      difference_type;
+        typedef typename rep_type::reference            reference;
+        typedef typename rep_type::const_reference      const_reference;
+        typedef typename rep_type::pointer              pointer;
+        typedef typename rep_type::const_pointer        const_pointer;
+        typedef typename rep_type::iterator             iterator;
+        typedef typename rep_type::const_iterator       const_iterator;
+        typedef typename rep_type::node_type            node_type;
+
+        /** 构造 */
+        multimap() : tree_() {}
+
+        explicit multimap(const Compare& comp, const Alloc& a = Alloc()) : tree_(comp, a) {}
+
+        explicit multimap(const Alloc& a) : tree_(Compare(), a) {}
+
+        template<class InputIterator, typename enable_if<
+                is_input_iterator<InputIterator>::value, int>::type = 0>
+        multimap(InputIterator first, InputIterator last, const Compare& comp = Compare(), const Alloc& a = Alloc())
+        : tree_(comp, a){
+            tree_.insert_range_equal(first, last);
+        }
+
+        // 区间已按键排好序，相等的键保持原有顺序
+        template<class InputIterator, typename enable_if<
+                is_input_iterator<InputIterator>::value, int>::type = 0>
+        multimap(sorted_equivalent_t, InputIterator first, InputIterator last,
+                 const Compare& comp = Compare(), const Alloc& a = Alloc())
+        : tree_(comp, a){
+            tree_.assign_sorted(first, last, false);
+        }
+
+        multimap(std::initializer_list<value_type> il, const Compare& comp = Compare(), const Alloc& a = Alloc())
+        : tree_(comp, a){
+            tree_.insert_range_equal(il.begin(), il.end());
+        }
+
+        multimap(sorted_equivalent_t, std::initializer_list<value_type> il,
+                 const Compare& comp = Compare(), const Alloc& a = Alloc())
+        : tree_(comp, a){
+            tree_.assign_sorted(il.begin(), il.end(), false);
+        }
+
+        multimap(const multimap& other) : tree_(other.tree_) {}
+        multimap(const multimap& other, const Alloc& a) : tree_(other.tree_, a) {}
+        multimap(multimap&& other) noexcept : tree_(simple_stl::move(other.tree_)) {}
+
+        /** 赋值 */
+        multimap& operator=(const multimap& other){
+            tree_ = other.tree_;
+            return *this;
+        }
+
+        multimap& operator=(multimap&& other) noexcept(noexcept(tree_ = simple_stl::move(other.tree_))){
+            tree_ = simple_stl::move(other.tree_);
+            return *this;
+        }
+
+        multimap& operator=(std::initializer_list<value_type> il){
+            tree_.clear();
+            tree_.insert_range_equal(il.begin(), il.end());
+            return *this;
+        }
+
+        allocator_type get_allocator() const { return tree_.get_allocator(); }
+        key_compare key_comp() const { return tree_.key_comp(); }
+        value_compare value_comp() const { return value_compare(tree_.key_comp()); }
+
+        /** 迭代器 */
+        iterator begin() noexcept { return tree_.begin(); }
+        const_iterator begin() const noexcept { return tree_.begin(); }
+        const_iterator cbegin() const noexcept { return tree_.begin(); }
+        iterator end() noexcept { return tree_.end(); }
+        const_iterator end() const noexcept { return tree_.end(); }
+        const_iterator cend() const noexcept { return tree_.end(); }
+
+        /** 容量 */
+        bool empty() const noexcept { return tree_.empty(); }
+        size_type size() const noexcept { return tree_.size(); }
+        size_type max_size() const noexcept { return tree_.max_size(); }
+
+        /** 修改 */
+        iterator insert(const value_type& v) { return tree_.insert_equal(v); }
+        iterator insert(value_type&& v) { return tree_.insert_equal(simple_stl::move(v)); }
+
+        template<class P, typename enable_if<
+                std::is_constructible<value_type, P&&>::value, int>::type = 0>
+        iterator insert(P&& p) { return tree_.emplace_equal(simple_stl::forward<P>(p)); }
+
+        iterator insert(const_iterator hint, const value_type& v) { return tree_.insert_equal(hint, v); }
+        iterator insert(const_iterator hint, value_type&& v) { return tree_.insert_equal(hint, simple_stl::move(v)); }
+
+        template<class P, typename enable_if<
+                std::is_constructible<value_type, P&&>::value, int>::type = 0>
+        iterator insert(const_iterator hint, P&& p){
+            return tree_.emplace_hint_equal(hint, simple_stl::forward<P>(p));
+        }
+
+        template<class InputIterator, typename enable_if<
+                is_input_iterator<InputIterator>::value, int>::type = 0>
+        void insert(InputIterator first, InputIterator last) { tree_.insert_range_equal(first, last); }
+
+        void insert(std::initializer_list<value_type> il) { tree_.insert_range_equal(il.begin(), il.end()); }
+
+        iterator insert(node_type&& nh) { return tree_.insert_node_equal(simple_stl::move(nh)); }
+
+        iterator insert(const_iterator hint, node_type&& nh){
+            return tree_.insert_node_equal(hint, simple_stl::move(nh));
+        }
+
+        template<class... Args>
+        iterator emplace(Args&&... args){
+            return tree_.emplace_equal(simple_stl::forward<Args>(args)...);
+        }
+
+        template<class... Args>
+        iterator emplace_hint(const_iterator hint, Args&&... args){
+            return tree_.emplace_hint_equal(hint, simple_stl::forward<Args>(args)...);
+        }
+
+        iterator erase(const_iterator pos) { return tree_.erase(pos); }
+        iterator erase(iterator pos) { return tree_.erase(pos); }
+        iterator erase(const_iterator first, const_iterator last) { return tree_.erase(first, last); }
+        size_type erase(const key_type& k) { return tree_.erase(k); }
+
+        node_type extract(const_iterator pos) { return tree_.extract(pos); }
+        node_type extract(const key_type& k) { return tree_.extract(k); }
+
+        void clear() noexcept { tree_.clear(); }
+        void swap(multimap& other) noexcept { tree_.swap(other.tree_); }
+
+        /** 查找 */
+        iterator find(const key_type& k) { return tree_.find(k); }
+        const_iterator find(const key_type& k) const { return tree_.find(k); }
+        size_type count(const key_type& k) const { return tree_.count(k); }
+        bool contains(const key_type& k) const { return tree_.find(k) != tree_.end(); }
+
+        iterator lower_bound(const key_type& k) { return tree_.lower_bound(k); }
+        const_iterator lower_bound(const key_type& k) const { return tree_.lower_bound(k); }
+        iterator upper_bound(const key_type& k) { return tree_.upper_bound(k); }
+        const_iterator upper_bound(const key_type& k) const { return tree_.upper_bound(k); }
+        pair<iterator, iterator> equal_range(const key_type& k) { return tree_.equal_range(k); }
+        pair<const_iterator, const_iterator> equal_range(const key_type& k) const { return tree_.equal_range(k); }
+    };
+
+
+    template<class Key, class T, class Compare, class Alloc>
+    inline bool operator==(const map<Key, T, Compare, Alloc>& x, const map<Key, T, Compare, Alloc>& y){
+        return x.size() == y.size() && __associative_equal(x.begin(), x.end(), y.begin());
+    }
+
+    template<class Key, class T, class Compare, class Alloc>
+    inline bool operator!=(const map<Key, T, Compare, Alloc>& x, const map<Key, T, Compare, Alloc>& y){
+        return !(x == y);
+    }
+
+    template<class Key, class T, class Compare, class Alloc>
+    inline bool operator<(const map<Key, T, Compare, Alloc>& x, const map<Key, T, Compare, Alloc>& y){
+        return __associative_less(x.begin(), x.end(), y.begin(), y.end());
+    }
+
+    template<class Key, class T, class Compare, class Alloc>
+    inline void swap(map<Key, T, Compare, Alloc>& x, map<Key, T, Compare, Alloc>& y) noexcept{
+        x.swap(y);
+    }
+
+    template<class Key, class T, class Compare, class Alloc>
+    inline bool operator==(const multimap<Key, T, Compare, Alloc>& x, const multimap<Key, T, Compare, Alloc>& y){
+        return x.size() == y.size() && __associative_equal(x.begin(), x.end(), y.begin());
+    }
+
+    template<class Key, class T, class Compare, class Alloc>
+    inline bool operator!=(const multimap<Key, T, Compare, Alloc>& x, const multimap<Key, T, Compare, Alloc>& y){
+        return !(x == y);
+    }
+
+    template<class Key, class T, class Compare, class Alloc>
+    inline bool operator<(const multimap<Key, T, Compare, Alloc>& x, const multimap<Key, T, Compare, Alloc>& y){
+        return __associative_less(x.begin(), x.end(), y.begin(), y.end());
+    }
+
+    template<class Key, class T, class Compare, class Alloc>
+    inline void swap(multimap<Key, T, Compare, Alloc>& x, multimap<Key, T, Compare, Alloc>& y) noexcept{
+        x.swap(y);
+    }
+
+}   // simple_stl
+
+#endif //SIMPLESTL_STL_MAP_H
@@ -0,0 +1,303 @@
+/**
+ * Created by 史进 on 2023/6/24.
+ *
+ * mpmc_queue：多生产者多消费者的有界无锁队列（Vyukov 的算法）
+ *  - 容量向上取为 2 的幂，每个槽带一个序号 seq_：初始为槽下标 i；
+ *    seq_ == pos 时槽空闲，可供写入位置 pos；写入后置为 pos + 1，可供读出；读出后置为 pos + 容量，留给下一轮
+ *  - 生产者对 enqueue_pos_、消费者对 dequeue_pos_ 做 CAS 抢占位置，抢到后独占该槽，
+ *    不同线程写入不同的槽；两个位置计数之间填充一条缓存行
+ *  - 抢到位置后构造元素不能失败，否则该槽永远不会就绪；构造可能抛出异常时先在槽外构造好，再移动进去，
+ *    因此要求元素的移动构造不抛出异常
+ *  - try_push、try_pop 立即返回；push、pop 在满（空）时先自旋，再让出时间片，最后在条件变量上休眠。
+ *    每次成功入队（出队）后检查对方是否有线程休眠，有时才加锁唤醒，两种操作可以混用
+ *  - 槽数组经由 Alloc 重绑定到槽类型后配置
+ */
+#ifndef SIMPLESTL_STL_MPMC_QUEUE_H
+#define SIMPLESTL_STL_MPMC_QUEUE_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+
+#include "../type_traits.h"
+#include "../utility.h"
+#include "../__memory/stl_allocator.h"
+#include "../__memory/stl_allocator_traits.h"
+#include "../__memory/stl_construct.h"
+
+namespace simple_stl{
+
+    template<class T, class Alloc = allocator<T> >
+    class mpmc_queue{
+    public:
+        typedef T                   value_type;
+        typedef Alloc               allocator_type;
+        typedef size_t              size_type;
+        typedef T&                  reference;
+        typedef const T&            const_reference;
+
+        static_assert(std::is_nothrow_move_constructible<T>::value,
+                      "mpmc_queue requires a nothrow move constructor");
+
+    private:
+        struct __cell{
+            std::atomic<size_type> seq_;
+            typename std::aligned_storage<sizeof(T), alignof(T)>::type storage_;
+
+            explicit __cell(size_type seq) : seq_(seq) {}
+
+            T* __value() noexcept { return reinterpret_cast<T*>(&storage_); }
+        };
+
+        typedef typename allocator_traits<Alloc>::template rebind_alloc<__cell>   cell_allocator;
+        typedef allocator_traits<cell_allocator>                                   cell_traits;
+
+        // 自旋、让出时间片的次数，之后休眠
+        enum {__spin_count = 64, __yield_count = 16};
+
+        // 构造后只读的部分
+        struct __queue_impl : public cell_allocator{
+            __cell* cells_;
+            size_type mask_;
+
+            explicit __queue_impl(const Alloc& a) : cell_allocator(a), cells_(nullptr), mask_(0) {}
+        };
+
+        __queue_impl impl_;
+        char pad0_[__cache_line_size];
+
+        std::atomic<size_type> enqueue_pos_;
+        char pad1_[__cache_line_size];
+
+        std::atomic<size_type> dequeue_pos_;
+        char pad2_[__cache_line_size];
+
+        // 阻塞操作的休眠；计数为正时另一方才需要加锁唤醒
+        std::atomic<size_type> push_waiters_;
+        std::atomic<size_type> pop_waiters_;
+        std::mutex park_mutex_;
+        std::condition_variable not_full_;
+        std::condition_variable not_empty_;
+
+    public:
+        explicit mpmc_queue(size_type capacity, const Alloc& a = Alloc())
+        : impl_(a), enqueue_pos_(0), dequeue_pos_(0), push_waiters_(0), pop_waiters_(0){
+            size_type cap = 2;
+            while (cap < capacity)
+                cap <<= 1;
+            impl_.cells_ = cell_traits::allocate(impl_, cap);
+            for (size_type i = 0; i < cap; ++i)
+                simple_stl::construct(impl_.cells_ + i, i);
+            impl_.mask_ = cap - 1;
+        }
+
+        mpmc_queue(const mpmc_queue&) = delete;
+        mpmc_queue& operator=(const mpmc_queue&) = delete;
+
+        // 析构时不应再有其他线程访问
+        ~mpmc_queue(){
+            const size_type tail = enqueue_pos_.load(std::memory_order_relaxed);
+            for (size_type h = dequeue_pos_.load(std::memory_order_relaxed); h != tail; ++h)
+                simple_stl::destroy(impl_.cells_[h & impl_.mask_].__value());
+            simple_stl::destroy(impl_.cells_, impl_.cells_ + capacity());
+            cell_traits::deallocate(impl_, impl_.cells_, capacity());
+        }
+
+        allocator_type get_allocator() const { return allocator_type(impl_); }
+
+        size_type capacity() const noexcept { return impl_.mask_ + 1; }
+
+        // 其他线程可能同时在修改，结果只是近似值
+        size_type size() const noexcept{
+            const size_type head = dequeue_pos_.load(std::memory_order_acquire);
+            const size_type tail = enqueue_pos_.load(std::memory_order_acquire);
+            return tail - head <= capacity() ? tail - head : 0;
+        }
+
+        bool empty() const noexcept { return size() == 0; }
+
+        /** 非阻塞操作，满（空）时返回 false */
+        bool try_push(const T& value){
+            return __try_emplace(bool_constant_s<std::is_nothrow_copy_constructible<T>::value>(), value);
+        }
+
+        bool try_push(T&& value) { return __try_emplace(__true_type_s(), simple_stl::move(value)); }
+
+        // 构造可能抛出异常时先构造一个临时对象，此时即使队列已满，实参也可能已被移走
+        template<class... Args>
+        bool try_emplace(Args&&... args){
+            return __try_emplace(bool_constant_s<std::is_nothrow_constructible<T, Args&&...>::value>(),
+                                 simple_stl::forward<Args>(args)...);
+        }
+
+        bool try_pop(T& value){
+            __cell* cell = __claim_pop();
+            if (cell == nullptr)
+                return false;
+            {
+                __pop_guard guard(this, cell);
+                value = simple_stl::move(*cell->__value());
+            }
+            __notify(push_waiters_, not_full_);
+            return true;
+        }
+
+        /** 阻塞操作 */
+        void push(const T& value){
+            __blocking_push([&]{ return try_push(value); });
+        }
+
+        void push(T&& value){
+            __blocking_push([&]{ return try_push(simple_stl::move(value)); });
+        }
+
+        // 构造可能抛出异常时只构造一次临时对象，之后反复尝试移入
+        template<class... Args>
+        void emplace(Args&&... args){
+            __emplace(bool_constant_s<std::is_nothrow_constructible<T, Args&&...>::value>(),
+                      simple_stl::forward<Args>(args)...);
+        }
+
+        void pop(T& value){
+            __wait(pop_waiters_, not_empty_, [&]{ return try_pop(value); }, dequeue_pos_, 1);
+        }
+
+    private:
+        // 出队后的收尾：析构元素并交还槽位，移动赋值抛出异常时同样执行
+        struct __pop_guard{
+            mpmc_queue* queue_;
+            __cell* cell_;
+
+            __pop_guard(mpmc_queue* q, __cell* c) : queue_(q), cell_(c) {}
+
+            ~__pop_guard(){
+                simple_stl::destroy(cell_->__value());
+                cell_->seq_.store(cell_->seq_.load(std::memory_order_relaxed) + queue_->impl_.mask_,
+                                  std::memory_order_release);
+            }
+        };
+
+        // 抢占一个可写的槽，队列满时返回空指针
+        __cell* __claim_push() noexcept{
+            size_type pos = enqueue_pos_.load(std::memory_order_relaxed);
+            while (true){
+                __cell* cell = impl_.cells_ + (pos & impl_.mask_);
+                const size_type seq = cell->seq_.load(std::memory_order_acquire);
+                const intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+                if (diff == 0){
+                    if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                        return cell;
+                }else if (diff < 0){
+                    // 该槽上一轮的元素尚未被取走
+                    return nullptr;
+                }else{
+                    pos = enqueue_pos_.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        // 抢占一个可读的槽，队列空时返回空指针
+        __cell* __claim_pop() noexcept{
+            size_type pos = dequeue_pos_.load(std::memory_order_relaxed);
+            while (true){
+                __cell* cell = impl_.cells_ + (pos & impl_.mask_);
+                const size_type seq = cell->seq_.load(std::memory_order_acquire);
+                const intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+                if (diff == 0){
+                    if (dequeue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                        return cell;
+                }else if (diff < 0){
+                    return nullptr;
+                }else{
+                    pos = dequeue_pos_.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        // 构造不会抛出异常，抢到槽后原地构造
+        template<class... Args>
+        bool __try_emplace(__true_type_s, Args&&... args){
+            __cell* cell = __claim_push();
+            if (cell == nullptr)
+                return false;
+            simple_stl::construct(cell->__value(), simple_stl::forward<Args>(args)...);
+            cell->seq_.store(cell->seq_.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+            __notify(pop_waiters_, not_empty_);
+            return true;
+        }
+
+        // 构造可能抛出异常，先在槽外构造
+        template<class... Args>
+        bool __try_emplace(__false_type_s, Args&&... args){
+            T tmp(simple_stl::forward<Args>(args)...);
+            return __try_emplace(__true_type_s(), simple_stl::move(tmp));
+        }
+
+        template<class... Args>
+        void __emplace(__true_type_s, Args&&... args){
+            // 失败的尝试不会构造元素，实参保持原样
+            __blocking_push([&]{ return __try_emplace(__true_type_s(), simple_stl::forward<Args>(args)...); });
+        }
+
+        template<class... Args>
+        void __emplace(__false_type_s, Args&&... args){
+            T tmp(simple_stl::forward<Args>(args)...);
+            __blocking_push([&]{ return __try_emplace(__true_type_s(), simple_stl::move(tmp)); });
+        }
+
+        template<class Try>
+        void __blocking_push(Try attempt){
+            __wait(push_waiters_, not_full_, attempt, enqueue_pos_, 0);
+        }
+
+        // 位置 pos 对应的槽是否就绪：入队时 offset 为 0，出队时为 1。只读取，不抢占
+        bool __ready(const std::atomic<size_type>& position, size_type offset) const noexcept{
+            const size_type pos = position.load(std::memory_order_relaxed);
+            const size_type seq = impl_.cells_[pos & impl_.mask_].seq_.load(std::memory_order_acquire);
+            return static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + offset) >= 0;
+        }
+
+        // 反复尝试直到成功：先自旋，再让出时间片，最后休眠
+        template<class Try>
+        void __wait(std::atomic<size_type>& waiters, std::condition_variable& cv, Try attempt,
+                    const std::atomic<size_type>& position, size_type offset){
+            for (int i = 0; i < __spin_count; ++i){
+                if (attempt())
+                    return;
+                simple_stl::__cpu_relax();
+            }
+            for (int i = 0; i < __yield_count; ++i){
+                if (attempt())
+                    return;
+                std::this_thread::yield();
+            }
+            // 先登记再检查，与 __notify 中"先修改槽序号再读取计数"配对：
+            // 两侧各有一道全序栅栏，要么这里看到新的槽序号，要么对方看到登记。
+            // 尝试成功时会唤醒对方，要加锁，因此不能在持锁时尝试；持锁时只检查槽是否就绪
+            waiters.fetch_add(1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            while (!attempt()){
+                std::unique_lock<std::mutex> lock(park_mutex_);
+                if (!__ready(position, offset))
+                    cv.wait(lock);
+            }
+            waiters.fetch_sub(1, std::memory_order_relaxed);
+        }
+
+        // 成功入队（出队）后唤醒休眠中的另一方；没有休眠的线程时只有一道栅栏的开销
+        void __notify(std::atomic<size_type>& waiters, std::condition_variable& cv){
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (waiters.load(std::memory_order_relaxed) != 0){
+                { std::lock_guard<std::mutex> lock(park_mutex_); }
+                cv.notify_all();
+            }
+        }
+    };
+
+}   // simple_stl
+
+#endif //SIMPLESTL_STL_MPMC_QUEUE_H
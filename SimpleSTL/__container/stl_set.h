@@ -0,0 +1,362 @@
+/**
+ * Created by 史进 on 2023/6/16.
+ *
+ * set、multiset：以 rb_tree 为底层，元素即键。元素不可修改，iterator 与 const_iterator 相同
+ *  - 由 sorted_unique / sorted_equivalent 标记的有序区间构造时线性时间建树
+ */
+#ifndef SIMPLESTL_STL_SET_H
+#define SIMPLESTL_STL_SET_H
+
+#include <initializer_list>
+
+#include "stl_tree.h"
+#include "../__functional/stl_function.h"
+
+namespace simple_stl{
+
+    template<class Key, class Compare = less<Key>, class Alloc = allocator<Key> >
+    class set{
+    public:
+        typedef Key         key_type;
+        typedef Key         value_type;
+        typedef Compare     key_compare;
+        typedef Compare     value_compare;
+        typedef Alloc       allocator_type;
+
+    private:
+        typedef rb_tree<key_type, value_type, identity<value_type>, key_compare, Alloc> rep_type;
+        rep_type tree_;
+
+    public:
+        typedef typename rep_type::size_type            size_type;
+        typedef typename rep_type::difference_type      difference_type;
+        typedef typename rep_type::const_reference      reference;
+        typedef typename rep_type::const_reference      const_reference;
+        typedef typename rep_type::const_pointer        pointer;
+        typedef typename rep_type::const_pointer        const_pointer;
+        typedef typename rep_type::const_iterator       iterator;
+        typedef typename rep_type::const_iterator       const_iterator;
+        typedef typename rep_type::node_type            node_type;
+        typedef __insert_return_type<iterator, node_type> insert_return_type;
+
+        /** 构造 */
+        set() : tree_() {}
+
+        explicit set(const Compare& comp, const Alloc& a = Alloc()) : tree_(comp, a) {}
+
+        explicit set(const Alloc& a) : tree_(Compare(), a) {}
+
+        template<class InputIterator, typename enable_if<
+                is_input_iterator<InputIterator>::value, int>::type = 0>
+        set(InputIterator first, InputIterator last, const Compare& comp = Compare(), const Alloc& a = Alloc())
+        : tree_(comp, a){
+            tree_.insert_range_unique(first, last);
+        }
+
+        // 区间已排好序且元素互不相同
+        template<class InputIterator, typename enable_if<
+                is_input_iterator<InputIterator>::value, int>::type = 0>
+        set(sorted_unique_t, InputIterator first, InputIterator last,
+            const Compare& comp = Compare(), const Alloc& a = Alloc())
+        : tree_(comp, a){
+            tree_.assign_sorted(first, last, true);
+        }
+
+        set(std::initializer_list<value_type> il, const Compare& comp = Compare(), const Alloc& a = Alloc())
+        : tree_(comp, a){
+            tree_.insert_range_unique(il.begin(), il.end());
+        }
+
+        set(sorted_unique_t, std::initializer_list<value_type> il,
+            const Compare& comp = Compare(), const Alloc& a = Alloc())
+        : tree_(comp, a){
+            tree_.assign_sorted(il.begin(), il.end(), true);
+        }
+
+        set(const set& other) : tree_(other.tree_) {}
+        set(const set& other, const Alloc& a) : tree_(other.tree_, a) {}
+        set(set&& other) noexcept : tree_(simple_stl::move(other.tree_)) {}
+
+        /** 赋值 */
+        set& operator=(const set& other){
+            tree_ = other.tree_;
+            return *this;
+        }
+
+        set& operator=(set&& other) noexcept(noexcept(tree_ = simple_stl::move(other.tree_))){
+            tree_ = simple_stl::move(other.tree_);
+            return *this;
+        }
+
+        set& operator=(std::initializer_list<value_type> il){
+            tree_.clear();
+            tree_.insert_range_unique(il.begin(), il.end());
+            return *this;
+        }
+
+        allocator_type get_allocator() const { return tree_.get_allocator(); }
+        key_compare key_comp() const { return tree_.key_comp(); }
+        value_compare value_comp() const { return tree_.key_comp(); }
+
+        /** 迭代器 */
+        iterator begin() const noexcept { return tree_.begin(); }
+        iterator cbegin() const noexcept { return tree_.begin(); }
+        iterator end() const noexcept { return tree_.end(); }
+        iterator cend() const noexcept { return tree_.end(); }
+
+        /** 容量 */
+        bool empty() const noexcept { return tree_.empty(); }
+        size_type size() const noexcept { return tree_.size(); }
+        size_type max_size() const noexcept { return tree_.max_size(); }
+
+        /** 修改 */
+        pair<iterator, bool> insert(const value_type& v){
+            pair<typename rep_type::iterator, bool> p = tree_.insert_unique(v);
+            return pair<iterator, bool>(p.first, p.second);
+        }
+
+        pair<iterator, bool> insert(value_type&& v){
+            pair<typename rep_type::iterator, bool> p = tree_.insert_unique(simple_stl::move(v));
+            return pair<iterator, bool>(p.first, p.second);
+        }
+
+        iterator insert(const_iterator hint, const value_type& v) { return tree_.insert_unique(hint, v); }
+        iterator insert(const_iterator hint, value_type&& v) { return tree_.insert_unique(hint, simple_stl::move(v)); }
+
+        template<class InputIterator, typename enable_if<
+                is_input_iterator<InputIterator>::value, int>::type = 0>
+        void insert(InputIterator first, InputIterator last) { tree_.insert_range_unique(first, last); }
+
+        void insert(std::initializer_list<value_type> il) { tree_.insert_range_unique(il.begin(), il.end()); }
+
+        insert_return_type insert(node_type&& nh){
+            typename rep_type::insert_return_type r = tree_.insert_node_unique(simple_stl::move(nh));
+            insert_return_type result;
+            result.position = r.position;
+            result.inserted = r.inserted;
+            result.node = simple_stl::move(r.node);
+            return result;
+        }
+
+        iterator insert(const_iterator hint, node_type&& nh){
+            return tree_.insert_node_unique(hint, simple_stl::move(nh));
+        }
+
+        template<class... Args>
+        pair<iterator, bool> emplace(Args&&... args){
+            pair<typename rep_type::iterator, bool> p = tree_.emplace_unique(simple_stl::forward<Args>(args)...);
+            return pair<iterator, bool>(p.first, p.second);
+        }
+
+        template<class... Args>
+        iterator emplace_hint(const_iterator hint, Args&&... args){
+            return tree_.emplace_hint_unique(hint, simple_stl::forward<Args>(args)...);
+        }
+
+        iterator erase(const_iterator pos) { return tree_.erase(pos); }
+        iterator erase(const_iterator first, const_iterator last) { return tree_.erase(first, last); }
+        size_type erase(const key_type& k) { return tree_.erase(k); }
+
+        node_type extract(const_iterator pos) { return tree_.extract(pos); }
+        node_type extract(const key_type& k) { return tree_.extract(k); }
+
+        void clear() noexcept { tree_.clear(); }
+        void swap(set& other) noexcept { tree_.swap(other.tree_); }
+
+        /** 查找 */
+        iterator find(const key_type& k) const { return tree_.find(k); }
+        size_type count(const key_type& k) const { return tree_.find(k) == tree_.end() ? 0 : 1; }
+        bool contains(const key_type& k) const { return tree_.find(k) != tree_.end(); }
+
+        iterator lower_bound(const key_type& k) const { return tree_.lower_bound(k); }
+        iterator upper_bound(const key_type& k) const { return tree_.upper_bound(k); }
+        pair<iterator, iterator> equal_range(const key_type& k) const { return tree_.equal_range(k); }
+    };
+
+
+    template<class Key, class Compare = less<Key>, class Alloc = allocator<Key> >
+    class multiset{
+    public:
+        typedef Key         key_type;
+        typedef Key         value_type;
+        typedef Compare     key_compare;
+        typedef Compare     value_compare;
+        typedef Alloc       allocator_type;
+
+    private:
+        typedef rb_tree<key_type, value_type, identity<value_type>, key_compare, Alloc> rep_type;
+        rep_type tree_;
+
+    public:
+        typedef typename rep_type::size_type            size_type;
+        typedef typename rep_type::difference_type      difference_type;
+        typedef typename rep_type::const_reference      reference;
+        typedef typename rep_type::const_reference      const_reference;
+        typedef typename rep_type::const_pointer        pointer;
+        typedef typename rep_type::const_pointer        const_pointer;
+        typedef typename rep_type::const_iterator       iterator;
+        typedef typename rep_type::const_iterator       const_iterator;
+        typedef typename rep_type::node_type            node_type;
+
+        /** 构造 */
+        multiset() : tree_() {}
+
+        explicit multiset(const Compare& comp, const Alloc& a = Alloc()) : tree_(comp, a) {}
+
+        explicit multiset(const Alloc& a) : tree_(Compare(), a) {}
+
+        template<class InputIterator, typename enable_if<
+                is_input_iterator<InputIterator>::value, int>::type = 0>
+        multiset(InputIterator first, InputIterator last, const Compare& comp = Compare(), const Alloc& a = Alloc())
+        : tree_(comp, a){
+            tree_.insert_range_equal(first, last);
+        }
+
+        // 区间已排好序，相等的元素保持原有顺序
+        template<class InputIterator, typename enable_if<
+                is_input_iterator<InputIterator>::value, int>::type = 0>
+        multiset(sorted_equivalent_t, InputIterator first, InputIterator last,
+                 const Compare& comp = Compare(), const Alloc& a = Alloc())
+        : tree_(comp, a){
+            tree_.assign_sorted(first, last, false);
+        }
+
+        multiset(std::initializer_list<value_type> il, const Compare& comp = Compare(), const Alloc& a = Alloc())
+        : tree_(comp, a){
+            tree_.insert_range_equal(il.begin(), il.end());
+        }
+
+        multiset(sorted_equivalent_t, std::initializer_list<value_type> il,
+                 const Compare& comp = Compare(), const Alloc& a = Alloc())
+        : tree_(comp, a){
+            tree_.assign_sorted(il.begin(), il.end(), false);
+        }
+
+        multiset(const multiset& other) : tree_(other.tree_) {}
+        multiset(const multiset& other, const Alloc& a) : tree_(other.tree_, a) {}
+        multiset(multiset&& other) noexcept : tree_(simple_stl::move(other.tree_)) {}
+
+        /** 赋值 */
+        multiset& operator=(const multiset& other){
+            tree_ = other.tree_;
+            return *this;
+        }
+
+        multiset& operator=(multiset&& other) noexcept(noexcept(tree_ = simple_stl::move(other.tree_))){
+            tree_ = simple_stl::move(other.tree_);
+            return *this;
+        }
+
+        multiset& operator=(std::initializer_list<value_type> il){
+            tree_.clear();
+            tree_.insert_range_equal(il.begin(), il.end());
+            return *this;
+        }
+
+        allocator_type get_allocator() const { return tree_.get_allocator(); }
+        key_compare key_comp() const { return tree_.key_comp(); }
+        value_compare value_comp() const { return tree_.key_comp(); }
+
+        /** 迭代器 */
+        iterator begin() const noexcept { return tree_.begin(); }
+        iterator cbegin() const noexcept { return tree_.begin(); }
+        iterator end() const noexcept { return tree_.end(); }
+        iterator cend() const noexcept { return tree_.end(); }
+
+        /** 容量 */
+        bool empty() const noexcept { return tree_.empty(); }
+        size_type size() const noexcept { return tree_.size(); }
+        size_type max_size() const noexcept { return tree_.max_size(); }
+
+        /** 修改 */
+        iterator insert(const value_type& v) { return tree_.insert_equal(v); }
+        iterator insert(value_type&& v) { return tree_.insert_equal(simple_stl::move(v)); }
+        iterator insert(const_iterator hint, const value_type& v) { return tree_.insert_equal(hint, v); }
+        iterator insert(const_iterator hint, value_type&& v) { return tree_.insert_equal(hint, simple_stl::move(v)); }
+
+        template<class InputIterator, typename enable_if<
+                is_input_iterator<InputIterator>::value, int>::type = 0>
+        void insert(InputIterator first, InputIterator last) { tree_.insert_range_equal(first, last); }
+
+        void insert(std::initializer_list<value_type> il) { tree_.insert_range_equal(il.begin(), il.end()); }
+
+        iterator insert(node_type&& nh) { return tree_.insert_node_equal(simple_stl::move(nh)); }
+
+        iterator insert(const_iterator hint, node_type&& nh){
+            return tree_.insert_node_equal(hint, simple_stl::move(nh));
+        }
+
+        template<class... Args>
+        iterator emplace(Args&&... args){
+            return tree_.emplace_equal(simple_stl::forward<Args>(args)...);
+        }
+
+        template<class... Args>
+        iterator emplace_hint(const_iterator hint, Args&&... args){
+            return tree_.emplace_hint_equal(hint, simple_stl::forward<Args>(args)...);
+        }
+
+        iterator erase(const_iterator pos) { return tree_.erase(pos); }
+        iterator erase(const_iterator first, const_iterator last) { return tree_.erase(first, last); }
+        size_type erase(const key_type& k) { return tree_.erase(k); }
+
+        node_type extract(const_iterator pos) { return tree_.extract(pos); }
+        node_type extract(const key_type& k) { return tree_.extract(k); }
+
+        void clear() noexcept { tree_.clear(); }
+        void swap(multiset& other) noexcept { tree_.swap(other.tree_); }
+
+        /** 查找 */
+        iterator find(const key_type& k) const { return tree_.find(k); }
+        size_type count(const key_type& k) const { return tree_.count(k); }
+        bool contains(const key_type& k) const { return tree_.find(k) != tree_.end(); }
+
+        iterator lower_bound(const key_type& k) const { return tree_.lower_bound(k); }
+        iterator upper_bound(const key_type& k) const { return tree_.upper_bound(k); }
+        pair<iterator, iterator> equal_range(const key_type& k) const { return tree_.equal_range(k); }
+    };
+
+
+    template<class Key, class Compare, class Alloc>
+    inline bool operator==(const set<Key, Compare, Alloc>& x, const set<Key, Compare, Alloc>& y){
+        return x.size() == y.size() && __associative_equal(x.begin(), x.end(), y.begin());
+    }
+
+    template<class Key, class Compare, class Alloc>
+    inline bool operator!=(const set<Key, Compare, Alloc>& x, const set<Key, Compare, Alloc>& y){
+        return !(x == y);
+    }
+
+    template<class Key, class Compare, class Alloc>
+    inline bool operator<(const set<Key, Compare, Alloc>& x, const set<Key, Compare, Alloc>& y){
+        return __associative_less(x.begin(), x.end(), y.begin(), y.end());
+    }
+
+    template<class Key, class Compare, class Alloc>
+    inline void swap(set<Key, Compare, Alloc>& x, set<Key, Compare, Alloc>& y) noexcept{
+        x.swap(y);
+    }
+
+    template<class Key, class Compare, class Alloc>
+    inline bool operator==(const multiset<Key, Compare, Alloc>& x, const multiset<Key, Compare, Alloc>& y){
+        return x.size() == y.size() && __associative_equal(x.begin(), x.end(), y.begin());
+    }
+
+    template<class Key, class Compare, class Alloc>
+    inline bool operator!=(const multiset<Key, Compare, Alloc>& x, const multiset<Key, Compare, Alloc>& y){
+        return !(x == y);
+    }
+
+    template<class Key, class Compare, class Alloc>
+    inline bool operator<(const multiset<Key, Compare, Alloc>& x, const multiset<Key, Compare, Alloc>& y){
+        return __associative_less(x.begin(), x.end(), y.begin(), y.end());
+    }
+
+    template<class Key, class Compare, class Alloc>
+    inline void swap(multiset<Key, Compare, Alloc>& x, multiset<Key, Compare, Alloc>& y) noexcept{
+        x.swap(y);
+    }
+
+}   // simple_stl
+
+#endif //SIMPLESTL_STL_SET_H
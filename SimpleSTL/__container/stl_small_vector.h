@@ -0,0 +1,519 @@
+/**
+ * Created by 史进 on 2023/6/13.
+ *
+ * small_vector：带内联缓冲区的 vector
+ *  - 不超过 N 个元素时存放在对象内部的缓冲区中，不向配置器申请内存
+ *  - 超过 N 个元素后溢出到配置器申请的堆空间，之后的行为与 vector 相同
+ *  - 溢出与拷贝时元素的搬移使用 uninitialized_move / uninitialized_copy
+ *  - 元素位于内联缓冲区时，移动构造与交换只能逐一移动元素
+ *  - 扩容、插入、赋值的算法与 vector 共用 __vector_ops；元素与堆空间由 impl_ 负责释放，
+ *    构造函数中途抛出异常时也不会泄漏
+ */
+#ifndef SIMPLESTL_STL_SMALL_VECTOR_H
+#define SIMPLESTL_STL_SMALL_VECTOR_H
+
+#include <cstddef>
+#include <initializer_list>
+#include <stdexcept>
+#include <type_traits>
+
+#include "stl_vector.h"
+#include "../iterator.h"
+#include "../type_traits.h"
+#include "../utility.h"
+#include "../__memory/stl_allocator.h"
+#include "../__memory/stl_allocator_traits.h"
+#include "../__memory/stl_construct.h"
+#include "../__memory/stl_uninitialized.h"
+#include "../__algorithm/stl_algobase.h"
+
+namespace simple_stl{
+
+    template<class T, size_t N, class Alloc = allocator<T> >
+    class small_vector : private __vector_ops<small_vector<T, N, Alloc>, T, Alloc>{
+        static_assert(N > 0, "small_vector requires a non-empty inline buffer");
+
+    public:
+        typedef T                                   value_type;
+        typedef Alloc                               allocator_type;
+        typedef size_t                              size_type;
+        typedef ptrdiff_t                           difference_type;
+        typedef T&                                  reference;
+        typedef const T&                            const_reference;
+        typedef T*                                  pointer;
+        typedef const T*                            const_pointer;
+        typedef T*                                  iterator;
+        typedef const T*                            const_iterator;
+
+        static const size_type inline_capacity = N;
+
+    private:
+        typedef allocator_traits<Alloc>             alloc_traits;
+        typedef typename std::aligned_storage<sizeof(T), alignof(T)>::type storage_type;
+        typedef __vector_ops<small_vector, T, Alloc>    __ops;
+
+        friend class __vector_ops<small_vector, T, Alloc>;
+
+        using __ops::__erase_at_end;
+        using __ops::__transfer;
+        using __ops::__transfer_all;
+        using __ops::__realloc_emplace;
+        using __ops::__fill_insert;
+        using __ops::__range_insert;
+        using __ops::__assign_aux;
+
+        // 继承配置器以便无状态配置器不占空间，内联缓冲区紧随三个指针之后
+        struct __small_impl : public Alloc{
+            T* start_;
+            T* finish_;
+            T* end_of_storage_;
+            storage_type buf_[N];
+
+            __small_impl() : Alloc() { __reset(); }
+            explicit __small_impl(const Alloc& a) : Alloc(a) { __reset(); }
+
+            // 析构元素并归还堆空间；small_vector 的构造函数抛出异常时同样经由这里释放
+            ~__small_impl(){
+                simple_stl::destroy(start_, finish_);
+                if (start_ != __inline_data())
+                    alloc_traits::deallocate(*this, start_, size_type(end_of_storage_ - start_));
+            }
+
+            T* __inline_data() noexcept { return reinterpret_cast<T*>(buf_); }
+
+            void __reset() noexcept{
+                start_ = finish_ = __inline_data();
+                end_of_storage_ = start_ + N;
+            }
+        };
+
+        __small_impl impl_;
+
+        Alloc& __alloc() noexcept { return impl_; }
+        const Alloc& __alloc() const noexcept { return impl_; }
+
+    public:
+        /** 构造、析构 */
+        small_vector() : impl_() {}
+
+        explicit small_vector(const Alloc& a) : impl_(a) {}
+
+        explicit small_vector(size_type n, const Alloc& a = Alloc()) : impl_(a){
+            resize(n);
+        }
+
+        small_vector(size_type n, const T& value, const Alloc& a = Alloc()) : impl_(a){
+            assign(n, value);
+        }
+
+        template<class InputIterator, typename enable_if<
+                is_input_iterator<InputIterator>::value, int>::type = 0>
+        small_vector(InputIterator first, InputIterator last, const Alloc& a = Alloc()) : impl_(a){
+            assign(first, last);
+        }
+
+        small_vector(std::initializer_list<T> il, const Alloc& a = Alloc()) : impl_(a){
+            assign(il.begin(), il.end());
+        }
+
+        small_vector(const small_vector& other)
+        : impl_(alloc_traits::select_on_container_copy_construction(other.__alloc())){
+            assign(other.begin(), other.end());
+        }
+
+        small_vector(small_vector&& other) noexcept(std::is_nothrow_move_constructible<T>::value)
+        : impl_(simple_stl::move(other.__alloc())){
+            __move_from(other);
+        }
+
+        // 元素与堆空间由 impl_ 的析构函数释放
+        ~small_vector() = default;
+
+        /** 赋值 */
+        small_vector& operator=(const small_vector& other){
+            if (this != &other){
+                __copy_assign_alloc(other,
+                        typename alloc_traits::propagate_on_container_copy_assignment());
+                assign(other.begin(), other.end());
+            }
+            return *this;
+        }
+
+        small_vector& operator=(small_vector&& other) noexcept(alloc_traits::is_always_equal::value &&
+                                                              std::is_nothrow_move_constructible<T>::value &&
+                                                              std::is_nothrow_move_assignable<T>::value){
+            if (this != &other){
+                if (!other.is_inline() && __alloc() == other.__alloc()){
+                    clear();
+                    __free_storage();
+                    __move_from(other);
+                }else{
+                    assign(simple_stl::make_move_iterator(other.begin()),
+                           simple_stl::make_move_iterator(other.end()));
+                    other.clear();
+                }
+            }
+            return *this;
+        }
+
+        small_vector& operator=(std::initializer_list<T> il){
+            assign(il.begin(), il.end());
+            return *this;
+        }
+
+        void assign(size_type n, const T& value){
+            if (n > capacity()){
+                // 先拷贝一份，防止 value 引用的正是容器内的元素
+                T copy = value;
+                __reset_storage(n);
+                impl_.finish_ = simple_stl::uninitialized_fill_n(impl_.start_, n, copy);
+            }else if (n > size()){
+                simple_stl::fill(impl_.start_, impl_.finish_, value);
+                impl_.finish_ = simple_stl::uninitialized_fill_n(impl_.finish_, n - size(), value);
+            }else{
+                simple_stl::fill(impl_.start_, impl_.start_ + n, value);
+                __erase_at_end(impl_.start_ + n);
+            }
+        }
+
+        template<class InputIterator, typename enable_if<
+                is_input_iterator<InputIterator>::value, int>::type = 0>
+        void assign(InputIterator first, InputIterator last){
+            __assign_aux(first, last, iterator_category(first));
+        }
+
+        void assign(std::initializer_list<T> il){
+            assign(il.begin(), il.end());
+        }
+
+        allocator_type get_allocator() const{
+            return __alloc();
+        }
+
+        /** 迭代器 */
+        iterator begin() noexcept { return impl_.start_; }
+        const_iterator begin() const noexcept { return impl_.start_; }
+        const_iterator cbegin() const noexcept { return impl_.start_; }
+        iterator end() noexcept { return impl_.finish_; }
+        const_iterator end() const noexcept { return impl_.finish_; }
+        const_iterator cend() const noexcept { return impl_.finish_; }
+
+        /** 容量 */
+        size_type size() const noexcept { return size_type(impl_.finish_ - impl_.start_); }
+        size_type capacity() const noexcept { return size_type(impl_.end_of_storage_ - impl_.start_); }
+        bool empty() const noexcept { return impl_.start_ == impl_.finish_; }
+
+        // 元素是否仍在内联缓冲区中
+        bool is_inline() const noexcept{
+            return impl_.start_ == reinterpret_cast<const T*>(impl_.buf_);
+        }
+
+        size_type max_size() const noexcept{
+            return alloc_traits::max_size(__alloc());
+        }
+
+        void reserve(size_type n){
+            if (n > max_size())
+                throw std::length_error("small_vector::reserve");
+            if (n > capacity())
+                __grow(n);
+        }
+
+        // 元素能放回内联缓冲区时放回，否则收缩到恰好容纳
+        void shrink_to_fit(){
+            if (is_inline() || capacity() == size())
+                return;
+            if (size() <= N){
+                T* old_start = impl_.start_;
+                T* old_finish = impl_.finish_;
+                const size_type old_cap = capacity();
+                T* new_finish = __transfer(old_start, old_finish, impl_.__inline_data());
+                if (!is_trivially_relocatable<T>::value)
+                    simple_stl::destroy(old_start, old_finish);
+                // 先换回内联缓冲区，再归还堆空间
+                impl_.__reset();
+                impl_.finish_ = new_finish;
+                alloc_traits::deallocate(__alloc(), old_start, old_cap);
+            }else{
+                __grow(size());
+            }
+        }
+
+        void resize(size_type n){
+            if (n > size()){
+                const size_type extra = n - size();
+                if (size_type(impl_.end_of_storage_ - impl_.finish_) < extra)
+                    __grow(__next_capacity(extra));
+                T* cur = impl_.finish_;
+                try {
+                    for ( ; cur != impl_.start_ + n; ++cur)
+                        ::new ((void*)cur) T();
+                }catch(...){
+                    simple_stl::destroy(impl_.finish_, cur);
+                    throw;
+                }
+                impl_.finish_ = cur;
+            }else{
+                __erase_at_end(impl_.start_ + n);
+            }
+        }
+
+        void resize(size_type n, const T& value){
+            if (n > size())
+                insert(end(), n - size(), value);
+            else
+                __erase_at_end(impl_.start_ + n);
+        }
+
+        /** 元素访问 */
+        reference operator[](size_type n) { return impl_.start_[n]; }
+        const_reference operator[](size_type n) const { return impl_.start_[n]; }
+
+        reference at(size_type n){
+            __range_check(n);
+            return impl_.start_[n];
+        }
+
+        const_reference at(size_type n) const{
+            __range_check(n);
+            return impl_.start_[n];
+        }
+
+        reference front() { return *impl_.start_; }
+        const_reference front() const { return *impl_.start_; }
+        reference back() { return *(impl_.finish_ - 1); }
+        const_reference back() const { return *(impl_.finish_ - 1); }
+
+        T* data() noexcept { return impl_.start_; }
+        const T* data() const noexcept { return impl_.start_; }
+
+        /** 修改 */
+        void push_back(const T& value){
+            emplace_back(value);
+        }
+
+        void push_back(T&& value){
+            emplace_back(simple_stl::move(value));
+        }
+
+        template<class... Args>
+        reference emplace_back(Args&&... args){
+            if (impl_.finish_ != impl_.end_of_storage_){
+                simple_stl::construct(impl_.finish_, simple_stl::forward<Args>(args)...);
+                ++impl_.finish_;
+            }else{
+                __realloc_emplace(impl_.finish_, simple_stl::forward<Args>(args)...);
+            }
+            return back();
+        }
+
+        void pop_back(){
+            --impl_.finish_;
+            simple_stl::destroy(impl_.finish_);
+        }
+
+        template<class... Args>
+        iterator emplace(const_iterator pos, Args&&... args){
+            T* p = const_cast<T*>(pos);
+            const difference_type offset = p - impl_.start_;
+            if (impl_.finish_ == impl_.end_of_storage_){
+                __realloc_emplace(p, simple_stl::forward<Args>(args)...);
+            }else if (p == impl_.finish_){
+                simple_stl::construct(impl_.finish_, simple_stl::forward<Args>(args)...);
+                ++impl_.finish_;
+            }else{
+                // 先构造临时对象，防止参数引用容器内的元素
+                T tmp(simple_stl::forward<Args>(args)...);
+                simple_stl::construct(impl_.finish_, simple_stl::move(*(impl_.finish_ - 1)));
+                ++impl_.finish_;
+                simple_stl::move_backward(p, impl_.finish_ - 2, impl_.finish_ - 1);
+                *p = simple_stl::move(tmp);
+            }
+            return impl_.start_ + offset;
+        }
+
+        iterator insert(const_iterator pos, const T& value){
+            return emplace(pos, value);
+        }
+
+        iterator insert(const_iterator pos, T&& value){
+            return emplace(pos, simple_stl::move(value));
+        }
+
+        iterator insert(const_iterator pos, size_type n, const T& value){
+            const difference_type offset = pos - impl_.start_;
+            __fill_insert(const_cast<T*>(pos), n, value);
+            return impl_.start_ + offset;
+        }
+
+        template<class InputIterator, typename enable_if<
+                is_input_iterator<InputIterator>::value, int>::type = 0>
+        iterator insert(const_iterator pos, InputIterator first, InputIterator last){
+            const difference_type offset = pos - impl_.start_;
+            __range_insert(const_cast<T*>(pos), first, last, iterator_category(first));
+            return impl_.start_ + offset;
+        }
+
+        iterator insert(const_iterator pos, std::initializer_list<T> il){
+            return insert(pos, il.begin(), il.end());
+        }
+
+        iterator erase(const_iterator pos){
+            T* p = const_cast<T*>(pos);
+            if (p + 1 != impl_.finish_)
+                simple_stl::move(p + 1, impl_.finish_, p);
+            pop_back();
+            return p;
+        }
+
+        iterator erase(const_iterator first, const_iterator last){
+            T* f = const_cast<T*>(first);
+            T* l = const_cast<T*>(last);
+            if (f != l)
+                __erase_at_end(simple_stl::move(l, impl_.finish_, f));
+            return f;
+        }
+
+        void clear() noexcept{
+            __erase_at_end(impl_.start_);
+        }
+
+        // 双方都在堆上时交换指针，否则经由临时对象逐一移动
+        void swap(small_vector& other){
+            if (this == &other)
+                return;
+            if (!is_inline() && !other.is_inline() && __alloc() == other.__alloc()){
+                simple_stl::swap(impl_.start_, other.impl_.start_);
+                simple_stl::swap(impl_.finish_, other.impl_.finish_);
+                simple_stl::swap(impl_.end_of_storage_, other.impl_.end_of_storage_);
+            }else{
+                small_vector tmp(simple_stl::move(other));
+                other = simple_stl::move(*this);
+                *this = simple_stl::move(tmp);
+            }
+        }
+
+    private:
+        void __range_check(size_type n) const{
+            if (n >= size())
+                throw std::out_of_range("small_vector::at");
+        }
+
+        // 供 __vector_ops 调用：归还堆空间并换回内联缓冲区，元素已析构或已转移
+        void __free_storage() noexcept{
+            if (!is_inline()){
+                alloc_traits::deallocate(__alloc(), impl_.start_, capacity());
+                impl_.__reset();
+            }
+        }
+
+        void __copy_assign_alloc(const small_vector& other, __true_type_s){
+            if (__alloc() != other.__alloc()){
+                clear();
+                __free_storage();
+            }
+            __alloc() = other.__alloc();
+        }
+
+        void __copy_assign_alloc(const small_vector&, __false_type_s) {}
+
+        // 接管对方的堆空间；对方在内联缓冲区时逐一移动元素
+        void __move_from(small_vector& other){
+            if (other.is_inline()){
+                impl_.finish_ = simple_stl::uninitialized_move(other.impl_.start_, other.impl_.finish_,
+                                                              impl_.start_);
+                other.clear();
+            }else{
+                impl_.start_ = other.impl_.start_;
+                impl_.finish_ = other.impl_.finish_;
+                impl_.end_of_storage_ = other.impl_.end_of_storage_;
+                other.impl_.__reset();
+            }
+        }
+
+        // 清空后换用至少容纳 n 个元素的空间
+        void __reset_storage(size_type n){
+            clear();
+            if (n <= capacity())
+                return;
+            T* p = alloc_traits::allocate(__alloc(), n);
+            __free_storage();
+            impl_.start_ = impl_.finish_ = p;
+            impl_.end_of_storage_ = p + n;
+        }
+
+        // 供 __vector_ops 调用：容量不足时清空并换用新空间后拷贝
+        template<class ForwardIterator>
+        void __assign_realloc(ForwardIterator first, ForwardIterator last, size_type n){
+            __reset_storage(n);
+            impl_.finish_ = simple_stl::uninitialized_copy(first, last, impl_.start_);
+        }
+
+        size_type __next_capacity(size_type extra) const{
+            const size_type max = max_size();
+            if (max - size() < extra)
+                throw std::length_error("small_vector");
+            return vector_growth<>::next_capacity(capacity(), size() + extra, max);
+        }
+
+        // 溢出到容量为 n 的堆空间；已在堆上且配置器可原地扩展时交给 reallocate()
+        void __grow(size_type n){
+            __grow_aux(n, bool_constant_s<is_trivially_relocatable<T>::value &&
+                                          __has_reallocate<Alloc>::value>());
+        }
+
+        void __grow_aux(size_type n, __true_type_s){
+            if (is_inline()){
+                __grow_aux(n, __false_type_s());
+                return;
+            }
+            const size_type old_size = size();
+            impl_.start_ = __alloc().reallocate(impl_.start_, capacity(), n);
+            impl_.finish_ = impl_.start_ + old_size;
+            impl_.end_of_storage_ = impl_.start_ + n;
+        }
+
+        void __grow_aux(size_type n, __false_type_s){
+            __transfer_all(n);
+        }
+    };
+
+    template<class T, size_t N, class Alloc>
+    const typename small_vector<T, N, Alloc>::size_type small_vector<T, N, Alloc>::inline_capacity;
+
+    template<class T, size_t N, class Alloc>
+    inline bool operator==(const small_vector<T, N, Alloc>& x, const small_vector<T, N, Alloc>& y){
+        if (x.size() != y.size())
+            return false;
+        for (size_t i = 0; i < x.size(); ++i)
+            if (!(x[i] == y[i]))
+                return false;
+        return true;
+    }
+
+    template<class T, size_t N, class Alloc>
+    inline bool operator!=(const small_vector<T, N, Alloc>& x, const small_vector<T, N, Alloc>& y){
+        return !(x == y);
+    }
+
+    template<class T, size_t N, class Alloc>
+    inline bool operator<(const small_vector<T, N, Alloc>& x, const small_vector<T, N, Alloc>& y){
+        const T* f1 = x.begin();
+        const T* f2 = y.begin();
+        for ( ; f1 != x.end() && f2 != y.end(); ++f1, ++f2) {
+            if (*f1 < *f2)
+                return true;
+            if (*f2 < *f1)
+                return false;
+        }
+        return f1 == x.end() && f2 != y.end();
+    }
+
+    template<class T, size_t N, class Alloc>
+    inline void swap(small_vector<T, N, Alloc>& x, small_vector<T, N, Alloc>& y){
+        x.swap(y);
+    }
+
+}   // simple_stl
+
+#endif //SIMPLESTL_STL_SMALL_VECTOR_H
@@ -0,0 +1,201 @@
+/**
+ * Created by 史进 on 2023/6/24.
+ *
+ * spsc_queue：单生产者单消费者的有界无锁环形队列
+ *  - 容量向上取为 2 的幂，head_、tail_ 为只增不减的计数，对容量取模得到槽位，tail_ - head_ 即元素个数
+ *  - 生产者只写 tail_，消费者只写 head_，各自以 release 发布、以 acquire 读取对方的计数；
+ *    两组数据之间填充一条缓存行，互不干扰
+ *  - 双方各自缓存对方计数的旧值，只有按旧值判断为满（空）时才重新读取，
+ *    平时读写都只落在自己的缓存行上
+ *  - push_n、pop_n 一次处理一批元素，最多分两段（环绕处断开），每段经 uninitialized_copy_n、
+ *    move、destroy 处理，平凡类型为整段 memmove
+ *  - 只允许一个线程调用 try_push 系列，一个线程调用 try_pop 系列；size、empty 只是近似值
+ */
+#ifndef SIMPLESTL_STL_SPSC_QUEUE_H
+#define SIMPLESTL_STL_SPSC_QUEUE_H
+
+#include <atomic>
+#include <cstddef>
+
+#include "../iterator.h"
+#include "../utility.h"
+#include "../__algorithm/stl_algobase.h"
+#include "../__memory/stl_allocator.h"
+#include "../__memory/stl_allocator_traits.h"
+#include "../__memory/stl_construct.h"
+#include "../__memory/stl_uninitialized.h"
+
+namespace simple_stl{
+
+    template<class T, class Alloc = allocator<T> >
+    class spsc_queue{
+    public:
+        typedef T                   value_type;
+        typedef Alloc               allocator_type;
+        typedef size_t              size_type;
+        typedef T&                  reference;
+        typedef const T&            const_reference;
+
+    private:
+        typedef allocator_traits<Alloc>     alloc_traits;
+
+        // 构造后只读的部分，两个线程共享不会引起缓存行失效
+        struct __queue_impl : public Alloc{
+            T* buffer_;
+            size_type mask_;
+
+            explicit __queue_impl(const Alloc& a) : Alloc(a), buffer_(nullptr), mask_(0) {}
+        };
+
+        __queue_impl impl_;
+        char pad0_[__cache_line_size];
+
+        // 生产者一侧
+        std::atomic<size_type> tail_;
+        size_type head_cache_;
+        char pad1_[__cache_line_size];
+
+        // 消费者一侧
+        std::atomic<size_type> head_;
+        size_type tail_cache_;
+        char pad2_[__cache_line_size];
+
+    public:
+        explicit spsc_queue(size_type capacity, const Alloc& a = Alloc())
+        : impl_(a), tail_(0), head_cache_(0), head_(0), tail_cache_(0){
+            size_type cap = 1;
+            while (cap < capacity)
+                cap <<= 1;
+            impl_.buffer_ = alloc_traits::allocate(impl_, cap);
+            impl_.mask_ = cap - 1;
+        }
+
+        spsc_queue(const spsc_queue&) = delete;
+        spsc_queue& operator=(const spsc_queue&) = delete;
+
+        ~spsc_queue(){
+            const size_type tail = tail_.load(std::memory_order_relaxed);
+            for (size_type h = head_.load(std::memory_order_relaxed); h != tail; ++h)
+                simple_stl::destroy(impl_.buffer_ + (h & impl_.mask_));
+            alloc_traits::deallocate(impl_, impl_.buffer_, impl_.mask_ + 1);
+        }
+
+        allocator_type get_allocator() const { return impl_; }
+
+        size_type capacity() const noexcept { return impl_.mask_ + 1; }
+
+        // 另一方可能同时在修改，结果只是近似值
+        size_type size() const noexcept{
+            const size_type head = head_.load(std::memory_order_acquire);
+            const size_type tail = tail_.load(std::memory_order_acquire);
+            return tail - head <= capacity() ? tail - head : 0;
+        }
+
+        bool empty() const noexcept { return size() == 0; }
+
+        /** 生产者 */
+        template<class... Args>
+        bool try_emplace(Args&&... args){
+            const size_type tail = tail_.load(std::memory_order_relaxed);
+            if (tail - head_cache_ > impl_.mask_){
+                head_cache_ = head_.load(std::memory_order_acquire);
+                if (tail - head_cache_ > impl_.mask_)
+                    return false;
+            }
+            simple_stl::construct(impl_.buffer_ + (tail & impl_.mask_), simple_stl::forward<Args>(args)...);
+            tail_.store(tail + 1, std::memory_order_release);
+            return true;
+        }
+
+        bool try_push(const T& value) { return try_emplace(value); }
+
+        bool try_push(T&& value) { return try_emplace(simple_stl::move(value)); }
+
+        // 从 first 起拷贝至多 n 个元素，返回实际放入的个数；构造抛出异常时本批元素都不放入
+        template<class ForwardIterator>
+        size_type push_n(ForwardIterator first, size_type n){
+            const size_type tail = tail_.load(std::memory_order_relaxed);
+            size_type room = capacity() - (tail - head_cache_);
+            if (room < n){
+                head_cache_ = head_.load(std::memory_order_acquire);
+                room = capacity() - (tail - head_cache_);
+            }
+            if (n > room)
+                n = room;
+            if (n == 0)
+                return 0;
+            const size_type index = tail & impl_.mask_;
+            const size_type first_part = n < capacity() - index ? n : capacity() - index;
+            T* const dest = impl_.buffer_ + index;
+            simple_stl::uninitialized_copy_n(first, first_part, dest);
+            if (first_part < n){
+                simple_stl::advance(first, first_part);
+                try {
+                    simple_stl::uninitialized_copy_n(first, n - first_part, impl_.buffer_);
+                }catch(...){
+                    simple_stl::destroy(dest, dest + first_part);
+                    throw;
+                }
+            }
+            tail_.store(tail + n, std::memory_order_release);
+            return n;
+        }
+
+        /** 消费者 */
+        // 队首元素，队列为空时返回空指针；与 pop 配合可以原地使用元素
+        T* front() noexcept{
+            const size_type head = head_.load(std::memory_order_relaxed);
+            if (head == tail_cache_){
+                tail_cache_ = tail_.load(std::memory_order_acquire);
+                if (head == tail_cache_)
+                    return nullptr;
+            }
+            return impl_.buffer_ + (head & impl_.mask_);
+        }
+
+        // 弹出队首元素，只能在 front 返回非空之后调用
+        void pop() noexcept{
+            const size_type head = head_.load(std::memory_order_relaxed);
+            simple_stl::destroy(impl_.buffer_ + (head & impl_.mask_));
+            head_.store(head + 1, std::memory_order_release);
+        }
+
+        bool try_pop(T& value){
+            T* p = front();
+            if (p == nullptr)
+                return false;
+            value = simple_stl::move(*p);
+            pop();
+            return true;
+        }
+
+        // 将至多 n 个元素依次移动赋值到 result 起的区间，返回实际取出的个数
+        template<class OutputIterator>
+        size_type pop_n(OutputIterator result, size_type n){
+            const size_type head = head_.load(std::memory_order_relaxed);
+            size_type avail = tail_cache_ - head;
+            if (avail < n){
+                tail_cache_ = tail_.load(std::memory_order_acquire);
+                avail = tail_cache_ - head;
+            }
+            if (n > avail)
+                n = avail;
+            if (n == 0)
+                return 0;
+            const size_type index = head & impl_.mask_;
+            const size_type first_part = n < capacity() - index ? n : capacity() - index;
+            T* const src = impl_.buffer_ + index;
+            result = simple_stl::move(src, src + first_part, result);
+            simple_stl::destroy(src, src + first_part);
+            if (first_part < n){
+                simple_stl::move(impl_.buffer_, impl_.buffer_ + (n - first_part), result);
+                simple_stl::destroy(impl_.buffer_, impl_.buffer_ + (n - first_part));
+            }
+            head_.store(head + n, std::memory_order_release);
+            return n;
+        }
+    };
+
+}   // simple_stl
+
+#endif //SIMPLESTL_STL_SPSC_QUEUE_H
@@ -0,0 +1,1201 @@
+/**
+ * Created by 史进 on 2023/6/16.
+ *
+ * rb_tree：map、set、multimap、multiset 共用的红黑树
+ *  - 带头节点：header_.parent_ 指向根，left_ 指向最小节点，right_ 指向最大节点，
+ *    end() 即头节点；头节点着红色，以便 --end() 时与根区分
+ *  - 节点经 rebind 后的配置器配置。默认的 allocator 走带线程缓存的内存池；
+ *    使用 node_pool_allocator 时节点来自单独的节点池
+ *  - emplace 先构造节点再按节点中的键找位置，元素只构造一次；键已存在时销毁该节点
+ *  - extract 摘下节点交给节点句柄，insert 节点句柄时直接接入，不重新配置也不拷贝元素
+ *  - 由有序区间建树时按中位数递归建成平衡树，最深一层着红色，不需要比较也不需要旋转，线性时间
+ */
+#ifndef SIMPLESTL_STL_TREE_H
+#define SIMPLESTL_STL_TREE_H
+
+#include <cstddef>
+#include <type_traits>
+
+#include "../iterator.h"
+#include "../type_traits.h"
+#include "../utility.h"
+#include "../__memory/stl_allocator.h"
+#include "../__memory/stl_allocator_traits.h"
+#include "../__memory/stl_construct.h"
+
+namespace simple_stl{
+
+    typedef bool __rb_tree_color_type;
+    const __rb_tree_color_type __rb_tree_red = false;
+    const __rb_tree_color_type __rb_tree_black = true;
+
+    struct __rb_tree_node_base{
+        typedef __rb_tree_node_base* base_ptr;
+
+        __rb_tree_color_type color_;
+        base_ptr parent_;
+        base_ptr left_;
+        base_ptr right_;
+
+        static base_ptr minimum(base_ptr x) noexcept{
+            while (x->left_ != nullptr)
+                x = x->left_;
+            return x;
+        }
+
+        static base_ptr maximum(base_ptr x) noexcept{
+            while (x->right_ != nullptr)
+                x = x->right_;
+            return x;
+        }
+    };
+
+    template<class Value>
+    struct __rb_tree_node : public __rb_tree_node_base{
+        Value value_;
+    };
+
+    // 中序后继，x 为最大节点时返回头节点
+    inline __rb_tree_node_base* __rb_tree_increment(__rb_tree_node_base* x) noexcept{
+        if (x->right_ != nullptr){
+            x = x->right_;
+            while (x->left_ != nullptr)
+                x = x->left_;
+        }else{
+            __rb_tree_node_base* y = x->parent_;
+            while (x == y->right_){
+                x = y;
+                y = y->parent_;
+            }
+            // 根没有右子节点时 x 停在头节点，y 为根，此时 x 即为结果
+            if (x->right_ != y)
+                x = y;
+        }
+        return x;
+    }
+
+    // 中序前驱，x 为头节点时返回最大节点
+    inline __rb_tree_node_base* __rb_tree_decrement(__rb_tree_node_base* x) noexcept{
+        if (x->color_ == __rb_tree_red && x->parent_->parent_ == x){
+            x = x->right_;
+        }else if (x->left_ != nullptr){
+            x = x->left_;
+            while (x->right_ != nullptr)
+                x = x->right_;
+        }else{
+            __rb_tree_node_base* y = x->parent_;
+            while (x == y->left_){
+                x = y;
+                y = y->parent_;
+            }
+            x = y;
+        }
+        return x;
+    }
+
+    inline void __rb_tree_rotate_left(__rb_tree_node_base* x, __rb_tree_node_base*& root) noexcept{
+        __rb_tree_node_base* y = x->right_;
+        x->right_ = y->left_;
+        if (y->left_ != nullptr)
+            y->left_->parent_ = x;
+        y->parent_ = x->parent_;
+        if (x == root)
+            root = y;
+        else if (x == x->parent_->left_)
+            x->parent_->left_ = y;
+        else
+            x->parent_->right_ = y;
+        y->left_ = x;
+        x->parent_ = y;
+    }
+
+    inline void __rb_tree_rotate_right(__rb_tree_node_base* x, __rb_tree_node_base*& root) noexcept{
+        __rb_tree_node_base* y = x->left_;
+        x->left_ = y->right_;
+        if (y->right_ != nullptr)
+            y->right_->parent_ = x;
+        y->parent_ = x->parent_;
+        if (x == root)
+            root = y;
+        else if (x == x->parent_->right_)
+            x->parent_->right_ = y;
+        else
+            x->parent_->left_ = y;
+        y->right_ = x;
+        x->parent_ = y;
+    }
+
+    // 将 z 接为 p 的左（insert_left）或右子节点，维护头节点的最小、最大指针后重新平衡
+    inline void __rb_tree_insert_and_rebalance(bool insert_left, __rb_tree_node_base* z,
+                                               __rb_tree_node_base* p, __rb_tree_node_base& header) noexcept{
+        __rb_tree_node_base*& root = header.parent_;
+        z->parent_ = p;
+        z->left_ = nullptr;
+        z->right_ = nullptr;
+        z->color_ = __rb_tree_red;
+
+        if (insert_left){
+            p->left_ = z;               // p 为头节点时即设置了 leftmost
+            if (p == &header){
+                header.parent_ = z;
+                header.right_ = z;
+            }else if (p == header.left_){
+                header.left_ = z;
+            }
+        }else{
+            p->right_ = z;
+            if (p == header.right_)
+                header.right_ = z;
+        }
+
+        while (z != root && z->parent_->color_ == __rb_tree_red){
+            __rb_tree_node_base* const zpp = z->parent_->parent_;
+            if (z->parent_ == zpp->left_){
+                __rb_tree_node_base* const y = zpp->right_;
+                if (y != nullptr && y->color_ == __rb_tree_red){
+                    z->parent_->color_ = __rb_tree_black;
+                    y->color_ = __rb_tree_black;
+                    zpp->color_ = __rb_tree_red;
+                    z = zpp;
+                }else{
+                    if (z == z->parent_->right_){
+                        z = z->parent_;
+                        __rb_tree_rotate_left(z, root);
+                    }
+                    z->parent_->color_ = __rb_tree_black;
+                    zpp->color_ = __rb_tree_red;
+                    __rb_tree_rotate_right(zpp, root);
+                }
+            }else{
+                __rb_tree_node_base* const y = zpp->left_;
+                if (y != nullptr && y->color_ == __rb_tree_red){
+                    z->parent_->color_ = __rb_tree_black;
+                    y->color_ = __rb_tree_black;
+                    zpp->color_ = __rb_tree_red;
+                    z = zpp;
+                }else{
+                    if (z == z->parent_->left_){
+                        z = z->parent_;
+                        __rb_tree_rotate_right(z, root);
+                    }
+                    z->parent_->color_ = __rb_tree_black;
+                    zpp->color_ = __rb_tree_red;
+                    __rb_tree_rotate_left(zpp, root);
+                }
+            }
+        }
+        root->color_ = __rb_tree_black;
+    }
+
+    // 将 z 从树中摘下并重新平衡，返回 z；节点本身不释放
+    inline __rb_tree_node_base* __rb_tree_rebalance_for_erase(__rb_tree_node_base* const z,
+                                                              __rb_tree_node_base& header) noexcept{
+        __rb_tree_node_base*& root = header.parent_;
+        __rb_tree_node_base*& leftmost = header.left_;
+        __rb_tree_node_base*& rightmost = header.right_;
+        __rb_tree_node_base* y = z;
+        __rb_tree_node_base* x = nullptr;
+        __rb_tree_node_base* x_parent = nullptr;
+
+        if (y->left_ == nullptr){
+            x = y->right_;
+        }else if (y->right_ == nullptr){
+            x = y->left_;
+        }else{
+            // z 有两个子节点，以其后继 y 顶替 z 的位置
+            y = y->right_;
+            while (y->left_ != nullptr)
+                y = y->left_;
+            x = y->right_;
+        }
+
+        if (y != z){
+            z->left_->parent_ = y;
+            y->left_ = z->left_;
+            if (y != z->right_){
+                x_parent = y->parent_;
+                if (x != nullptr)
+                    x->parent_ = y->parent_;
+                y->parent_->left_ = x;
+                y->right_ = z->right_;
+                z->right_->parent_ = y;
+            }else{
+                x_parent = y;
+            }
+            if (root == z)
+                root = y;
+            else if (z->parent_->left_ == z)
+                z->parent_->left_ = y;
+            else
+                z->parent_->right_ = y;
+            y->parent_ = z->parent_;
+            __rb_tree_color_type c = y->color_;
+            y->color_ = z->color_;
+            z->color_ = c;
+            y = z;                      // y 指向实际删去的位置，其颜色决定是否需要调整
+        }else{
+            x_parent = y->parent_;
+            if (x != nullptr)
+                x->parent_ = y->parent_;
+            if (root == z)
+                root = x;
+            else if (z->parent_->left_ == z)
+                z->parent_->left_ = x;
+            else
+                z->parent_->right_ = x;
+            if (leftmost == z)
+                leftmost = z->right_ == nullptr ? z->parent_ : __rb_tree_node_base::minimum(x);
+            if (rightmost == z)
+                rightmost = z->left_ == nullptr ? z->parent_ : __rb_tree_node_base::maximum(x);
+        }
+
+        if (y->color_ != __rb_tree_red){
+            while (x != root && (x == nullptr || x->color_ == __rb_tree_black)){
+                if (x == x_parent->left_){
+                    __rb_tree_node_base* w = x_parent->right_;
+                    if (w->color_ == __rb_tree_red){
+                        w->color_ = __rb_tree_black;
+                        x_parent->color_ = __rb_tree_red;
+                        __rb_tree_rotate_left(x_parent, root);
+                        w = x_parent->right_;
+                    }
+                    if ((w->left_ == nullptr || w->left_->color_ == __rb_tree_black) &&
+                        (w->right_ == nullptr || w->right_->color_ == __rb_tree_black)){
+                        w->color_ = __rb_tree_red;
+                        x = x_parent;
+                        x_parent = x_parent->parent_;
+                    }else{
+                        if (w->right_ == nullptr || w->right_->color_ == __rb_tree_black){
+                            w->left_->color_ = __rb_tree_black;
+                            w->color_ = __rb_tree_red;
+                            __rb_tree_rotate_right(w, root);
+                            w = x_parent->right_;
+                        }
+                        w->color_ = x_parent->color_;
+                        x_parent->color_ = __rb_tree_black;
+                        if (w->right_ != nullptr)
+                            w->right_->color_ = __rb_tree_black;
+                        __rb_tree_rotate_left(x_parent, root);
+                        break;
+                    }
+                }else{
+                    __rb_tree_node_base* w = x_parent->left_;
+                    if (w->color_ == __rb_tree_red){
+                        w->color_ = __rb_tree_black;
+                        x_parent->color_ = __rb_tree_red;
+                        __rb_tree_rotate_right(x_parent, root);
+                        w = x_parent->left_;
+                    }
+                    if ((w->right_ == nullptr || w->right_->color_ == __rb_tree_black) &&
+                        (w->left_ == nullptr || w->left_->color_ == __rb_tree_black)){
+                        w->color_ = __rb_tree_red;
+                        x = x_parent;
+                        x_parent = x_parent->parent_;
+                    }else{
+                        if (w->left_ == nullptr || w->left_->color_ == __rb_tree_black){
+                            w->right_->color_ = __rb_tree_black;
+                            w->color_ = __rb_tree_red;
+                            __rb_tree_rotate_left(w, root);
+                            w = x_parent->left_;
+                        }
+                        w->color_ = x_parent->color_;
+                        x_parent->color_ = __rb_tree_black;
+                        if (w->left_ != nullptr)
+                            w->left_->color_ = __rb_tree_black;
+                        __rb_tree_rotate_right(x_parent, root);
+                        break;
+                    }
+                }
+            }
+            if (x != nullptr)
+                x->color_ = __rb_tree_black;
+        }
+        return y;
+    }
+
+
+    template<class Value, class Ref, class Ptr>
+    struct __rb_tree_iterator{
+        typedef __rb_tree_iterator<Value, Value&, Value*>               iterator;
+        typedef __rb_tree_iterator<Value, const Value&, const Value*>   const_iterator;
+        typedef __rb_tree_iterator                                      self;
+
+        typedef bidirectional_iterator_tag  iterator_category;
+        typedef Value                       value_type;
+        typedef Ptr                         pointer;
+        typedef Ref                         reference;
+        typedef ptrdiff_t                   difference_type;
+        typedef __rb_tree_node<Value>*      link_type;
+
+        __rb_tree_node_base* node_;
+
+        __rb_tree_iterator() noexcept : node_(nullptr) {}
+        explicit __rb_tree_iterator(__rb_tree_node_base* node) noexcept : node_(node) {}
+
+        // iterator 可转换为 const_iterator
+        __rb_tree_iterator(const iterator& other) noexcept : node_(other.node_) {}
+
+        __rb_tree_iterator& operator=(const __rb_tree_iterator&) = default;
+
+        reference operator*() const { return static_cast<link_type>(node_)->value_; }
+        pointer operator->() const { return &static_cast<link_type>(node_)->value_; }
+
+        self& operator++(){
+            node_ = __rb_tree_increment(node_);
+            return *this;
+        }
+
+        self operator++(int){
+            self tmp = *this;
+            node_ = __rb_tree_increment(node_);
+            return tmp;
+        }
+
+        self& operator--(){
+            node_ = __rb_tree_decrement(node_);
+            return *this;
+        }
+
+        self operator--(int){
+            self tmp = *this;
+            node_ = __rb_tree_decrement(node_);
+            return tmp;
+        }
+
+        template<class R, class P>
+        bool operator==(const __rb_tree_iterator<Value, R, P>& x) const { return node_ == x.node_; }
+
+        template<class R, class P>
+        bool operator!=(const __rb_tree_iterator<Value, R, P>& x) const { return node_ != x.node_; }
+    };
+
+
+    template<class Key, class Value, class KeyOfValue, class Compare, class Alloc>
+    class rb_tree;
+
+    /**
+     * 节点句柄：持有一个从树上摘下的节点及其配置器，析构时销毁元素并归还节点。
+     * 只能移动；空句柄不持有配置器，因此配置器不需要默认构造
+     */
+    template<class Value, class NodeAlloc>
+    class __tree_node_handle{
+    public:
+        typedef Value value_type;
+
+    private:
+        typedef __rb_tree_node<Value>       node;
+        typedef allocator_traits<NodeAlloc> node_traits;
+
+        node* node_;
+        typename std::aligned_storage<sizeof(NodeAlloc), alignof(NodeAlloc)>::type alloc_buf_;
+
+        NodeAlloc& __alloc() noexcept { return *reinterpret_cast<NodeAlloc*>(&alloc_buf_); }
+
+        __tree_node_handle(node* p, const NodeAlloc& a) : node_(p){
+            ::new(static_cast<void*>(&alloc_buf_)) NodeAlloc(a);
+        }
+
+        // 交出节点，句柄变空
+        node* __release() noexcept{
+            node* p = node_;
+            __alloc().~NodeAlloc();
+            node_ = nullptr;
+            return p;
+        }
+
+        void __reset() noexcept{
+            if (node_ != nullptr){
+                simple_stl::destroy(&node_->value_);
+                node_traits::deallocate(__alloc(), node_, 1);
+                __release();
+            }
+        }
+
+        template<class, class, class, class, class>
+        friend class rb_tree;
+
+    public:
+        __tree_node_handle() noexcept : node_(nullptr) {}
+
+        __tree_node_handle(__tree_node_handle&& other) noexcept : node_(nullptr){
+            if (other.node_ != nullptr){
+                ::new(static_cast<void*>(&alloc_buf_)) NodeAlloc(simple_stl::move(other.__alloc()));
+                node_ = other.__release();
+            }
+        }
+
+        __tree_node_handle& operator=(__tree_node_handle&& other) noexcept{
+            if (this != &other){
+                __reset();
+                if (other.node_ != nullptr){
+                    ::new(static_cast<void*>(&alloc_buf_)) NodeAlloc(simple_stl::move(other.__alloc()));
+                    node_ = other.__release();
+                }
+            }
+            return *this;
+        }
+
+        __tree_node_handle(const __tree_node_handle&) = delete;
+        __tree_node_handle& operator=(const __tree_node_handle&) = delete;
+
+        ~__tree_node_handle(){
+            __reset();
+        }
+
+        bool empty() const noexcept { return node_ == nullptr; }
+        explicit operator bool() const noexcept { return node_ != nullptr; }
+
+        // set 的节点
+        value_type& value() const { return node_->value_; }
+
+        // map 的节点：键可以修改后再插回
+        template<class V = Value>
+        typename std::remove_const<typename V::first_type>::type& key() const{
+            return const_cast<typename std::remove_const<typename V::first_type>::type&>(node_->value_.first);
+        }
+
+        template<class V = Value>
+        typename V::second_type& mapped() const{
+            return node_->value_.second;
+        }
+
+        void swap(__tree_node_handle& other) noexcept{
+            __tree_node_handle tmp(simple_stl::move(other));
+            other = simple_stl::move(*this);
+            *this = simple_stl::move(tmp);
+        }
+    };
+
+    template<class Value, class NodeAlloc>
+    inline void swap(__tree_node_handle<Value, NodeAlloc>& x, __tree_node_handle<Value, NodeAlloc>& y) noexcept{
+        x.swap(y);
+    }
+
+    // 唯一键容器插入节点句柄的结果
+    template<class Iterator, class NodeType>
+    struct __insert_return_type{
+        Iterator position;
+        bool inserted;
+        NodeType node;
+    };
+
+
+    // 有序容器的比较：逐一比较元素
+    template<class InputIterator1, class InputIterator2>
+    inline bool __associative_equal(InputIterator1 first1, InputIterator1 last1, InputIterator2 first2){
+        for ( ; first1 != last1; ++first1, ++first2)
+            if (!(*first1 == *first2))
+                return false;
+        return true;
+    }
+
+    template<class InputIterator1, class InputIterator2>
+    inline bool __associative_less(InputIterator1 first1, InputIterator1 last1,
+                                   InputIterator2 first2, InputIterator2 last2){
+        for ( ; first1 != last1 && first2 != last2; ++first1, ++first2){
+            if (*first1 < *first2)
+                return true;
+            if (*first2 < *first1)
+                return false;
+        }
+        return first1 == last1 && first2 != last2;
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Compare, class Alloc = allocator<Value> >
+    class rb_tree{
+    public:
+        typedef Key                                                         key_type;
+        typedef Value                                                       value_type;
+        typedef Compare                                                     key_compare;
+        typedef Alloc                                                       allocator_type;
+        typedef size_t                                                      size_type;
+        typedef ptrdiff_t                                                   difference_type;
+        typedef Value&                                                      reference;
+        typedef const Value&                                                const_reference;
+        typedef Value*                                                      pointer;
+        typedef const Value*                                                const_pointer;
+        typedef __rb_tree_iterator<Value, Value&, Value*>                   iterator;
+        typedef __rb_tree_iterator<Value, const Value&, const Value*>       const_iterator;
+
+    private:
+        typedef __rb_tree_node_base                                             node_base;
+        typedef __rb_tree_node<Value>                                           node;
+        typedef typename allocator_traits<Alloc>::template rebind_alloc<node>   node_allocator;
+        typedef allocator_traits<node_allocator>                                node_traits;
+
+    public:
+        typedef __tree_node_handle<Value, node_allocator>                   node_type;
+        typedef __insert_return_type<iterator, node_type>                   insert_return_type;
+
+    private:
+        // 继承节点配置器以便无状态配置器不占空间，比较函数、头节点与元素个数随对象存放
+        struct __tree_impl : public node_allocator{
+            Compare comp_;
+            node_base header_;
+            size_type node_count_;
+
+            __tree_impl(const Compare& comp, const node_allocator& a)
+            : node_allocator(a), comp_(comp), node_count_(0) { __reset(); }
+
+            void __reset() noexcept{
+                header_.color_ = __rb_tree_red;
+                header_.parent_ = nullptr;
+                header_.left_ = &header_;
+                header_.right_ = &header_;
+                node_count_ = 0;
+            }
+        };
+
+        __tree_impl impl_;
+
+        node_allocator& __node_alloc() noexcept { return impl_; }
+        const node_allocator& __node_alloc() const noexcept { return impl_; }
+
+        node_base* __header() const noexcept { return const_cast<node_base*>(&impl_.header_); }
+        node_base*& __root() noexcept { return impl_.header_.parent_; }
+        node_base* __root() const noexcept { return impl_.header_.parent_; }
+        node_base*& __leftmost() noexcept { return impl_.header_.left_; }
+        node_base*& __rightmost() noexcept { return impl_.header_.right_; }
+
+        static const Key& __key(const node_base* x) { return KeyOfValue()(static_cast<const node*>(x)->value_); }
+
+    public:
+        /** 构造、析构 */
+        explicit rb_tree(const Compare& comp = Compare(), const Alloc& a = Alloc())
+        : impl_(comp, node_allocator(a)) {}
+
+        rb_tree(const rb_tree& other)
+        : impl_(other.impl_.comp_, node_traits::select_on_container_copy_construction(other.__node_alloc())){
+            __copy_from(other);
+        }
+
+        rb_tree(const rb_tree& other, const Alloc& a) : impl_(other.impl_.comp_, node_allocator(a)){
+            __copy_from(other);
+        }
+
+        rb_tree(rb_tree&& other) noexcept
+        : impl_(other.impl_.comp_, simple_stl::move(other.__node_alloc())){
+            __steal(other);
+        }
+
+        ~rb_tree(){
+            clear();
+        }
+
+        /** 赋值 */
+        rb_tree& operator=(const rb_tree& other){
+            if (this != &other){
+                clear();
+                __copy_assign_alloc(other,
+                        typename node_traits::propagate_on_container_copy_assignment());
+                impl_.comp_ = other.impl_.comp_;
+                __copy_from(other);
+            }
+            return *this;
+        }
+
+        rb_tree& operator=(rb_tree&& other) noexcept(
+                node_traits::propagate_on_container_move_assignment::value ||
+                node_traits::is_always_equal::value){
+            if (this != &other)
+                __move_assign(other, bool_constant_s<
+                        node_traits::propagate_on_container_move_assignment::value ||
+                        node_traits::is_always_equal::value>());
+            return *this;
+        }
+
+        allocator_type get_allocator() const{
+            return allocator_type(__node_alloc());
+        }
+
+        key_compare key_comp() const { return impl_.comp_; }
+
+        /** 迭代器 */
+        iterator begin() noexcept { return iterator(impl_.header_.left_); }
+        const_iterator begin() const noexcept { return const_iterator(impl_.header_.left_); }
+        iterator end() noexcept { return iterator(__header()); }
+        const_iterator end() const noexcept { return const_iterator(__header()); }
+
+        /** 容量 */
+        size_type size() const noexcept { return impl_.node_count_; }
+        bool empty() const noexcept { return impl_.node_count_ == 0; }
+
+        size_type max_size() const noexcept{
+            return node_traits::max_size(__node_alloc());
+        }
+
+        /** 插入：唯一键 */
+        // 先找位置，键已存在时不构造节点
+        template<class V>
+        pair<iterator, bool> insert_unique(V&& v){
+            pair<node_base*, node_base*> pos = __get_insert_unique_pos(KeyOfValue()(v));
+            if (pos.second == nullptr)
+                return pair<iterator, bool>(iterator(pos.first), false);
+            return pair<iterator, bool>(__insert_value(pos.first, pos.second, simple_stl::forward<V>(v)), true);
+        }
+
+        template<class V>
+        iterator insert_unique(const_iterator hint, V&& v){
+            pair<node_base*, node_base*> pos = __get_insert_hint_unique_pos(hint, KeyOfValue()(v));
+            if (pos.second == nullptr)
+                return iterator(pos.first);
+            return __insert_value(pos.first, pos.second, simple_stl::forward<V>(v));
+        }
+
+        // 逐个以 end() 为提示插入，输入已排序时每次插入均摊常数时间
+        template<class InputIterator>
+        void insert_range_unique(InputIterator first, InputIterator last){
+            for ( ; first != last; ++first)
+                insert_unique(end(), *first);
+        }
+
+        // 节点只构造一次，键已存在时销毁
+        template<class... Args>
+        pair<iterator, bool> emplace_unique(Args&&... args){
+            node* z = __create_node(simple_stl::forward<Args>(args)...);
+            pair<node_base*, node_base*> pos;
+            try {
+                pos = __get_insert_unique_pos(__key(z));
+            }catch(...){
+                __destroy_node(z);
+                throw;
+            }
+            if (pos.second == nullptr){
+                __destroy_node(z);
+                return pair<iterator, bool>(iterator(pos.first), false);
+            }
+            return pair<iterator, bool>(__insert_node(pos.first, pos.second, z), true);
+        }
+
+        template<class... Args>
+        iterator emplace_hint_unique(const_iterator hint, Args&&... args){
+            node* z = __create_node(simple_stl::forward<Args>(args)...);
+            pair<node_base*, node_base*> pos;
+            try {
+                pos = __get_insert_hint_unique_pos(hint, __key(z));
+            }catch(...){
+                __destroy_node(z);
+                throw;
+            }
+            if (pos.second == nullptr){
+                __destroy_node(z);
+                return iterator(pos.first);
+            }
+            return __insert_node(pos.first, pos.second, z);
+        }
+
+        // 句柄为空或键已存在时不插入，后者节点留在返回值的句柄中
+        insert_return_type insert_node_unique(node_type&& nh){
+            insert_return_type result;
+            if (nh.empty()){
+                result.position = end();
+                result.inserted = false;
+                return result;
+            }
+            pair<node_base*, node_base*> pos = __get_insert_unique_pos(__key(nh.node_));
+            if (pos.second == nullptr){
+                result.position = iterator(pos.first);
+                result.inserted = false;
+                result.node = simple_stl::move(nh);
+            }else{
+                result.position = __insert_node(pos.first, pos.second, nh.__release());
+                result.inserted = true;
+            }
+            return result;
+        }
+
+        iterator insert_node_unique(const_iterator hint, node_type&& nh){
+            if (nh.empty())
+                return end();
+            pair<node_base*, node_base*> pos = __get_insert_hint_unique_pos(hint, __key(nh.node_));
+            if (pos.second == nullptr)
+                return iterator(pos.first);
+            return __insert_node(pos.first, pos.second, nh.__release());
+        }
+
+        /** 插入：可重复键 */
+        template<class V>
+        iterator insert_equal(V&& v){
+            pair<node_base*, node_base*> pos = __get_insert_equal_pos(KeyOfValue()(v));
+            return __insert_value(pos.first, pos.second, simple_stl::forward<V>(v));
+        }
+
+        template<class V>
+        iterator insert_equal(const_iterator hint, V&& v){
+            pair<node_base*, node_base*> pos = __get_insert_hint_equal_pos(hint, KeyOfValue()(v));
+            return __insert_value(pos.first, pos.second, simple_stl::forward<V>(v));
+        }
+
+        template<class InputIterator>
+        void insert_range_equal(InputIterator first, InputIterator last){
+            for ( ; first != last; ++first)
+                insert_equal(end(), *first);
+        }
+
+        template<class... Args>
+        iterator emplace_equal(Args&&... args){
+            node* z = __create_node(simple_stl::forward<Args>(args)...);
+            pair<node_base*, node_base*> pos;
+            try {
+                pos = __get_insert_equal_pos(__key(z));
+            }catch(...){
+                __destroy_node(z);
+                throw;
+            }
+            return __insert_node(pos.first, pos.second, z);
+        }
+
+        template<class... Args>
+        iterator emplace_hint_equal(const_iterator hint, Args&&... args){
+            node* z = __create_node(simple_stl::forward<Args>(args)...);
+            pair<node_base*, node_base*> pos;
+            try {
+                pos = __get_insert_hint_equal_pos(hint, __key(z));
+            }catch(...){
+                __destroy_node(z);
+                throw;
+            }
+            return __insert_node(pos.first, pos.second, z);
+        }
+
+        iterator insert_node_equal(node_type&& nh){
+            if (nh.empty())
+                return end();
+            pair<node_base*, node_base*> pos = __get_insert_equal_pos(__key(nh.node_));
+            return __insert_node(pos.first, pos.second, nh.__release());
+        }
+
+        iterator insert_node_equal(const_iterator hint, node_type&& nh){
+            if (nh.empty())
+                return end();
+            pair<node_base*, node_base*> pos = __get_insert_hint_equal_pos(hint, __key(nh.node_));
+            return __insert_node(pos.first, pos.second, nh.__release());
+        }
+
+        /** 由有序区间建树 */
+        // 清空后按中位数递归建成平衡树，区间须已按键排序；输入迭代器无法预知长度，退化为逐个提示插入
+        template<class InputIterator>
+        void assign_sorted(InputIterator first, InputIterator last, bool unique){
+            clear();
+            __assign_sorted(first, last, unique, iterator_category(first));
+        }
+
+        /** 删除 */
+        iterator erase(const_iterator pos){
+            iterator next(pos.node_);
+            ++next;
+            __destroy_node(static_cast<node*>(__unlink(pos.node_)));
+            return next;
+        }
+
+        iterator erase(const_iterator first, const_iterator last){
+            if (first == begin() && last == end()){
+                clear();
+                return end();
+            }
+            while (first != last)
+                first = erase(first);
+            return iterator(last.node_);
+        }
+
+        size_type erase(const key_type& k){
+            pair<iterator, iterator> range = equal_range(k);
+            const size_type old_size = size();
+            erase(range.first, range.second);
+            return old_size - size();
+        }
+
+        void clear() noexcept{
+            if (impl_.node_count_ != 0){
+                __erase_subtree(static_cast<node*>(__root()));
+                impl_.__reset();
+            }
+        }
+
+        // 摘下节点交给句柄，元素不动
+        node_type extract(const_iterator pos){
+            node* p = static_cast<node*>(__unlink(pos.node_));
+            return node_type(p, __node_alloc());
+        }
+
+        node_type extract(const key_type& k){
+            iterator it = find(k);
+            if (it == end())
+                return node_type();
+            return extract(it);
+        }
+
+        void swap(rb_tree& other) noexcept{
+            __swap_alloc(other, typename node_traits::propagate_on_container_swap());
+            simple_stl::swap(impl_.comp_, other.impl_.comp_);
+            rb_tree tmp_holder(impl_.comp_, get_allocator());
+            tmp_holder.__steal(other);
+            other.__steal(*this);
+            __steal(tmp_holder);
+        }
+
+        /** 查找 */
+        iterator find(const key_type& k){
+            iterator j = lower_bound(k);
+            return (j == end() || impl_.comp_(k, __key(j.node_))) ? end() : j;
+        }
+
+        const_iterator find(const key_type& k) const{
+            const_iterator j = lower_bound(k);
+            return (j == end() || impl_.comp_(k, __key(j.node_))) ? end() : j;
+        }
+
+        size_type count(const key_type& k) const{
+            pair<const_iterator, const_iterator> range = equal_range(k);
+            return static_cast<size_type>(simple_stl::distance(range.first, range.second));
+        }
+
+        // 第一个不小于 k 的元素
+        iterator lower_bound(const key_type& k) { return iterator(__lower_bound(k)); }
+        const_iterator lower_bound(const key_type& k) const { return const_iterator(__lower_bound(k)); }
+
+        // 第一个大于 k 的元素
+        iterator upper_bound(const key_type& k) { return iterator(__upper_bound(k)); }
+        const_iterator upper_bound(const key_type& k) const { return const_iterator(__upper_bound(k)); }
+
+        pair<iterator, iterator> equal_range(const key_type& k){
+            return pair<iterator, iterator>(lower_bound(k), upper_bound(k));
+        }
+
+        pair<const_iterator, const_iterator> equal_range(const key_type& k) const{
+            return pair<const_iterator, const_iterator>(lower_bound(k), upper_bound(k));
+        }
+
+    private:
+        template<class... Args>
+        node* __create_node(Args&&... args){
+            node* p = node_traits::allocate(__node_alloc(), 1);
+            try {
+                simple_stl::construct(&p->value_, simple_stl::forward<Args>(args)...);
+            }catch(...){
+                node_traits::deallocate(__node_alloc(), p, 1);
+                throw;
+            }
+            return p;
+        }
+
+        void __destroy_node(node* p) noexcept{
+            simple_stl::destroy(&p->value_);
+            node_traits::deallocate(__node_alloc(), p, 1);
+        }
+
+        // 释放整棵子树，不做平衡；沿左链迭代、对右子树递归，递归深度不超过树高
+        void __erase_subtree(node* x) noexcept{
+            while (x != nullptr){
+                __erase_subtree(static_cast<node*>(x->right_));
+                node* left = static_cast<node*>(x->left_);
+                __destroy_node(x);
+                x = left;
+            }
+        }
+
+        // 从树上摘下节点，不释放
+        node_base* __unlink(node_base* z) noexcept{
+            node_base* p = __rb_tree_rebalance_for_erase(z, impl_.header_);
+            --impl_.node_count_;
+            return p;
+        }
+
+        /**
+         * 查找插入位置，返回 (x, p)：
+         *  - p 非空时新节点接为 p 的子节点，x 非空表示接为左子节点
+         *  - p 为空时 x 是键相等的已有节点
+         */
+        pair<node_base*, node_base*> __get_insert_unique_pos(const key_type& k){
+            node_base* x = __root();
+            node_base* y = __header();
+            bool comp = true;
+            while (x != nullptr){
+                y = x;
+                comp = impl_.comp_(k, __key(x));
+                x = comp ? x->left_ : x->right_;
+            }
+            node_base* j = y;
+            if (comp){
+                if (j == impl_.header_.left_)
+                    return pair<node_base*, node_base*>(nullptr, y);
+                j = __rb_tree_decrement(j);
+            }
+            if (impl_.comp_(__key(j), k))
+                return pair<node_base*, node_base*>(nullptr, y);
+            return pair<node_base*, node_base*>(j, nullptr);
+        }
+
+        // 相等的键插在已有元素之后
+        pair<node_base*, node_base*> __get_insert_equal_pos(const key_type& k){
+            node_base* x = __root();
+            node_base* y = __header();
+            while (x != nullptr){
+                y = x;
+                x = impl_.comp_(k, __key(x)) ? x->left_ : x->right_;
+            }
+            return pair<node_base*, node_base*>(nullptr, y);
+        }
+
+        // 键落在提示位置与其相邻元素之间时直接接入，否则退回从根查找
+        pair<node_base*, node_base*> __get_insert_hint_unique_pos(const_iterator hint, const key_type& k){
+            node_base* pos = hint.node_;
+            if (pos == __header()){
+                if (size() > 0 && impl_.comp_(__key(impl_.header_.right_), k))
+                    return pair<node_base*, node_base*>(nullptr, impl_.header_.right_);
+                return __get_insert_unique_pos(k);
+            }
+            if (impl_.comp_(k, __key(pos))){
+                if (pos == impl_.header_.left_)
+                    return pair<node_base*, node_base*>(pos, pos);
+                node_base* before = __rb_tree_decrement(pos);
+                if (impl_.comp_(__key(before), k)){
+                    // before 没有右子节点时接为其右子节点，否则 pos 必没有左子节点
+                    if (before->right_ == nullptr)
+                        return pair<node_base*, node_base*>(nullptr, before);
+                    return pair<node_base*, node_base*>(pos, pos);
+                }
+                return __get_insert_unique_pos(k);
+            }
+            if (impl_.comp_(__key(pos), k)){
+                if (pos == impl_.header_.right_)
+                    return pair<node_base*, node_base*>(nullptr, pos);
+                node_base* after = __rb_tree_increment(pos);
+                if (impl_.comp_(k, __key(after))){
+                    if (pos->right_ == nullptr)
+                        return pair<node_base*, node_base*>(nullptr, pos);
+                    return pair<node_base*, node_base*>(after, after);
+                }
+                return __get_insert_unique_pos(k);
+            }
+            return pair<node_base*, node_base*>(pos, nullptr);
+        }
+
+        pair<node_base*, node_base*> __get_insert_hint_equal_pos(const_iterator hint, const key_type& k){
+            node_base* pos = hint.node_;
+            if (pos == __header()){
+                if (size() > 0 && !impl_.comp_(k, __key(impl_.header_.right_)))
+                    return pair<node_base*, node_base*>(nullptr, impl_.header_.right_);
+                return __get_insert_equal_pos(k);
+            }
+            if (!impl_.comp_(__key(pos), k)){
+                if (pos == impl_.header_.left_)
+                    return pair<node_base*, node_base*>(pos, pos);
+                node_base* before = __rb_tree_decrement(pos);
+                if (!impl_.comp_(k, __key(before))){
+                    if (before->right_ == nullptr)
+                        return pair<node_base*, node_base*>(nullptr, before);
+                    return pair<node_base*, node_base*>(pos, pos);
+                }
+                return __get_insert_equal_pos(k);
+            }
+            if (pos == impl_.header_.right_)
+                return pair<node_base*, node_base*>(nullptr, pos);
+            node_base* after = __rb_tree_increment(pos);
+            if (!impl_.comp_(__key(after), k)){
+                if (pos->right_ == nullptr)
+                    return pair<node_base*, node_base*>(nullptr, pos);
+                return pair<node_base*, node_base*>(after, after);
+            }
+            return __get_insert_equal_pos(k);
+        }
+
+        iterator __insert_node(node_base* x, node_base* p, node_base* z){
+            const bool insert_left = x != nullptr || p == __header() || impl_.comp_(__key(z), __key(p));
+            __rb_tree_insert_and_rebalance(insert_left, z, p, impl_.header_);
+            ++impl_.node_count_;
+            return iterator(z);
+        }
+
+        template<class V>
+        iterator __insert_value(node_base* x, node_base* p, V&& v){
+            node* z = __create_node(simple_stl::forward<V>(v));
+            return __insert_node(x, p, z);
+        }
+
+        node_base* __lower_bound(const key_type& k) const{
+            node_base* x = __root();
+            node_base* y = __header();
+            while (x != nullptr){
+                if (!impl_.comp_(__key(x), k)){
+                    y = x;
+                    x = x->left_;
+                }else{
+                    x = x->right_;
+                }
+            }
+            return y;
+        }
+
+        node_base* __upper_bound(const key_type& k) const{
+            node_base* x = __root();
+            node_base* y = __header();
+            while (x != nullptr){
+                if (impl_.comp_(k, __key(x))){
+                    y = x;
+                    x = x->left_;
+                }else{
+                    x = x->right_;
+                }
+            }
+            return y;
+        }
+
+        // 按原树的形状与颜色复制子树 x，挂到 p 之下
+        node* __copy(const node* x, node_base* p){
+            node* top = __clone_node(x);
+            top->parent_ = p;
+            try {
+                if (x->right_ != nullptr)
+                    top->right_ = __copy(static_cast<const node*>(x->right_), top);
+                p = top;
+                x = static_cast<const node*>(x->left_);
+                while (x != nullptr){
+                    node* y = __clone_node(x);
+                    p->left_ = y;
+                    y->parent_ = p;
+                    if (x->right_ != nullptr)
+                        y->right_ = __copy(static_cast<const node*>(x->right_), y);
+                    p = y;
+                    x = static_cast<const node*>(x->left_);
+                }
+            }catch(...){
+                __erase_subtree(top);
+                throw;
+            }
+            return top;
+        }
+
+        node* __clone_node(const node* x){
+            node* y = __create_node(x->value_);
+            y->color_ = x->color_;
+            y->left_ = nullptr;
+            y->right_ = nullptr;
+            return y;
+        }
+
+        void __copy_from(const rb_tree& other){
+            if (other.__root() == nullptr)
+                return;
+            __root() = __copy(static_cast<const node*>(other.__root()), __header());
+            __leftmost() = node_base::minimum(__root());
+            __rightmost() = node_base::maximum(__root());
+            impl_.node_count_ = other.impl_.node_count_;
+        }
+
+        template<class InputIterator>
+        void __assign_sorted(InputIterator first, InputIterator last, bool unique, input_iterator_tag){
+            if (unique)
+                insert_range_unique(first, last);
+            else
+                insert_range_equal(first, last);
+        }
+
+        template<class ForwardIterator>
+        void __assign_sorted(ForwardIterator first, ForwardIterator last, bool, forward_iterator_tag){
+            const size_type n = static_cast<size_type>(simple_stl::distance(first, last));
+            if (n == 0)
+                return;
+            // 按中位数划分时左右子树的节点数至多差一，所有空链接的深度只差一层；
+            // 不是满二叉树时把最深一层着红色，各路径的黑色节点数就相同
+            size_type depth = 0;
+            for (size_type m = n; m > 1; m >>= 1)
+                ++depth;
+            const size_type red_depth = ((n + 1) & n) == 0 ? size_type(-1) : depth;
+            node_base* root = __build_sorted(first, n, 0, red_depth);
+            root->parent_ = __header();
+            root->color_ = __rb_tree_black;
+            __root() = root;
+            __leftmost() = node_base::minimum(root);
+            __rightmost() = node_base::maximum(root);
+            impl_.node_count_ = n;
+        }
+
+        // 以 first 起的 n 个元素建子树，first 前进 n 步
+        template<class ForwardIterator>
+        node* __build_sorted(ForwardIterator& first, size_type n, size_type depth, size_type red_depth){
+            if (n == 0)
+                return nullptr;
+            const size_type left_n = (n - 1) / 2;
+            node* left = __build_sorted(first, left_n, depth + 1, red_depth);
+            node* z;
+            try {
+                z = __create_node(*first);
+            }catch(...){
+                __erase_subtree(left);
+                throw;
+            }
+            ++first;
+            z->color_ = depth == red_depth ? __rb_tree_red : __rb_tree_black;
+            z->left_ = left;
+            z->right_ = nullptr;
+            if (left != nullptr)
+                left->parent_ = z;
+            node* right;
+            try {
+                right = __build_sorted(first, n - 1 - left_n, depth + 1, red_depth);
+            }catch(...){
+                __erase_subtree(z);
+                throw;
+            }
+            z->right_ = right;
+            if (right != nullptr)
+                right->parent_ = z;
+            return z;
+        }
+
+        // 接管 other 的全部节点：头节点在对象内，根的父节点要改为指向自己的头节点
+        void __steal(rb_tree& other) noexcept{
+            if (other.__root() == nullptr)
+                return;
+            impl_.header_.parent_ = other.impl_.header_.parent_;
+            impl_.header_.left_ = other.impl_.header_.left_;
+            impl_.header_.right_ = other.impl_.header_.right_;
+            impl_.header_.parent_->parent_ = __header();
+            impl_.node_count_ = other.impl_.node_count_;
+            other.impl_.__reset();
+        }
+
+        void __copy_assign_alloc(const rb_tree& other, __true_type_s){
+            __node_alloc() = other.__node_alloc();
+        }
+
+        void __copy_assign_alloc(const rb_tree&, __false_type_s) {}
+
+        // 可以接管对方的节点
+        void __move_assign(rb_tree& other, __true_type_s){
+            clear();
+            __move_assign_alloc(other, typename node_traits::propagate_on_container_move_assignment());
+            impl_.comp_ = other.impl_.comp_;
+            __steal(other);
+        }
+
+        // 配置器不传播，相等时接管节点，否则逐一移动元素
+        void __move_assign(rb_tree& other, __false_type_s){
+            if (__node_alloc() == other.__node_alloc()){
+                __move_assign(other, __true_type_s());
+            }else{
+                clear();
+                impl_.comp_ = other.impl_.comp_;
+                for (iterator it = other.begin(); it != other.end(); ++it)
+                    emplace_hint_equal(end(), simple_stl::move(*it));
+                other.clear();
+            }
+        }
+
+        void __move_assign_alloc(rb_tree& other, __true_type_s){
+            __node_alloc() = simple_stl::move(other.__node_alloc());
+        }
+
+        void __move_assign_alloc(rb_tree&, __false_type_s) {}
+
+        void __swap_alloc(rb_tree& other, __true_type_s){
+            simple_stl::swap(__node_alloc(), other.__node_alloc());
+        }
+
+        void __swap_alloc(rb_tree&, __false_type_s) {}
+    };
+
+}   // simple_stl
+
+#endif //SIMPLESTL_STL_TREE_H
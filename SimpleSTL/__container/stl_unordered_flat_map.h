@@ -0,0 +1,250 @@
+/**
+ * Created by 史进 on 2023/6/17.
+ *
+ * unordered_flat_map：以 __flat_hashtable 为底层，元素直接存放在开放寻址的槽中
+ *  - 槽中存放 pair<Key, T>，以 pair<const Key, T> 的引用交给使用者
+ *  - 与 unordered_map 不同，扩容会使全部迭代器与元素的引用失效
+ */
+#ifndef SIMPLESTL_STL_UNORDERED_FLAT_MAP_H
+#define SIMPLESTL_STL_UNORDERED_FLAT_MAP_H
+
+#include <initializer_list>
+#include <stdexcept>
+
+#include "stl_flat_hashtable.h"
+#include "../__functional/stl_function.h"
+
+namespace simple_stl{
+
+    template<class Key, class T, class Hash = hash<Key>, class KeyEqual = equal_to<Key>,
+             class Alloc = allocator<pair<const Key, T> > >
+    class unordered_flat_map{
+    public:
+        typedef Key                     key_type;
+        typedef T                       mapped_type;
+        typedef pair<const Key, T>      value_type;
+        typedef Hash                    hasher;
+        typedef KeyEqual                key_equal;
+        typedef Alloc                   allocator_type;
+
+    private:
+        typedef pair<Key, T>    slot_type;
+        typedef __flat_hashtable<key_type, value_type, slot_type, __select1st_any,
+                                 Hash, KeyEqual, Alloc> rep_type;
+        rep_type table_;
+
+    public:
+        typedef typename rep_type::size_type            size_type;
+        typedef typename rep_type::difference_type      difference_type;
+        typedef value_type&                             reference;
+        typedef const value_type&                       const_reference;
+        typedef value_type*                             pointer;
+        typedef const value_type*                       const_pointer;
+        typedef typename rep_type::iterator             iterator;
+        typedef typename rep_type::const_iterator       const_iterator;
+
+        /** 构造 */
+        unordered_flat_map() : table_() {}
+
+        explicit unordered_flat_map(size_type n, const Hash& h = Hash(), const KeyEqual& eq = KeyEqual(),
+                                    const Alloc& a = Alloc())
+        : table_(n, h, eq, a) {}
+
+        explicit unordered_flat_map(const Alloc& a) : table_(0, Hash(), KeyEqual(), a) {}
+
+        template<class InputIterator, typename enable_if<
+                is_input_iterator<InputIterator>::value, int>::type = 0>
+        unordered_flat_map(InputIterator first, InputIterator last, size_type n = 0,
+                           const Hash& h = Hash(), const KeyEqual& eq = KeyEqual(), const Alloc& a = Alloc())
+        : table_(n, h, eq, a){
+            table_.insert_range_unique(first, last);
+        }
+
+        unordered_flat_map(std::initializer_list<value_type> il, size_type n = 0,
+                           const Hash& h = Hash(), const KeyEqual& eq = KeyEqual(), const Alloc& a = Alloc())
+        : table_(n, h, eq, a){
+            table_.insert_range_unique(il.begin(), il.end());
+        }
+
+        unordered_flat_map(const unordered_flat_map& other) : table_(other.table_) {}
+        unordered_flat_map(const unordered_flat_map& other, const Alloc& a) : table_(other.table_, a) {}
+        unordered_flat_map(unordered_flat_map&& other) noexcept : table_(simple_stl::move(other.table_)) {}
+
+        /** 赋值 */
+        unordered_flat_map& operator=(const unordered_flat_map& other){
+            table_ = other.table_;
+            return *this;
+        }
+
+        unordered_flat_map& operator=(unordered_flat_map&& other) noexcept(
+                noexcept(table_ = simple_stl::move(other.table_))){
+            table_ = simple_stl::move(other.table_);
+            return *this;
+        }
+
+        unordered_flat_map& operator=(std::initializer_list<value_type> il){
+            table_.clear();
+            table_.insert_range_unique(il.begin(), il.end());
+            return *this;
+        }
+
+        allocator_type get_allocator() const { return table_.get_allocator(); }
+        hasher hash_function() const { return table_.hash_function(); }
+        key_equal key_eq() const { return table_.key_eq(); }
+
+        /** 迭代器 */
+        iterator begin() noexcept { return table_.begin(); }
+        const_iterator begin() const noexcept { return table_.begin(); }
+        const_iterator cbegin() const noexcept { return table_.begin(); }
+        iterator end() noexcept { return table_.end(); }
+        const_iterator end() const noexcept { return table_.end(); }
+        const_iterator cend() const noexcept { return table_.end(); }
+
+        /** 容量 */
+        bool empty() const noexcept { return table_.empty(); }
+        size_type size() const noexcept { return table_.size(); }
+        size_type max_size() const noexcept { return table_.max_size(); }
+
+        /** 元素访问 */
+        // 键不存在时插入值初始化的元素
+        mapped_type& operator[](const key_type& k){
+            return try_emplace(k).first->second;
+        }
+
+        mapped_type& operator[](key_type&& k){
+            return try_emplace(simple_stl::move(k)).first->second;
+        }
+
+        mapped_type& at(const key_type& k){
+            iterator it = find(k);
+            if (it == end())
+                throw std::out_of_range("unordered_flat_map::at");
+            return it->second;
+        }
+
+        const mapped_type& at(const key_type& k) const{
+            const_iterator it = find(k);
+            if (it == end())
+                throw std::out_of_range("unordered_flat_map::at");
+            return it->second;
+        }
+
+        /** 修改 */
+        pair<iterator, bool> insert(const value_type& v) { return table_.insert_unique(v); }
+        pair<iterator, bool> insert(value_type&& v) { return table_.insert_unique(simple_stl::move(v)); }
+
+        template<class P, typename enable_if<
+                std::is_constructible<value_type, P&&>::value, int>::type = 0>
+        pair<iterator, bool> insert(P&& p) { return table_.emplace_unique(simple_stl::forward<P>(p)); }
+
+        // 开放寻址表的位置由哈希值决定，提示位置不起作用
+        iterator insert(const_iterator, const value_type& v) { return insert(v).first; }
+        iterator insert(const_iterator, value_type&& v) { return insert(simple_stl::move(v)).first; }
+
+        template<class InputIterator, typename enable_if<
+                is_input_iterator<InputIterator>::value, int>::type = 0>
+        void insert(InputIterator first, InputIterator last) { table_.insert_range_unique(first, last); }
+
+        void insert(std::initializer_list<value_type> il) { table_.insert_range_unique(il.begin(), il.end()); }
+
+        template<class... Args>
+        pair<iterator, bool> emplace(Args&&... args){
+            return table_.emplace_unique(simple_stl::forward<Args>(args)...);
+        }
+
+        template<class... Args>
+        iterator emplace_hint(const_iterator, Args&&... args){
+            return table_.emplace_unique(simple_stl::forward<Args>(args)...).first;
+        }
+
+        // 键不存在时才构造元素，键存在时 args 不被移动
+        template<class... Args>
+        pair<iterator, bool> try_emplace(const key_type& k, Args&&... args){
+            return table_.emplace_key_with(k, [&](slot_type* p){
+                simple_stl::construct(p, k, mapped_type(simple_stl::forward<Args>(args)...));
+            });
+        }
+
+        template<class... Args>
+        pair<iterator, bool> try_emplace(key_type&& k, Args&&... args){
+            return table_.emplace_key_with(k, [&](slot_type* p){
+                simple_stl::construct(p, simple_stl::move(k), mapped_type(simple_stl::forward<Args>(args)...));
+            });
+        }
+
+        template<class M>
+        pair<iterator, bool> insert_or_assign(const key_type& k, M&& obj){
+            pair<iterator, bool> r = table_.emplace_key_args(k, k, simple_stl::forward<M>(obj));
+            if (!r.second)
+                r.first->second = simple_stl::forward<M>(obj);
+            return r;
+        }
+
+        iterator erase(const_iterator pos) { return table_.erase(pos); }
+        iterator erase(iterator pos) { return table_.erase(pos); }
+        iterator erase(const_iterator first, const_iterator last) { return table_.erase(first, last); }
+        size_type erase(const key_type& k) { return table_.erase(k); }
+
+        void clear() noexcept { table_.clear(); }
+        void swap(unordered_flat_map& other) noexcept { table_.swap(other.table_); }
+
+        /** 查找 */
+        iterator find(const key_type& k) { return table_.find(k); }
+        const_iterator find(const key_type& k) const { return table_.find(k); }
+        size_type count(const key_type& k) const { return table_.contains(k) ? 1 : 0; }
+        bool contains(const key_type& k) const { return table_.contains(k); }
+
+        pair<iterator, iterator> equal_range(const key_type& k){
+            iterator first = find(k);
+            iterator last = first;
+            if (last != end())
+                ++last;
+            return pair<iterator, iterator>(first, last);
+        }
+
+        pair<const_iterator, const_iterator> equal_range(const key_type& k) const{
+            const_iterator first = find(k);
+            const_iterator last = first;
+            if (last != end())
+                ++last;
+            return pair<const_iterator, const_iterator>(first, last);
+        }
+
+        /** 散列策略 */
+        size_type bucket_count() const noexcept { return table_.bucket_count(); }
+        float load_factor() const noexcept { return table_.load_factor(); }
+        float max_load_factor() const noexcept { return table_.max_load_factor(); }
+        void rehash(size_type n) { table_.rehash(n); }
+        void reserve(size_type n) { table_.reserve(n); }
+    };
+
+    // 元素个数相同，且 x 的每个元素都能在 y 中找到相等的元素
+    template<class Key, class T, class Hash, class KeyEqual, class Alloc>
+    inline bool operator==(const unordered_flat_map<Key, T, Hash, KeyEqual, Alloc>& x,
+                           const unordered_flat_map<Key, T, Hash, KeyEqual, Alloc>& y){
+        if (x.size() != y.size())
+            return false;
+        for (typename unordered_flat_map<Key, T, Hash, KeyEqual, Alloc>::const_iterator it = x.begin();
+             it != x.end(); ++it){
+            typename unordered_flat_map<Key, T, Hash, KeyEqual, Alloc>::const_iterator j = y.find(it->first);
+            if (j == y.end() || !(j->second == it->second))
+                return false;
+        }
+        return true;
+    }
+
+    template<class Key, class T, class Hash, class KeyEqual, class Alloc>
+    inline bool operator!=(const unordered_flat_map<Key, T, Hash, KeyEqual, Alloc>& x,
+                           const unordered_flat_map<Key, T, Hash, KeyEqual, Alloc>& y){
+        return !(x == y);
+    }
+
+    template<class Key, class T, class Hash, class KeyEqual, class Alloc>
+    inline void swap(unordered_flat_map<Key, T, Hash, KeyEqual, Alloc>& x,
+                     unordered_flat_map<Key, T, Hash, KeyEqual, Alloc>& y) noexcept{
+        x.swap(y);
+    }
+
+}   // simple_stl
+
+#endif //SIMPLESTL_STL_UNORDERED_FLAT_MAP_H
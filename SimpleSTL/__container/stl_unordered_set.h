@@ -0,0 +1,193 @@
+/**
+ * Created by 史进 on 2023/6/18.
+ *
+ * unordered_set：以 hashtable 为底层，元素即键，不可修改，iterator 与 const_iterator 相同。
+ * 渐进式扩容同 unordered_map
+ */
+#ifndef SIMPLESTL_STL_UNORDERED_SET_H
+#define SIMPLESTL_STL_UNORDERED_SET_H
+
+#include <initializer_list>
+
+#include "stl_hashtable.h"
+#include "../__functional/stl_function.h"
+
+namespace simple_stl{
+
+    template<class Key, class Hash = hash<Key>, class KeyEqual = equal_to<Key>, class Alloc = allocator<Key> >
+    class unordered_set{
+    public:
+        typedef Key         key_type;
+        typedef Key         value_type;
+        typedef Hash        hasher;
+        typedef KeyEqual    key_equal;
+        typedef Alloc       allocator_type;
+
+    private:
+        typedef hashtable<value_type, key_type, identity<value_type>, Hash, KeyEqual, Alloc> rep_type;
+        rep_type table_;
+
+    public:
+        typedef typename rep_type::size_type            size_type;
+        typedef typename rep_type::difference_type      difference_type;
+        typedef const value_type&                       reference;
+        typedef const value_type&                       const_reference;
+        typedef const value_type*                       pointer;
+        typedef const value_type*                       const_pointer;
+        typedef typename rep_type::const_iterator       iterator;
+        typedef typename rep_type::const_iterator       const_iterator;
+
+        /** 构造 */
+        unordered_set() : table_() {}
+
+        explicit unordered_set(size_type n, const Hash& h = Hash(), const KeyEqual& eq = KeyEqual(),
+                                    const Alloc& a = Alloc())
+        : table_(n, h, eq, a) {}
+
+        explicit unordered_set(const Alloc& a) : table_(0, Hash(), KeyEqual(), a) {}
+
+        template<class InputIterator, typename enable_if<
+                is_input_iterator<InputIterator>::value, int>::type = 0>
+        unordered_set(InputIterator first, InputIterator last, size_type n = 0,
+                           const Hash& h = Hash(), const KeyEqual& eq = KeyEqual(), const Alloc& a = Alloc())
+        : table_(n, h, eq, a){
+            table_.insert_range_unique(first, last);
+        }
+
+        unordered_set(std::initializer_list<value_type> il, size_type n = 0,
+                           const Hash& h = Hash(), const KeyEqual& eq = KeyEqual(), const Alloc& a = Alloc())
+        : table_(n, h, eq, a){
+            table_.insert_range_unique(il.begin(), il.end());
+        }
+
+        unordered_set(const unordered_set& other) : table_(other.table_) {}
+        unordered_set(const unordered_set& other, const Alloc& a) : table_(other.table_, a) {}
+        unordered_set(unordered_set&& other) noexcept : table_(simple_stl::move(other.table_)) {}
+
+        /** 赋值 */
+        unordered_set& operator=(const unordered_set& other){
+            table_ = other.table_;
+            return *this;
+        }
+
+        unordered_set& operator=(unordered_set&& other) noexcept(
+                noexcept(table_ = simple_stl::move(other.table_))){
+            table_ = simple_stl::move(other.table_);
+            return *this;
+        }
+
+        unordered_set& operator=(std::initializer_list<value_type> il){
+            table_.clear();
+            table_.insert_range_unique(il.begin(), il.end());
+            return *this;
+        }
+
+        allocator_type get_allocator() const { return table_.get_allocator(); }
+        hasher hash_function() const { return table_.hash_function(); }
+        key_equal key_eq() const { return table_.key_eq(); }
+
+        /** 迭代器 */
+        iterator begin() const noexcept { return table_.begin(); }
+        iterator cbegin() const noexcept { return table_.begin(); }
+        iterator end() const noexcept { return table_.end(); }
+        iterator cend() const noexcept { return table_.end(); }
+
+        /** 容量 */
+        bool empty() const noexcept { return table_.empty(); }
+        size_type size() const noexcept { return table_.size(); }
+        size_type max_size() const noexcept { return table_.max_size(); }
+
+        /** 修改 */
+        pair<iterator, bool> insert(const value_type& v){
+            pair<typename rep_type::iterator, bool> p = table_.insert_unique(v);
+            return pair<iterator, bool>(p.first, p.second);
+        }
+
+        pair<iterator, bool> insert(value_type&& v){
+            pair<typename rep_type::iterator, bool> p = table_.insert_unique(simple_stl::move(v));
+            return pair<iterator, bool>(p.first, p.second);
+        }
+
+        // 节点位置由哈希值决定，提示位置不起作用
+        iterator insert(const_iterator, const value_type& v) { return insert(v).first; }
+        iterator insert(const_iterator, value_type&& v) { return insert(simple_stl::move(v)).first; }
+
+        template<class InputIterator, typename enable_if<
+                is_input_iterator<InputIterator>::value, int>::type = 0>
+        void insert(InputIterator first, InputIterator last) { table_.insert_range_unique(first, last); }
+
+        void insert(std::initializer_list<value_type> il) { table_.insert_range_unique(il.begin(), il.end()); }
+
+        template<class... Args>
+        pair<iterator, bool> emplace(Args&&... args){
+            pair<typename rep_type::iterator, bool> p = table_.emplace_unique(simple_stl::forward<Args>(args)...);
+            return pair<iterator, bool>(p.first, p.second);
+        }
+
+        template<class... Args>
+        iterator emplace_hint(const_iterator, Args&&... args){
+            return emplace(simple_stl::forward<Args>(args)...).first;
+        }
+
+        iterator erase(const_iterator pos) { return table_.erase(pos); }
+        iterator erase(const_iterator first, const_iterator last) { return table_.erase(first, last); }
+        size_type erase(const key_type& k) { return table_.erase(k); }
+
+        void clear() noexcept { table_.clear(); }
+        void swap(unordered_set& other) noexcept { table_.swap(other.table_); }
+
+        /** 查找 */
+        iterator find(const key_type& k) const { return table_.find(k); }
+        size_type count(const key_type& k) const { return table_.contains(k) ? 1 : 0; }
+        bool contains(const key_type& k) const { return table_.contains(k); }
+
+        pair<iterator, iterator> equal_range(const key_type& k) const{
+            iterator first = find(k);
+            iterator last = first;
+            if (last != end())
+                ++last;
+            return pair<iterator, iterator>(first, last);
+        }
+
+        /** 散列策略 */
+        size_type bucket_count() const noexcept { return table_.bucket_count(); }
+        float load_factor() const noexcept { return table_.load_factor(); }
+        float max_load_factor() const noexcept { return table_.max_load_factor(); }
+        void max_load_factor(float ml) noexcept { table_.max_load_factor(ml); }
+        void rehash(size_type n) { table_.rehash(n); }
+        void reserve(size_type n) { table_.reserve(n); }
+
+        /** 渐进式扩容 */
+        void set_rehash_step(size_type n) noexcept { table_.set_rehash_step(n); }
+        size_type rehash_step() const noexcept { return table_.rehash_step(); }
+        bool rehashing() const noexcept { return table_.rehashing(); }
+        bool migrate(size_type n) { return table_.migrate(n); }
+    };
+
+    template<class Key, class Hash, class KeyEqual, class Alloc>
+    inline bool operator==(const unordered_set<Key, Hash, KeyEqual, Alloc>& x,
+                           const unordered_set<Key, Hash, KeyEqual, Alloc>& y){
+        if (x.size() != y.size())
+            return false;
+        for (typename unordered_set<Key, Hash, KeyEqual, Alloc>::const_iterator it = x.begin();
+             it != x.end(); ++it)
+            if (!y.contains(*it))
+                return false;
+        return true;
+    }
+
+    template<class Key, class Hash, class KeyEqual, class Alloc>
+    inline bool operator!=(const unordered_set<Key, Hash, KeyEqual, Alloc>& x,
+                           const unordered_set<Key, Hash, KeyEqual, Alloc>& y){
+        return !(x == y);
+    }
+
+    template<class Key, class Hash, class KeyEqual, class Alloc>
+    inline void swap(unordered_set<Key, Hash, KeyEqual, Alloc>& x,
+                     unordered_set<Key, Hash, KeyEqual, Alloc>& y) noexcept{
+        x.swap(y);
+    }
+
+}   // simple_stl
+
+#endif //SIMPLESTL_STL_UNORDERED_SET_H
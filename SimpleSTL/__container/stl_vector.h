@@ -0,0 +1,850 @@
+/**
+ * Created by 史进 on 2023/6/12.
+ *
+ * vector：连续存储的动态数组，迭代器即为原生指针
+ *  - 内存通过 allocator_traits 向配置器申请，元素的构造与析构使用 uninitialized_* 与 destroy
+ *  - 扩容倍数由 GrowthPolicy 决定，默认为 2 倍
+ *  - 扩容时可平凡重定位的元素整体按字节搬移，配置器提供 reallocate() 时交给它原地扩展；
+ *    其它元素在移动构造不抛异常时移动，否则拷贝（move_if_noexcept）
+ *  - 扩容、插入、赋值的算法放在 __vector_ops 中，与 small_vector 共用
+ */
+#ifndef SIMPLESTL_STL_VECTOR_H
+#define SIMPLESTL_STL_VECTOR_H
+
+#include <cstddef>
+#include <initializer_list>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "../iterator.h"
+#include "../type_traits.h"
+#include "../utility.h"
+#include "../__memory/stl_allocator.h"
+#include "../__memory/stl_allocator_traits.h"
+#include "../__memory/stl_construct.h"
+#include "../__memory/stl_uninitialized.h"
+#include "../__algorithm/stl_algobase.h"
+
+namespace simple_stl{
+
+    // 扩容策略：新容量为旧容量的 Num / Den 倍，且不小于所需容量
+    template<size_t Num = 2, size_t Den = 1>
+    struct vector_growth{
+        static_assert(Num > Den && Den > 0, "growth factor must be greater than 1");
+
+        static size_t next_capacity(size_t old_cap, size_t required, size_t max_cap){
+            size_t grown = old_cap / Den * Num + old_cap % Den * Num / Den;
+            if (grown < old_cap || grown > max_cap)
+                grown = max_cap;
+            return grown < required ? required : grown;
+        }
+    };
+
+    // 检测配置器是否提供 reallocate(p, old_n, new_n)
+    template<class Alloc>
+    struct __has_reallocate{
+    private:
+        struct __two {char __lx; char __rx;};
+        template <class A> static __two __test(...);
+        template <class A> static char __test(decltype(std::declval<A&>().reallocate(
+                std::declval<typename A::value_type*>(), size_t(), size_t()))*);
+    public:
+        static const bool value = sizeof(__test<Alloc>(nullptr)) == 1;
+    };
+
+    template<class Tp>
+    inline Tp* __uninitialized_move_if_noexcept_aux(Tp* first, Tp* last, Tp* result, __true_type_s){
+        return simple_stl::uninitialized_move(first, last, result);
+    }
+
+    template<class Tp>
+    inline Tp* __uninitialized_move_if_noexcept_aux(Tp* first, Tp* last, Tp* result, __false_type_s){
+        return simple_stl::uninitialized_copy(first, last, result);
+    }
+
+    // 移动构造不抛异常，或者只能移动时才移动，否则拷贝，以保证扩容的强异常安全
+    template<class Tp>
+    inline Tp* __uninitialized_move_if_noexcept(Tp* first, Tp* last, Tp* result){
+        typedef bool_constant_s<std::is_nothrow_move_constructible<Tp>::value ||
+                                !std::is_copy_constructible<Tp>::value> use_move;
+        return __uninitialized_move_if_noexcept_aux(first, last, result, use_move());
+    }
+
+
+    // vector 与 small_vector 共用的扩容、插入与赋值算法（CRTP）。Derived 提供：
+    //  - impl_：含 start_、finish_、end_of_storage_ 三个指针，继承配置器
+    //  - __alloc()、__next_capacity(extra)、emplace_back()
+    //  - __free_storage()：归还当前空间（元素已析构或已转移）
+    //  - __assign_realloc(first, last, n)：容量不足 n 时的整体赋值
+    template<class Derived, class T, class Alloc>
+    class __vector_ops{
+    protected:
+        typedef allocator_traits<Alloc>     __alloc_traits;
+
+        Derived& __derived() noexcept { return *static_cast<Derived*>(this); }
+        auto& __impl() noexcept { return __derived().impl_; }
+
+        T* __allocate(size_t n){
+            return n == 0 ? nullptr : __alloc_traits::allocate(__derived().__alloc(), n);
+        }
+
+        void __deallocate(T* p, size_t n){
+            if (p != nullptr)
+                __alloc_traits::deallocate(__derived().__alloc(), p, n);
+        }
+
+        void __erase_at_end(T* pos) noexcept{
+            simple_stl::destroy(pos, __impl().finish_);
+            __impl().finish_ = pos;
+        }
+
+        // 将 [first, last) 转移到未初始化的 result 处：
+        // 可平凡重定位时按字节搬移，原区间即告结束；否则移动或拷贝，原区间由 __release_old 析构
+        static T* __transfer(T* first, T* last, T* result){
+            return __transfer_aux(first, last, result, bool_constant_s<is_trivially_relocatable<T>::value>());
+        }
+
+        static T* __transfer_aux(T* first, T* last, T* result, __true_type_s){
+            return simple_stl::uninitialized_relocate(first, last, result);
+        }
+
+        static T* __transfer_aux(T* first, T* last, T* result, __false_type_s){
+            return __uninitialized_move_if_noexcept(first, last, result);
+        }
+
+        // 转移全部完成后析构原有元素、归还旧空间，并换用新空间
+        void __release_old(T* new_start, T* new_finish, size_t new_cap){
+            if (!is_trivially_relocatable<T>::value)
+                simple_stl::destroy(__impl().start_, __impl().finish_);
+            __derived().__free_storage();
+            __impl().start_ = new_start;
+            __impl().finish_ = new_finish;
+            __impl().end_of_storage_ = new_start + new_cap;
+        }
+
+        // 将现有元素转移到容量为 n 的新空间
+        void __transfer_all(size_t n){
+            T* new_start = __allocate(n);
+            T* new_finish;
+            try {
+                new_finish = __transfer(__impl().start_, __impl().finish_, new_start);
+            }catch(...){
+                __deallocate(new_start, n);
+                throw;
+            }
+            __release_old(new_start, new_finish, n);
+        }
+
+        // 新元素已构造在新空间的 [before, before + n)，将原有元素转移到其前后；
+        // 转移失败时原有元素不受影响
+        void __transfer_around(T* pos, T* new_start, size_t new_cap, size_t before, size_t n){
+            T* new_finish = nullptr;
+            try {
+                new_finish = __transfer(__impl().start_, pos, new_start);
+                new_finish = __transfer(pos, __impl().finish_, new_finish + n);
+            }catch(...){
+                if (new_finish != nullptr)
+                    simple_stl::destroy(new_start, new_start + before);
+                simple_stl::destroy(new_start + before, new_start + before + n);
+                __deallocate(new_start, new_cap);
+                throw;
+            }
+            __release_old(new_start, new_finish, new_cap);
+        }
+
+        // 容量已满时在 pos 处构造新元素：新元素先构造，防止参数引用容器内的元素
+        template<class... Args>
+        void __realloc_emplace(T* pos, Args&&... args){
+            const size_t new_cap = __derived().__next_capacity(1);
+            const size_t before = size_t(pos - __impl().start_);
+            T* new_start = __allocate(new_cap);
+            try {
+                simple_stl::construct(new_start + before, simple_stl::forward<Args>(args)...);
+            }catch(...){
+                __deallocate(new_start, new_cap);
+                throw;
+            }
+            __transfer_around(pos, new_start, new_cap, before, 1);
+        }
+
+        void __fill_insert(T* pos, size_t n, const T& value){
+            if (n == 0)
+                return;
+            if (size_t(__impl().end_of_storage_ - __impl().finish_) >= n){
+                // 先拷贝一份，防止 value 引用的正是容器内的元素
+                T copy = value;
+                const size_t elems_after = size_t(__impl().finish_ - pos);
+                T* old_finish = __impl().finish_;
+                if (elems_after > n){
+                    __impl().finish_ = simple_stl::uninitialized_move(old_finish - n, old_finish, old_finish);
+                    simple_stl::move_backward(pos, old_finish - n, old_finish);
+                    simple_stl::fill(pos, pos + n, copy);
+                }else{
+                    __impl().finish_ = simple_stl::uninitialized_fill_n(old_finish, n - elems_after, copy);
+                    __impl().finish_ = simple_stl::uninitialized_move(pos, old_finish, __impl().finish_);
+                    simple_stl::fill(pos, old_finish, copy);
+                }
+            }else{
+                const size_t new_cap = __derived().__next_capacity(n);
+                const size_t before = size_t(pos - __impl().start_);
+                T* new_start = __allocate(new_cap);
+                try {
+                    simple_stl::uninitialized_fill_n(new_start + before, n, value);
+                }catch(...){
+                    __deallocate(new_start, new_cap);
+                    throw;
+                }
+                __transfer_around(pos, new_start, new_cap, before, n);
+            }
+        }
+
+        template<class InputIterator>
+        void __range_insert(T* pos, InputIterator first, InputIterator last, input_iterator_tag){
+            if (pos == __impl().finish_){
+                for ( ; first != last; ++first)
+                    __derived().emplace_back(*first);
+            }else{
+                // 先收集到临时容器中，再按前向迭代器处理
+                Derived tmp(first, last, __derived().__alloc());
+                __range_insert(pos, simple_stl::make_move_iterator(tmp.begin()),
+                               simple_stl::make_move_iterator(tmp.end()), forward_iterator_tag());
+            }
+        }
+
+        template<class ForwardIterator>
+        void __range_insert(T* pos, ForwardIterator first, ForwardIterator last, forward_iterator_tag){
+            const size_t n = static_cast<size_t>(simple_stl::distance(first, last));
+            if (n == 0)
+                return;
+            if (size_t(__impl().end_of_storage_ - __impl().finish_) >= n){
+                const size_t elems_after = size_t(__impl().finish_ - pos);
+                T* old_finish = __impl().finish_;
+                if (elems_after > n){
+                    __impl().finish_ = simple_stl::uninitialized_move(old_finish - n, old_finish, old_finish);
+                    simple_stl::move_backward(pos, old_finish - n, old_finish);
+                    simple_stl::copy(first, last, pos);
+                }else{
+                    ForwardIterator mid = first;
+                    simple_stl::advance(mid, elems_after);
+                    __impl().finish_ = simple_stl::uninitialized_copy(mid, last, old_finish);
+                    __impl().finish_ = simple_stl::uninitialized_move(pos, old_finish, __impl().finish_);
+                    simple_stl::copy(first, mid, pos);
+                }
+            }else{
+                const size_t new_cap = __derived().__next_capacity(n);
+                const size_t before = size_t(pos - __impl().start_);
+                T* new_start = __allocate(new_cap);
+                try {
+                    simple_stl::uninitialized_copy(first, last, new_start + before);
+                }catch(...){
+                    __deallocate(new_start, new_cap);
+                    throw;
+                }
+                __transfer_around(pos, new_start, new_cap, before, n);
+            }
+        }
+
+        template<class InputIterator>
+        void __assign_aux(InputIterator first, InputIterator last, input_iterator_tag){
+            T* cur = __impl().start_;
+            for ( ; first != last && cur != __impl().finish_; ++first, ++cur)
+                *cur = *first;
+            if (first == last)
+                __erase_at_end(cur);
+            else
+                for ( ; first != last; ++first)
+                    __derived().emplace_back(*first);
+        }
+
+        template<class ForwardIterator>
+        void __assign_aux(ForwardIterator first, ForwardIterator last, forward_iterator_tag){
+            const size_t n = static_cast<size_t>(simple_stl::distance(first, last));
+            const size_t sz = size_t(__impl().finish_ - __impl().start_);
+            if (n > size_t(__impl().end_of_storage_ - __impl().start_)){
+                __derived().__assign_realloc(first, last, n);
+            }else if (n > sz){
+                ForwardIterator mid = first;
+                simple_stl::advance(mid, sz);
+                simple_stl::copy(first, mid, __impl().start_);
+                __impl().finish_ = simple_stl::uninitialized_copy(mid, last, __impl().finish_);
+            }else{
+                __erase_at_end(simple_stl::copy(first, last, __impl().start_));
+            }
+        }
+    };
+
+
+    template<class T, class Alloc = allocator<T>, class GrowthPolicy = vector_growth<> >
+    class vector : private __vector_ops<vector<T, Alloc, GrowthPolicy>, T, Alloc>{
+    public:
+        typedef T                                   value_type;
+        typedef Alloc                               allocator_type;
+        typedef size_t                              size_type;
+        typedef ptrdiff_t                           difference_type;
+        typedef T&                                  reference;
+        typedef const T&                            const_reference;
+        typedef T*                                  pointer;
+        typedef const T*                            const_pointer;
+        typedef T*                                  iterator;
+        typedef const T*                            const_iterator;
+
+    private:
+        typedef allocator_traits<Alloc>             alloc_traits;
+        typedef __vector_ops<vector, T, Alloc>      __ops;
+
+        friend class __vector_ops<vector, T, Alloc>;
+
+        using __ops::__allocate;
+        using __ops::__deallocate;
+        using __ops::__erase_at_end;
+        using __ops::__transfer_all;
+        using __ops::__realloc_emplace;
+        using __ops::__fill_insert;
+        using __ops::__range_insert;
+        using __ops::__assign_aux;
+
+        // 继承配置器以便无状态配置器不占空间
+        struct __vector_impl : public Alloc{
+            T* start_;
+            T* finish_;
+            T* end_of_storage_;
+
+            __vector_impl() : Alloc(), start_(nullptr), finish_(nullptr), end_of_storage_(nullptr) {}
+            explicit __vector_impl(const Alloc& a)
+            : Alloc(a), start_(nullptr), finish_(nullptr), end_of_storage_(nullptr) {}
+        };
+
+        __vector_impl impl_;
+
+        Alloc& __alloc() noexcept { return impl_; }
+        const Alloc& __alloc() const noexcept { return impl_; }
+
+        // 释放内存并置空三个指针，调用前元素已全部析构
+        void __release_storage() noexcept{
+            __deallocate(impl_.start_, capacity());
+            impl_.start_ = impl_.finish_ = impl_.end_of_storage_ = nullptr;
+        }
+
+    public:
+        /** 构造、析构 */
+        vector() : impl_() {}
+
+        explicit vector(const Alloc& a) : impl_(a) {}
+
+        // 构造函数体抛出异常时不会调用析构函数，需自行释放已配置的内存
+        explicit vector(size_type n, const Alloc& a = Alloc()) : impl_(a){
+            __init_n(n);
+            try {
+                __default_append(n);
+            }catch(...){
+                __release_storage();
+                throw;
+            }
+        }
+
+        vector(size_type n, const T& value, const Alloc& a = Alloc()) : impl_(a){
+            __init_n(n);
+            try {
+                impl_.finish_ = simple_stl::uninitialized_fill_n(impl_.start_, n, value);
+            }catch(...){
+                __release_storage();
+                throw;
+            }
+        }
+
+        template<class InputIterator, typename enable_if<
+                is_input_iterator<InputIterator>::value, int>::type = 0>
+        vector(InputIterator first, InputIterator last, const Alloc& a = Alloc()) : impl_(a){
+            __range_init(first, last, iterator_category(first));
+        }
+
+        vector(std::initializer_list<T> il, const Alloc& a = Alloc()) : impl_(a){
+            __range_init(il.begin(), il.end(), random_access_iterator_tag());
+        }
+
+        vector(const vector& other)
+        : impl_(alloc_traits::select_on_container_copy_construction(other.__alloc())){
+            __range_init(other.begin(), other.end(), random_access_iterator_tag());
+        }
+
+        vector(const vector& other, const Alloc& a) : impl_(a){
+            __range_init(other.begin(), other.end(), random_access_iterator_tag());
+        }
+
+        vector(vector&& other) noexcept : impl_(simple_stl::move(other.__alloc())){
+            __steal(other);
+        }
+
+        // 配置器不相等时无法接管内存，只能逐一移动元素
+        vector(vector&& other, const Alloc& a) : impl_(a){
+            if (a == other.__alloc()){
+                __steal(other);
+            }else{
+                __init_n(other.size());
+                try {
+                    impl_.finish_ = simple_stl::uninitialized_move(other.begin(), other.end(), impl_.start_);
+                }catch(...){
+                    __release_storage();
+                    throw;
+                }
+            }
+        }
+
+        ~vector(){
+            simple_stl::destroy(impl_.start_, impl_.finish_);
+            __deallocate(impl_.start_, capacity());
+        }
+
+        /** 赋值 */
+        vector& operator=(const vector& other){
+            if (this != &other){
+                __copy_assign_alloc(other,
+                        typename alloc_traits::propagate_on_container_copy_assignment());
+                assign(other.begin(), other.end());
+            }
+            return *this;
+        }
+
+        vector& operator=(vector&& other) noexcept(
+                alloc_traits::propagate_on_container_move_assignment::value ||
+                alloc_traits::is_always_equal::value){
+            if (this != &other)
+                __move_assign(other, bool_constant_s<
+                        alloc_traits::propagate_on_container_move_assignment::value ||
+                        alloc_traits::is_always_equal::value>());
+            return *this;
+        }
+
+        vector& operator=(std::initializer_list<T> il){
+            assign(il.begin(), il.end());
+            return *this;
+        }
+
+        void assign(size_type n, const T& value){
+            if (n > capacity()){
+                vector tmp(n, value, __alloc());
+                swap(tmp);
+            }else if (n > size()){
+                simple_stl::fill(impl_.start_, impl_.finish_, value);
+                impl_.finish_ = simple_stl::uninitialized_fill_n(impl_.finish_, n - size(), value);
+            }else{
+                simple_stl::fill(impl_.start_, impl_.start_ + n, value);
+                __erase_at_end(impl_.start_ + n);
+            }
+        }
+
+        template<class InputIterator, typename enable_if<
+                is_input_iterator<InputIterator>::value, int>::type = 0>
+        void assign(InputIterator first, InputIterator last){
+            __assign_aux(first, last, iterator_category(first));
+        }
+
+        void assign(std::initializer_list<T> il){
+            assign(il.begin(), il.end());
+        }
+
+        allocator_type get_allocator() const{
+            return __alloc();
+        }
+
+        /** 迭代器 */
+        iterator begin() noexcept { return impl_.start_; }
+        const_iterator begin() const noexcept { return impl_.start_; }
+        const_iterator cbegin() const noexcept { return impl_.start_; }
+        iterator end() noexcept { return impl_.finish_; }
+        const_iterator end() const noexcept { return impl_.finish_; }
+        const_iterator cend() const noexcept { return impl_.finish_; }
+
+        /** 容量 */
+        size_type size() const noexcept { return size_type(impl_.finish_ - impl_.start_); }
+        size_type capacity() const noexcept { return size_type(impl_.end_of_storage_ - impl_.start_); }
+        bool empty() const noexcept { return impl_.start_ == impl_.finish_; }
+
+        size_type max_size() const noexcept{
+            return alloc_traits::max_size(__alloc());
+        }
+
+        // 容量不足 n 时一次扩展到 n
+        void reserve(size_type n){
+            if (n > max_size())
+                throw std::length_error("vector::reserve");
+            if (n > capacity())
+                __reallocate(n);
+        }
+
+        // 释放多余容量
+        void shrink_to_fit(){
+            if (capacity() > size())
+                __reallocate(size());
+        }
+
+        void resize(size_type n){
+            if (n > size())
+                __default_append(n - size());
+            else
+                __erase_at_end(impl_.start_ + n);
+        }
+
+        void resize(size_type n, const T& value){
+            if (n > size())
+                insert(end(), n - size(), value);
+            else
+                __erase_at_end(impl_.start_ + n);
+        }
+
+        /** 元素访问 */
+        reference operator[](size_type n) { return impl_.start_[n]; }
+        const_reference operator[](size_type n) const { return impl_.start_[n]; }
+
+        reference at(size_type n){
+            __range_check(n);
+            return impl_.start_[n];
+        }
+
+        const_reference at(size_type n) const{
+            __range_check(n);
+            return impl_.start_[n];
+        }
+
+        reference front() { return *impl_.start_; }
+        const_reference front() const { return *impl_.start_; }
+        reference back() { return *(impl_.finish_ - 1); }
+        const_reference back() const { return *(impl_.finish_ - 1); }
+
+        T* data() noexcept { return impl_.start_; }
+        const T* data() const noexcept { return impl_.start_; }
+
+        /** 修改 */
+        void push_back(const T& value){
+            emplace_back(value);
+        }
+
+        void push_back(T&& value){
+            emplace_back(simple_stl::move(value));
+        }
+
+        template<class... Args>
+        reference emplace_back(Args&&... args){
+            if (impl_.finish_ != impl_.end_of_storage_){
+                simple_stl::construct(impl_.finish_, simple_stl::forward<Args>(args)...);
+                ++impl_.finish_;
+            }else{
+                __realloc_emplace(impl_.finish_, simple_stl::forward<Args>(args)...);
+            }
+            return back();
+        }
+
+        void pop_back(){
+            --impl_.finish_;
+            simple_stl::destroy(impl_.finish_);
+        }
+
+        template<class... Args>
+        iterator emplace(const_iterator pos, Args&&... args){
+            T* p = const_cast<T*>(pos);
+            const difference_type offset = p - impl_.start_;
+            if (impl_.finish_ == impl_.end_of_storage_){
+                __realloc_emplace(p, simple_stl::forward<Args>(args)...);
+            }else if (p == impl_.finish_){
+                simple_stl::construct(impl_.finish_, simple_stl::forward<Args>(args)...);
+                ++impl_.finish_;
+            }else{
+                // 先构造临时对象，防止参数引用容器内的元素
+                T tmp(simple_stl::forward<Args>(args)...);
+                simple_stl::construct(impl_.finish_, simple_stl::move(*(impl_.finish_ - 1)));
+                ++impl_.finish_;
+                simple_stl::move_backward(p, impl_.finish_ - 2, impl_.finish_ - 1);
+                *p = simple_stl::move(tmp);
+            }
+            return impl_.start_ + offset;
+        }
+
+        iterator insert(const_iterator pos, const T& value){
+            return emplace(pos, value);
+        }
+
+        iterator insert(const_iterator pos, T&& value){
+            return emplace(pos, simple_stl::move(value));
+        }
+
+        iterator insert(const_iterator pos, size_type n, const T& value){
+            const difference_type offset = pos - impl_.start_;
+            __fill_insert(const_cast<T*>(pos), n, value);
+            return impl_.start_ + offset;
+        }
+
+        template<class InputIterator, typename enable_if<
+                is_input_iterator<InputIterator>::value, int>::type = 0>
+        iterator insert(const_iterator pos, InputIterator first, InputIterator last){
+            const difference_type offset = pos - impl_.start_;
+            __range_insert(const_cast<T*>(pos), first, last, iterator_category(first));
+            return impl_.start_ + offset;
+        }
+
+        iterator insert(const_iterator pos, std::initializer_list<T> il){
+            return insert(pos, il.begin(), il.end());
+        }
+
+        iterator erase(const_iterator pos){
+            T* p = const_cast<T*>(pos);
+            if (p + 1 != impl_.finish_)
+                simple_stl::move(p + 1, impl_.finish_, p);
+            pop_back();
+            return p;
+        }
+
+        iterator erase(const_iterator first, const_iterator last){
+            T* f = const_cast<T*>(first);
+            T* l = const_cast<T*>(last);
+            if (f != l)
+                __erase_at_end(simple_stl::move(l, impl_.finish_, f));
+            return f;
+        }
+
+        void clear() noexcept{
+            __erase_at_end(impl_.start_);
+        }
+
+        void swap(vector& other) noexcept{
+            __swap_alloc(other, typename alloc_traits::propagate_on_container_swap());
+            simple_stl::swap(impl_.start_, other.impl_.start_);
+            simple_stl::swap(impl_.finish_, other.impl_.finish_);
+            simple_stl::swap(impl_.end_of_storage_, other.impl_.end_of_storage_);
+        }
+
+        // 供 flat_map、flat_set 使用：把按 comp 有序的 [first, last) 移入本身有序的元素中。
+        // 容量不足时只重新配置一次，随后由后向前一趟合并，原有元素成段后移：
+        // 落在未初始化区域的部分用 uninitialized_move，其余用 __move_backward。
+        // 与新元素等价的原有元素排在前面；移动抛出异常时只保证容器有效
+        template<class Compare>
+        void __merge_sorted(T* first, T* last, Compare comp){
+            const size_type n = size_type(last - first);
+            if (n == 0)
+                return;
+            if (size_type(impl_.end_of_storage_ - impl_.finish_) < n)
+                __reallocate(__next_capacity(n));
+            T* const old_finish = impl_.finish_;
+            T* const new_finish = old_finish + n;
+            T* src = old_finish;        // 尚未就位的原有元素为 [start_, src)
+            T* dst = new_finish;        // [dst, new_finish) 已就位
+            T* built = new_finish;      // 未初始化区域中已构造的部分为 [built, new_finish)
+            try {
+                while (last != first){
+                    --last;
+                    T* run = src;
+                    while (run != impl_.start_ && comp(*last, *(run - 1)))
+                        --run;
+                    T* run_dst = dst - (src - run);
+                    if (dst > old_finish){
+                        T* raw_dst = run_dst > old_finish ? run_dst : old_finish;
+                        T* split = src - (dst - raw_dst);
+                        simple_stl::uninitialized_move(split, src, raw_dst);
+                        built = raw_dst;
+                        src = split;
+                        dst = raw_dst;
+                    }
+                    simple_stl::move_backward(run, src, dst);
+                    src = run;
+                    dst = run_dst - 1;
+                    if (dst >= old_finish){
+                        simple_stl::construct(dst, simple_stl::move(*last));
+                        built = dst;
+                    }else{
+                        *dst = simple_stl::move(*last);
+                    }
+                }
+            }catch(...){
+                simple_stl::destroy(built, new_finish);
+                throw;
+            }
+            impl_.finish_ = new_finish;
+        }
+
+    private:
+        void __range_check(size_type n) const{
+            if (n >= size())
+                throw std::out_of_range("vector::at");
+        }
+
+        void __init_n(size_type n){
+            if (n > max_size())
+                throw std::length_error("vector");
+            impl_.start_ = __allocate(n);
+            impl_.finish_ = impl_.start_;
+            impl_.end_of_storage_ = impl_.start_ + n;
+        }
+
+        void __steal(vector& other) noexcept{
+            impl_.start_ = other.impl_.start_;
+            impl_.finish_ = other.impl_.finish_;
+            impl_.end_of_storage_ = other.impl_.end_of_storage_;
+            other.impl_.start_ = other.impl_.finish_ = other.impl_.end_of_storage_ = nullptr;
+        }
+
+        // input_iterator_tag版，只能逐一插入
+        template<class InputIterator>
+        void __range_init(InputIterator first, InputIterator last, input_iterator_tag){
+            try {
+                for ( ; first != last; ++first)
+                    emplace_back(*first);
+            }catch(...){
+                clear();
+                __release_storage();
+                throw;
+            }
+        }
+
+        // forward_iterator_tag版，先用 distance() 求出长度，只配置一次
+        template<class ForwardIterator>
+        void __range_init(ForwardIterator first, ForwardIterator last, forward_iterator_tag){
+            const size_type n = static_cast<size_type>(simple_stl::distance(first, last));
+            __init_n(n);
+            try {
+                impl_.finish_ = simple_stl::uninitialized_copy(first, last, impl_.start_);
+            }catch(...){
+                __release_storage();
+                throw;
+            }
+        }
+
+        // 在尾部值初始化 n 个元素
+        void __default_append(size_type n){
+            if (n == 0)
+                return;
+            if (size_type(impl_.end_of_storage_ - impl_.finish_) < n)
+                __reallocate(__next_capacity(n));
+            __value_init_n(impl_.finish_, n, typename __type_traits_s<T>::have_trivial_default_constructor());
+            impl_.finish_ += n;
+        }
+
+        void __value_init_n(T* p, size_type n, __true_type_s){
+            simple_stl::uninitialized_fill_n(p, n, T());
+        }
+
+        void __value_init_n(T* p, size_type n, __false_type_s){
+            T* cur = p;
+            try {
+                for ( ; n > 0; --n, ++cur)
+                    simple_stl::construct(cur);
+            }catch(...){
+                simple_stl::destroy(p, cur);
+                throw;
+            }
+        }
+
+        size_type __next_capacity(size_type extra) const{
+            const size_type max = max_size();
+            if (max - size() < extra)
+                throw std::length_error("vector");
+            return GrowthPolicy::next_capacity(capacity(), size() + extra, max);
+        }
+
+        // 将现有元素搬到容量为 n 的新空间
+        void __reallocate(size_type n){
+            __reallocate_aux(n, bool_constant_s<is_trivially_relocatable<T>::value &&
+                                                __has_reallocate<Alloc>::value>());
+        }
+
+        // 配置器可原地扩展，元素按字节搬移即可
+        void __reallocate_aux(size_type n, __true_type_s){
+            const size_type old_size = size();
+            impl_.start_ = __alloc().reallocate(impl_.start_, capacity(), n);
+            impl_.finish_ = impl_.start_ + old_size;
+            impl_.end_of_storage_ = impl_.start_ + n;
+        }
+
+        void __reallocate_aux(size_type n, __false_type_s){
+            __transfer_all(n);
+        }
+
+        // 供 __vector_ops 调用：归还当前空间
+        void __free_storage() noexcept{
+            __deallocate(impl_.start_, capacity());
+        }
+
+        // 供 __vector_ops 调用：容量不足时在新空间中构造，成功后交换，失败时原有元素不受影响
+        template<class ForwardIterator>
+        void __assign_realloc(ForwardIterator first, ForwardIterator last, size_type){
+            vector tmp(__alloc());
+            tmp.__range_init(first, last, forward_iterator_tag());
+            swap(tmp);
+        }
+
+        void __copy_assign_alloc(const vector& other, __true_type_s){
+            if (__alloc() != other.__alloc()){
+                clear();
+                __release_storage();
+            }
+            __alloc() = other.__alloc();
+        }
+
+        void __copy_assign_alloc(const vector&, __false_type_s) {}
+
+        // 可以接管对方的内存
+        void __move_assign(vector& other, __true_type_s){
+            clear();
+            __deallocate(impl_.start_, capacity());
+            __move_assign_alloc(other, typename alloc_traits::propagate_on_container_move_assignment());
+            __steal(other);
+        }
+
+        // 配置器不传播，相等时接管内存，否则逐一移动元素
+        void __move_assign(vector& other, __false_type_s){
+            if (__alloc() == other.__alloc()){
+                __move_assign(other, __true_type_s());
+            }else{
+                assign(simple_stl::make_move_iterator(other.begin()), simple_stl::make_move_iterator(other.end()));
+                other.clear();
+            }
+        }
+
+        void __move_assign_alloc(vector& other, __true_type_s){
+            __alloc() = simple_stl::move(other.__alloc());
+        }
+
+        void __move_assign_alloc(vector&, __false_type_s) {}
+
+        void __swap_alloc(vector& other, __true_type_s){
+            simple_stl::swap(__alloc(), other.__alloc());
+        }
+
+        void __swap_alloc(vector&, __false_type_s) {}
+    };
+
+    template<class T, class Alloc, class G>
+    inline bool operator==(const vector<T, Alloc, G>& x, const vector<T, Alloc, G>& y){
+        if (x.size() != y.size())
+            return false;
+        for (size_t i = 0; i < x.size(); ++i)
+            if (!(x[i] == y[i]))
+                return false;
+        return true;
+    }
+
+    template<class T, class Alloc, class G>
+    inline bool operator!=(const vector<T, Alloc, G>& x, const vector<T, Alloc, G>& y){
+        return !(x == y);
+    }
+
+    template<class T, class Alloc, class G>
+    inline bool operator<(const vector<T, Alloc, G>& x, const vector<T, Alloc, G>& y){
+        const T* f1 = x.begin();
+        const T* f2 = y.begin();
+        for ( ; f1 != x.end() && f2 != y.end(); ++f1, ++f2) {
+            if (*f1 < *f2)
+                return true;
+            if (*f2 < *f1)
+                return false;
+        }
+        return f1 == x.end() && f2 != y.end();
+    }
+
+    template<class T, class Alloc, class G>
+    inline void swap(vector<T, Alloc, G>& x, vector<T, Alloc, G>& y) noexcept{
+        x.swap(y);
+    }
+
+}   // simple_stl
+
+#endif //SIMPLESTL_STL_VECTOR_H
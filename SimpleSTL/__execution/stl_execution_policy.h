@@ -0,0 +1,64 @@
+/**
+ * Created by 史进 on 2023/6/23.
+ *
+ * 执行策略：execution::seq、execution::par、execution::par_unseq
+ *  - seq 在调用线程上顺序执行
+ *  - par 把随机访问区间切块交给线程池并行执行，元素访问函数可在不同线程上并发调用
+ *  - par_unseq 另外允许同一线程内的向量化交错执行，当前按 par 处理
+ *  - par、par_unseq 默认使用 thread_pool::default_pool()，可用 on(pool) 指定线程池
+ */
+#ifndef SIMPLESTL_STL_EXECUTION_POLICY_H
+#define SIMPLESTL_STL_EXECUTION_POLICY_H
+
+#include <type_traits>
+
+#include "stl_thread_pool.h"
+#include "../type_traits.h"
+
+namespace simple_stl{
+
+    namespace execution{
+
+        struct sequenced_policy{};
+
+        struct parallel_policy{
+            thread_pool* pool_;
+
+            constexpr parallel_policy() : pool_(nullptr) {}
+            explicit constexpr parallel_policy(thread_pool& pool) : pool_(&pool) {}
+
+            parallel_policy on(thread_pool& pool) const { return parallel_policy(pool); }
+            thread_pool& pool() const { return pool_ ? *pool_ : thread_pool::default_pool(); }
+        };
+
+        struct parallel_unsequenced_policy{
+            thread_pool* pool_;
+
+            constexpr parallel_unsequenced_policy() : pool_(nullptr) {}
+            explicit constexpr parallel_unsequenced_policy(thread_pool& pool) : pool_(&pool) {}
+
+            parallel_unsequenced_policy on(thread_pool& pool) const { return parallel_unsequenced_policy(pool); }
+            thread_pool& pool() const { return pool_ ? *pool_ : thread_pool::default_pool(); }
+        };
+
+        constexpr sequenced_policy              seq{};
+        constexpr parallel_policy               par{};
+        constexpr parallel_unsequenced_policy   par_unseq{};
+
+    }   // execution
+
+    template<class T>
+    struct is_execution_policy : __false_type_s {};
+
+    template<> struct is_execution_policy<execution::sequenced_policy> : __true_type_s {};
+    template<> struct is_execution_policy<execution::parallel_policy> : __true_type_s {};
+    template<> struct is_execution_policy<execution::parallel_unsequenced_policy> : __true_type_s {};
+
+    // 并行算法重载的约束：第一个参数去掉引用与 cv 后是执行策略
+    template<class ExecutionPolicy, class R>
+    struct __enable_if_execution_policy
+            : std::enable_if<is_execution_policy<typename std::decay<ExecutionPolicy>::type>::value, R> {};
+
+}   // simple_stl
+
+#endif //SIMPLESTL_STL_EXECUTION_POLICY_H
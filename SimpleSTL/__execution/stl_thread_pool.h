@@ -0,0 +1,255 @@
+/**
+ * Created by 史进 on 2023/6/23.
+ *
+ * thread_pool：工作窃取线程池，供并行算法使用
+ *  - 每个工作线程有自己的任务双端队列，自己从尾部压入、弹出（后进先出，缓存较热），
+ *    空闲时随机挑选其他线程，从其队列头部窃取（先进先出，窃得的通常是较大的一块）
+ *  - 任务为一段块号区间 [lo, hi)，执行时不断对半切分，右半压回队列供他人窃取，自己处理左半，
+ *    调用者只需提交一个任务，切分随窃取按需展开
+ *  - 调用 parallel_for 的线程不闲等，一边等待一边执行或窃取任务，工作线程内嵌套并行不会死锁
+ *  - 没有任务时工作线程在条件变量上休眠
+ */
+#ifndef SIMPLESTL_STL_THREAD_POOL_H
+#define SIMPLESTL_STL_THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "../__container/stl_deque.h"
+#include "../__container/stl_vector.h"
+#include "../utility.h"
+
+namespace simple_stl{
+
+    class thread_pool{
+    private:
+        // 执行块号区间 [lo, hi) 中的块；job 记录尚未完成的块数与第一个异常
+        struct job{
+            void (*fn_)(void*, size_t);
+            void* ctx_;
+            std::atomic<size_t> remaining_;
+            std::atomic<bool> failed_;
+            std::exception_ptr error_;
+
+            job(void (*fn)(void*, size_t), void* ctx, size_t n)
+            : fn_(fn), ctx_(ctx), remaining_(n), failed_(false), error_() {}
+        };
+
+        struct task{
+            job* job_;
+            size_t lo_;
+            size_t hi_;
+        };
+
+        // 末尾填充一条缓存行，避免相邻队列的锁互相干扰
+        struct worker{
+            std::mutex mutex_;
+            deque<task> tasks_;
+            char padding_[__cache_line_size];
+        };
+
+        // 当前线程所属的线程池与其工作线程下标
+        struct thread_state{
+            thread_pool* pool_;
+            size_t index_;
+            size_t seed_;
+        };
+
+        size_t count_;
+        std::unique_ptr<worker[]> workers_;
+        vector<std::thread> threads_;
+        std::atomic<size_t> queued_;
+        std::atomic<bool> stop_;
+        std::mutex sleep_mutex_;
+        std::condition_variable sleep_cv_;
+
+    public:
+        // threads 为工作线程数；调用者也参与执行，总并发为 threads + 1
+        explicit thread_pool(size_t threads = default_threads())
+        : count_(threads), workers_(new worker[threads ? threads : 1]), threads_(),
+          queued_(0), stop_(false), sleep_mutex_(), sleep_cv_(){
+            threads_.reserve(threads);
+            try{
+                for (size_t i = 0; i < threads; ++i)
+                    threads_.push_back(std::thread(&thread_pool::__worker_loop, this, i));
+            }
+            catch (...){
+                __shutdown();
+                throw;
+            }
+        }
+
+        thread_pool(const thread_pool&) = delete;
+        thread_pool& operator=(const thread_pool&) = delete;
+
+        ~thread_pool() { __shutdown(); }
+
+        // 硬件线程数减去调用者自身
+        static size_t default_threads(){
+            const size_t hw = std::thread::hardware_concurrency();
+            return hw > 1 ? hw - 1 : 0;
+        }
+
+        // 并行算法默认使用的线程池，首次使用时创建
+        static thread_pool& default_pool(){
+            static thread_pool pool;
+            return pool;
+        }
+
+        size_t size() const noexcept { return count_; }
+        size_t concurrency() const noexcept { return count_ + 1; }
+
+        // 对块号 0 到 n - 1 调用 f(i)，全部完成后返回；某块抛出异常时在此重新抛出第一个异常
+        template<class Function>
+        void parallel_for(size_t n, Function& f){
+            if (n == 0)
+                return;
+            if (n == 1 || count_ == 0){
+                for (size_t i = 0; i < n; ++i)
+                    f(i);
+                return;
+            }
+            job j(&thread_pool::__invoke<Function>, static_cast<void*>(&f), n);
+            __run(task{&j, 0, n});
+            while (j.remaining_.load(std::memory_order_acquire) != 0)
+                if (!run_pending_task())
+                    std::this_thread::yield();
+            if (j.failed_.load(std::memory_order_relaxed))
+                std::rethrow_exception(j.error_);
+        }
+
+        // 执行一个排队中的任务，没有可执行的任务时返回 false
+        bool run_pending_task(){
+            task t;
+            if (!__acquire(t))
+                return false;
+            __run(t);
+            return true;
+        }
+
+    private:
+        template<class Function>
+        static void __invoke(void* ctx, size_t i){
+            (*static_cast<Function*>(ctx))(i);
+        }
+
+        static thread_state& __current(){
+            static thread_local thread_state state = {nullptr, 0, 0};
+            return state;
+        }
+
+        // xorshift 选取窃取对象
+        static size_t __random(thread_state& s){
+            // 非工作线程首次窃取时以线程局部变量的地址作种子
+            size_t x = s.seed_ ? s.seed_ : reinterpret_cast<size_t>(&s) | 1;
+            x ^= x << 13;
+            x ^= x >> 7;
+            x ^= x << 17;
+            s.seed_ = x;
+            return x;
+        }
+
+        // 当前线程是本池的工作线程时压入自己的队列，否则随机选一个
+        void __push(const task& t){
+            thread_state& s = __current();
+            const size_t i = s.pool_ == this ? s.index_ : __random(s) % count_;
+            {
+                std::lock_guard<std::mutex> lock(workers_[i].mutex_);
+                workers_[i].tasks_.push_back(t);
+            }
+            queued_.fetch_add(1, std::memory_order_release);
+            // 与休眠前的检查串行化，避免唤醒丢失
+            { std::lock_guard<std::mutex> lock(sleep_mutex_); }
+            sleep_cv_.notify_one();
+        }
+
+        bool __pop_back(size_t i, task& t){
+            std::lock_guard<std::mutex> lock(workers_[i].mutex_);
+            if (workers_[i].tasks_.empty())
+                return false;
+            t = workers_[i].tasks_.back();
+            workers_[i].tasks_.pop_back();
+            return true;
+        }
+
+        bool __steal(size_t i, task& t){
+            std::unique_lock<std::mutex> lock(workers_[i].mutex_, std::try_to_lock);
+            if (!lock.owns_lock() || workers_[i].tasks_.empty())
+                return false;
+            t = workers_[i].tasks_.front();
+            workers_[i].tasks_.pop_front();
+            return true;
+        }
+
+        // 先取自己队列的尾部，再从随机位置开始依次尝试窃取
+        bool __acquire(task& t){
+            if (count_ == 0 || queued_.load(std::memory_order_acquire) == 0)
+                return false;
+            thread_state& s = __current();
+            bool found = s.pool_ == this && __pop_back(s.index_, t);
+            if (!found){
+                const size_t start = __random(s) % count_;
+                for (size_t k = 0; k < count_ && !found; ++k)
+                    found = __steal((start + k) % count_, t);
+            }
+            if (found)
+                queued_.fetch_sub(1, std::memory_order_relaxed);
+            return found;
+        }
+
+        // 对半切分，右半压回队列，直到只剩一块
+        void __run(task t){
+            job* j = t.job_;
+            while (t.hi_ - t.lo_ > 1){
+                const size_t mid = t.lo_ + (t.hi_ - t.lo_) / 2;
+                __push(task{j, mid, t.hi_});
+                t.hi_ = mid;
+            }
+            try{
+                j->fn_(j->ctx_, t.lo_);
+            }
+            catch (...){
+                bool expected = false;
+                if (j->failed_.compare_exchange_strong(expected, true))
+                    j->error_ = std::current_exception();
+            }
+            j->remaining_.fetch_sub(1, std::memory_order_acq_rel);
+        }
+
+        void __worker_loop(size_t index){
+            thread_state& s = __current();
+            s.pool_ = this;
+            s.index_ = index;
+            s.seed_ = index * 0x9E3779B97F4A7C15ull + 1;
+            while (true){
+                if (run_pending_task())
+                    continue;
+                std::unique_lock<std::mutex> lock(sleep_mutex_);
+                sleep_cv_.wait(lock, [this]{
+                    return stop_.load(std::memory_order_relaxed) || queued_.load(std::memory_order_acquire) != 0;
+                });
+                if (stop_.load(std::memory_order_relaxed))
+                    return;
+            }
+        }
+
+        void __shutdown(){
+            {
+                std::lock_guard<std::mutex> lock(sleep_mutex_);
+                stop_.store(true, std::memory_order_relaxed);
+            }
+            sleep_cv_.notify_all();
+            for (size_t i = 0; i < threads_.size(); ++i)
+                if (threads_[i].joinable())
+                    threads_[i].join();
+        }
+    };
+
+}   // simple_stl
+
+#endif //SIMPLESTL_STL_THREAD_POOL_H
@@ -0,0 +1,163 @@
+/**
+ * Created by 史进 on 2023/6/16.
+ *
+ * 函数对象：算术类的 plus、minus、multiplies，比较类的 less、greater、equal_to 等，
+ * 绑定一个参数的 binder1st、binder2nd，
+ * 以及容器内部使用的 identity（取元素本身）与 select1st（取 pair 的 first）
+ */
+#ifndef SIMPLESTL_STL_FUNCTION_H
+#define SIMPLESTL_STL_FUNCTION_H
+
+namespace simple_stl{
+
+    template<class T>
+    struct plus{
+        typedef T       first_argument_type;
+        typedef T       second_argument_type;
+        typedef T       result_type;
+
+        T operator()(const T& x, const T& y) const { return x + y; }
+    };
+
+    template<class T>
+    struct minus{
+        typedef T       first_argument_type;
+        typedef T       second_argument_type;
+        typedef T       result_type;
+
+        T operator()(const T& x, const T& y) const { return x - y; }
+    };
+
+    template<class T>
+    struct multiplies{
+        typedef T       first_argument_type;
+        typedef T       second_argument_type;
+        typedef T       result_type;
+
+        T operator()(const T& x, const T& y) const { return x * y; }
+    };
+
+    template<class T>
+    struct less{
+        typedef T       first_argument_type;
+        typedef T       second_argument_type;
+        typedef bool    result_type;
+
+        bool operator()(const T& x, const T& y) const { return x < y; }
+    };
+
+    template<class T>
+    struct greater{
+        typedef T       first_argument_type;
+        typedef T       second_argument_type;
+        typedef bool    result_type;
+
+        bool operator()(const T& x, const T& y) const { return y < x; }
+    };
+
+    template<class T>
+    struct less_equal{
+        typedef T       first_argument_type;
+        typedef T       second_argument_type;
+        typedef bool    result_type;
+
+        bool operator()(const T& x, const T& y) const { return !(y < x); }
+    };
+
+    template<class T>
+    struct greater_equal{
+        typedef T       first_argument_type;
+        typedef T       second_argument_type;
+        typedef bool    result_type;
+
+        bool operator()(const T& x, const T& y) const { return !(x < y); }
+    };
+
+    template<class T>
+    struct equal_to{
+        typedef T       first_argument_type;
+        typedef T       second_argument_type;
+        typedef bool    result_type;
+
+        bool operator()(const T& x, const T& y) const { return x == y; }
+    };
+
+    template<class T>
+    struct not_equal_to{
+        typedef T       first_argument_type;
+        typedef T       second_argument_type;
+        typedef bool    result_type;
+
+        bool operator()(const T& x, const T& y) const { return !(x == y); }
+    };
+
+    // 把二元函数对象的第一个参数绑定为 value，得到一元函数对象
+    // find_if 等算法识别 bind2nd(equal_to<T>(), value) 一类谓词，按值查找
+    template<class Operation>
+    class binder1st{
+    protected:
+        Operation op_;
+        typename Operation::first_argument_type value_;
+
+    public:
+        typedef typename Operation::second_argument_type    argument_type;
+        typedef typename Operation::result_type             result_type;
+
+        binder1st(const Operation& op, const typename Operation::first_argument_type& value)
+        : op_(op), value_(value) {}
+
+        result_type operator()(const argument_type& x) const { return op_(value_, x); }
+
+        const typename Operation::first_argument_type& value() const { return value_; }
+    };
+
+    template<class Operation, class T>
+    inline binder1st<Operation> bind1st(const Operation& op, const T& value){
+        return binder1st<Operation>(op, typename Operation::first_argument_type(value));
+    }
+
+    // 把二元函数对象的第二个参数绑定为 value
+    template<class Operation>
+    class binder2nd{
+    protected:
+        Operation op_;
+        typename Operation::second_argument_type value_;
+
+    public:
+        typedef typename Operation::first_argument_type     argument_type;
+        typedef typename Operation::result_type             result_type;
+
+        binder2nd(const Operation& op, const typename Operation::second_argument_type& value)
+        : op_(op), value_(value) {}
+
+        result_type operator()(const argument_type& x) const { return op_(x, value_); }
+
+        const typename Operation::second_argument_type& value() const { return value_; }
+    };
+
+    template<class Operation, class T>
+    inline binder2nd<Operation> bind2nd(const Operation& op, const T& value){
+        return binder2nd<Operation>(op, typename Operation::second_argument_type(value));
+    }
+
+    // 返回元素本身，set 以元素为键
+    template<class T>
+    struct identity{
+        const T& operator()(const T& x) const { return x; }
+    };
+
+    // 返回 pair 的第一个元素，map 以 first 为键
+    template<class Pair>
+    struct select1st{
+        const typename Pair::first_type& operator()(const Pair& x) const { return x.first; }
+    };
+
+    // 取 pair 的 first，容器内部存放的 pair<Key, T> 与交出的 pair<const Key, T> 都适用
+    struct __select1st_any{
+        template<class Pair>
+        auto operator()(const Pair& p) const -> decltype((p.first)) { return p.first; }
+    };
+
+}   // simple_stl
+
+#endif //SIMPLESTL_STL_FUNCTION_H
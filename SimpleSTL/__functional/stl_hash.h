@@ -0,0 +1,229 @@
+/**
+ * Created by 史进 on 2023/6/17.
+ *
+ * 哈希函数对象 hash<T>：
+ *  - 整数、指针、浮点数（+0 与 -0 相同）的位模式经 __hash_int 混合：64 位乘法取 128 位积，高低两半异或，
+ *    每个输入位都影响结果的高低位，2 的幂大小的表取低位也不会集中
+ *  - 字节序列（字符串、string_view）用 __hash_bytes，wyhash 的算法：每 16 字节做一次 128 位乘法，
+ *    短于 16 字节的键用重叠读取凑出两个 64 位数，不逐字节循环
+ *  - pair 用 __hash_combine 合并两个成员的哈希值
+ * 上述 hash 都定义了 is_avalanching，哈希表据此省去 __hash_mix；用户提供的哈希函数仍经 __hash_mix 打散
+ */
+#ifndef SIMPLESTL_STL_HASH_H
+#define SIMPLESTL_STL_HASH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "../type_traits.h"
+#include "../utility.h"
+
+namespace simple_stl{
+
+    /** wyhash 的基本运算 */
+    static const uint64_t __wy_p0 = 0xa0761d6478bd642full;
+    static const uint64_t __wy_p1 = 0xe7037ed1a0b428dbull;
+    static const uint64_t __wy_p2 = 0x8ebc6af09c88c6e3ull;
+    static const uint64_t __wy_p3 = 0x589965cc75374cc3ull;
+
+    // a * b 的 128 位积，低半部分存入 a，高半部分存入 b
+    inline void __wy_mum(uint64_t& a, uint64_t& b) noexcept{
+#if defined(__SIZEOF_INT128__)
+        const unsigned __int128 r = static_cast<unsigned __int128>(a) * b;
+        a = static_cast<uint64_t>(r);
+        b = static_cast<uint64_t>(r >> 64);
+#else
+        // 拆成 32 位的四个部分积
+        const uint64_t ha = a >> 32, hb = b >> 32, la = static_cast<uint32_t>(a), lb = static_cast<uint32_t>(b);
+        const uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+        const uint64_t t = rl + (rm0 << 32);
+        uint64_t c = t < rl;
+        const uint64_t lo = t + (rm1 << 32);
+        c += lo < t;
+        a = lo;
+        b = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+#endif
+    }
+
+    // 128 位积的高低两半异或
+    inline uint64_t __wy_mix(uint64_t a, uint64_t b) noexcept{
+        simple_stl::__wy_mum(a, b);
+        return a ^ b;
+    }
+
+    // 按本机字节序读取，结果只在同一平台内保持一致
+    inline uint64_t __wy_r8(const unsigned char* p) noexcept{
+        uint64_t v;
+        std::memcpy(&v, p, 8);
+        return v;
+    }
+
+    inline uint64_t __wy_r4(const unsigned char* p) noexcept{
+        uint32_t v;
+        std::memcpy(&v, p, 4);
+        return v;
+    }
+
+    // 1 到 3 个字节：首、中、尾三个字节拼在一起
+    inline uint64_t __wy_r3(const unsigned char* p, size_t k) noexcept{
+        return (static_cast<uint64_t>(p[0]) << 16) | (static_cast<uint64_t>(p[k >> 1]) << 8) | p[k - 1];
+    }
+
+    // [p, p + len) 的 64 位哈希值
+    inline uint64_t __hash_bytes(const void* key, size_t len, uint64_t seed = 0) noexcept{
+        const unsigned char* p = static_cast<const unsigned char*>(key);
+        seed ^= simple_stl::__wy_mix(seed ^ __wy_p0, __wy_p1);
+        uint64_t a, b;
+        if (len <= 16){
+            if (len >= 4){
+                // 4 到 16 个字节：首尾各取两个可能重叠的 4 字节
+                const size_t off = (len >> 3) << 2;
+                a = (simple_stl::__wy_r4(p) << 32) | simple_stl::__wy_r4(p + off);
+                b = (simple_stl::__wy_r4(p + len - 4) << 32) | simple_stl::__wy_r4(p + len - 4 - off);
+            }else if (len > 0){
+                a = simple_stl::__wy_r3(p, len);
+                b = 0;
+            }else{
+                a = b = 0;
+            }
+        }else{
+            size_t i = len;
+            if (i > 48){
+                // 三条互不依赖的链，乘法可以并行
+                uint64_t see1 = seed, see2 = seed;
+                do {
+                    seed = simple_stl::__wy_mix(simple_stl::__wy_r8(p) ^ __wy_p1, simple_stl::__wy_r8(p + 8) ^ seed);
+                    see1 = simple_stl::__wy_mix(simple_stl::__wy_r8(p + 16) ^ __wy_p2, simple_stl::__wy_r8(p + 24) ^ see1);
+                    see2 = simple_stl::__wy_mix(simple_stl::__wy_r8(p + 32) ^ __wy_p3, simple_stl::__wy_r8(p + 40) ^ see2);
+                    p += 48;
+                    i -= 48;
+                } while (i > 48);
+                seed ^= see1 ^ see2;
+            }
+            while (i > 16){
+                seed = simple_stl::__wy_mix(simple_stl::__wy_r8(p) ^ __wy_p1, simple_stl::__wy_r8(p + 8) ^ seed);
+                p += 16;
+                i -= 16;
+            }
+            // 最后 16 个字节，可能与前面重叠
+            a = simple_stl::__wy_r8(p + i - 16);
+            b = simple_stl::__wy_r8(p + i - 8);
+        }
+        a ^= __wy_p1;
+        b ^= seed;
+        simple_stl::__wy_mum(a, b);
+        return simple_stl::__wy_mix(a ^ __wy_p0 ^ len, b ^ __wy_p1);
+    }
+
+    // 整数的混合：一次 128 位乘法
+    inline size_t __hash_int(uint64_t x) noexcept{
+        return static_cast<size_t>(simple_stl::__wy_mix(x, 0x9E3779B97F4A7C15ull));
+    }
+
+    // 合并两个哈希值，与顺序有关
+    inline size_t __hash_combine(size_t h1, size_t h2) noexcept{
+        return static_cast<size_t>(simple_stl::__wy_mix(static_cast<uint64_t>(h1) ^ __wy_p0,
+                                                        static_cast<uint64_t>(h2) ^ __wy_p1));
+    }
+
+    template<class Key>
+    struct hash{};
+
+#define SIMPLESTL_INTEGRAL_HASH(Type)                                       \
+    template<>                                                              \
+    struct hash<Type>{                                                      \
+        typedef Type    argument_type;                                      \
+        typedef size_t  result_type;                                        \
+        typedef void    is_avalanching;                                     \
+        size_t operator()(Type x) const noexcept { return simple_stl::__hash_int(static_cast<uint64_t>(x)); } \
+    };
+
+    SIMPLESTL_INTEGRAL_HASH(bool)
+    SIMPLESTL_INTEGRAL_HASH(char)
+    SIMPLESTL_INTEGRAL_HASH(signed char)
+    SIMPLESTL_INTEGRAL_HASH(unsigned char)
+    SIMPLESTL_INTEGRAL_HASH(wchar_t)
+    SIMPLESTL_INTEGRAL_HASH(char16_t)
+    SIMPLESTL_INTEGRAL_HASH(char32_t)
+    SIMPLESTL_INTEGRAL_HASH(short)
+    SIMPLESTL_INTEGRAL_HASH(unsigned short)
+    SIMPLESTL_INTEGRAL_HASH(int)
+    SIMPLESTL_INTEGRAL_HASH(unsigned int)
+    SIMPLESTL_INTEGRAL_HASH(long)
+    SIMPLESTL_INTEGRAL_HASH(unsigned long)
+    SIMPLESTL_INTEGRAL_HASH(long long)
+    SIMPLESTL_INTEGRAL_HASH(unsigned long long)
+
+#undef SIMPLESTL_INTEGRAL_HASH
+
+    template<class T>
+    struct hash<T*>{
+        typedef T*      argument_type;
+        typedef size_t  result_type;
+        typedef void    is_avalanching;
+        size_t operator()(T* p) const noexcept { return simple_stl::__hash_int(reinterpret_cast<uintptr_t>(p)); }
+    };
+
+    // 浮点数按位哈希，+0 与 -0 相等，因此都按 0 处理
+    template<class Float>
+    inline size_t __float_hash(Float x) noexcept{
+        if (x == Float(0))
+            return simple_stl::__hash_int(0);
+        uint64_t bits = 0;
+        std::memcpy(&bits, &x, sizeof(x) < sizeof(bits) ? sizeof(x) : sizeof(bits));
+        return simple_stl::__hash_int(bits);
+    }
+
+    template<>
+    struct hash<float>{
+        typedef float   argument_type;
+        typedef size_t  result_type;
+        typedef void    is_avalanching;
+        size_t operator()(float x) const noexcept { return __float_hash(x); }
+    };
+
+    template<>
+    struct hash<double>{
+        typedef double  argument_type;
+        typedef size_t  result_type;
+        typedef void    is_avalanching;
+        size_t operator()(double x) const noexcept { return __float_hash(x); }
+    };
+
+    template<class T1, class T2>
+    struct hash<pair<T1, T2> >{
+        typedef pair<T1, T2>    argument_type;
+        typedef size_t          result_type;
+        typedef void            is_avalanching;
+        size_t operator()(const pair<T1, T2>& p) const{
+            return simple_stl::__hash_combine(hash<T1>()(p.first), hash<T2>()(p.second));
+        }
+    };
+
+    // 将哈希值的高低位充分混合：乘以黄金分割常数后把高半部分折叠到低半部分。
+    // 开放寻址表以低位选起始位置、另取 7 位作为控制字节，未经混合的哈希值（如直接返回整数）会让两者都集中
+    inline size_t __hash_mix(size_t h) noexcept{
+#if SIZE_MAX > 0xFFFFFFFFu
+        unsigned long long x = static_cast<unsigned long long>(h) * 0x9E3779B97F4A7C15ull;
+        return static_cast<size_t>(x ^ (x >> 32));
+#else
+        unsigned int x = static_cast<unsigned int>(h) * 0x9E3779B9u;
+        return static_cast<size_t>(x ^ (x >> 16));
+#endif
+    }
+
+    // 哈希函数的结果是否已充分混合，即是否定义了 is_avalanching
+    template<class Hash, class = void>
+    struct __hash_is_avalanching : __false_type_s {};
+
+    template<class Hash>
+    struct __hash_is_avalanching<Hash, typename __make_void<typename Hash::is_avalanching>::type> : __true_type_s {};
+
+    // 哈希表使用的最终哈希值：已充分混合的原样使用，否则经 __hash_mix 打散
+    inline size_t __hash_finish(size_t h, __true_type_s) noexcept { return h; }
+    inline size_t __hash_finish(size_t h, __false_type_s) noexcept { return simple_stl::__hash_mix(h); }
+
+}   // simple_stl
+
+#endif //SIMPLESTL_STL_HASH_H
@@ -1,12 +1,741 @@
 /**
  * Created by 史进 on 2023/6/2.
  *
+ * 空间配置器alloc，采用两级配置：
+ *  第一级配置器 __malloc_alloc_template：直接使用malloc()、free()、realloc()，
+ *      内存不足时调用用户设置的 oom handler（仿真 set_new_handler）
+ *  第二级配置器 __default_alloc_template：需求不超过 __MAX_BYTES 时使用内存池，
+ *      维护 __NFREELISTS 个自由链表，按 __ALIGN 字节对齐，链表空时一次补充多个区块；
+ *      超过 __MAX_BYTES 时转交第一级配置器
+ *  带线程缓存的配置器 __thread_alloc_template：每个线程从自己的 span 中配置小型区块，
+ *      跨线程释放的区块成批归还给所属线程，为默认的 alloc
+ *
+ * 定义 __USE_MALLOC 时 alloc 即为第一级配置器，便于内存检查工具定位问题；
+ * 定义 __STL_NO_THREAD_CACHE 时 alloc 为加锁的第二级配置器
  */
 #ifndef SIMPLESTL_STL_ALLOC_H
 #define SIMPLESTL_STL_ALLOC_H
 
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include <new>
+#include <mutex>
+#include <atomic>
+
 namespace simple_stl{
 
+    /** 第一级配置器 */
+    template<int inst>
+    class __malloc_alloc_template{
+    public:
+        typedef void (*oom_handler_type)();
+
+    private:
+        // 以下函数用来处理内存不足的情况
+        static void* oom_malloc(size_t n);
+        static void* oom_realloc(void* p, size_t n);
+        static oom_handler_type __malloc_alloc_oom_handler;
+
+    public:
+        static void* allocate(size_t n){
+            void* result = malloc(n);
+            if (result == nullptr)
+                result = oom_malloc(n);
+            return result;
+        }
+
+        static void deallocate(void* p, size_t /* n */){
+            free(p);
+        }
+
+        static void* reallocate(void* p, size_t /* old_sz */, size_t new_sz){
+            void* result = realloc(p, new_sz);
+            if (result == nullptr)
+                result = oom_realloc(p, new_sz);
+            return result;
+        }
+
+        // 仿真 set_new_handler，返回旧的 handler
+        static oom_handler_type set_malloc_handler(oom_handler_type f){
+            oom_handler_type old = __malloc_alloc_oom_handler;
+            __malloc_alloc_oom_handler = f;
+            return old;
+        }
+    };
+
+    template<int inst>
+    typename __malloc_alloc_template<inst>::oom_handler_type
+    __malloc_alloc_template<inst>::__malloc_alloc_oom_handler = nullptr;
+
+    // 不断调用 handler 并重新尝试配置，直到成功；未设置 handler 时抛出 bad_alloc
+    template<int inst>
+    void* __malloc_alloc_template<inst>::oom_malloc(size_t n){
+        for (;;) {
+            oom_handler_type handler = __malloc_alloc_oom_handler;
+            if (handler == nullptr)
+                throw std::bad_alloc();
+            (*handler)();
+            void* result = malloc(n);
+            if (result != nullptr)
+                return result;
+        }
+    }
+
+    template<int inst>
+    void* __malloc_alloc_template<inst>::oom_realloc(void* p, size_t n){
+        for (;;) {
+            oom_handler_type handler = __malloc_alloc_oom_handler;
+            if (handler == nullptr)
+                throw std::bad_alloc();
+            (*handler)();
+            void* result = realloc(p, n);
+            if (result != nullptr)
+                return result;
+        }
+    }
+
+    typedef __malloc_alloc_template<0> malloc_alloc;
+
+
+    /** 第二级配置器 */
+    enum {__ALIGN = 8};                             // 小型区块的上调边界
+    enum {__MAX_BYTES = 128};                       // 小型区块的上限
+    enum {__NFREELISTS = __MAX_BYTES / __ALIGN};    // 自由链表个数
+    enum {__NOBJS = 20};                            // 每次补充的区块个数
+
+    // threads 为 true 时内存池由互斥量保护，inst 仅用于区分不同实例
+    template<bool threads, int inst>
+    class __default_alloc_template{
+    private:
+        // 将 bytes 上调至 __ALIGN 的倍数
+        static size_t ROUND_UP(size_t bytes){
+            return (bytes + __ALIGN - 1) & ~((size_t)__ALIGN - 1);
+        }
+
+        // 自由链表的节点，未分配时存放下一节点的指针，分配后即为用户数据
+        union obj{
+            union obj* free_list_link;
+            char client_data[1];
+        };
+
+        static obj* free_list[__NFREELISTS];
+
+        // 根据区块大小选择自由链表，从0起算
+        static size_t FREELIST_INDEX(size_t bytes){
+            return (bytes + __ALIGN - 1) / __ALIGN - 1;
+        }
+
+        // 返回一个大小为n的区块，并可能将其余区块加入自由链表
+        static void* refill(size_t n);
+        // 配置一大块空间，可容纳nobjs个大小为size的区块，空间不足时nobjs可能减少
+        static char* chunk_alloc(size_t size, int& nobjs);
+
+        static char*  start_free;   // 内存池起始位置
+        static char*  end_free;     // 内存池结束位置
+        static size_t heap_size;    // 已向系统申请的总量，用于决定下次申请的附加量
+
+        static std::mutex __alloc_mutex;
+
+        // threads 为 false 时不加锁
+        struct __lock{
+            __lock()  { if (threads) __alloc_mutex.lock(); }
+            ~__lock() { if (threads) __alloc_mutex.unlock(); }
+        };
+
+    public:
+        // n 必须大于0
+        static void* allocate(size_t n){
+            if (n > (size_t)__MAX_BYTES)
+                return malloc_alloc::allocate(n);
+
+            __lock guard;
+            obj** my_free_list = free_list + FREELIST_INDEX(n);
+            obj* result = *my_free_list;
+            if (result == nullptr)
+                return refill(ROUND_UP(n));
+            *my_free_list = result->free_list_link;
+            return result;
+        }
+
+        // p 不可为空，n 必须与配置时一致
+        static void deallocate(void* p, size_t n){
+            if (n > (size_t)__MAX_BYTES){
+                malloc_alloc::deallocate(p, n);
+                return;
+            }
+
+            __lock guard;
+            obj* q = static_cast<obj*>(p);
+            obj** my_free_list = free_list + FREELIST_INDEX(n);
+            q->free_list_link = *my_free_list;
+            *my_free_list = q;
+        }
+
+        static void* reallocate(void* p, size_t old_sz, size_t new_sz);
+    };
+
+    template<bool threads, int inst>
+    char* __default_alloc_template<threads, inst>::start_free = nullptr;
+
+    template<bool threads, int inst>
+    char* __default_alloc_template<threads, inst>::end_free = nullptr;
+
+    template<bool threads, int inst>
+    size_t __default_alloc_template<threads, inst>::heap_size = 0;
+
+    template<bool threads, int inst>
+    typename __default_alloc_template<threads, inst>::obj*
+    __default_alloc_template<threads, inst>::free_list[__NFREELISTS] = {};
+
+    template<bool threads, int inst>
+    std::mutex __default_alloc_template<threads, inst>::__alloc_mutex;
+
+    // 调用时已持有锁，n 已上调至 __ALIGN 的倍数
+    template<bool threads, int inst>
+    void* __default_alloc_template<threads, inst>::refill(size_t n){
+        int nobjs = __NOBJS;
+        char* chunk = chunk_alloc(n, nobjs);
+
+        // 只获得一个区块，直接交给调用者
+        if (nobjs == 1)
+            return chunk;
+
+        // 第一块返回给调用者，其余串接进自由链表
+        obj** my_free_list = free_list + FREELIST_INDEX(n);
+        obj* result = reinterpret_cast<obj*>(chunk);
+        obj* next_obj = reinterpret_cast<obj*>(chunk + n);
+        *my_free_list = next_obj;
+        for (int i = 1; ; ++i) {
+            obj* current_obj = next_obj;
+            next_obj = reinterpret_cast<obj*>(reinterpret_cast<char*>(next_obj) + n);
+            if (i == nobjs - 1){
+                current_obj->free_list_link = nullptr;
+                break;
+            }
+            current_obj->free_list_link = next_obj;
+        }
+        return result;
+    }
+
+    // 调用时已持有锁，size 已上调至 __ALIGN 的倍数
+    template<bool threads, int inst>
+    char* __default_alloc_template<threads, inst>::chunk_alloc(size_t size, int& nobjs){
+        size_t total_bytes = size * nobjs;
+        size_t bytes_left = end_free - start_free;
+
+        // 内存池剩余空间完全满足需求
+        if (bytes_left >= total_bytes){
+            char* result = start_free;
+            start_free += total_bytes;
+            return result;
+        }
+
+        // 内存池剩余空间至少能供应一个区块
+        if (bytes_left >= size){
+            nobjs = (int)(bytes_left / size);
+            total_bytes = size * nobjs;
+            char* result = start_free;
+            start_free += total_bytes;
+            return result;
+        }
+
+        // 内存池连一个区块都无法提供，先将残余零头编入适当的自由链表
+        if (bytes_left > 0){
+            obj** my_free_list = free_list + FREELIST_INDEX(bytes_left);
+            reinterpret_cast<obj*>(start_free)->free_list_link = *my_free_list;
+            *my_free_list = reinterpret_cast<obj*>(start_free);
+        }
+
+        // 向系统申请需求量的两倍，再加上随申请次数增长的附加量
+        size_t bytes_to_get = 2 * total_bytes + ROUND_UP(heap_size >> 4);
+        start_free = static_cast<char*>(malloc(bytes_to_get));
+        if (start_free == nullptr){
+            // malloc 失败，在更大的自由链表中寻找尚未使用的区块
+            for (size_t i = size; i <= (size_t)__MAX_BYTES; i += __ALIGN) {
+                obj** my_free_list = free_list + FREELIST_INDEX(i);
+                obj* p = *my_free_list;
+                if (p != nullptr){
+                    *my_free_list = p->free_list_link;
+                    start_free = reinterpret_cast<char*>(p);
+                    end_free = start_free + i;
+                    return chunk_alloc(size, nobjs);
+                }
+            }
+            // 山穷水尽，交给第一级配置器，由 oom handler 处理或抛出 bad_alloc
+            end_free = nullptr;
+            start_free = static_cast<char*>(malloc_alloc::allocate(bytes_to_get));
+        }
+        heap_size += bytes_to_get;
+        end_free = start_free + bytes_to_get;
+        return chunk_alloc(size, nobjs);
+    }
+
+    template<bool threads, int inst>
+    void* __default_alloc_template<threads, inst>::reallocate(void* p, size_t old_sz, size_t new_sz){
+        if (old_sz > (size_t)__MAX_BYTES && new_sz > (size_t)__MAX_BYTES)
+            return malloc_alloc::reallocate(p, old_sz, new_sz);
+        if (ROUND_UP(old_sz) == ROUND_UP(new_sz))
+            return p;
+
+        void* result = allocate(new_sz);
+        size_t copy_sz = new_sz > old_sz ? old_sz : new_sz;
+        memcpy(result, p, copy_sz);
+        deallocate(p, old_sz);
+        return result;
+    }
+
+    /** 带线程缓存的配置器
+     *
+     *  内存以 __SPAN_SIZE 大小、按自身大小对齐的 span 为单位分给各线程缓存，
+     *  一个 span 只切分同一种尺寸的区块，区块地址向下对齐即可找到所属 span 与 owner。
+     *  - 本线程释放：直接挂回 span 的自由链表，无任何同步
+     *  - 跨线程释放：先暂存在释放方的 remote_out 槽中，攒满 __REMOTE_BATCH 个后
+     *    一次 CAS 挂到 owner 的 remote_in 上，owner 在缺货时一次性取走
+     *  - 完全空闲的 span 留在线程缓存中备用，数量上限 empty_limit 随"刚归还又要申请"
+     *    的次数自适应增长，超出部分交回全局 span 池
+     *  线程退出时先收取跨线程归还的区块、发出暂存的批次，再把所有完全空闲的 span
+     *  （包括各尺寸保留的最后一个）交回全局 span 池；仍有区块在外的 span 随缓存挂入
+     *  弃置链表，由之后新建的线程接管。缓存本身永不释放，因此跨线程归还总能找到合法的 owner。
+     */
+    enum {__SPAN_SIZE = 32 * 1024};         // span 大小，同时也是其对齐边界
+    enum {__SPANS_PER_SEGMENT = 32};        // 每次向系统申请的 span 个数
+    enum {__REMOTE_SLOTS = 4};              // 跨线程归还的暂存槽个数
+    enum {__REMOTE_BATCH = 32};             // 每批跨线程归还的区块数
+    enum {__MAX_EMPTY_SPANS = 16};          // 线程缓存保留空闲 span 的上限
+
+    template<int inst>
+    class __thread_alloc_template{
+    private:
+        static size_t ROUND_UP(size_t bytes){
+            return (bytes + __ALIGN - 1) & ~((size_t)__ALIGN - 1);
+        }
+
+        static size_t FREELIST_INDEX(size_t bytes){
+            return (bytes + __ALIGN - 1) / __ALIGN - 1;
+        }
+
+        union obj{
+            union obj* free_list_link;
+            char client_data[1];
+        };
+
+        struct __thread_cache;
+
+        // span 头部，位于 span 起始处，其后即为区块
+        struct __span{
+            __thread_cache* owner;
+            size_t  block_size;
+            obj*    free;       // 已归还的区块
+            char*   bump;       // 尚未切分区域的起点
+            size_t  used;       // 已配置且尚未回到 owner 的区块数
+            __span* prev;
+            __span* next;
+            bool    linked;     // 是否在 owner 的 avail 链表中
+        };
+
+        // 发往同一 owner 的跨线程归还批次
+        struct __remote_batch{
+            __thread_cache* owner;
+            obj*    head;
+            obj*    tail;
+            size_t  count;
+        };
+
+        struct __thread_cache{
+            __span* avail[__NFREELISTS];            // 各尺寸尚有空闲区块的 span
+            __span* empty;                          // 完全空闲的 span
+            size_t  empty_count;
+            size_t  empty_limit;
+            bool    released;                       // 上次取 span 后是否向全局归还过
+            __remote_batch remote_out[__REMOTE_SLOTS];
+            std::atomic<obj*> remote_in;            // 其它线程归还给本缓存的区块
+            __thread_cache* next_abandoned;
+
+            __thread_cache() : avail(), empty(nullptr), empty_count(0), empty_limit(1),
+                               released(false), remote_out(), remote_in(nullptr),
+                               next_abandoned(nullptr) {}
+        };
+
+        static std::mutex       __global_mutex;     // 保护以下两个全局链表
+        static __span*          __free_spans;       // 全局 span 池
+        static __thread_cache*  __abandoned;        // 线程退出后留下的缓存
+
+        static __span* span_of(void* p){
+            return reinterpret_cast<__span*>(
+                    reinterpret_cast<uintptr_t>(p) & ~(uintptr_t)(__SPAN_SIZE - 1));
+        }
+
+        static bool span_full(__span* s){
+            return s->free == nullptr
+                   && s->bump + s->block_size > reinterpret_cast<char*>(s) + __SPAN_SIZE;
+        }
+
+        static void link(__thread_cache* c, __span* s){
+            __span*& head = c->avail[FREELIST_INDEX(s->block_size)];
+            s->prev = nullptr;
+            s->next = head;
+            if (head != nullptr)
+                head->prev = s;
+            head = s;
+            s->linked = true;
+        }
+
+        static void unlink(__thread_cache* c, __span* s){
+            if (s->prev != nullptr)
+                s->prev->next = s->next;
+            else
+                c->avail[FREELIST_INDEX(s->block_size)] = s->next;
+            if (s->next != nullptr)
+                s->next->prev = s->prev;
+            s->linked = false;
+        }
+
+        static __span* global_fetch();
+        static void global_release(__span* s);
+
+        // 由 owner 线程调用，归还一个属于本缓存的区块
+        static void local_free(__thread_cache* c, __span* s, obj* q);
+        // 空闲 span 留在缓存中，超出上限则交回全局
+        static void retire_empty(__thread_cache* c, __span* s);
+        // 取走其它线程归还的全部区块
+        static void drain_remote(__thread_cache* c);
+        static void push_remote(__thread_cache* owner, obj* head, obj* tail);
+        static void flush_remote(__remote_batch& batch);
+        static void remote_free(__thread_cache* c, __thread_cache* owner, obj* q);
+        // 本尺寸无可用 span 时调用，返回一个有空闲区块的 span
+        static __span* refill(__thread_cache* c, size_t n);
+
+        static __thread_cache* acquire_cache();
+        static void abandon_cache(__thread_cache* c);
+
+        static __thread_cache*& tl_cache(){
+            static thread_local __thread_cache* cache = nullptr;
+            return cache;
+        }
+
+        // 线程退出时将缓存挂入弃置链表
+        struct __cache_guard{
+            ~__cache_guard(){
+                __thread_cache*& c = tl_cache();
+                if (c != nullptr){
+                    abandon_cache(c);
+                    c = nullptr;
+                }
+            }
+        };
+
+        // 线程退出过程中（guard 已析构后）再次配置时会重新取得一个缓存，
+        // 该缓存不会再被弃置，只在这种罕见情况下滞留
+        static __thread_cache* local_cache(){
+            __thread_cache*& c = tl_cache();
+            if (c == nullptr){
+                c = acquire_cache();
+                static thread_local __cache_guard guard;
+                (void)guard;
+            }
+            return c;
+        }
+
+    public:
+        static void* allocate(size_t n){
+            if (n > (size_t)__MAX_BYTES)
+                return malloc_alloc::allocate(n);
+
+            __thread_cache* c = local_cache();
+            __span* s = c->avail[FREELIST_INDEX(n)];
+            if (s == nullptr)
+                s = refill(c, n);
+
+            obj* result = s->free;
+            if (result != nullptr){
+                s->free = result->free_list_link;
+            }else{
+                result = reinterpret_cast<obj*>(s->bump);
+                s->bump += s->block_size;
+            }
+            ++s->used;
+            if (span_full(s))
+                unlink(c, s);
+            return result;
+        }
+
+        static void deallocate(void* p, size_t n){
+            if (n > (size_t)__MAX_BYTES){
+                malloc_alloc::deallocate(p, n);
+                return;
+            }
+
+            obj* q = static_cast<obj*>(p);
+            __span* s = span_of(p);
+            __thread_cache* c = tl_cache();
+            if (c == s->owner)
+                local_free(c, s, q);
+            else if (c == nullptr)
+                push_remote(s->owner, q, q);
+            else
+                remote_free(c, s->owner, q);
+        }
+
+        static void* reallocate(void* p, size_t old_sz, size_t new_sz){
+            if (old_sz > (size_t)__MAX_BYTES && new_sz > (size_t)__MAX_BYTES)
+                return malloc_alloc::reallocate(p, old_sz, new_sz);
+            if (ROUND_UP(old_sz) == ROUND_UP(new_sz))
+                return p;
+
+            void* result = allocate(new_sz);
+            memcpy(result, p, new_sz > old_sz ? old_sz : new_sz);
+            deallocate(p, old_sz);
+            return result;
+        }
+    };
+
+    template<int inst>
+    std::mutex __thread_alloc_template<inst>::__global_mutex;
+
+    template<int inst>
+    typename __thread_alloc_template<inst>::__span*
+    __thread_alloc_template<inst>::__free_spans = nullptr;
+
+    template<int inst>
+    typename __thread_alloc_template<inst>::__thread_cache*
+    __thread_alloc_template<inst>::__abandoned = nullptr;
+
+    template<int inst>
+    typename __thread_alloc_template<inst>::__span*
+    __thread_alloc_template<inst>::global_fetch(){
+        std::lock_guard<std::mutex> guard(__global_mutex);
+        if (__free_spans == nullptr){
+            // 多申请一个 span 的空间，以便按 __SPAN_SIZE 对齐，所得内存不再归还系统
+            char* raw = static_cast<char*>(
+                    malloc_alloc::allocate((__SPANS_PER_SEGMENT + 1) * (size_t)__SPAN_SIZE));
+            char* first = reinterpret_cast<char*>(
+                    (reinterpret_cast<uintptr_t>(raw) + __SPAN_SIZE - 1) & ~(uintptr_t)(__SPAN_SIZE - 1));
+            for (int i = 0; i < __SPANS_PER_SEGMENT; ++i) {
+                __span* s = reinterpret_cast<__span*>(first + (size_t)i * __SPAN_SIZE);
+                s->next = __free_spans;
+                __free_spans = s;
+            }
+        }
+        __span* s = __free_spans;
+        __free_spans = s->next;
+        return s;
+    }
+
+    template<int inst>
+    void __thread_alloc_template<inst>::global_release(__span* s){
+        std::lock_guard<std::mutex> guard(__global_mutex);
+        s->next = __free_spans;
+        __free_spans = s;
+    }
+
+    template<int inst>
+    void __thread_alloc_template<inst>::local_free(__thread_cache* c, __span* s, obj* q){
+        q->free_list_link = s->free;
+        s->free = q;
+        --s->used;
+        if (!s->linked)
+            link(c, s);
+        // 保留每种尺寸最后一个可用 span，避免在边界上反复申请、归还
+        if (s->used == 0 && (s->prev != nullptr || s->next != nullptr)){
+            unlink(c, s);
+            retire_empty(c, s);
+        }
+    }
+
+    template<int inst>
+    void __thread_alloc_template<inst>::retire_empty(__thread_cache* c, __span* s){
+        s->next = c->empty;
+        c->empty = s;
+        if (++c->empty_count > c->empty_limit){
+            __span* victim = c->empty;
+            c->empty = victim->next;
+            --c->empty_count;
+            c->released = true;
+            global_release(victim);
+        }
+    }
+
+    template<int inst>
+    void __thread_alloc_template<inst>::drain_remote(__thread_cache* c){
+        obj* p = c->remote_in.exchange(nullptr, std::memory_order_acquire);
+        while (p != nullptr){
+            obj* next = p->free_list_link;
+            local_free(c, span_of(p), p);
+            p = next;
+        }
+    }
+
+    template<int inst>
+    void __thread_alloc_template<inst>::push_remote(__thread_cache* owner, obj* head, obj* tail){
+        obj* old = owner->remote_in.load(std::memory_order_relaxed);
+        do {
+            tail->free_list_link = old;
+        } while (!owner->remote_in.compare_exchange_weak(old, head,
+                        std::memory_order_release, std::memory_order_relaxed));
+    }
+
+    template<int inst>
+    void __thread_alloc_template<inst>::flush_remote(__remote_batch& batch){
+        if (batch.count != 0)
+            push_remote(batch.owner, batch.head, batch.tail);
+        batch.owner = nullptr;
+        batch.head = batch.tail = nullptr;
+        batch.count = 0;
+    }
+
+    template<int inst>
+    void __thread_alloc_template<inst>::remote_free(__thread_cache* c, __thread_cache* owner, obj* q){
+        __remote_batch* slot = nullptr;
+        for (int i = 0; i < __REMOTE_SLOTS; ++i) {
+            __remote_batch& b = c->remote_out[i];
+            if (b.owner == owner){
+                slot = &b;
+                break;
+            }
+            if (slot == nullptr && b.owner == nullptr)
+                slot = &b;
+        }
+        // 槽位已满，按 owner 地址挑一个批次先行发出
+        if (slot == nullptr){
+            slot = &c->remote_out[(reinterpret_cast<uintptr_t>(owner) / sizeof(__thread_cache)) % __REMOTE_SLOTS];
+            flush_remote(*slot);
+        }
+
+        slot->owner = owner;
+        q->free_list_link = slot->head;
+        slot->head = q;
+        if (slot->tail == nullptr)
+            slot->tail = q;
+        if (++slot->count >= (size_t)__REMOTE_BATCH)
+            flush_remote(*slot);
+    }
+
+    template<int inst>
+    typename __thread_alloc_template<inst>::__span*
+    __thread_alloc_template<inst>::refill(__thread_cache* c, size_t n){
+        // 进入慢路径时顺带收取和发出跨线程归还的区块
+        drain_remote(c);
+        for (int i = 0; i < __REMOTE_SLOTS; ++i)
+            flush_remote(c->remote_out[i]);
+
+        size_t block_size = ROUND_UP(n);
+        __span* s = c->avail[FREELIST_INDEX(n)];
+        if (s != nullptr)
+            return s;
+
+        if (c->empty != nullptr){
+            s = c->empty;
+            c->empty = s->next;
+            --c->empty_count;
+        }else{
+            // 刚向全局归还过又来申请，说明保留的空闲 span 太少
+            if (c->released && c->empty_limit < (size_t)__MAX_EMPTY_SPANS)
+                c->empty_limit *= 2;
+            c->released = false;
+            s = global_fetch();
+        }
+
+        s->owner = c;
+        s->block_size = block_size;
+        s->free = nullptr;
+        s->bump = reinterpret_cast<char*>(s) + ROUND_UP(sizeof(__span));
+        s->used = 0;
+        link(c, s);
+        return s;
+    }
+
+    template<int inst>
+    typename __thread_alloc_template<inst>::__thread_cache*
+    __thread_alloc_template<inst>::acquire_cache(){
+        {
+            std::lock_guard<std::mutex> guard(__global_mutex);
+            if (__abandoned != nullptr){
+                __thread_cache* c = __abandoned;
+                __abandoned = c->next_abandoned;
+                c->next_abandoned = nullptr;
+                return c;
+            }
+        }
+        void* p = malloc_alloc::allocate(sizeof(__thread_cache));
+        return ::new (p) __thread_cache();
+    }
+
+    template<int inst>
+    void __thread_alloc_template<inst>::abandon_cache(__thread_cache* c){
+        drain_remote(c);
+        for (int i = 0; i < __REMOTE_SLOTS; ++i)
+            flush_remote(c->remote_out[i]);
+        for (int i = 0; i < __NFREELISTS; ++i) {
+            __span* s = c->avail[i];
+            while (s != nullptr){
+                __span* next = s->next;
+                if (s->used == 0){
+                    unlink(c, s);
+                    global_release(s);
+                }
+                s = next;
+            }
+        }
+        while (c->empty != nullptr){
+            __span* s = c->empty;
+            c->empty = s->next;
+            global_release(s);
+        }
+        c->empty_count = 0;
+
+        std::lock_guard<std::mutex> guard(__global_mutex);
+        c->next_abandoned = __abandoned;
+        __abandoned = c;
+    }
+
+
+#ifdef __USE_MALLOC
+    typedef malloc_alloc alloc;
+    typedef malloc_alloc single_client_alloc;
+#elif defined(__STL_NO_THREAD_CACHE)
+    typedef __default_alloc_template<true, 0>   alloc;
+    typedef __default_alloc_template<false, 0>  single_client_alloc;
+#else
+    typedef __thread_alloc_template<0>          alloc;
+    typedef __default_alloc_template<false, 0>  single_client_alloc;
+#endif
+
+
+    // 以元素个数为单位的配置接口，隐藏字节换算
+    template<class T, class Alloc>
+    class simple_alloc{
+    public:
+        static T* allocate(size_t n){
+            return n == 0 ? nullptr : static_cast<T*>(Alloc::allocate(n * sizeof(T)));
+        }
+
+        static T* allocate(){
+            return static_cast<T*>(Alloc::allocate(sizeof(T)));
+        }
+
+        static void deallocate(T* p, size_t n){
+            if (n != 0 && p != nullptr)
+                Alloc::deallocate(p, n * sizeof(T));
+        }
+
+        static void deallocate(T* p){
+            if (p != nullptr)
+                Alloc::deallocate(p, sizeof(T));
+        }
+
+        // 按字节搬移原有内容，只适用于可平凡重定位的类型
+        static T* reallocate(T* p, size_t old_n, size_t new_n){
+            if (old_n == 0)
+                return allocate(new_n);
+            if (new_n == 0){
+                deallocate(p, old_n);
+                return nullptr;
+            }
+            return static_cast<T*>(Alloc::reallocate(p, old_n * sizeof(T), new_n * sizeof(T)));
+        }
+    };
 
 }   // simple_stl
 
@@ -3,20 +3,24 @@
  *
  * 包含一个模板类allocator，用于管理内存的分配、释放，对象的构造、析构
  *
- * ps：旧allocator，新allocator为alloc
+ * ps：旧allocator，新allocator为alloc；allocator 现已转交 alloc 配置内存
  */
 #ifndef SIMPLESTL_STL_ALLOCATOR_H
 #define SIMPLESTL_STL_ALLOCATOR_H
 
+#include <iostream>
+#include <cstdlib>
+
+#include "stl_alloc.h"
 #include "stl_construct.h"
-#include "s../utility.h"
+#include "../utility.h"
 
 namespace simple_stl{
     template<class T>
     inline T* allocate(ptrdiff_t size, T*){
         T* tmp = static_cast<T*>(::operator new((size_t)(size*sizeof(T))));
         if (tmp == 0){
-            cerr << "out of memory" << endl;
+            std::cerr << "out of memory" << std::endl;
             exit(1);
         }
         return tmp;
@@ -30,6 +34,13 @@ namespace simple_stl{
     }
 
 
+    // 对齐要求超过 __ALIGN 的类型无法由内存池保证对齐，交给第一级配置器
+    template<class T>
+    struct __allocator_backend{
+        typedef typename std::conditional<alignof(T) <= (size_t)__ALIGN,
+                alloc, malloc_alloc>::type type;
+    };
+
     // 模板类allocator
     template<class T>
     struct allocator{
@@ -41,16 +52,39 @@ namespace simple_stl{
         typedef size_t      size_type;
         typedef ptrdiff_t   difference_type;
 
+        typedef simple_alloc<T, typename __allocator_backend<T>::type> data_allocator;
+
+        // 无状态，任意两个 allocator 都可互相释放对方配置的内存
+        typedef __true_type_s   is_always_equal;
+
+        template<class U>
+        struct rebind{
+            typedef allocator<U> other;
+        };
+
+        allocator() noexcept = default;
+
+        template<class U>
+        allocator(const allocator<U>&) noexcept {}
+
         pointer allocate(){
-            return simple_stl::allocate((difference_type)1, (pointer)0);
+            return data_allocator::allocate();
         }
 
         pointer allocate(size_type n){
-            return simple_stl::allocate((difference_type)n, (pointer)0);
+            return data_allocator::allocate(n);
         }
 
-        void deallocate(pointer p){
-            simple_stl::deallocate(p);
+        // n 必须与 allocate(n) 时一致，allocate() 配置的单个对象以 n = 1 释放。
+        // 不提供单参数版本：内存池按大小归还，猜测 n 会把区块挂到错误的自由链表上
+        void deallocate(pointer p, size_type n){
+            data_allocator::deallocate(p, n);
+        }
+
+        // 将 old_n 个元素的空间扩展或收缩为 new_n 个，内容按字节搬移，
+        // 只适用于可平凡重定位的类型，大块内存可由 realloc 原地扩展
+        pointer reallocate(pointer p, size_type old_n, size_type new_n){
+            return data_allocator::reallocate(p, old_n, new_n);
         }
 
         void construct(pointer p){
@@ -85,8 +119,22 @@ namespace simple_stl{
         const_pointer address(const_reference x){
             return static_cast<const_pointer>(&x);
         }
+
+        size_type max_size() const noexcept{
+            return size_type(-1) / sizeof(T);
+        }
     };
 
+    template<class T1, class T2>
+    inline bool operator==(const allocator<T1>&, const allocator<T2>&) noexcept{
+        return true;
+    }
+
+    template<class T1, class T2>
+    inline bool operator!=(const allocator<T1>&, const allocator<T2>&) noexcept{
+        return false;
+    }
+
 
 
 
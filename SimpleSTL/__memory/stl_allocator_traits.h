@@ -0,0 +1,250 @@
+/**
+ * Created by 史进 on 2023/6/8.
+ *
+ * allocator_traits：为容器提供统一的配置器接口
+ * 配置器未提供的类型与函数由此给出默认版本，包括三个传播特性
+ *  propagate_on_container_copy_assignment
+ *  propagate_on_container_move_assignment
+ *  propagate_on_container_swap
+ * 以及 is_always_equal，容器据此决定赋值、交换时是否连同配置器一起处理
+ */
+#ifndef SIMPLESTL_STL_ALLOCATOR_TRAITS_H
+#define SIMPLESTL_STL_ALLOCATOR_TRAITS_H
+
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+#include "stl_construct.h"
+#include "../type_traits.h"
+#include "../utility.h"
+
+namespace simple_stl{
+
+    // pointer
+    template<class Alloc, class = void>
+    struct __alloc_pointer { typedef typename Alloc::value_type* type; };
+
+    template<class Alloc>
+    struct __alloc_pointer<Alloc, typename __make_void<typename Alloc::pointer>::type> {
+        typedef typename Alloc::pointer type;
+    };
+
+    // const_pointer
+    template<class Alloc, class = void>
+    struct __alloc_const_pointer { typedef const typename Alloc::value_type* type; };
+
+    template<class Alloc>
+    struct __alloc_const_pointer<Alloc, typename __make_void<typename Alloc::const_pointer>::type> {
+        typedef typename Alloc::const_pointer type;
+    };
+
+    // size_type
+    template<class Alloc, class = void>
+    struct __alloc_size_type { typedef size_t type; };
+
+    template<class Alloc>
+    struct __alloc_size_type<Alloc, typename __make_void<typename Alloc::size_type>::type> {
+        typedef typename Alloc::size_type type;
+    };
+
+    // difference_type
+    template<class Alloc, class = void>
+    struct __alloc_difference_type { typedef ptrdiff_t type; };
+
+    template<class Alloc>
+    struct __alloc_difference_type<Alloc, typename __make_void<typename Alloc::difference_type>::type> {
+        typedef typename Alloc::difference_type type;
+    };
+
+    // propagate_on_container_copy_assignment，默认不传播
+    template<class Alloc, class = void>
+    struct __alloc_pocca { typedef __false_type_s type; };
+
+    template<class Alloc>
+    struct __alloc_pocca<Alloc,
+            typename __make_void<typename Alloc::propagate_on_container_copy_assignment>::type> {
+        typedef typename Alloc::propagate_on_container_copy_assignment type;
+    };
+
+    // propagate_on_container_move_assignment，默认不传播
+    template<class Alloc, class = void>
+    struct __alloc_pocma { typedef __false_type_s type; };
+
+    template<class Alloc>
+    struct __alloc_pocma<Alloc,
+            typename __make_void<typename Alloc::propagate_on_container_move_assignment>::type> {
+        typedef typename Alloc::propagate_on_container_move_assignment type;
+    };
+
+    // propagate_on_container_swap，默认不传播
+    template<class Alloc, class = void>
+    struct __alloc_pocs { typedef __false_type_s type; };
+
+    template<class Alloc>
+    struct __alloc_pocs<Alloc,
+            typename __make_void<typename Alloc::propagate_on_container_swap>::type> {
+        typedef typename Alloc::propagate_on_container_swap type;
+    };
+
+    // is_always_equal，默认空类（无状态）的配置器总是相等
+    template<class Alloc, class = void>
+    struct __alloc_is_always_equal { typedef bool_constant_s<std::is_empty<Alloc>::value> type; };
+
+    template<class Alloc>
+    struct __alloc_is_always_equal<Alloc, typename __make_void<typename Alloc::is_always_equal>::type> {
+        typedef typename Alloc::is_always_equal type;
+    };
+
+    // rebind，未提供时将 Alloc<T, Args...> 替换为 Alloc<U, Args...>
+    template<class Alloc, class U>
+    struct __alloc_rebind_default {};
+
+    template<template<class, class...> class Alloc, class T, class... Args, class U>
+    struct __alloc_rebind_default<Alloc<T, Args...>, U> { typedef Alloc<U, Args...> type; };
+
+    template<class Alloc, class U, class = void>
+    struct __alloc_rebind { typedef typename __alloc_rebind_default<Alloc, U>::type type; };
+
+    template<class Alloc, class U>
+    struct __alloc_rebind<Alloc, U, typename __make_void<typename Alloc::template rebind<U>::other>::type> {
+        typedef typename Alloc::template rebind<U>::other type;
+    };
+
+    // 检测配置器是否提供 construct(p, args...)
+    template<class Alloc, class Tp, class... Args>
+    struct __has_construct{
+    private:
+        struct __two {char __lx; char __rx;};
+        template <class A> static __two __test(...);
+        template <class A> static char __test(decltype(std::declval<A&>().construct(
+                std::declval<Tp*>(), std::declval<Args>()...))*);
+    public:
+        static const bool value = sizeof(__test<Alloc>(nullptr)) == 1;
+    };
+
+    // 检测配置器是否提供 destroy(p)
+    template<class Alloc, class Tp>
+    struct __has_destroy{
+    private:
+        struct __two {char __lx; char __rx;};
+        template <class A> static __two __test(...);
+        template <class A> static char __test(decltype(std::declval<A&>().destroy(std::declval<Tp*>()))*);
+    public:
+        static const bool value = sizeof(__test<Alloc>(nullptr)) == 1;
+    };
+
+    // 检测配置器是否提供 max_size()
+    template<class Alloc>
+    struct __has_max_size{
+    private:
+        struct __two {char __lx; char __rx;};
+        template <class A> static __two __test(...);
+        template <class A> static char __test(decltype(std::declval<const A&>().max_size())*);
+    public:
+        static const bool value = sizeof(__test<Alloc>(nullptr)) == 1;
+    };
+
+    // 检测配置器是否提供 select_on_container_copy_construction()
+    template<class Alloc>
+    struct __has_select_on_copy{
+    private:
+        struct __two {char __lx; char __rx;};
+        template <class A> static __two __test(...);
+        template <class A> static char __test(decltype(
+                std::declval<const A&>().select_on_container_copy_construction())*);
+    public:
+        static const bool value = sizeof(__test<Alloc>(nullptr)) == 1;
+    };
+
+
+    template<class Alloc>
+    struct allocator_traits{
+        typedef Alloc                                                   allocator_type;
+        typedef typename Alloc::value_type                              value_type;
+        typedef typename __alloc_pointer<Alloc>::type                   pointer;
+        typedef typename __alloc_const_pointer<Alloc>::type             const_pointer;
+        typedef typename __alloc_size_type<Alloc>::type                 size_type;
+        typedef typename __alloc_difference_type<Alloc>::type           difference_type;
+
+        typedef typename __alloc_pocca<Alloc>::type     propagate_on_container_copy_assignment;
+        typedef typename __alloc_pocma<Alloc>::type     propagate_on_container_move_assignment;
+        typedef typename __alloc_pocs<Alloc>::type      propagate_on_container_swap;
+        typedef typename __alloc_is_always_equal<Alloc>::type is_always_equal;
+
+        template<class U>
+        using rebind_alloc = typename __alloc_rebind<Alloc, U>::type;
+
+        template<class U>
+        using rebind_traits = allocator_traits<rebind_alloc<U> >;
+
+        static pointer allocate(Alloc& a, size_type n){
+            return a.allocate(n);
+        }
+
+        static void deallocate(Alloc& a, pointer p, size_type n){
+            a.deallocate(p, n);
+        }
+
+        template<class Tp, class... Args>
+        static void construct(Alloc& a, Tp* p, Args&&... args){
+            __construct(bool_constant_s<__has_construct<Alloc, Tp, Args...>::value>(),
+                        a, p, simple_stl::forward<Args>(args)...);
+        }
+
+        template<class Tp>
+        static void destroy(Alloc& a, Tp* p){
+            __destroy(bool_constant_s<__has_destroy<Alloc, Tp>::value>(), a, p);
+        }
+
+        static size_type max_size(const Alloc& a) noexcept{
+            return __max_size(bool_constant_s<__has_max_size<Alloc>::value>(), a);
+        }
+
+        // 容器拷贝构造时为新容器选择配置器
+        static Alloc select_on_container_copy_construction(const Alloc& a){
+            return __select_on_copy(bool_constant_s<__has_select_on_copy<Alloc>::value>(), a);
+        }
+
+    private:
+        template<class Tp, class... Args>
+        static void __construct(__true_type_s, Alloc& a, Tp* p, Args&&... args){
+            a.construct(p, simple_stl::forward<Args>(args)...);
+        }
+
+        template<class Tp, class... Args>
+        static void __construct(__false_type_s, Alloc&, Tp* p, Args&&... args){
+            ::new ((void*)p) Tp(simple_stl::forward<Args>(args)...);
+        }
+
+        template<class Tp>
+        static void __destroy(__true_type_s, Alloc& a, Tp* p){
+            a.destroy(p);
+        }
+
+        template<class Tp>
+        static void __destroy(__false_type_s, Alloc&, Tp* p){
+            p->~Tp();
+        }
+
+        static size_type __max_size(__true_type_s, const Alloc& a){
+            return a.max_size();
+        }
+
+        static size_type __max_size(__false_type_s, const Alloc&){
+            return std::numeric_limits<size_type>::max() / sizeof(value_type);
+        }
+
+        static Alloc __select_on_copy(__true_type_s, const Alloc& a){
+            return a.select_on_container_copy_construction();
+        }
+
+        static Alloc __select_on_copy(__false_type_s, const Alloc& a){
+            return a;
+        }
+    };
+
+}   // simple_stl
+
+#endif //SIMPLESTL_STL_ALLOCATOR_TRAITS_H
@@ -34,34 +34,66 @@ namespace simple_stl{
 
     template<class Tp, class... Args>
     inline void construct(Tp* _p, Args&&... _args){
-        ::new ((void*)_p) Tp(forward<Args>(_args)...);
+        ::new ((void*)_p) Tp(simple_stl::forward<Args>(_args)...);
     }
 
+    template <class ForwardIterator>
+    inline void destroy(ForwardIterator first, ForwardIterator last);
+
     template<class ForwardIterator>
     inline void construct(ForwardIterator first, ForwardIterator last){
         using value_type = typename iterator_traits<ForwardIterator>::value_type;
         ForwardIterator idx = first;
         try {
             for( ; idx!=last; ++idx)
-                ::new ((void*)address_of(*__idx)) value_type();
+                ::new ((void*)address_of(*idx)) value_type();
         }catch(...) {
-            destroy(first, idx);
+            simple_stl::destroy(first, idx);
         }
     }
 
     // destroy 析构对象
-    // 版本1：接受一个指针
+    // 版本1：接受一个指针，析构函数平凡时什么也不做
     template <class Tp>
-    inline void destroy(Tp* _loc){
+    inline void __destroy_one(Tp* _loc, __false_type_s){
         if (_loc != nullptr){
             _loc->~Tp();
         }
     }
 
+    template <class Tp>
+    inline void __destroy_one(Tp*, __true_type_s){}
+
+    template <class Tp>
+    inline void destroy(Tp* _loc){
+        __destroy_one(_loc, typename __type_traits_s<Tp>::have_trivial_destructor());
+    }
+
     template <class ForwardIterator>
-    inline void __destroy_aux(ForwardIterator first, ForwardIterator last, __false_type_s){
+    inline void __destroy_range(ForwardIterator first, ForwardIterator last, __false_type_s){
         for ( ; first!=last ; ++first)
-            destroy(&*first);
+            simple_stl::destroy(&*first);
+    }
+
+    // 分段迭代器，逐段析构，段内为原生指针
+    template <class SegmentedIterator>
+    inline void __destroy_range(SegmentedIterator first, SegmentedIterator last, __true_type_s){
+        typedef segmented_iterator_traits<SegmentedIterator> traits;
+        typename traits::segment_iterator sf = traits::segment(first);
+        typename traits::segment_iterator sl = traits::segment(last);
+        if (sf == sl){
+            simple_stl::destroy(traits::local(first), traits::local(last));
+            return;
+        }
+        simple_stl::destroy(traits::local(first), traits::end(sf));
+        for (++sf; sf != sl; ++sf)
+            simple_stl::destroy(traits::begin(sf), traits::end(sf));
+        simple_stl::destroy(traits::begin(sl), traits::local(last));
+    }
+
+    template <class ForwardIterator>
+    inline void __destroy_aux(ForwardIterator first, ForwardIterator last, __false_type_s){
+        __destroy_range(first, last, is_segmented_iterator<ForwardIterator>());
     }
 
     template <class ForwardIterator>
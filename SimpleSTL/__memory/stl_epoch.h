@@ -0,0 +1,150 @@
+/**
+ * Created by 史进 on 2023/6/24.
+ *
+ * 基于纪元（epoch）的内存回收，供无锁读取的并发容器使用
+ *  - 全局纪元 global_ 只增不减；每个线程有一条记录，读取共享结构前以 __epoch_guard 登记当时的纪元，
+ *    离开时清零。登记可以嵌套，只有最外层生效
+ *  - 写者摘除节点后以 __epoch_domain::retire_epoch() 取得当时的纪元 e 并记下，不立即释放；
+ *    所有登记中的线程都已处于当前纪元时全局纪元才能前进，因此纪元达到 e + 2 时，
+ *    摘除前可能看到该节点的线程都已离开，可以释放
+ *  - 线程记录挂在全局链表上，线程退出时交还，由之后的线程复用，记录本身永不释放
+ */
+#ifndef SIMPLESTL_STL_EPOCH_H
+#define SIMPLESTL_STL_EPOCH_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "../utility.h"
+
+namespace simple_stl{
+
+    class __epoch_domain{
+    public:
+        // 每条记录独占一条缓存行，登记、清零只写自己的缓存行
+        struct record{
+            std::atomic<uint64_t> local_;       // 登记的纪元，0 表示不在读取中
+            std::atomic<bool> in_use_;
+            record* next_;
+            char padding_[__cache_line_size];
+
+            record() : local_(0), in_use_(true), next_(nullptr) {}
+        };
+
+    private:
+        std::atomic<uint64_t> global_;
+        char padding_[__cache_line_size];
+        std::atomic<record*> records_;
+
+        __epoch_domain() : global_(1), records_(nullptr) {}
+
+    public:
+        // 有意不析构：线程局部的记录可能在静态对象析构之后才交还
+        static __epoch_domain& instance(){
+            static __epoch_domain* domain = new __epoch_domain();
+            return *domain;
+        }
+
+        // 复用已交还的记录，没有时新建并挂到链表头部
+        record* acquire_record(){
+            for (record* r = records_.load(std::memory_order_acquire); r != nullptr; r = r->next_){
+                bool expected = false;
+                if (!r->in_use_.load(std::memory_order_relaxed) &&
+                    r->in_use_.compare_exchange_strong(expected, true, std::memory_order_acquire))
+                    return r;
+            }
+            record* r = new record();
+            record* head = records_.load(std::memory_order_relaxed);
+            do {
+                r->next_ = head;
+            } while (!records_.compare_exchange_weak(head, r, std::memory_order_release, std::memory_order_relaxed));
+            return r;
+        }
+
+        void release_record(record* r) noexcept{
+            r->local_.store(0, std::memory_order_release);
+            r->in_use_.store(false, std::memory_order_release);
+        }
+
+        void enter(record* r) noexcept{
+            // 登记先于之后对共享结构的读取。x86 上 seq_cst 的 exchange 即为全屏障，比 mfence 便宜
+#if defined(__x86_64__) || defined(__i386__)
+            r->local_.exchange(global_.load(std::memory_order_relaxed), std::memory_order_seq_cst);
+#else
+            r->local_.store(global_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+#endif
+        }
+
+        void leave(record* r) noexcept{
+            r->local_.store(0, std::memory_order_release);
+        }
+
+        // 摘除之后调用，返回的纪元加 2 即为可以释放的纪元
+        uint64_t retire_epoch() noexcept{
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            return global_.load(std::memory_order_relaxed);
+        }
+
+        uint64_t epoch() const noexcept { return global_.load(std::memory_order_acquire); }
+
+        // 所有登记中的线程都处于当前纪元时前进一步，返回前进后（或未能前进时）的纪元
+        uint64_t try_advance() noexcept{
+            uint64_t e = global_.load(std::memory_order_seq_cst);
+            for (record* r = records_.load(std::memory_order_acquire); r != nullptr; r = r->next_){
+                const uint64_t local = r->local_.load(std::memory_order_seq_cst);
+                if (local != 0 && local != e)
+                    return e;
+            }
+            if (global_.compare_exchange_strong(e, e + 1, std::memory_order_seq_cst))
+                return e + 1;
+            return e;
+        }
+    };
+
+    // 当前线程的记录与登记的嵌套深度，线程退出时交还记录
+    struct __epoch_thread{
+        __epoch_domain::record* record_;
+        unsigned depth_;
+
+        __epoch_thread() : record_(nullptr), depth_(0) {}
+
+        ~__epoch_thread(){
+            if (record_ != nullptr)
+                __epoch_domain::instance().release_record(record_);
+        }
+
+        static __epoch_thread& current(){
+            static thread_local __epoch_thread state;
+            return state;
+        }
+    };
+
+    // 作用域内读取到的节点不会被释放
+    class __epoch_guard{
+    private:
+        __epoch_thread& state_;
+
+    public:
+        __epoch_guard() : state_(__epoch_thread::current()){
+            if (state_.depth_++ == 0){
+                __epoch_domain& domain = __epoch_domain::instance();
+                if (state_.record_ == nullptr)
+                    state_.record_ = domain.acquire_record();
+                domain.enter(state_.record_);
+            }
+        }
+
+        __epoch_guard(const __epoch_guard&) = delete;
+        __epoch_guard& operator=(const __epoch_guard&) = delete;
+
+        ~__epoch_guard(){
+            if (--state_.depth_ == 0)
+                __epoch_domain::instance().leave(state_.record_);
+        }
+    };
+
+}   // simple_stl
+
+#endif //SIMPLESTL_STL_EPOCH_H
@@ -0,0 +1,593 @@
+/**
+ * Created by 史进 on 2023/6/8.
+ *
+ * memory_resource 内存资源层，以及指向内存资源的有状态配置器 polymorphic_allocator
+ *  alloc_resource()：以 alloc 为后端，默认的内存资源
+ *  null_memory_resource()：任何配置请求都抛出 bad_alloc
+ *  monotonic_buffer_resource：单调增长的 bump 区域，释放为空操作，release() 一次归还全部内存
+ *  unsynchronized_pool_resource：按 2 的幂划分尺寸的内存池，不加锁
+ *  synchronized_pool_resource：加锁的内存池，可供多线程共用
+ */
+#ifndef SIMPLESTL_STL_MEMORY_RESOURCE_H
+#define SIMPLESTL_STL_MEMORY_RESOURCE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <mutex>
+#include <atomic>
+
+#include "stl_alloc.h"
+#include "stl_construct.h"
+#include "../utility.h"
+
+namespace simple_stl{
+
+    enum {__MAX_ALIGN = alignof(std::max_align_t)};
+
+    // 将 n 上调至 align 的倍数，align 须为 2 的幂
+    inline size_t __align_up(size_t n, size_t align){
+        return (n + align - 1) & ~(align - 1);
+    }
+
+    class memory_resource{
+    public:
+        virtual ~memory_resource() = default;
+
+        void* allocate(size_t bytes, size_t alignment = __MAX_ALIGN){
+            return do_allocate(bytes, alignment);
+        }
+
+        void deallocate(void* p, size_t bytes, size_t alignment = __MAX_ALIGN){
+            do_deallocate(p, bytes, alignment);
+        }
+
+        bool is_equal(const memory_resource& other) const noexcept{
+            return do_is_equal(other);
+        }
+
+    private:
+        virtual void* do_allocate(size_t bytes, size_t alignment) = 0;
+        virtual void do_deallocate(void* p, size_t bytes, size_t alignment) = 0;
+        virtual bool do_is_equal(const memory_resource& other) const noexcept = 0;
+    };
+
+    inline bool operator==(const memory_resource& a, const memory_resource& b) noexcept{
+        return &a == &b || a.is_equal(b);
+    }
+
+    inline bool operator!=(const memory_resource& a, const memory_resource& b) noexcept{
+        return !(a == b);
+    }
+
+
+    /** 以 alloc 为后端的内存资源 */
+    class __alloc_resource : public memory_resource{
+    private:
+        // 超出 malloc 对齐保证时多配置 alignment 字节，原始地址存放在返回地址之前
+        static void* __aligned_allocate(size_t bytes, size_t alignment){
+            char* raw = static_cast<char*>(malloc_alloc::allocate(bytes + alignment + sizeof(void*)));
+            char* aligned = reinterpret_cast<char*>(
+                    __align_up(reinterpret_cast<uintptr_t>(raw) + sizeof(void*), alignment));
+            reinterpret_cast<void**>(aligned)[-1] = raw;
+            return aligned;
+        }
+
+        void* do_allocate(size_t bytes, size_t alignment) override{
+            if (bytes == 0)
+                bytes = 1;
+            if (alignment <= (size_t)__ALIGN)
+                return alloc::allocate(bytes);
+            if (alignment <= (size_t)__MAX_ALIGN)
+                return malloc_alloc::allocate(bytes);
+            return __aligned_allocate(bytes, alignment);
+        }
+
+        void do_deallocate(void* p, size_t bytes, size_t alignment) override{
+            if (bytes == 0)
+                bytes = 1;
+            if (alignment <= (size_t)__ALIGN)
+                alloc::deallocate(p, bytes);
+            else if (alignment <= (size_t)__MAX_ALIGN)
+                malloc_alloc::deallocate(p, bytes);
+            else
+                malloc_alloc::deallocate(static_cast<void**>(p)[-1], bytes);
+        }
+
+        bool do_is_equal(const memory_resource& other) const noexcept override{
+            return dynamic_cast<const __alloc_resource*>(&other) != nullptr;
+        }
+    };
+
+    class __null_resource : public memory_resource{
+    private:
+        void* do_allocate(size_t, size_t) override{
+            throw std::bad_alloc();
+        }
+
+        void do_deallocate(void*, size_t, size_t) override {}
+
+        bool do_is_equal(const memory_resource& other) const noexcept override{
+            return &other == this;
+        }
+    };
+
+    inline memory_resource* alloc_resource() noexcept{
+        static __alloc_resource resource;
+        return &resource;
+    }
+
+    inline memory_resource* null_memory_resource() noexcept{
+        static __null_resource resource;
+        return &resource;
+    }
+
+    inline std::atomic<memory_resource*>& __default_resource() noexcept{
+        static std::atomic<memory_resource*> resource(alloc_resource());
+        return resource;
+    }
+
+    inline memory_resource* get_default_resource() noexcept{
+        return __default_resource().load(std::memory_order_acquire);
+    }
+
+    // 传入空指针时恢复为 alloc_resource()，返回旧的默认资源
+    inline memory_resource* set_default_resource(memory_resource* r) noexcept{
+        if (r == nullptr)
+            r = alloc_resource();
+        return __default_resource().exchange(r, std::memory_order_acq_rel);
+    }
+
+
+    /** monotonic_buffer_resource */
+    class monotonic_buffer_resource : public memory_resource{
+    private:
+        // 每块内存的头部，串成链表以便 release() 归还
+        struct __chunk{
+            __chunk* next;
+            size_t   size;
+            size_t   alignment;
+        };
+
+        enum {__INITIAL_SIZE = 1024};
+        enum {__GROWTH_FACTOR = 2};
+
+        memory_resource* upstream_;
+        void*   initial_buffer_;
+        size_t  initial_size_;
+        char*   current_;           // 当前块中未使用区域的起点
+        size_t  space_;             // 当前块剩余的字节数
+        size_t  first_size_;        // 首次向上游申请的大小，release() 后恢复
+        size_t  next_size_;         // 下次向上游申请的大小
+        __chunk* chunks_;
+
+    public:
+        explicit monotonic_buffer_resource(memory_resource* upstream = get_default_resource())
+        : monotonic_buffer_resource(nullptr, 0, __INITIAL_SIZE, upstream) {}
+
+        explicit monotonic_buffer_resource(size_t initial_size,
+                                           memory_resource* upstream = get_default_resource())
+        : monotonic_buffer_resource(nullptr, 0, initial_size, upstream) {}
+
+        // 先使用调用者提供的缓冲区，用尽后再向上游申请
+        monotonic_buffer_resource(void* buffer, size_t buffer_size,
+                                  memory_resource* upstream = get_default_resource())
+        : monotonic_buffer_resource(buffer, buffer_size, buffer_size * __GROWTH_FACTOR, upstream) {}
+
+        monotonic_buffer_resource(const monotonic_buffer_resource&) = delete;
+        monotonic_buffer_resource& operator=(const monotonic_buffer_resource&) = delete;
+
+        ~monotonic_buffer_resource() override{
+            release();
+        }
+
+        // 一次归还所有向上游申请的内存，之后可继续使用
+        void release(){
+            while (chunks_ != nullptr){
+                __chunk* next = chunks_->next;
+                upstream_->deallocate(chunks_, chunks_->size, chunks_->alignment);
+                chunks_ = next;
+            }
+            current_ = static_cast<char*>(initial_buffer_);
+            space_ = initial_size_;
+            next_size_ = first_size_;
+        }
+
+        memory_resource* upstream_resource() const noexcept{
+            return upstream_;
+        }
+
+    private:
+        monotonic_buffer_resource(void* buffer, size_t buffer_size, size_t next_size,
+                                  memory_resource* upstream)
+        : upstream_(upstream), initial_buffer_(buffer), initial_size_(buffer_size),
+          current_(static_cast<char*>(buffer)), space_(buffer_size),
+          first_size_(next_size ? next_size : (size_t)__INITIAL_SIZE),
+          next_size_(first_size_), chunks_(nullptr) {}
+
+        // 在当前块中切出 bytes 字节，空间不足时返回空指针
+        void* __carve(size_t bytes, size_t alignment){
+            if (current_ == nullptr)
+                return nullptr;
+            size_t pad = __align_up(reinterpret_cast<uintptr_t>(current_), alignment)
+                         - reinterpret_cast<uintptr_t>(current_);
+            if (pad + bytes > space_)
+                return nullptr;
+            char* result = current_ + pad;
+            current_ = result + bytes;
+            space_ -= pad + bytes;
+            return result;
+        }
+
+        void* do_allocate(size_t bytes, size_t alignment) override{
+            void* result = __carve(bytes, alignment);
+            if (result != nullptr)
+                return result;
+
+            // 新块至少容纳头部、对齐填充与本次需求，并按增长因子扩大下一块
+            size_t chunk_align = alignment > alignof(__chunk) ? alignment : alignof(__chunk);
+            size_t header = __align_up(sizeof(__chunk), chunk_align);
+            size_t size = next_size_;
+            if (size < header + bytes)
+                size = header + bytes;
+            __chunk* c = static_cast<__chunk*>(upstream_->allocate(size, chunk_align));
+            c->next = chunks_;
+            c->size = size;
+            c->alignment = chunk_align;
+            chunks_ = c;
+            next_size_ = size * __GROWTH_FACTOR;
+
+            current_ = reinterpret_cast<char*>(c) + header;
+            space_ = size - header;
+            return __carve(bytes, alignment);
+        }
+
+        // 单调资源不回收单个对象
+        void do_deallocate(void*, size_t, size_t) override {}
+
+        bool do_is_equal(const memory_resource& other) const noexcept override{
+            return &other == this;
+        }
+    };
+
+
+    /** 内存池资源 */
+    struct pool_options{
+        size_t max_blocks_per_chunk = 0;            // 每次补充的区块数上限，0 表示使用默认值
+        size_t largest_required_pool_block = 0;     // 由池管理的最大区块，0 表示使用默认值
+    };
+
+    class unsynchronized_pool_resource : public memory_resource{
+    private:
+        enum {__MIN_BLOCK = 8};
+        enum {__DEFAULT_LARGEST_BLOCK = 4096};
+        enum {__DEFAULT_MAX_BLOCKS = 1024};
+        enum {__FIRST_BLOCKS = 16};
+
+        union obj{
+            union obj* free_list_link;
+            char client_data[1];
+        };
+
+        // 块的尾部，串成链表以便 release() 归还
+        struct __chunk{
+            __chunk* next;
+            size_t   size;
+        };
+
+        // 超出池范围、直接向上游申请的大区块的头部，位于返回地址之前
+        struct __large{
+            __large* prev;
+            __large* next;
+            size_t   size;
+            size_t   alignment;
+        };
+
+        // 管理同一尺寸区块的池
+        struct __pool{
+            size_t   block_size;
+            obj*     free;
+            char*    bump;          // 尚未切分区域
+            char*    bump_end;
+            __chunk* chunks;
+            size_t   next_blocks;   // 下次补充的区块数，按倍数增长
+        };
+
+        memory_resource* upstream_;
+        pool_options options_;
+        __pool*  pools_;
+        size_t   pool_count_;
+        __large* large_;
+
+    public:
+        unsynchronized_pool_resource() : unsynchronized_pool_resource(pool_options(), get_default_resource()) {}
+
+        explicit unsynchronized_pool_resource(memory_resource* upstream)
+        : unsynchronized_pool_resource(pool_options(), upstream) {}
+
+        explicit unsynchronized_pool_resource(const pool_options& opts,
+                                              memory_resource* upstream = get_default_resource())
+        : upstream_(upstream), options_(opts), pools_(nullptr), pool_count_(0), large_(nullptr){
+            if (options_.largest_required_pool_block == 0)
+                options_.largest_required_pool_block = __DEFAULT_LARGEST_BLOCK;
+            if (options_.max_blocks_per_chunk == 0)
+                options_.max_blocks_per_chunk = __DEFAULT_MAX_BLOCKS;
+            size_t block = __MIN_BLOCK;
+            while (block < options_.largest_required_pool_block){
+                block <<= 1;
+                ++pool_count_;
+            }
+            ++pool_count_;
+            options_.largest_required_pool_block = block;
+        }
+
+        unsynchronized_pool_resource(const unsynchronized_pool_resource&) = delete;
+        unsynchronized_pool_resource& operator=(const unsynchronized_pool_resource&) = delete;
+
+        ~unsynchronized_pool_resource() override{
+            release();
+        }
+
+        // 归还所有内存，包括尚未释放的区块
+        void release(){
+            if (pools_ != nullptr){
+                for (size_t i = 0; i < pool_count_; ++i) {
+                    __chunk* c = pools_[i].chunks;
+                    while (c != nullptr){
+                        __chunk* next = c->next;
+                        size_t size = c->size;
+                        char* base = reinterpret_cast<char*>(c) + sizeof(__chunk) - size;
+                        upstream_->deallocate(base, size, __MAX_ALIGN);
+                        c = next;
+                    }
+                }
+                upstream_->deallocate(pools_, pool_count_ * sizeof(__pool), alignof(__pool));
+                pools_ = nullptr;
+            }
+            while (large_ != nullptr){
+                __large* next = large_->next;
+                upstream_->deallocate(large_, large_->size, large_->alignment);
+                large_ = next;
+            }
+        }
+
+        memory_resource* upstream_resource() const noexcept{
+            return upstream_;
+        }
+
+        pool_options options() const noexcept{
+            return options_;
+        }
+
+    private:
+        // 区块尺寸为不小于 max(bytes, alignment) 的 2 的幂
+        size_t __pool_index(size_t bytes, size_t alignment) const{
+            size_t need = bytes > alignment ? bytes : alignment;
+            size_t block = __MIN_BLOCK;
+            size_t index = 0;
+            while (block < need){
+                block <<= 1;
+                ++index;
+            }
+            return index;
+        }
+
+        void __init_pools(){
+            pools_ = static_cast<__pool*>(upstream_->allocate(pool_count_ * sizeof(__pool), alignof(__pool)));
+            size_t block = __MIN_BLOCK;
+            for (size_t i = 0; i < pool_count_; ++i, block <<= 1) {
+                __pool& p = pools_[i];
+                p.block_size = block;
+                p.free = nullptr;
+                p.bump = p.bump_end = nullptr;
+                p.chunks = nullptr;
+                p.next_blocks = __FIRST_BLOCKS;
+            }
+        }
+
+        // 向上游申请一块新内存，区块从块首起按 block_size 切分，块尾存放 __chunk
+        void __refill(__pool& p){
+            size_t blocks = p.next_blocks;
+            size_t size = blocks * p.block_size + sizeof(__chunk);
+            char* base = static_cast<char*>(upstream_->allocate(size, __MAX_ALIGN));
+            __chunk* c = reinterpret_cast<__chunk*>(base + blocks * p.block_size);
+            c->next = p.chunks;
+            c->size = size;
+            p.chunks = c;
+            p.bump = base;
+            p.bump_end = base + blocks * p.block_size;
+            if (p.next_blocks * 2 <= options_.max_blocks_per_chunk)
+                p.next_blocks *= 2;
+        }
+
+        size_t __large_header(size_t alignment) const{
+            return __align_up(sizeof(__large), alignment > (size_t)__MAX_ALIGN ? alignment : (size_t)__MAX_ALIGN);
+        }
+
+        void* do_allocate(size_t bytes, size_t alignment) override{
+            if (bytes > options_.largest_required_pool_block || alignment > (size_t)__MAX_ALIGN){
+                size_t header = __large_header(alignment);
+                size_t large_align = alignment > (size_t)__MAX_ALIGN ? alignment : (size_t)__MAX_ALIGN;
+                char* base = static_cast<char*>(upstream_->allocate(header + bytes, large_align));
+                __large* l = reinterpret_cast<__large*>(base);
+                l->size = header + bytes;
+                l->alignment = large_align;
+                l->prev = nullptr;
+                l->next = large_;
+                if (large_ != nullptr)
+                    large_->prev = l;
+                large_ = l;
+                return base + header;
+            }
+
+            if (pools_ == nullptr)
+                __init_pools();
+            __pool& p = pools_[__pool_index(bytes, alignment)];
+            obj* result = p.free;
+            if (result != nullptr){
+                p.free = result->free_list_link;
+                return result;
+            }
+            if (p.bump == p.bump_end)
+                __refill(p);
+            char* block = p.bump;
+            p.bump += p.block_size;
+            return block;
+        }
+
+        void do_deallocate(void* ptr, size_t bytes, size_t alignment) override{
+            if (bytes > options_.largest_required_pool_block || alignment > (size_t)__MAX_ALIGN){
+                __large* l = reinterpret_cast<__large*>(static_cast<char*>(ptr) - __large_header(alignment));
+                if (l->prev != nullptr)
+                    l->prev->next = l->next;
+                else
+                    large_ = l->next;
+                if (l->next != nullptr)
+                    l->next->prev = l->prev;
+                upstream_->deallocate(l, l->size, l->alignment);
+                return;
+            }
+
+            __pool& p = pools_[__pool_index(bytes, alignment)];
+            obj* q = static_cast<obj*>(ptr);
+            q->free_list_link = p.free;
+            p.free = q;
+        }
+
+        bool do_is_equal(const memory_resource& other) const noexcept override{
+            return &other == this;
+        }
+    };
+
+    class synchronized_pool_resource : public memory_resource{
+    private:
+        std::mutex mutex_;
+        unsynchronized_pool_resource pool_;
+
+    public:
+        synchronized_pool_resource() : pool_() {}
+
+        explicit synchronized_pool_resource(memory_resource* upstream) : pool_(upstream) {}
+
+        explicit synchronized_pool_resource(const pool_options& opts,
+                                            memory_resource* upstream = get_default_resource())
+        : pool_(opts, upstream) {}
+
+        synchronized_pool_resource(const synchronized_pool_resource&) = delete;
+        synchronized_pool_resource& operator=(const synchronized_pool_resource&) = delete;
+
+        void release(){
+            std::lock_guard<std::mutex> guard(mutex_);
+            pool_.release();
+        }
+
+        memory_resource* upstream_resource() const noexcept{
+            return pool_.upstream_resource();
+        }
+
+        pool_options options() const noexcept{
+            return pool_.options();
+        }
+
+    private:
+        void* do_allocate(size_t bytes, size_t alignment) override{
+            std::lock_guard<std::mutex> guard(mutex_);
+            return pool_.allocate(bytes, alignment);
+        }
+
+        void do_deallocate(void* p, size_t bytes, size_t alignment) override{
+            std::lock_guard<std::mutex> guard(mutex_);
+            pool_.deallocate(p, bytes, alignment);
+        }
+
+        bool do_is_equal(const memory_resource& other) const noexcept override{
+            return &other == this;
+        }
+    };
+
+
+    /** 有状态配置器，所有配置请求转交给其指向的内存资源 */
+    template<class T>
+    class polymorphic_allocator{
+    public:
+        typedef T           value_type;
+        typedef T*          pointer;
+        typedef const T*    const_pointer;
+        typedef T&          reference;
+        typedef const T&    const_reference;
+        typedef size_t      size_type;
+        typedef ptrdiff_t   difference_type;
+
+        // 容器之间赋值、交换时不传播，内存始终由原资源管理
+        typedef __false_type_s  propagate_on_container_copy_assignment;
+        typedef __false_type_s  propagate_on_container_move_assignment;
+        typedef __false_type_s  propagate_on_container_swap;
+        typedef __false_type_s  is_always_equal;
+
+        template<class U>
+        struct rebind{
+            typedef polymorphic_allocator<U> other;
+        };
+
+    private:
+        memory_resource* resource_;
+
+    public:
+        polymorphic_allocator() noexcept : resource_(get_default_resource()) {}
+
+        polymorphic_allocator(memory_resource* r) noexcept : resource_(r) {}
+
+        polymorphic_allocator(const polymorphic_allocator&) = default;
+
+        template<class U>
+        polymorphic_allocator(const polymorphic_allocator<U>& other) noexcept : resource_(other.resource()) {}
+
+        polymorphic_allocator& operator=(const polymorphic_allocator&) = delete;
+
+        pointer allocate(size_type n){
+            if (n > max_size())
+                throw std::bad_alloc();
+            return static_cast<pointer>(resource_->allocate(n * sizeof(T), alignof(T)));
+        }
+
+        void deallocate(pointer p, size_type n){
+            resource_->deallocate(p, n * sizeof(T), alignof(T));
+        }
+
+        template<class U, class... Args>
+        void construct(U* p, Args&&... args){
+            ::new ((void*)p) U(simple_stl::forward<Args>(args)...);
+        }
+
+        template<class U>
+        void destroy(U* p){
+            p->~U();
+        }
+
+        size_type max_size() const noexcept{
+            return size_type(-1) / sizeof(T);
+        }
+
+        // 拷贝容器时不沿用原资源，而是使用默认资源
+        polymorphic_allocator select_on_container_copy_construction() const{
+            return polymorphic_allocator();
+        }
+
+        memory_resource* resource() const noexcept{
+            return resource_;
+        }
+    };
+
+    template<class T1, class T2>
+    inline bool operator==(const polymorphic_allocator<T1>& a, const polymorphic_allocator<T2>& b) noexcept{
+        return *a.resource() == *b.resource();
+    }
+
+    template<class T1, class T2>
+    inline bool operator!=(const polymorphic_allocator<T1>& a, const polymorphic_allocator<T2>& b) noexcept{
+        return !(a == b);
+    }
+
+}   // simple_stl
+
+#endif //SIMPLESTL_STL_MEMORY_RESOURCE_H
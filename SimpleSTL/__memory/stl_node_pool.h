@@ -0,0 +1,198 @@
+/**
+ * Created by 史进 on 2023/6/15.
+ *
+ * 节点池 node_pool：为链表、树等基于节点的容器配置定长的小型区块
+ *  - 按 8 字节分级，每级一条自由链表，链表空时一次向第一级配置器要一整块再切分，
+ *    每次要的块逐渐增大；释放的节点挂回自由链表以便复用，直到节点池析构才归还整块内存
+ *  - 不加锁，只能在一个线程内使用。可以由一个容器独占，也可以由多个容器共享，
+ *    共享同一节点池的容器之间可以 splice
+ *  - 超过 __MAX_NODE_BYTES 的区块直接交给第一级配置器
+ *
+ * node_pool_allocator<T>：从指定节点池配置单个对象的配置器，一次配置多个对象时转交第一级配置器
+ */
+#ifndef SIMPLESTL_STL_NODE_POOL_H
+#define SIMPLESTL_STL_NODE_POOL_H
+
+#include <cstddef>
+
+#include "stl_alloc.h"
+#include "../type_traits.h"
+
+namespace simple_stl{
+
+    class node_pool{
+    public:
+        enum {__NODE_ALIGN = 8};                                    // 节点的上调边界
+        enum {__MAX_NODE_BYTES = 256};                              // 节点的上限
+        enum {__NNODELISTS = __MAX_NODE_BYTES / __NODE_ALIGN};      // 自由链表个数
+        enum {__MIN_CHUNK_NODES = 16, __MAX_CHUNK_NODES = 1024};    // 每块切出的节点个数
+
+    private:
+        union obj{
+            union obj* free_list_link;
+            char client_data[1];
+        };
+
+        // 每块内存的头部，串起全部块以便统一归还；按 16 字节对齐以保证其后的节点对齐
+        struct alignas(16) chunk{
+            chunk* next;
+            size_t bytes;
+        };
+
+        obj* free_list_[__NNODELISTS];
+        size_t chunk_nodes_[__NNODELISTS];      // 各级下次配置整块时切出的节点个数
+        chunk* chunks_;
+
+        static size_t ROUND_UP(size_t bytes){
+            return (bytes + __NODE_ALIGN - 1) & ~((size_t)__NODE_ALIGN - 1);
+        }
+
+        static size_t FREELIST_INDEX(size_t bytes){
+            return (bytes + __NODE_ALIGN - 1) / __NODE_ALIGN - 1;
+        }
+
+        // 向第一级配置器要一整块，切成 size 大小的节点，第一个返回，其余挂入自由链表
+        void* refill(size_t index, size_t size){
+            const size_t nodes = chunk_nodes_[index];
+            const size_t bytes = sizeof(chunk) + nodes * size;
+            chunk* c = static_cast<chunk*>(malloc_alloc::allocate(bytes));
+            c->next = chunks_;
+            c->bytes = bytes;
+            chunks_ = c;
+            if (nodes < __MAX_CHUNK_NODES)
+                chunk_nodes_[index] = nodes * 2;
+
+            char* first = reinterpret_cast<char*>(c + 1);
+            obj* cur = reinterpret_cast<obj*>(first + size);
+            free_list_[index] = cur;
+            for (size_t i = 2; i < nodes; ++i){
+                obj* next = reinterpret_cast<obj*>(reinterpret_cast<char*>(cur) + size);
+                cur->free_list_link = next;
+                cur = next;
+            }
+            cur->free_list_link = nullptr;
+            return first;
+        }
+
+    public:
+        node_pool() noexcept : chunks_(nullptr){
+            for (size_t i = 0; i < __NNODELISTS; ++i){
+                free_list_[i] = nullptr;
+                chunk_nodes_[i] = __MIN_CHUNK_NODES;
+            }
+        }
+
+        node_pool(const node_pool&) = delete;
+        node_pool& operator=(const node_pool&) = delete;
+
+        ~node_pool(){
+            release();
+        }
+
+        void* allocate(size_t bytes){
+            if (bytes > (size_t)__MAX_NODE_BYTES)
+                return malloc_alloc::allocate(bytes);
+            const size_t index = FREELIST_INDEX(bytes);
+            obj* result = free_list_[index];
+            if (result == nullptr)
+                return refill(index, ROUND_UP(bytes));
+            free_list_[index] = result->free_list_link;
+            return result;
+        }
+
+        void deallocate(void* p, size_t bytes) noexcept{
+            if (bytes > (size_t)__MAX_NODE_BYTES){
+                malloc_alloc::deallocate(p, bytes);
+                return;
+            }
+            obj* q = static_cast<obj*>(p);
+            const size_t index = FREELIST_INDEX(bytes);
+            q->free_list_link = free_list_[index];
+            free_list_[index] = q;
+        }
+
+        // 归还全部整块内存，之前配置的节点全部失效
+        void release() noexcept{
+            while (chunks_ != nullptr){
+                chunk* next = chunks_->next;
+                malloc_alloc::deallocate(chunks_, chunks_->bytes);
+                chunks_ = next;
+            }
+            for (size_t i = 0; i < __NNODELISTS; ++i){
+                free_list_[i] = nullptr;
+                chunk_nodes_[i] = __MIN_CHUNK_NODES;
+            }
+        }
+    };
+
+
+    // 有状态的配置器，持有节点池的指针；指向同一节点池的配置器相等
+    template<class T>
+    class node_pool_allocator{
+    public:
+        typedef T           value_type;
+        typedef T*          pointer;
+        typedef const T*    const_pointer;
+        typedef T&          reference;
+        typedef const T&    const_reference;
+        typedef size_t      size_type;
+        typedef ptrdiff_t   difference_type;
+
+        // 容器移动赋值与交换时连同节点池一起转移，拷贝赋值时保留自己的节点池
+        typedef __false_type_s  propagate_on_container_copy_assignment;
+        typedef __true_type_s   propagate_on_container_move_assignment;
+        typedef __true_type_s   propagate_on_container_swap;
+        typedef __false_type_s  is_always_equal;
+
+        template<class U>
+        struct rebind{
+            typedef node_pool_allocator<U> other;
+        };
+
+    private:
+        node_pool* pool_;
+
+        // 单个对象且对齐要求不超过节点池时才由节点池配置
+        static bool __from_pool(size_type n){
+            return n == 1 && alignof(T) <= (size_t)node_pool::__NODE_ALIGN;
+        }
+
+    public:
+        node_pool_allocator(node_pool& pool) noexcept : pool_(&pool) {}
+
+        template<class U>
+        node_pool_allocator(const node_pool_allocator<U>& other) noexcept : pool_(other.pool()) {}
+
+        node_pool* pool() const noexcept { return pool_; }
+
+        pointer allocate(size_type n){
+            if (__from_pool(n))
+                return static_cast<pointer>(pool_->allocate(sizeof(T)));
+            return static_cast<pointer>(malloc_alloc::allocate(n * sizeof(T)));
+        }
+
+        void deallocate(pointer p, size_type n) noexcept{
+            if (__from_pool(n))
+                pool_->deallocate(p, sizeof(T));
+            else
+                malloc_alloc::deallocate(p, n * sizeof(T));
+        }
+
+        size_type max_size() const noexcept{
+            return size_type(-1) / sizeof(T);
+        }
+    };
+
+    template<class T1, class T2>
+    inline bool operator==(const node_pool_allocator<T1>& x, const node_pool_allocator<T2>& y) noexcept{
+        return x.pool() == y.pool();
+    }
+
+    template<class T1, class T2>
+    inline bool operator!=(const node_pool_allocator<T1>& x, const node_pool_allocator<T2>& y) noexcept{
+        return x.pool() != y.pool();
+    }
+
+}   // simple_stl
+
+#endif //SIMPLESTL_STL_NODE_POOL_H
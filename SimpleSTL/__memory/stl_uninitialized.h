@@ -3,41 +3,162 @@
  *
  * 内存基本处理工具，作用于未初始化空间上
  *
+ * 目标类型为POD时，构造与赋值等价，改为调用 stl_algobase.h 的 copy、fill 等批量处理：
+ *  连续迭代器且元素类型相同时使用memmove，值的各字节相同的填充使用memset，
+ *  其余情况使用计数循环，便于编译器向量化
+ *
+ * 源区间或目标区间为分段迭代器（如 deque）时逐段处理，
+ * 每段都是原生指针区间，仍可走上述批量路径
  */
 #ifndef SIMPLESTL_STL_UNINITIALIZED_H
 #define SIMPLESTL_STL_UNINITIALIZED_H
 
+#include <cstring>
+#include <type_traits>
+
 #include "../iterator.h"
 #include "../utility.h"
+#include "../__algorithm/stl_algobase.h"
 #include "stl_construct.h"
 
 namespace simple_stl{
 
+    /** 分段迭代器的逐段处理 */
+    template<class InputIterator, class ForwardIterator>
+    inline ForwardIterator uninitialized_copy(InputIterator first, InputIterator last, ForwardIterator result);
+
+    template<class InputIterator, class ForwardIterator>
+    inline ForwardIterator uninitialized_move(InputIterator first, InputIterator last, ForwardIterator result);
+
+    template<class ForwardIterator, class Tp>
+    inline void uninitialized_fill(ForwardIterator first, ForwardIterator last, const Tp& value);
+
+    template<class ForwardIterator, class Size, class Tp>
+    inline ForwardIterator uninitialized_fill_n(ForwardIterator first, Size n, const Tp& value);
+
+    // 分段方式的选择见 stl_algobase.h 的 __segment_dispatch
+    // 段内拷贝、移动、填充，op(local, k) 在 local 处构造 k 个元素并返回尾后位置
+    template<class RandomAccessIterator>
+    struct __segment_copy_op{
+        RandomAccessIterator first;
+
+        template<class LocalIterator, class Distance>
+        LocalIterator operator()(LocalIterator local, Distance k){
+            LocalIterator r = simple_stl::uninitialized_copy(first, first + k, local);
+            first += k;
+            return r;
+        }
+    };
+
+    template<class RandomAccessIterator>
+    struct __segment_move_op{
+        RandomAccessIterator first;
+
+        template<class LocalIterator, class Distance>
+        LocalIterator operator()(LocalIterator local, Distance k){
+            LocalIterator r = simple_stl::uninitialized_move(first, first + k, local);
+            first += k;
+            return r;
+        }
+    };
+
+    template<class Tp>
+    struct __segment_fill_op{
+        const Tp& value;
+
+        template<class LocalIterator, class Distance>
+        LocalIterator operator()(LocalIterator local, Distance k){
+            return simple_stl::uninitialized_fill_n(local, k, value);
+        }
+    };
+
+    // 目标区间分段：每段填满后转到下一段的开头；
+    // 某段抛出异常时该段已自行回滚，只需析构之前各段的元素
+    template<class SegmentedIterator, class Distance, class Op>
+    inline SegmentedIterator __segmented_output(SegmentedIterator result, Distance n, Op op){
+        typedef segmented_iterator_traits<SegmentedIterator> traits;
+        // 空区间不触碰目标的分段，目标可能是尚未配置任何分段的空容器
+        if (n <= 0)
+            return result;
+        typename traits::segment_iterator s = traits::segment(result);
+        typename traits::local_iterator l = traits::local(result);
+        try {
+            for (Distance room = traits::end(s) - l; n >= room && n > 0; room = traits::end(s) - l){
+                op(l, room);
+                n -= room;
+                ++s;
+                l = traits::begin(s);
+            }
+            l = op(l, n);
+        }catch(...){
+            simple_stl::destroy(result, traits::compose(s, l));
+            throw;
+        }
+        return traits::compose(s, l);
+    }
+
+    // 源区间分段：逐段交给 op，目标区间可以是任意迭代器（包括分段迭代器）
+    template<class SegmentedIterator, class ForwardIterator, class Op>
+    inline ForwardIterator __segmented_input(SegmentedIterator first, SegmentedIterator last,
+                                             ForwardIterator result, Op op){
+        typedef segmented_iterator_traits<SegmentedIterator> traits;
+        typename traits::segment_iterator sf = traits::segment(first);
+        typename traits::segment_iterator sl = traits::segment(last);
+        if (sf == sl)
+            return op(traits::local(first), traits::local(last), result);
+        ForwardIterator cur = result;
+        try {
+            cur = op(traits::local(first), traits::end(sf), cur);
+            for (++sf; sf != sl; ++sf)
+                cur = op(traits::begin(sf), traits::end(sf), cur);
+            cur = op(traits::begin(sl), traits::local(last), cur);
+        }catch(...){
+            simple_stl::destroy(result, cur);
+            throw;
+        }
+        return cur;
+    }
+
+    struct __range_copy_op{
+        template<class LocalIterator, class ForwardIterator>
+        ForwardIterator operator()(LocalIterator first, LocalIterator last, ForwardIterator result) const{
+            return simple_stl::uninitialized_copy(first, last, result);
+        }
+    };
+
+    struct __range_move_op{
+        template<class LocalIterator, class ForwardIterator>
+        ForwardIterator operator()(LocalIterator first, LocalIterator last, ForwardIterator result) const{
+            return simple_stl::uninitialized_move(first, last, result);
+        }
+    };
+
+
     /** uninitialized_copy() */
     template<class InputIterator, class ForwardIterator>
     inline ForwardIterator
     __uninitialized_copy_aux(InputIterator first, InputIterator last,
-                             ForwardIterator result, __type_traits_s){
-        // 调用copy函数
+                             ForwardIterator result, __true_type_s){
+        return simple_stl::copy(first, last, result);
     }
 
     template<class InputIterator, class ForwardIterator>
     inline ForwardIterator
     __uninitialized_copy_aux(InputIterator first, InputIterator last,
                              ForwardIterator result, __false_type_s){
-//        typedef typename iterator_traits<ForwardIterator>::value_type value_type;
         ForwardIterator stable = result;
         try {
             for( ; first!=last; ++first, ++result)
-//                ::new ((void*)*result) value_type(*first);
-                construct(&*result, *first);
+                simple_stl::construct(&*result, *first);
         }catch(...){
             for ( ; stable!=result; ++stable)
-                destroy(&*stable);
+                simple_stl::destroy(&*stable);
+            throw;
         }
         return result;
     }
 
+    // 是否为POD取决于目标区间的元素类型
     template<class InputIterator, class ForwardIterator, class Tp>
     inline ForwardIterator
     __uninitialized_copy(InputIterator first, InputIterator last,
@@ -46,11 +167,34 @@ namespace simple_stl{
         return __uninitialized_copy_aux(first, last, result, is_POD());
     }
 
+    template<class InputIterator, class ForwardIterator>
+    inline ForwardIterator
+    __uninitialized_copy_seg(InputIterator first, InputIterator last,
+                             ForwardIterator result, __unsegmented_tag){
+        return __uninitialized_copy(first, last, result, value_type(result));
+    }
+
+    template<class InputIterator, class ForwardIterator>
+    inline ForwardIterator
+    __uninitialized_copy_seg(InputIterator first, InputIterator last,
+                             ForwardIterator result, __segmented_input_tag){
+        return __segmented_input(first, last, result, __range_copy_op());
+    }
+
+    template<class InputIterator, class ForwardIterator>
+    inline ForwardIterator
+    __uninitialized_copy_seg(InputIterator first, InputIterator last,
+                             ForwardIterator result, __segmented_output_tag){
+        __segment_copy_op<InputIterator> op = {first};
+        return __segmented_output(result, last - first, op);
+    }
+
     template<class InputIterator, class ForwardIterator>
     inline ForwardIterator
     uninitialized_copy(InputIterator first, InputIterator last,
                        ForwardIterator result){
-        return __uninitialized_copy(first, last, result, value_type(first));
+        typedef typename __segment_dispatch<InputIterator, ForwardIterator>::type segment_tag;
+        return __uninitialized_copy_seg(first, last, result, segment_tag());
     }
 
 
@@ -59,20 +203,21 @@ namespace simple_stl{
     inline ForwardIterator
     __uninitialized_copy_n_aux(InputIterator first, Size n,
                                ForwardIterator result, __true_type_s){
-        // 调用copy_n函数
+        return simple_stl::copy_n(first, n, result);
     }
 
     template<class InputIterator, class Size, class ForwardIterator>
     inline ForwardIterator
     __uninitialized_copy_n_aux(InputIterator first, Size n,
-                               ForwardIterator result, __true_type_s){
+                               ForwardIterator result, __false_type_s){
         ForwardIterator stable = result;
         try {
             for( ; n>0; ++first, ++result, --n)
-                construct(&*result, *first);
+                simple_stl::construct(&*result, *first);
         }catch(...){
             for ( ; stable!=result; ++stable)
-                destroy(&*stable);
+                simple_stl::destroy(&*stable);
+            throw;
         }
         return result;
     }
@@ -84,17 +229,33 @@ namespace simple_stl{
         return __uninitialized_copy_n_aux(first, n, result, is_POD());
     }
 
+    // 涉及分段迭代器且源区间可随机访问时，转为 uninitialized_copy() 逐段处理
+    template<class InputIterator, class Size, class ForwardIterator>
+    inline ForwardIterator
+    __uninitialized_copy_n_seg(InputIterator first, Size n, ForwardIterator result, __true_type_s){
+        return simple_stl::uninitialized_copy(first, first + n, result);
+    }
+
+    template<class InputIterator, class Size, class ForwardIterator>
+    inline ForwardIterator
+    __uninitialized_copy_n_seg(InputIterator first, Size n, ForwardIterator result, __false_type_s){
+        return __uninitialized_copy_n(first, n, result, value_type(result));
+    }
+
     template<class InputIterator, class Size, class ForwardIterator>
     inline ForwardIterator
     uninitialized_copy_n(InputIterator first, Size n, ForwardIterator result){
-        return __uninitialized_copy_n(first, n, result, value_type(first));
+        typedef bool_constant_s<(is_segmented_iterator<InputIterator>::value ||
+                                 is_segmented_iterator<ForwardIterator>::value) &&
+                                is_random_access_iterator<InputIterator>::value> segmented;
+        return __uninitialized_copy_n_seg(first, n, result, segmented());
     }
 
     /** uninitialized_fill() */
     template<class ForwardIterator, class Tp>
     inline void __uninitialized_fill_aux(ForwardIterator first, ForwardIterator last,
                                          const Tp& value, __true_type_s){
-        // 调用fill函数
+        simple_stl::fill(first, last, value);
     }
 
     template<class ForwardIterator, class Tp>
@@ -103,10 +264,11 @@ namespace simple_stl{
         ForwardIterator stable = first;
         try {
             for( ; first!=last; ++first)
-                construct(&*first, value);
+                simple_stl::construct(&*first, value);
         }catch(...){
             for ( ; stable!=first; ++stable)
-                destroy(&*stable);
+                simple_stl::destroy(&*stable);
+            throw;
         }
     }
 
@@ -117,17 +279,47 @@ namespace simple_stl{
         __uninitialized_fill_aux(first, last, value, is_POD());
     }
 
+    template<class ForwardIterator, class Tp>
+    inline void __uninitialized_fill_seg(ForwardIterator first, ForwardIterator last,
+                                         const Tp& value, __false_type_s){
+        __uninitialized_fill(first, last, value, value_type(first));
+    }
+
+    // 分段迭代器，逐段填充，某段抛出异常时析构之前各段的元素
+    template<class SegmentedIterator, class Tp>
+    inline void __uninitialized_fill_seg(SegmentedIterator first, SegmentedIterator last,
+                                         const Tp& value, __true_type_s){
+        typedef segmented_iterator_traits<SegmentedIterator> traits;
+        typename traits::segment_iterator sf = traits::segment(first);
+        typename traits::segment_iterator sl = traits::segment(last);
+        if (sf == sl){
+            simple_stl::uninitialized_fill(traits::local(first), traits::local(last), value);
+            return;
+        }
+        typename traits::segment_iterator cur = sf;
+        try {
+            simple_stl::uninitialized_fill(traits::local(first), traits::end(sf), value);
+            for (++cur; cur != sl; ++cur)
+                simple_stl::uninitialized_fill(traits::begin(cur), traits::end(cur), value);
+            simple_stl::uninitialized_fill(traits::begin(sl), traits::local(last), value);
+        }catch(...){
+            if (cur != sf)
+                simple_stl::destroy(first, traits::compose(cur, traits::begin(cur)));
+            throw;
+        }
+    }
+
     template<class ForwardIterator, class Tp>
     inline void uninitialized_fill(ForwardIterator first, ForwardIterator last,
                                    const Tp& value){
-        __uninitialized_fill(first, last, value, value_type(first));
+        __uninitialized_fill_seg(first, last, value, is_segmented_iterator<ForwardIterator>());
     }
 
     /** uninitialized_fill_n() */
     template<class ForwardIterator, class Size, class Tp>
     inline ForwardIterator __uninitialized_fill_n_aux(ForwardIterator first, Size n,
                                          const Tp& value, __true_type_s){
-        // 调用fill_n函数
+        return simple_stl::fill_n(first, n, value);
     }
 
     template<class ForwardIterator, class Size, class Tp>
@@ -136,10 +328,11 @@ namespace simple_stl{
         ForwardIterator stable = first;
         try {
             for( ; n>0; ++first, --n)
-                construct(&*first, value);
+                simple_stl::construct(&*first, value);
         }catch(...){
             for ( ; stable!=first; ++stable)
-                destroy(&*stable);
+                simple_stl::destroy(&*stable);
+            throw;
         }
         return first;
     }
@@ -151,33 +344,47 @@ namespace simple_stl{
         return __uninitialized_fill_n_aux(first, n, value, is_POD());
     }
 
+    template<class ForwardIterator, class Size, class Tp>
+    inline ForwardIterator __uninitialized_fill_n_seg(ForwardIterator first, Size n,
+                                                      const Tp& value, __false_type_s){
+        return __uninitialized_fill_n(first, n, value, value_type(first));
+    }
+
+    template<class SegmentedIterator, class Size, class Tp>
+    inline SegmentedIterator __uninitialized_fill_n_seg(SegmentedIterator first, Size n,
+                                                        const Tp& value, __true_type_s){
+        typedef typename iterator_traits<SegmentedIterator>::difference_type difference_type;
+        __segment_fill_op<Tp> op = {value};
+        return __segmented_output(first, static_cast<difference_type>(n), op);
+    }
+
     template<class ForwardIterator, class Size, class Tp>
     inline ForwardIterator uninitialized_fill_n(ForwardIterator first, Size n,
                                    const Tp& value){
-        return __uninitialized_fill_n(first, n, value, value_type(first));
+        return __uninitialized_fill_n_seg(first, n, value, is_segmented_iterator<ForwardIterator>());
     }
 
     /** uninitialized_move() */
+    // POD 的移动即拷贝
     template<class InputIterator, class ForwardIterator>
     inline ForwardIterator
     __uninitialized_move_aux(InputIterator first, InputIterator last,
-                             ForwardIterator result, __type_traits_s){
-        // 调用move函数
+                             ForwardIterator result, __true_type_s){
+        return simple_stl::move(first, last, result);
     }
 
     template<class InputIterator, class ForwardIterator>
     inline ForwardIterator
     __uninitialized_move_aux(InputIterator first, InputIterator last,
                              ForwardIterator result, __false_type_s){
-//        typedef typename iterator_traits<ForwardIterator>::value_type value_type;
         ForwardIterator idx = result;
         try {
             for( ; first!=last; ++first, ++idx)
-//                ::new ((void*)address_of(*idx)) value_type(move(*first));
-                construct(&*idx, move(*first)
-
-        }catch(...)
-            destroy(result, idx)
+                simple_stl::construct(&*idx, simple_stl::move(*first));
+        }catch(...){
+            simple_stl::destroy(result, idx);
+            throw;
+        }
         return idx;
     }
 
@@ -189,33 +396,56 @@ namespace simple_stl{
         return __uninitialized_move_aux(first, last, result, is_POD());
     }
 
+    template<class InputIterator, class ForwardIterator>
+    inline ForwardIterator
+    __uninitialized_move_seg(InputIterator first, InputIterator last,
+                             ForwardIterator result, __unsegmented_tag){
+        return __uninitialized_move(first, last, result, value_type(result));
+    }
+
+    template<class InputIterator, class ForwardIterator>
+    inline ForwardIterator
+    __uninitialized_move_seg(InputIterator first, InputIterator last,
+                             ForwardIterator result, __segmented_input_tag){
+        return __segmented_input(first, last, result, __range_move_op());
+    }
+
+    template<class InputIterator, class ForwardIterator>
+    inline ForwardIterator
+    __uninitialized_move_seg(InputIterator first, InputIterator last,
+                             ForwardIterator result, __segmented_output_tag){
+        __segment_move_op<InputIterator> op = {first};
+        return __segmented_output(result, last - first, op);
+    }
+
     template<class InputIterator, class ForwardIterator>
     inline ForwardIterator
     uninitialized_move(InputIterator first, InputIterator last,
                        ForwardIterator result){
-        return __uninitialized_move(first, last, result, value_type(first));
+        typedef typename __segment_dispatch<InputIterator, ForwardIterator>::type segment_tag;
+        return __uninitialized_move_seg(first, last, result, segment_tag());
     }
 
     /** uninitialized_move_n() */
     template<class InputIterator, class Size, class ForwardIterator>
     inline ForwardIterator
     __uninitialized_move_n_aux(InputIterator first, Size n,
-                             ForwardIterator result, __type_traits_s){
-        // 调用move_n函数
+                             ForwardIterator result, __true_type_s){
+        return simple_stl::copy_n(first, n, result);
     }
 
     template<class InputIterator, class Size, class ForwardIterator>
     inline ForwardIterator
     __uninitialized_move_n_aux(InputIterator first, Size n,
                              ForwardIterator result, __false_type_s){
-//        typedef typename iterator_traits<ForwardIterator>::value_type value_type;
         ForwardIterator idx = result;
         try {
             for( ; n>0; ++first, ++idx, --n)
-//                ::new ((void*)address_of(*idx)) value_type(move(*first));
-                construct(&*idx, move(*first)
-        }catch(...)
-        destroy(result, idx)
+                simple_stl::construct(&*idx, simple_stl::move(*first));
+        }catch(...){
+            simple_stl::destroy(result, idx);
+            throw;
+        }
         return idx;
     }
 
@@ -227,11 +457,50 @@ namespace simple_stl{
         return __uninitialized_move_n_aux(first, n, result, is_POD());
     }
 
+    template<class InputIterator, class Size, class ForwardIterator>
+    inline ForwardIterator
+    __uninitialized_move_n_seg(InputIterator first, Size n, ForwardIterator result, __true_type_s){
+        return simple_stl::uninitialized_move(first, first + n, result);
+    }
+
+    template<class InputIterator, class Size, class ForwardIterator>
+    inline ForwardIterator
+    __uninitialized_move_n_seg(InputIterator first, Size n, ForwardIterator result, __false_type_s){
+        return __uninitialized_move_n(first, n, result, value_type(result));
+    }
+
     template<class InputIterator,class Size, class ForwardIterator>
     inline ForwardIterator
     uninitialized_move_n(InputIterator first, Size n,
                        ForwardIterator result){
-        return __uninitialized_move_n(first, n, result, value_type(first));
+        typedef bool_constant_s<(is_segmented_iterator<InputIterator>::value ||
+                                 is_segmented_iterator<ForwardIterator>::value) &&
+                                is_random_access_iterator<InputIterator>::value> segmented;
+        return __uninitialized_move_n_seg(first, n, result, segmented());
+    }
+
+    /** uninitialized_relocate()：将[first, last)移至result处并析构原对象，返回目标区间的尾后位置 */
+    // 可平凡重定位，按字节搬移，源区间与目标区间可以重叠
+    template<class Tp>
+    inline Tp* __uninitialized_relocate_aux(Tp* first, Tp* last, Tp* result, __true_type_s){
+        const ptrdiff_t n = last - first;
+        if (n > 0)
+            memmove(static_cast<void*>(result), static_cast<const void*>(first), sizeof(Tp) * n);
+        return result + n;
+    }
+
+    // 源区间与目标区间不可重叠
+    template<class Tp>
+    inline Tp* __uninitialized_relocate_aux(Tp* first, Tp* last, Tp* result, __false_type_s){
+        Tp* cur = simple_stl::uninitialized_move(first, last, result);
+        simple_stl::destroy(first, last);
+        return cur;
+    }
+
+    template<class Tp>
+    inline Tp* uninitialized_relocate(Tp* first, Tp* last, Tp* result){
+        typedef bool_constant_s<is_trivially_relocatable<Tp>::value> trivially_relocatable;
+        return __uninitialized_relocate_aux(first, last, result, trivially_relocatable());
     }
 
 
@@ -0,0 +1,1124 @@
+/**
+ * Created by 史进 on 2023/6/24.
+ *
+ * basic_string：以空字符结尾的字符序列，带短字符串优化（SSO）
+ *  - 对象本身为三个字长（64 位下 24 字节）；短字符串直接存放在对象内部，不向配置器申请内存，
+ *    char 最多可存 22 个字符（外加结尾的空字符）
+ *  - 长字符串时三个字为 {指针, 长度, 容量}；短字符串时前面的字节存放字符，最后一个字节存放长度。
+ *    容量字的最高位恰好落在最后一个字节上，以其最高位区分长短：短字符串的长度不超过 127，该位总为 0
+ *  - 字符的搬移、填充、比较都经 Traits 完成，char_traits 中为 memcpy、memmove、memset、memcmp
+ *  - find、rfind、find_first_of 等使用 stl_char_traits.h 的查找函数，默认的 char_traits 下走 SIMD 内核
+ *  - 可与 basic_string_view 互相转换，hash 与 basic_string_view 一致
+ */
+#ifndef SIMPLESTL_STL_BASIC_STRING_H
+#define SIMPLESTL_STL_BASIC_STRING_H
+
+#include <cstddef>
+#include <initializer_list>
+#include <ostream>
+#include <stdexcept>
+#include <type_traits>
+
+#include "stl_char_traits.h"
+#include "stl_string_view.h"
+#include "../iterator.h"
+#include "../type_traits.h"
+#include "../utility.h"
+#include "../__functional/stl_hash.h"
+#include "../__memory/stl_allocator.h"
+#include "../__memory/stl_allocator_traits.h"
+
+namespace simple_stl{
+
+    template<class CharT, class Traits = char_traits<CharT>, class Alloc = allocator<CharT> >
+    class basic_string{
+    public:
+        typedef Traits                              traits_type;
+        typedef CharT                               value_type;
+        typedef Alloc                               allocator_type;
+        typedef size_t                              size_type;
+        typedef ptrdiff_t                           difference_type;
+        typedef CharT&                              reference;
+        typedef const CharT&                        const_reference;
+        typedef CharT*                              pointer;
+        typedef const CharT*                        const_pointer;
+        typedef CharT*                              iterator;
+        typedef const CharT*                        const_iterator;
+        typedef basic_string_view<CharT, Traits>    __self_view;
+
+        static const size_type npos = static_cast<size_type>(-1);
+
+        static_assert(std::is_trivial<CharT>::value && std::is_standard_layout<CharT>::value,
+                      "basic_string requires a trivial standard-layout character type");
+
+    private:
+        typedef allocator_traits<Alloc>             alloc_traits;
+
+        struct __long{
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+            // 大端时最后一个字节是容量字的最低字节，容量整体左移 8 位腾出该字节
+            static const size_type cap_shift = 8;
+            static const size_type long_flag = 0x80;
+#else
+            static const size_type cap_shift = 0;
+            static const size_type long_flag = ~(~size_type(0) >> 1);
+#endif
+            CharT* data_;
+            size_type size_;
+            size_type cap_;         // (容量 << cap_shift) | long_flag，容量不含结尾的空字符
+        };
+
+        // 短字符串缓冲区可容纳的字符数，含结尾的空字符；最后一个字节留给长度
+        static const size_type __min_cap = (sizeof(__long) - 1) / sizeof(CharT) > 2
+                                           ? (sizeof(__long) - 1) / sizeof(CharT) : 2;
+
+        union __rep{
+            __long l_;
+            CharT s_[__min_cap];
+        };
+
+        static_assert(sizeof(__rep) == sizeof(__long), "the short buffer must fit in the long representation");
+
+        // 继承配置器以便无状态配置器不占空间
+        struct __string_impl : public Alloc{
+            __rep r_;
+
+            __string_impl() : Alloc() { __zero(); }
+            explicit __string_impl(const Alloc& a) : Alloc(a) { __zero(); }
+            explicit __string_impl(Alloc&& a) : Alloc(simple_stl::move(a)) { __zero(); }
+
+            // 全零即为空的短字符串
+            void __zero() noexcept { std::memset(static_cast<void*>(&r_), 0, sizeof(r_)); }
+        };
+
+        __string_impl impl_;
+
+        Alloc& __alloc() noexcept { return impl_; }
+        const Alloc& __alloc() const noexcept { return impl_; }
+
+        /** 长短两种表示的读写 */
+        unsigned char& __tag() noexcept{
+            return reinterpret_cast<unsigned char*>(&impl_.r_)[sizeof(__rep) - 1];
+        }
+
+        unsigned char __tag() const noexcept{
+            return reinterpret_cast<const unsigned char*>(&impl_.r_)[sizeof(__rep) - 1];
+        }
+
+        bool __is_long() const noexcept { return (__tag() & 0x80) != 0; }
+
+        CharT* __get_pointer() noexcept { return __is_long() ? impl_.r_.l_.data_ : impl_.r_.s_; }
+        const CharT* __get_pointer() const noexcept { return __is_long() ? impl_.r_.l_.data_ : impl_.r_.s_; }
+
+        void __set_short_size(size_type n) noexcept { __tag() = static_cast<unsigned char>(n); }
+
+        void __set_size(size_type n) noexcept{
+            if (__is_long())
+                impl_.r_.l_.size_ = n;
+            else
+                __set_short_size(n);
+        }
+
+        size_type __get_long_cap() const noexcept{
+            return (impl_.r_.l_.cap_ & ~__long::long_flag) >> __long::cap_shift;
+        }
+
+        void __set_long(CharT* p, size_type n, size_type cap) noexcept{
+            impl_.r_.l_.data_ = p;
+            impl_.r_.l_.size_ = n;
+            impl_.r_.l_.cap_ = (cap << __long::cap_shift) | __long::long_flag;
+        }
+
+        // 容纳 n 个字符所需的容量：放得进短缓冲区时为短字符串的容量，否则按 16 字节向上取整
+        static size_type __recommend(size_type n) noexcept{
+            if (n < __min_cap)
+                return __min_cap - 1;
+            const size_type align = 16 / sizeof(CharT) > 1 ? 16 / sizeof(CharT) : 1;
+            return (n + 1 + align - 1) / align * align - 1;
+        }
+
+        CharT* __allocate(size_type cap){
+            return alloc_traits::allocate(__alloc(), cap + 1);
+        }
+
+        void __deallocate_long() noexcept{
+            if (__is_long())
+                alloc_traits::deallocate(__alloc(), impl_.r_.l_.data_, __get_long_cap() + 1);
+        }
+
+    public:
+        /** 构造、析构 */
+        basic_string() noexcept : impl_() {}
+
+        explicit basic_string(const Alloc& a) noexcept : impl_(a) {}
+
+        basic_string(size_type n, CharT c, const Alloc& a = Alloc()) : impl_(a){
+            __init(n, c);
+        }
+
+        basic_string(const CharT* s, const Alloc& a = Alloc()) : impl_(a){
+            __init(s, traits_type::length(s));
+        }
+
+        basic_string(const CharT* s, size_type n, const Alloc& a = Alloc()) : impl_(a){
+            __init(s, n);
+        }
+
+        basic_string(const basic_string& other, size_type pos, size_type n = npos, const Alloc& a = Alloc())
+        : impl_(a){
+            other.__pos_check(pos, "basic_string");
+            __init(other.data() + pos, other.__clamp(pos, n));
+        }
+
+        template<class InputIterator, typename enable_if<
+                is_input_iterator<InputIterator>::value, int>::type = 0>
+        basic_string(InputIterator first, InputIterator last, const Alloc& a = Alloc()) : impl_(a){
+            __range_init(first, last, iterator_category(first));
+        }
+
+        basic_string(std::initializer_list<CharT> il, const Alloc& a = Alloc()) : impl_(a){
+            __init(il.begin(), il.size());
+        }
+
+        explicit basic_string(__self_view v, const Alloc& a = Alloc()) : impl_(a){
+            __init(v.data(), v.size());
+        }
+
+        basic_string(const basic_string& other)
+        : impl_(alloc_traits::select_on_container_copy_construction(other.__alloc())){
+            __init_copy(other);
+        }
+
+        basic_string(const basic_string& other, const Alloc& a) : impl_(a){
+            __init_copy(other);
+        }
+
+        // 短字符串整个表示按字节拷贝，长字符串接管内存
+        basic_string(basic_string&& other) noexcept : impl_(simple_stl::move(other.__alloc())){
+            impl_.r_ = other.impl_.r_;
+            other.impl_.__zero();
+        }
+
+        basic_string(basic_string&& other, const Alloc& a) : impl_(a){
+            if (!other.__is_long() || a == other.__alloc()){
+                impl_.r_ = other.impl_.r_;
+                other.impl_.__zero();
+            }else{
+                __init(other.data(), other.size());
+            }
+        }
+
+        ~basic_string(){
+            __deallocate_long();
+        }
+
+        /** 赋值 */
+        basic_string& operator=(const basic_string& other){
+            if (this != &other){
+                __copy_assign_alloc(other, typename alloc_traits::propagate_on_container_copy_assignment());
+                assign(other.data(), other.size());
+            }
+            return *this;
+        }
+
+        basic_string& operator=(basic_string&& other) noexcept(
+                alloc_traits::propagate_on_container_move_assignment::value ||
+                alloc_traits::is_always_equal::value){
+            if (this != &other)
+                __move_assign(other, bool_constant_s<
+                        alloc_traits::propagate_on_container_move_assignment::value ||
+                        alloc_traits::is_always_equal::value>());
+            return *this;
+        }
+
+        basic_string& operator=(const CharT* s) { return assign(s); }
+
+        basic_string& operator=(CharT c) { return assign(size_type(1), c); }
+
+        basic_string& operator=(std::initializer_list<CharT> il) { return assign(il.begin(), il.size()); }
+
+        basic_string& operator=(__self_view v) { return assign(v.data(), v.size()); }
+
+        operator __self_view() const noexcept { return __self_view(data(), size()); }
+
+        basic_string& assign(const basic_string& other) { return *this = other; }
+
+        basic_string& assign(basic_string&& other) { return *this = simple_stl::move(other); }
+
+        basic_string& assign(const basic_string& other, size_type pos, size_type n = npos){
+            other.__pos_check(pos, "basic_string::assign");
+            return assign(other.data() + pos, other.__clamp(pos, n));
+        }
+
+        // s 可以指向自身
+        basic_string& assign(const CharT* s, size_type n){
+            if (n <= capacity()){
+                CharT* p = __get_pointer();
+                traits_type::move(p, s, n);
+                __finish(p, n);
+                return *this;
+            }
+            return __grow_replace(0, size(), s, n);
+        }
+
+        basic_string& assign(const CharT* s) { return assign(s, traits_type::length(s)); }
+
+        basic_string& assign(size_type n, CharT c){
+            if (n > capacity())
+                __grow_replace(0, size(), nullptr, 0, n);
+            CharT* p = __get_pointer();
+            traits_type::assign(p, n, c);
+            __finish(p, n);
+            return *this;
+        }
+
+        template<class InputIterator, typename enable_if<
+                is_input_iterator<InputIterator>::value, int>::type = 0>
+        basic_string& assign(InputIterator first, InputIterator last){
+            const basic_string tmp(first, last, __alloc());
+            return assign(tmp.data(), tmp.size());
+        }
+
+        basic_string& assign(std::initializer_list<CharT> il) { return assign(il.begin(), il.size()); }
+
+        allocator_type get_allocator() const { return __alloc(); }
+
+        /** 迭代器 */
+        iterator begin() noexcept { return __get_pointer(); }
+        const_iterator begin() const noexcept { return __get_pointer(); }
+        const_iterator cbegin() const noexcept { return __get_pointer(); }
+        iterator end() noexcept { return __get_pointer() + size(); }
+        const_iterator end() const noexcept { return __get_pointer() + size(); }
+        const_iterator cend() const noexcept { return __get_pointer() + size(); }
+
+        /** 容量 */
+        size_type size() const noexcept { return __is_long() ? impl_.r_.l_.size_ : __tag(); }
+        size_type length() const noexcept { return size(); }
+        size_type capacity() const noexcept { return __is_long() ? __get_long_cap() : __min_cap - 1; }
+        bool empty() const noexcept { return size() == 0; }
+
+        // 容量字的最高位用作标记，另留一个字符给结尾的空字符
+        size_type max_size() const noexcept{
+            const size_type m = alloc_traits::max_size(__alloc());
+            const size_type limit = (~__long::long_flag >> __long::cap_shift) - 1;
+            return m - 1 < limit ? m - 1 : limit;
+        }
+
+        void reserve(size_type n){
+            if (n > max_size())
+                throw std::length_error("basic_string::reserve");
+            if (n > capacity())
+                __reallocate(__recommend(n));
+        }
+
+        // 放得进短缓冲区时搬回对象内部
+        void shrink_to_fit(){
+            if (__is_long() && __recommend(size()) < capacity())
+                __reallocate(__recommend(size()));
+        }
+
+        void resize(size_type n, CharT c){
+            const size_type sz = size();
+            if (n > sz)
+                append(n - sz, c);
+            else
+                __finish(__get_pointer(), n);
+        }
+
+        void resize(size_type n) { resize(n, CharT()); }
+
+        void clear() noexcept { __finish(__get_pointer(), 0); }
+
+        /** 元素访问 */
+        reference operator[](size_type n) { return __get_pointer()[n]; }
+        const_reference operator[](size_type n) const { return __get_pointer()[n]; }
+
+        reference at(size_type n){
+            __range_check(n);
+            return __get_pointer()[n];
+        }
+
+        const_reference at(size_type n) const{
+            __range_check(n);
+            return __get_pointer()[n];
+        }
+
+        reference front() { return *__get_pointer(); }
+        const_reference front() const { return *__get_pointer(); }
+        reference back() { return __get_pointer()[size() - 1]; }
+        const_reference back() const { return __get_pointer()[size() - 1]; }
+
+        CharT* data() noexcept { return __get_pointer(); }
+        const CharT* data() const noexcept { return __get_pointer(); }
+        const CharT* c_str() const noexcept { return __get_pointer(); }
+
+        /** 修改 */
+        void push_back(CharT c){
+            const size_type sz = size();
+            if (sz == capacity())
+                __reallocate(__next_capacity(1));
+            CharT* p = __get_pointer();
+            traits_type::assign(p[sz], c);
+            __finish(p, sz + 1);
+        }
+
+        void pop_back() { __finish(__get_pointer(), size() - 1); }
+
+        basic_string& append(const basic_string& str) { return append(str.data(), str.size()); }
+
+        basic_string& append(const basic_string& str, size_type pos, size_type n = npos){
+            str.__pos_check(pos, "basic_string::append");
+            return append(str.data() + pos, str.__clamp(pos, n));
+        }
+
+        // 容量足够时直接追加；否则先配置新空间再拷贝，s 可以指向自身
+        basic_string& append(const CharT* s, size_type n){
+            const size_type sz = size();
+            if (capacity() - sz >= n){
+                CharT* p = __get_pointer();
+                traits_type::copy(p + sz, s, n);
+                __finish(p, sz + n);
+                return *this;
+            }
+            return __grow_replace(sz, 0, s, n);
+        }
+
+        basic_string& append(const CharT* s) { return append(s, traits_type::length(s)); }
+
+        basic_string& append(size_type n, CharT c){
+            if (n == 0)
+                return *this;
+            const size_type sz = size();
+            if (capacity() - sz < n)
+                __grow_replace(sz, 0, nullptr, 0, n);
+            CharT* p = __get_pointer();
+            traits_type::assign(p + sz, n, c);
+            __finish(p, sz + n);
+            return *this;
+        }
+
+        template<class InputIterator, typename enable_if<
+                is_input_iterator<InputIterator>::value, int>::type = 0>
+        basic_string& append(InputIterator first, InputIterator last){
+            const basic_string tmp(first, last, __alloc());
+            return append(tmp.data(), tmp.size());
+        }
+
+        basic_string& append(std::initializer_list<CharT> il) { return append(il.begin(), il.size()); }
+
+        basic_string& append(__self_view v) { return append(v.data(), v.size()); }
+
+        basic_string& operator+=(const basic_string& str) { return append(str.data(), str.size()); }
+        basic_string& operator+=(const CharT* s) { return append(s); }
+        basic_string& operator+=(CharT c) { push_back(c); return *this; }
+        basic_string& operator+=(std::initializer_list<CharT> il) { return append(il); }
+        basic_string& operator+=(__self_view v) { return append(v.data(), v.size()); }
+
+        basic_string& insert(size_type pos, const basic_string& str){
+            return insert(pos, str.data(), str.size());
+        }
+
+        basic_string& insert(size_type pos, const basic_string& str, size_type pos2, size_type n = npos){
+            str.__pos_check(pos2, "basic_string::insert");
+            return insert(pos, str.data() + pos2, str.__clamp(pos2, n));
+        }
+
+        basic_string& insert(size_type pos, const CharT* s, size_type n){
+            __pos_check(pos, "basic_string::insert");
+            return __replace(pos, 0, s, n);
+        }
+
+        basic_string& insert(size_type pos, const CharT* s) { return insert(pos, s, traits_type::length(s)); }
+
+        basic_string& insert(size_type pos, size_type n, CharT c){
+            __pos_check(pos, "basic_string::insert");
+            return __replace(pos, 0, n, c);
+        }
+
+        iterator insert(const_iterator it, CharT c){
+            const size_type pos = static_cast<size_type>(it - begin());
+            __replace(pos, 0, size_type(1), c);
+            return begin() + pos;
+        }
+
+        iterator insert(const_iterator it, size_type n, CharT c){
+            const size_type pos = static_cast<size_type>(it - begin());
+            __replace(pos, 0, n, c);
+            return begin() + pos;
+        }
+
+        template<class InputIterator, typename enable_if<
+                is_input_iterator<InputIterator>::value, int>::type = 0>
+        iterator insert(const_iterator it, InputIterator first, InputIterator last){
+            const size_type pos = static_cast<size_type>(it - begin());
+            const basic_string tmp(first, last, __alloc());
+            __replace(pos, 0, tmp.data(), tmp.size());
+            return begin() + pos;
+        }
+
+        iterator insert(const_iterator it, std::initializer_list<CharT> il){
+            const size_type pos = static_cast<size_type>(it - begin());
+            __replace(pos, 0, il.begin(), il.size());
+            return begin() + pos;
+        }
+
+        basic_string& erase(size_type pos = 0, size_type n = npos){
+            __pos_check(pos, "basic_string::erase");
+            __erase(pos, __clamp(pos, n));
+            return *this;
+        }
+
+        iterator erase(const_iterator it){
+            const size_type pos = static_cast<size_type>(it - begin());
+            __erase(pos, 1);
+            return begin() + pos;
+        }
+
+        iterator erase(const_iterator first, const_iterator last){
+            const size_type pos = static_cast<size_type>(first - begin());
+            __erase(pos, static_cast<size_type>(last - first));
+            return begin() + pos;
+        }
+
+        basic_string& replace(size_type pos, size_type n1, const basic_string& str){
+            return replace(pos, n1, str.data(), str.size());
+        }
+
+        basic_string& replace(size_type pos, size_type n1, const basic_string& str, size_type pos2, size_type n2 = npos){
+            str.__pos_check(pos2, "basic_string::replace");
+            return replace(pos, n1, str.data() + pos2, str.__clamp(pos2, n2));
+        }
+
+        basic_string& replace(size_type pos, size_type n1, const CharT* s, size_type n2){
+            __pos_check(pos, "basic_string::replace");
+            return __replace(pos, __clamp(pos, n1), s, n2);
+        }
+
+        basic_string& replace(size_type pos, size_type n1, const CharT* s){
+            return replace(pos, n1, s, traits_type::length(s));
+        }
+
+        basic_string& replace(size_type pos, size_type n1, size_type n2, CharT c){
+            __pos_check(pos, "basic_string::replace");
+            return __replace(pos, __clamp(pos, n1), n2, c);
+        }
+
+        basic_string& replace(const_iterator i1, const_iterator i2, const basic_string& str){
+            return __replace(static_cast<size_type>(i1 - begin()), static_cast<size_type>(i2 - i1), str.data(), str.size());
+        }
+
+        basic_string& replace(const_iterator i1, const_iterator i2, const CharT* s, size_type n){
+            return __replace(static_cast<size_type>(i1 - begin()), static_cast<size_type>(i2 - i1), s, n);
+        }
+
+        basic_string& replace(const_iterator i1, const_iterator i2, const CharT* s){
+            return replace(i1, i2, s, traits_type::length(s));
+        }
+
+        basic_string& replace(const_iterator i1, const_iterator i2, size_type n, CharT c){
+            return __replace(static_cast<size_type>(i1 - begin()), static_cast<size_type>(i2 - i1), n, c);
+        }
+
+        template<class InputIterator, typename enable_if<
+                is_input_iterator<InputIterator>::value, int>::type = 0>
+        basic_string& replace(const_iterator i1, const_iterator i2, InputIterator first, InputIterator last){
+            const basic_string tmp(first, last, __alloc());
+            return replace(i1, i2, tmp.data(), tmp.size());
+        }
+
+        basic_string& replace(const_iterator i1, const_iterator i2, std::initializer_list<CharT> il){
+            return replace(i1, i2, il.begin(), il.size());
+        }
+
+        // 将 [pos, pos + n) 拷贝到 s，不追加空字符，返回拷贝的字符数
+        size_type copy(CharT* s, size_type n, size_type pos = 0) const{
+            __pos_check(pos, "basic_string::copy");
+            n = __clamp(pos, n);
+            traits_type::copy(s, data() + pos, n);
+            return n;
+        }
+
+        basic_string substr(size_type pos = 0, size_type n = npos) const{
+            return basic_string(*this, pos, n);
+        }
+
+        void swap(basic_string& other) noexcept{
+            __swap_alloc(other, typename alloc_traits::propagate_on_container_swap());
+            simple_stl::swap(impl_.r_, other.impl_.r_);
+        }
+
+        /** 查找 */
+        size_type find(const basic_string& str, size_type pos = 0) const noexcept{
+            return simple_stl::__str_find<Traits>(data(), size(), str.data(), pos, str.size());
+        }
+
+        size_type find(const CharT* s, size_type pos, size_type n) const noexcept{
+            return simple_stl::__str_find<Traits>(data(), size(), s, pos, n);
+        }
+
+        size_type find(const CharT* s, size_type pos = 0) const noexcept{
+            return simple_stl::__str_find<Traits>(data(), size(), s, pos, traits_type::length(s));
+        }
+
+        size_type find(CharT c, size_type pos = 0) const noexcept{
+            return simple_stl::__str_find<Traits>(data(), size(), c, pos);
+        }
+
+        size_type rfind(const basic_string& str, size_type pos = npos) const noexcept{
+            return simple_stl::__str_rfind<Traits>(data(), size(), str.data(), pos, str.size());
+        }
+
+        size_type rfind(const CharT* s, size_type pos, size_type n) const noexcept{
+            return simple_stl::__str_rfind<Traits>(data(), size(), s, pos, n);
+        }
+
+        size_type rfind(const CharT* s, size_type pos = npos) const noexcept{
+            return simple_stl::__str_rfind<Traits>(data(), size(), s, pos, traits_type::length(s));
+        }
+
+        size_type rfind(CharT c, size_type pos = npos) const noexcept{
+            return simple_stl::__str_rfind<Traits>(data(), size(), c, pos);
+        }
+
+        size_type find_first_of(const basic_string& str, size_type pos = 0) const noexcept{
+            return simple_stl::__str_find_first_of<Traits>(data(), size(), str.data(), pos, str.size());
+        }
+
+        size_type find_first_of(const CharT* s, size_type pos, size_type n) const noexcept{
+            return simple_stl::__str_find_first_of<Traits>(data(), size(), s, pos, n);
+        }
+
+        size_type find_first_of(const CharT* s, size_type pos = 0) const noexcept{
+            return simple_stl::__str_find_first_of<Traits>(data(), size(), s, pos, traits_type::length(s));
+        }
+
+        size_type find_first_of(CharT c, size_type pos = 0) const noexcept { return find(c, pos); }
+
+        size_type find_last_of(const basic_string& str, size_type pos = npos) const noexcept{
+            return simple_stl::__str_find_last_of<Traits>(data(), size(), str.data(), pos, str.size());
+        }
+
+        size_type find_last_of(const CharT* s, size_type pos, size_type n) const noexcept{
+            return simple_stl::__str_find_last_of<Traits>(data(), size(), s, pos, n);
+        }
+
+        size_type find_last_of(const CharT* s, size_type pos = npos) const noexcept{
+            return simple_stl::__str_find_last_of<Traits>(data(), size(), s, pos, traits_type::length(s));
+        }
+
+        size_type find_last_of(CharT c, size_type pos = npos) const noexcept { return rfind(c, pos); }
+
+        size_type find_first_not_of(const basic_string& str, size_type pos = 0) const noexcept{
+            return simple_stl::__str_find_first_not_of<Traits>(data(), size(), str.data(), pos, str.size());
+        }
+
+        size_type find_first_not_of(const CharT* s, size_type pos, size_type n) const noexcept{
+            return simple_stl::__str_find_first_not_of<Traits>(data(), size(), s, pos, n);
+        }
+
+        size_type find_first_not_of(const CharT* s, size_type pos = 0) const noexcept{
+            return simple_stl::__str_find_first_not_of<Traits>(data(), size(), s, pos, traits_type::length(s));
+        }
+
+        size_type find_first_not_of(CharT c, size_type pos = 0) const noexcept{
+            return simple_stl::__str_find_first_not_of<Traits>(data(), size(), &c, pos, 1);
+        }
+
+        size_type find_last_not_of(const basic_string& str, size_type pos = npos) const noexcept{
+            return simple_stl::__str_find_last_not_of<Traits>(data(), size(), str.data(), pos, str.size());
+        }
+
+        size_type find_last_not_of(const CharT* s, size_type pos, size_type n) const noexcept{
+            return simple_stl::__str_find_last_not_of<Traits>(data(), size(), s, pos, n);
+        }
+
+        size_type find_last_not_of(const CharT* s, size_type pos = npos) const noexcept{
+            return simple_stl::__str_find_last_not_of<Traits>(data(), size(), s, pos, traits_type::length(s));
+        }
+
+        size_type find_last_not_of(CharT c, size_type pos = npos) const noexcept{
+            return simple_stl::__str_find_last_not_of<Traits>(data(), size(), &c, pos, 1);
+        }
+
+        /** 比较 */
+        int compare(const basic_string& str) const noexcept{
+            return simple_stl::__str_compare<Traits>(data(), size(), str.data(), str.size());
+        }
+
+        int compare(size_type pos, size_type n1, const basic_string& str) const{
+            return compare(pos, n1, str.data(), str.size());
+        }
+
+        int compare(size_type pos, size_type n1, const basic_string& str, size_type pos2, size_type n2 = npos) const{
+            str.__pos_check(pos2, "basic_string::compare");
+            return compare(pos, n1, str.data() + pos2, str.__clamp(pos2, n2));
+        }
+
+        int compare(__self_view v) const noexcept{
+            return simple_stl::__str_compare<Traits>(data(), size(), v.data(), v.size());
+        }
+
+        int compare(const CharT* s) const noexcept{
+            return simple_stl::__str_compare<Traits>(data(), size(), s, traits_type::length(s));
+        }
+
+        int compare(size_type pos, size_type n1, const CharT* s) const{
+            return compare(pos, n1, s, traits_type::length(s));
+        }
+
+        int compare(size_type pos, size_type n1, const CharT* s, size_type n2) const{
+            __pos_check(pos, "basic_string::compare");
+            return simple_stl::__str_compare<Traits>(data() + pos, __clamp(pos, n1), s, n2);
+        }
+
+    private:
+        void __range_check(size_type n) const{
+            if (n >= size())
+                throw std::out_of_range("basic_string::at");
+        }
+
+        void __pos_check(size_type pos, const char* what) const{
+            if (pos > size())
+                throw std::out_of_range(what);
+        }
+
+        // [pos, pos + n) 超出末尾时截到末尾
+        size_type __clamp(size_type pos, size_type n) const noexcept{
+            const size_type rest = size() - pos;
+            return n < rest ? n : rest;
+        }
+
+        // 设置长度并补上结尾的空字符
+        void __finish(CharT* p, size_type n) noexcept{
+            __set_size(n);
+            traits_type::assign(p[n], CharT());
+        }
+
+        void __init(const CharT* s, size_type n){
+            CharT* p = __init_n(n);
+            traits_type::copy(p, s, n);
+            __finish(p, n);
+        }
+
+        void __init(size_type n, CharT c){
+            CharT* p = __init_n(n);
+            traits_type::assign(p, n, c);
+            __finish(p, n);
+        }
+
+        // 为 n 个字符准备空间：短字符串用对象内部的缓冲区
+        CharT* __init_n(size_type n){
+            if (n > max_size())
+                throw std::length_error("basic_string");
+            if (n < __min_cap)
+                return impl_.r_.s_;
+            const size_type cap = __recommend(n);
+            CharT* p = __allocate(cap);
+            __set_long(p, 0, cap);
+            return p;
+        }
+
+        void __init_copy(const basic_string& other){
+            if (!other.__is_long())
+                impl_.r_ = other.impl_.r_;
+            else
+                __init(other.data(), other.size());
+        }
+
+        // input_iterator_tag版，只能逐一追加
+        template<class InputIterator>
+        void __range_init(InputIterator first, InputIterator last, input_iterator_tag){
+            try {
+                for ( ; first != last; ++first)
+                    push_back(*first);
+            }catch(...){
+                __deallocate_long();
+                throw;
+            }
+        }
+
+        // forward_iterator_tag版，先求出长度，只配置一次
+        template<class ForwardIterator>
+        void __range_init(ForwardIterator first, ForwardIterator last, forward_iterator_tag){
+            const size_type n = static_cast<size_type>(simple_stl::distance(first, last));
+            CharT* p = __init_n(n);
+            for (CharT* cur = p; first != last; ++first, ++cur)
+                traits_type::assign(*cur, *first);
+            __finish(p, n);
+        }
+
+        size_type __next_capacity(size_type extra) const{
+            const size_type max = max_size();
+            const size_type sz = size();
+            if (max - sz < extra)
+                throw std::length_error("basic_string");
+            const size_type cap = capacity();
+            const size_type grown = cap < max / 2 ? cap * 2 : max;
+            return __recommend(grown < sz + extra ? sz + extra : grown);
+        }
+
+        // 换到容量为 cap 的空间，cap 放得进短缓冲区时换回短字符串
+        void __reallocate(size_type cap){
+            const size_type sz = size();
+            CharT* old = __get_pointer();
+            const bool was_long = __is_long();
+            const size_type old_cap = capacity();
+            if (cap < __min_cap){
+                CharT tmp[__min_cap];
+                traits_type::copy(tmp, old, sz + 1);
+                alloc_traits::deallocate(__alloc(), old, old_cap + 1);
+                impl_.__zero();
+                traits_type::copy(impl_.r_.s_, tmp, sz + 1);
+                __set_short_size(sz);
+                return;
+            }
+            CharT* p = __allocate(cap);
+            traits_type::copy(p, old, sz + 1);
+            if (was_long)
+                alloc_traits::deallocate(__alloc(), old, old_cap + 1);
+            __set_long(p, sz, cap);
+        }
+
+        // 容量不足时的替换：在新空间中依次拼出 [0, pos)、s 的 n2 个字符（s 为空时留出 n2 + fill 个位置）、
+        // 原有的 [pos + n1, size())，再释放旧空间，因此 s 可以指向自身
+        basic_string& __grow_replace(size_type pos, size_type n1, const CharT* s, size_type n2, size_type fill = 0){
+            const size_type sz = size();
+            const size_type add = n2 + fill;
+            if (max_size() - (sz - n1) < add)
+                throw std::length_error("basic_string");
+            const size_type new_sz = sz - n1 + add;
+            const size_type cap = capacity();
+            const size_type grown = cap < max_size() / 2 ? cap * 2 : max_size();
+            const size_type new_cap = __recommend(grown < new_sz ? new_sz : grown);
+            CharT* old = __get_pointer();
+            CharT* p = __allocate(new_cap);
+            traits_type::copy(p, old, pos);
+            if (s != nullptr)
+                traits_type::copy(p + pos, s, n2);
+            traits_type::copy(p + pos + add, old + pos + n1, sz - pos - n1);
+            __deallocate_long();
+            __set_long(p, new_sz, new_cap);
+            traits_type::assign(p[new_sz], CharT());
+            return *this;
+        }
+
+        // 将 [pos, pos + n1) 替换为 [s, s + n2)，s 可以指向自身
+        basic_string& __replace(size_type pos, size_type n1, const CharT* s, size_type n2){
+            const size_type sz = size();
+            if (capacity() - (sz - n1) < n2)
+                return __grow_replace(pos, n1, s, n2);
+            CharT* p = __get_pointer();
+            const size_type new_sz = sz - n1 + n2;
+            const size_type tail = sz - pos - n1;
+            if (n1 != n2 && tail != 0){
+                if (n1 > n2){
+                    // 先写入再左移尾部，s 位于尾部时尚未被覆盖
+                    traits_type::move(p + pos, s, n2);
+                    traits_type::move(p + pos + n2, p + pos + n1, tail);
+                    __finish(p, new_sz);
+                    return *this;
+                }
+                // 尾部右移，s 落在移动的部分时随之后移；横跨被替换区间时先写入未移动的前半段
+                if (p + pos < s && s < p + sz){
+                    if (p + pos + n1 <= s){
+                        s += n2 - n1;
+                    }else{
+                        traits_type::move(p + pos, s, n1);
+                        pos += n1;
+                        s += n2;
+                        n2 -= n1;
+                        n1 = 0;
+                    }
+                }
+                traits_type::move(p + pos + n2, p + pos + n1, tail);
+            }
+            traits_type::move(p + pos, s, n2);
+            __finish(p, new_sz);
+            return *this;
+        }
+
+        basic_string& __replace(size_type pos, size_type n1, size_type n2, CharT c){
+            const size_type sz = size();
+            if (capacity() - (sz - n1) < n2)
+                __grow_replace(pos, n1, nullptr, 0, n2);
+            else if (n1 != n2)
+                traits_type::move(__get_pointer() + pos + n2, __get_pointer() + pos + n1, sz - pos - n1);
+            CharT* p = __get_pointer();
+            traits_type::assign(p + pos, n2, c);
+            __finish(p, sz - n1 + n2);
+            return *this;
+        }
+
+        void __erase(size_type pos, size_type n) noexcept{
+            if (n == 0)
+                return;
+            const size_type sz = size();
+            CharT* p = __get_pointer();
+            traits_type::move(p + pos, p + pos + n, sz - pos - n);
+            __finish(p, sz - n);
+        }
+
+        void __copy_assign_alloc(const basic_string& other, __true_type_s){
+            if (__alloc() != other.__alloc()){
+                __deallocate_long();
+                impl_.__zero();
+            }
+            __alloc() = other.__alloc();
+        }
+
+        void __copy_assign_alloc(const basic_string&, __false_type_s) {}
+
+        // 可以接管对方的内存
+        void __move_assign(basic_string& other, __true_type_s){
+            __deallocate_long();
+            __move_assign_alloc(other, typename alloc_traits::propagate_on_container_move_assignment());
+            impl_.r_ = other.impl_.r_;
+            other.impl_.__zero();
+        }
+
+        // 配置器不传播，相等时接管内存，否则拷贝字符
+        void __move_assign(basic_string& other, __false_type_s){
+            if (__alloc() == other.__alloc())
+                __move_assign(other, __true_type_s());
+            else
+                assign(other.data(), other.size());
+        }
+
+        void __move_assign_alloc(basic_string& other, __true_type_s){
+            __alloc() = simple_stl::move(other.__alloc());
+        }
+
+        void __move_assign_alloc(basic_string&, __false_type_s) {}
+
+        void __swap_alloc(basic_string& other, __true_type_s){
+            simple_stl::swap(__alloc(), other.__alloc());
+        }
+
+        void __swap_alloc(basic_string&, __false_type_s) {}
+    };
+
+    template<class CharT, class Traits, class Alloc>
+    const typename basic_string<CharT, Traits, Alloc>::size_type basic_string<CharT, Traits, Alloc>::npos;
+
+    typedef basic_string<char>      string;
+    typedef basic_string<wchar_t>   wstring;
+    typedef basic_string<char16_t>  u16string;
+    typedef basic_string<char32_t>  u32string;
+
+    static_assert(sizeof(string) == 3 * sizeof(void*), "string should occupy three words");
+
+    /** 拼接 */
+    template<class CharT, class Traits, class Alloc>
+    inline basic_string<CharT, Traits, Alloc>
+    operator+(const basic_string<CharT, Traits, Alloc>& x, const basic_string<CharT, Traits, Alloc>& y){
+        basic_string<CharT, Traits, Alloc> r(x.get_allocator());
+        r.reserve(x.size() + y.size());
+        r.append(x.data(), x.size());
+        r.append(y.data(), y.size());
+        return r;
+    }
+
+    template<class CharT, class Traits, class Alloc>
+    inline basic_string<CharT, Traits, Alloc>
+    operator+(const CharT* x, const basic_string<CharT, Traits, Alloc>& y){
+        const size_t n = Traits::length(x);
+        basic_string<CharT, Traits, Alloc> r(y.get_allocator());
+        r.reserve(n + y.size());
+        r.append(x, n);
+        r.append(y.data(), y.size());
+        return r;
+    }
+
+    template<class CharT, class Traits, class Alloc>
+    inline basic_string<CharT, Traits, Alloc>
+    operator+(CharT x, const basic_string<CharT, Traits, Alloc>& y){
+        basic_string<CharT, Traits, Alloc> r(y.get_allocator());
+        r.reserve(1 + y.size());
+        r.push_back(x);
+        r.append(y.data(), y.size());
+        return r;
+    }
+
+    template<class CharT, class Traits, class Alloc>
+    inline basic_string<CharT, Traits, Alloc>
+    operator+(const basic_string<CharT, Traits, Alloc>& x, const CharT* y){
+        const size_t n = Traits::length(y);
+        basic_string<CharT, Traits, Alloc> r(x.get_allocator());
+        r.reserve(x.size() + n);
+        r.append(x.data(), x.size());
+        r.append(y, n);
+        return r;
+    }
+
+    template<class CharT, class Traits, class Alloc>
+    inline basic_string<CharT, Traits, Alloc>
+    operator+(const basic_string<CharT, Traits, Alloc>& x, CharT y){
+        basic_string<CharT, Traits, Alloc> r(x.get_allocator());
+        r.reserve(x.size() + 1);
+        r.append(x.data(), x.size());
+        r.push_back(y);
+        return r;
+    }
+
+    // 左操作数为右值时在其上追加，沿用它的空间
+    template<class CharT, class Traits, class Alloc>
+    inline basic_string<CharT, Traits, Alloc>
+    operator+(basic_string<CharT, Traits, Alloc>&& x, const basic_string<CharT, Traits, Alloc>& y){
+        return simple_stl::move(x.append(y));
+    }
+
+    template<class CharT, class Traits, class Alloc>
+    inline basic_string<CharT, Traits, Alloc>
+    operator+(const basic_string<CharT, Traits, Alloc>& x, basic_string<CharT, Traits, Alloc>&& y){
+        return simple_stl::move(y.insert(0, x));
+    }
+
+    template<class CharT, class Traits, class Alloc>
+    inline basic_string<CharT, Traits, Alloc>
+    operator+(basic_string<CharT, Traits, Alloc>&& x, basic_string<CharT, Traits, Alloc>&& y){
+        return simple_stl::move(x.append(y));
+    }
+
+    template<class CharT, class Traits, class Alloc>
+    inline basic_string<CharT, Traits, Alloc>
+    operator+(basic_string<CharT, Traits, Alloc>&& x, const CharT* y){
+        return simple_stl::move(x.append(y));
+    }
+
+    template<class CharT, class Traits, class Alloc>
+    inline basic_string<CharT, Traits, Alloc>
+    operator+(basic_string<CharT, Traits, Alloc>&& x, CharT y){
+        x.push_back(y);
+        return simple_stl::move(x);
+    }
+
+    template<class CharT, class Traits, class Alloc>
+    inline basic_string<CharT, Traits, Alloc>
+    operator+(const CharT* x, basic_string<CharT, Traits, Alloc>&& y){
+        return simple_stl::move(y.insert(0, x));
+    }
+
+    template<class CharT, class Traits, class Alloc>
+    inline basic_string<CharT, Traits, Alloc>
+    operator+(CharT x, basic_string<CharT, Traits, Alloc>&& y){
+        y.insert(y.begin(), x);
+        return simple_stl::move(y);
+    }
+
+    /** 比较 */
+    template<class CharT, class Traits, class Alloc>
+    inline bool operator==(const basic_string<CharT, Traits, Alloc>& x, const basic_string<CharT, Traits, Alloc>& y) noexcept{
+        return x.size() == y.size() && Traits::compare(x.data(), y.data(), x.size()) == 0;
+    }
+
+    template<class CharT, class Traits, class Alloc>
+    inline bool operator==(const basic_string<CharT, Traits, Alloc>& x, const CharT* y) noexcept{
+        return x.compare(y) == 0;
+    }
+
+    template<class CharT, class Traits, class Alloc>
+    inline bool operator==(const CharT* x, const basic_string<CharT, Traits, Alloc>& y) noexcept{
+        return y.compare(x) == 0;
+    }
+
+    template<class CharT, class Traits, class Alloc>
+    inline bool operator!=(const basic_string<CharT, Traits, Alloc>& x, const basic_string<CharT, Traits, Alloc>& y) noexcept{
+        return !(x == y);
+    }
+
+    template<class CharT, class Traits, class Alloc>
+    inline bool operator!=(const basic_string<CharT, Traits, Alloc>& x, const CharT* y) noexcept{
+        return !(x == y);
+    }
+
+    template<class CharT, class Traits, class Alloc>
+    inline bool operator!=(const CharT* x, const basic_string<CharT, Traits, Alloc>& y) noexcept{
+        return !(x == y);
+    }
+
+    template<class CharT, class Traits, class Alloc>
+    inline bool operator<(const basic_string<CharT, Traits, Alloc>& x, const basic_string<CharT, Traits, Alloc>& y) noexcept{
+        return x.compare(y) < 0;
+    }
+
+    template<class CharT, class Traits, class Alloc>
+    inline bool operator<(const basic_string<CharT, Traits, Alloc>& x, const CharT* y) noexcept{
+        return x.compare(y) < 0;
+    }
+
+    template<class CharT, class Traits, class Alloc>
+    inline bool operator<(const CharT* x, const basic_string<CharT, Traits, Alloc>& y) noexcept{
+        return y.compare(x) > 0;
+    }
+
+    template<class CharT, class Traits, class Alloc>
+    inline bool operator>(const basic_string<CharT, Traits, Alloc>& x, const basic_string<CharT, Traits, Alloc>& y) noexcept{
+        return y < x;
+    }
+
+    template<class CharT, class Traits, class Alloc>
+    inline bool operator>(const basic_string<CharT, Traits, Alloc>& x, const CharT* y) noexcept{
+        return y < x;
+    }
+
+    template<class CharT, class Traits, class Alloc>
+    inline bool operator>(const CharT* x, const basic_string<CharT, Traits, Alloc>& y) noexcept{
+        return y < x;
+    }
+
+    template<class CharT, class Traits, class Alloc>
+    inline bool operator<=(const basic_string<CharT, Traits, Alloc>& x, const basic_string<CharT, Traits, Alloc>& y) noexcept{
+        return !(y < x);
+    }
+
+    template<class CharT, class Traits, class Alloc>
+    inline bool operator<=(const basic_string<CharT, Traits, Alloc>& x, const CharT* y) noexcept{
+        return !(y < x);
+    }
+
+    template<class CharT, class Traits, class Alloc>
+    inline bool operator<=(const CharT* x, const basic_string<CharT, Traits, Alloc>& y) noexcept{
+        return !(y < x);
+    }
+
+    template<class CharT, class Traits, class Alloc>
+    inline bool operator>=(const basic_string<CharT, Traits, Alloc>& x, const basic_string<CharT, Traits, Alloc>& y) noexcept{
+        return !(x < y);
+    }
+
+    template<class CharT, class Traits, class Alloc>
+    inline bool operator>=(const basic_string<CharT, Traits, Alloc>& x, const CharT* y) noexcept{
+        return !(x < y);
+    }
+
+    template<class CharT, class Traits, class Alloc>
+    inline bool operator>=(const CharT* x, const basic_string<CharT, Traits, Alloc>& y) noexcept{
+        return !(x < y);
+    }
+
+    template<class CharT, class Traits, class Alloc>
+    inline void swap(basic_string<CharT, Traits, Alloc>& x, basic_string<CharT, Traits, Alloc>& y) noexcept{
+        x.swap(y);
+    }
+
+    // 只为默认的 char_traits 提供，与 basic_string_view 的 hash 一致
+    template<class CharT, class Alloc>
+    struct hash<basic_string<CharT, char_traits<CharT>, Alloc> >{
+        typedef basic_string<CharT, char_traits<CharT>, Alloc>  argument_type;
+        typedef size_t                                          result_type;
+        typedef void                                            is_avalanching;
+        size_t operator()(const argument_type& s) const noexcept{
+            return static_cast<size_t>(simple_stl::__hash_bytes(s.data(), s.size() * sizeof(CharT)));
+        }
+    };
+
+    // 按字符原样写出，不经过 std::char_traits
+    template<class CharT, class Traits, class Alloc>
+    inline std::basic_ostream<CharT>& operator<<(std::basic_ostream<CharT>& os,
+                                                 const basic_string<CharT, Traits, Alloc>& str){
+        return os.write(str.data(), static_cast<std::streamsize>(str.size()));
+    }
+
+}   // simple_stl
+
+#endif //SIMPLESTL_STL_BASIC_STRING_H
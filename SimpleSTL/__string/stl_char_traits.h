@@ -0,0 +1,300 @@
+/**
+ * Created by 史进 on 2023/6/24.
+ *
+ * char_traits：字符类型的基本操作，供 basic_string 使用
+ *  - 字符都是平凡类型，批量的 copy、move、assign 按字节处理（memcpy、memmove、memset）
+ *  - char 的 compare、length、find 交给 memcmp、strlen、memchr；其它字符类型逐个处理
+ *
+ * 另有 basic_string 与 string_view 共用的查找函数 __str_find 等：
+ * 使用 char_traits<CharT> 且字符为标量类型时换成 stl_simd.h 的内核（单字节字符的 find_first_of 同样），
+ * 子串查找先用内核找首字符，再比较其余部分；char 的正向查找字符仍用 memchr，C 库的实现不比内核慢
+ */
+#ifndef SIMPLESTL_STL_CHAR_TRAITS_H
+#define SIMPLESTL_STL_CHAR_TRAITS_H
+
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+#include "../__algorithm/stl_simd.h"
+#include "../type_traits.h"
+
+namespace simple_stl{
+
+    template<class CharT>
+    struct char_traits{
+        typedef CharT               char_type;
+        typedef unsigned long long  int_type;
+
+        static void assign(char_type& r, const char_type& a) noexcept { r = a; }
+        static bool eq(char_type a, char_type b) noexcept { return a == b; }
+        static bool lt(char_type a, char_type b) noexcept { return a < b; }
+
+        static int compare(const char_type* s1, const char_type* s2, size_t n) noexcept{
+            for ( ; n > 0; --n, ++s1, ++s2){
+                if (lt(*s1, *s2))
+                    return -1;
+                if (lt(*s2, *s1))
+                    return 1;
+            }
+            return 0;
+        }
+
+        static size_t length(const char_type* s) noexcept{
+            size_t n = 0;
+            for ( ; !eq(s[n], char_type()); ++n) {}
+            return n;
+        }
+
+        static const char_type* find(const char_type* s, size_t n, const char_type& a) noexcept{
+            for ( ; n > 0; --n, ++s)
+                if (eq(*s, a))
+                    return s;
+            return nullptr;
+        }
+
+        // 区间可以重叠
+        static char_type* move(char_type* s1, const char_type* s2, size_t n) noexcept{
+            if (n > 0)
+                std::memmove(s1, s2, n * sizeof(char_type));
+            return s1;
+        }
+
+        static char_type* copy(char_type* s1, const char_type* s2, size_t n) noexcept{
+            if (n > 0)
+                std::memcpy(s1, s2, n * sizeof(char_type));
+            return s1;
+        }
+
+        static char_type* assign(char_type* s, size_t n, char_type a) noexcept{
+            for (size_t i = 0; i < n; ++i)
+                s[i] = a;
+            return s;
+        }
+
+        // 先换成同宽的无符号数，负值字符不会与 eof() 相同
+        static int_type to_int_type(char_type c) noexcept{
+            return static_cast<int_type>(static_cast<typename std::make_unsigned<char_type>::type>(c));
+        }
+        static char_type to_char_type(int_type i) noexcept { return static_cast<char_type>(i); }
+        static bool eq_int_type(int_type a, int_type b) noexcept { return a == b; }
+        static int_type eof() noexcept { return static_cast<int_type>(-1); }
+        static int_type not_eof(int_type i) noexcept { return i == eof() ? 0 : i; }
+    };
+
+    template<>
+    struct char_traits<char>{
+        typedef char    char_type;
+        typedef int     int_type;
+
+        static void assign(char_type& r, const char_type& a) noexcept { r = a; }
+        static bool eq(char_type a, char_type b) noexcept { return a == b; }
+        // 与 memcmp 一致，按无符号数比较
+        static bool lt(char_type a, char_type b) noexcept{
+            return static_cast<unsigned char>(a) < static_cast<unsigned char>(b);
+        }
+
+        static int compare(const char_type* s1, const char_type* s2, size_t n) noexcept{
+            return n == 0 ? 0 : std::memcmp(s1, s2, n);
+        }
+
+        static size_t length(const char_type* s) noexcept { return std::strlen(s); }
+
+        static const char_type* find(const char_type* s, size_t n, const char_type& a) noexcept{
+            return n == 0 ? nullptr : static_cast<const char_type*>(std::memchr(s, a, n));
+        }
+
+        static char_type* move(char_type* s1, const char_type* s2, size_t n) noexcept{
+            if (n > 0)
+                std::memmove(s1, s2, n);
+            return s1;
+        }
+
+        static char_type* copy(char_type* s1, const char_type* s2, size_t n) noexcept{
+            if (n > 0)
+                std::memcpy(s1, s2, n);
+            return s1;
+        }
+
+        static char_type* assign(char_type* s, size_t n, char_type a) noexcept{
+            if (n > 0)
+                std::memset(s, a, n);
+            return s;
+        }
+
+        static int_type to_int_type(char_type c) noexcept { return static_cast<unsigned char>(c); }
+        static char_type to_char_type(int_type i) noexcept { return static_cast<char_type>(i); }
+        static bool eq_int_type(int_type a, int_type b) noexcept { return a == b; }
+        static int_type eof() noexcept { return -1; }
+        static int_type not_eof(int_type i) noexcept { return i == eof() ? 0 : i; }
+    };
+
+    /** 字符串查找，p 为长度 sz 的字符串，找不到时返回 npos */
+    static const size_t __str_npos = static_cast<size_t>(-1);
+
+    // 以默认的 char_traits 比较标量字符时，Traits::eq 就是 ==，可以使用 SIMD 内核
+    template<class CharT, class Traits>
+    struct __str_simd
+            : bool_constant_s<std::is_same<Traits, char_traits<CharT> >::value && __simd_scalar<CharT>::value> {};
+
+    template<class CharT, class Traits>
+    struct __str_simd_find
+            : bool_constant_s<__str_simd<CharT, Traits>::value && !std::is_same<CharT, char>::value> {};
+
+    template<class CharT, class Traits>
+    struct __str_simd_set
+            : bool_constant_s<__str_simd<CharT, Traits>::value && sizeof(CharT) == 1> {};
+
+    // [first, last) 中第一个等于 c 的字符
+    template<class Traits, class CharT>
+    inline const CharT* __str_find_char_aux(const CharT* first, const CharT* last, CharT c, __true_type_s){
+        return simple_stl::__simd_find(first, last, c, true);
+    }
+
+    template<class Traits, class CharT>
+    inline const CharT* __str_find_char_aux(const CharT* first, const CharT* last, CharT c, __false_type_s){
+        const CharT* r = Traits::find(first, static_cast<size_t>(last - first), c);
+        return r == nullptr ? last : r;
+    }
+
+    template<class Traits, class CharT>
+    inline const CharT* __str_find_char(const CharT* first, const CharT* last, CharT c){
+        return simple_stl::__str_find_char_aux<Traits>(first, last, c, __str_simd_find<CharT, Traits>());
+    }
+
+    template<class Traits, class CharT>
+    inline size_t __str_find(const CharT* p, size_t sz, CharT c, size_t pos) noexcept{
+        if (pos >= sz)
+            return __str_npos;
+        const CharT* r = simple_stl::__str_find_char<Traits>(p + pos, p + sz, c);
+        return r == p + sz ? __str_npos : static_cast<size_t>(r - p);
+    }
+
+    template<class Traits, class CharT>
+    inline size_t __str_find(const CharT* p, size_t sz, const CharT* s, size_t pos, size_t n) noexcept{
+        if (pos > sz || sz - pos < n)
+            return __str_npos;
+        if (n == 0)
+            return pos;
+        // 首字符只能出现在 [p + pos, last) 内
+        const CharT* const last = p + sz - n + 1;
+        for (const CharT* cur = p + pos; ; ++cur){
+            cur = simple_stl::__str_find_char<Traits>(cur, last, s[0]);
+            if (cur == last)
+                return __str_npos;
+            if (Traits::compare(cur + 1, s + 1, n - 1) == 0)
+                return static_cast<size_t>(cur - p);
+        }
+    }
+
+    // [first, last) 中最后一个等于 c 的字符
+    template<class Traits, class CharT>
+    inline const CharT* __str_rfind_char_aux(const CharT* first, const CharT* last, CharT c, __true_type_s){
+        return simple_stl::__simd_rfind(first, last, c);
+    }
+
+    template<class Traits, class CharT>
+    inline const CharT* __str_rfind_char_aux(const CharT* first, const CharT* last, CharT c, __false_type_s){
+        for (const CharT* cur = last; cur != first; )
+            if (Traits::eq(*--cur, c))
+                return cur;
+        return last;
+    }
+
+    template<class Traits, class CharT>
+    inline const CharT* __str_rfind_char(const CharT* first, const CharT* last, CharT c){
+        return simple_stl::__str_rfind_char_aux<Traits>(first, last, c, __str_simd<CharT, Traits>());
+    }
+
+    template<class Traits, class CharT>
+    inline size_t __str_rfind(const CharT* p, size_t sz, CharT c, size_t pos) noexcept{
+        if (sz == 0)
+            return __str_npos;
+        const CharT* const last = p + (pos < sz ? pos + 1 : sz);
+        const CharT* r = simple_stl::__str_rfind_char<Traits>(p, last, c);
+        return r == last ? __str_npos : static_cast<size_t>(r - p);
+    }
+
+    template<class Traits, class CharT>
+    inline size_t __str_rfind(const CharT* p, size_t sz, const CharT* s, size_t pos, size_t n) noexcept{
+        if (n > sz)
+            return __str_npos;
+        if (pos > sz - n)
+            pos = sz - n;
+        if (n == 0)
+            return pos;
+        // 首字符只能出现在 [p, last) 内，从后往前找
+        for (const CharT* last = p + pos + 1; last != p; ){
+            const CharT* cur = simple_stl::__str_rfind_char<Traits>(p, last, s[0]);
+            if (cur == last)
+                return __str_npos;
+            if (Traits::compare(cur + 1, s + 1, n - 1) == 0)
+                return static_cast<size_t>(cur - p);
+            last = cur;
+        }
+        return __str_npos;
+    }
+
+    // [first, last) 中第一个属于（equal 为 true）或不属于字符集合 [s, s + n) 的字符
+    template<class Traits, class CharT>
+    inline const CharT* __str_find_of_aux(const CharT* first, const CharT* last, const CharT* s, size_t n,
+                                          bool equal, __true_type_s){
+        return simple_stl::__simd_find_of(first, last, s, n, equal);
+    }
+
+    template<class Traits, class CharT>
+    inline const CharT* __str_find_of_aux(const CharT* first, const CharT* last, const CharT* s, size_t n,
+                                          bool equal, __false_type_s){
+        for ( ; first != last; ++first)
+            if ((Traits::find(s, n, *first) != nullptr) == equal)
+                return first;
+        return last;
+    }
+
+    template<class Traits, class CharT>
+    inline size_t __str_find_first_of(const CharT* p, size_t sz, const CharT* s, size_t pos, size_t n) noexcept{
+        if (pos >= sz || n == 0)
+            return __str_npos;
+        const CharT* r = simple_stl::__str_find_of_aux<Traits>(p + pos, p + sz, s, n, true, __str_simd_set<CharT, Traits>());
+        return r == p + sz ? __str_npos : static_cast<size_t>(r - p);
+    }
+
+    template<class Traits, class CharT>
+    inline size_t __str_find_first_not_of(const CharT* p, size_t sz, const CharT* s, size_t pos, size_t n) noexcept{
+        if (pos >= sz)
+            return __str_npos;
+        const CharT* r = simple_stl::__str_find_of_aux<Traits>(p + pos, p + sz, s, n, false, __str_simd_set<CharT, Traits>());
+        return r == p + sz ? __str_npos : static_cast<size_t>(r - p);
+    }
+
+    // 反向的集合查找较少使用，逐个字符在集合中查找
+    template<class Traits, class CharT>
+    inline size_t __str_find_last_of(const CharT* p, size_t sz, const CharT* s, size_t pos, size_t n) noexcept{
+        if (n == 0)
+            return __str_npos;
+        for (size_t i = pos < sz ? pos + 1 : sz; i > 0; )
+            if (Traits::find(s, n, p[--i]) != nullptr)
+                return i;
+        return __str_npos;
+    }
+
+    template<class Traits, class CharT>
+    inline size_t __str_find_last_not_of(const CharT* p, size_t sz, const CharT* s, size_t pos, size_t n) noexcept{
+        for (size_t i = pos < sz ? pos + 1 : sz; i > 0; )
+            if (Traits::find(s, n, p[--i]) == nullptr)
+                return i;
+        return __str_npos;
+    }
+
+    // 按字典序比较，相同前缀时短者为小
+    template<class Traits, class CharT>
+    inline int __str_compare(const CharT* s1, size_t n1, const CharT* s2, size_t n2) noexcept{
+        const int r = Traits::compare(s1, s2, n1 < n2 ? n1 : n2);
+        if (r != 0)
+            return r;
+        return n1 < n2 ? -1 : (n1 > n2 ? 1 : 0);
+    }
+
+}   // simple_stl
+
+#endif //SIMPLESTL_STL_CHAR_TRAITS_H
@@ -0,0 +1,392 @@
+/**
+ * Created by 史进 on 2023/6/24.
+ *
+ * basic_string_view：只读的字符序列视图，只保存指针与长度，不拥有内存，也不要求以空字符结尾
+ *  - 查找、比较与 basic_string 共用 stl_char_traits.h 中的 __str_find 等函数
+ *  - hash 与 basic_string 相同（__hash_bytes），内容相同的 string 与 string_view 哈希值相等
+ */
+#ifndef SIMPLESTL_STL_STRING_VIEW_H
+#define SIMPLESTL_STL_STRING_VIEW_H
+
+#include <cstddef>
+#include <ostream>
+#include <stdexcept>
+
+#include "stl_char_traits.h"
+#include "../__functional/stl_hash.h"
+
+namespace simple_stl{
+
+    template<class CharT, class Traits = char_traits<CharT> >
+    class basic_string_view{
+    public:
+        typedef Traits                              traits_type;
+        typedef CharT                               value_type;
+        typedef size_t                              size_type;
+        typedef ptrdiff_t                           difference_type;
+        typedef const CharT&                        reference;
+        typedef const CharT&                        const_reference;
+        typedef const CharT*                        pointer;
+        typedef const CharT*                        const_pointer;
+        typedef const CharT*                        iterator;
+        typedef const CharT*                        const_iterator;
+
+        static const size_type npos = static_cast<size_type>(-1);
+
+    private:
+        const CharT* data_;
+        size_type size_;
+
+    public:
+        /** 构造 */
+        constexpr basic_string_view() noexcept : data_(nullptr), size_(0) {}
+
+        constexpr basic_string_view(const CharT* s, size_type n) noexcept : data_(s), size_(n) {}
+
+        basic_string_view(const CharT* s) : data_(s), size_(traits_type::length(s)) {}
+
+        constexpr basic_string_view(const basic_string_view&) noexcept = default;
+        basic_string_view& operator=(const basic_string_view&) noexcept = default;
+
+        /** 迭代器 */
+        constexpr const_iterator begin() const noexcept { return data_; }
+        constexpr const_iterator cbegin() const noexcept { return data_; }
+        constexpr const_iterator end() const noexcept { return data_ + size_; }
+        constexpr const_iterator cend() const noexcept { return data_ + size_; }
+
+        /** 容量 */
+        constexpr size_type size() const noexcept { return size_; }
+        constexpr size_type length() const noexcept { return size_; }
+        constexpr size_type max_size() const noexcept { return npos / sizeof(CharT); }
+        constexpr bool empty() const noexcept { return size_ == 0; }
+
+        /** 元素访问 */
+        constexpr const_reference operator[](size_type n) const { return data_[n]; }
+
+        const_reference at(size_type n) const{
+            if (n >= size_)
+                throw std::out_of_range("basic_string_view::at");
+            return data_[n];
+        }
+
+        constexpr const_reference front() const { return data_[0]; }
+        constexpr const_reference back() const { return data_[size_ - 1]; }
+        constexpr const_pointer data() const noexcept { return data_; }
+
+        /** 修改 */
+        void remove_prefix(size_type n) noexcept{
+            data_ += n;
+            size_ -= n;
+        }
+
+        void remove_suffix(size_type n) noexcept { size_ -= n; }
+
+        void swap(basic_string_view& other) noexcept{
+            const CharT* p = data_;
+            data_ = other.data_;
+            other.data_ = p;
+            const size_type n = size_;
+            size_ = other.size_;
+            other.size_ = n;
+        }
+
+        /** 操作 */
+        // 将 [pos, pos + n) 拷贝到 s，不追加空字符，返回拷贝的字符数
+        size_type copy(CharT* s, size_type n, size_type pos = 0) const{
+            __pos_check(pos, "basic_string_view::copy");
+            n = __clamp(pos, n);
+            traits_type::copy(s, data_ + pos, n);
+            return n;
+        }
+
+        basic_string_view substr(size_type pos = 0, size_type n = npos) const{
+            __pos_check(pos, "basic_string_view::substr");
+            return basic_string_view(data_ + pos, __clamp(pos, n));
+        }
+
+        int compare(basic_string_view v) const noexcept{
+            return simple_stl::__str_compare<Traits>(data_, size_, v.data_, v.size_);
+        }
+
+        int compare(size_type pos, size_type n, basic_string_view v) const{
+            return substr(pos, n).compare(v);
+        }
+
+        int compare(size_type pos1, size_type n1, basic_string_view v, size_type pos2, size_type n2) const{
+            return substr(pos1, n1).compare(v.substr(pos2, n2));
+        }
+
+        int compare(const CharT* s) const { return compare(basic_string_view(s)); }
+
+        int compare(size_type pos, size_type n, const CharT* s) const{
+            return substr(pos, n).compare(basic_string_view(s));
+        }
+
+        int compare(size_type pos, size_type n1, const CharT* s, size_type n2) const{
+            return substr(pos, n1).compare(basic_string_view(s, n2));
+        }
+
+        bool starts_with(basic_string_view v) const noexcept{
+            return size_ >= v.size_ && traits_type::compare(data_, v.data_, v.size_) == 0;
+        }
+
+        bool starts_with(CharT c) const noexcept { return !empty() && traits_type::eq(front(), c); }
+
+        bool starts_with(const CharT* s) const { return starts_with(basic_string_view(s)); }
+
+        bool ends_with(basic_string_view v) const noexcept{
+            return size_ >= v.size_ && traits_type::compare(data_ + size_ - v.size_, v.data_, v.size_) == 0;
+        }
+
+        bool ends_with(CharT c) const noexcept { return !empty() && traits_type::eq(back(), c); }
+
+        bool ends_with(const CharT* s) const { return ends_with(basic_string_view(s)); }
+
+        /** 查找 */
+        size_type find(basic_string_view v, size_type pos = 0) const noexcept{
+            return simple_stl::__str_find<Traits>(data_, size_, v.data_, pos, v.size_);
+        }
+
+        size_type find(CharT c, size_type pos = 0) const noexcept{
+            return simple_stl::__str_find<Traits>(data_, size_, c, pos);
+        }
+
+        size_type find(const CharT* s, size_type pos, size_type n) const noexcept{
+            return simple_stl::__str_find<Traits>(data_, size_, s, pos, n);
+        }
+
+        size_type find(const CharT* s, size_type pos = 0) const noexcept{
+            return simple_stl::__str_find<Traits>(data_, size_, s, pos, traits_type::length(s));
+        }
+
+        size_type rfind(basic_string_view v, size_type pos = npos) const noexcept{
+            return simple_stl::__str_rfind<Traits>(data_, size_, v.data_, pos, v.size_);
+        }
+
+        size_type rfind(CharT c, size_type pos = npos) const noexcept{
+            return simple_stl::__str_rfind<Traits>(data_, size_, c, pos);
+        }
+
+        size_type rfind(const CharT* s, size_type pos, size_type n) const noexcept{
+            return simple_stl::__str_rfind<Traits>(data_, size_, s, pos, n);
+        }
+
+        size_type rfind(const CharT* s, size_type pos = npos) const noexcept{
+            return simple_stl::__str_rfind<Traits>(data_, size_, s, pos, traits_type::length(s));
+        }
+
+        size_type find_first_of(basic_string_view v, size_type pos = 0) const noexcept{
+            return simple_stl::__str_find_first_of<Traits>(data_, size_, v.data_, pos, v.size_);
+        }
+
+        size_type find_first_of(CharT c, size_type pos = 0) const noexcept { return find(c, pos); }
+
+        size_type find_first_of(const CharT* s, size_type pos, size_type n) const noexcept{
+            return simple_stl::__str_find_first_of<Traits>(data_, size_, s, pos, n);
+        }
+
+        size_type find_first_of(const CharT* s, size_type pos = 0) const noexcept{
+            return simple_stl::__str_find_first_of<Traits>(data_, size_, s, pos, traits_type::length(s));
+        }
+
+        size_type find_last_of(basic_string_view v, size_type pos = npos) const noexcept{
+            return simple_stl::__str_find_last_of<Traits>(data_, size_, v.data_, pos, v.size_);
+        }
+
+        size_type find_last_of(CharT c, size_type pos = npos) const noexcept { return rfind(c, pos); }
+
+        size_type find_last_of(const CharT* s, size_type pos, size_type n) const noexcept{
+            return simple_stl::__str_find_last_of<Traits>(data_, size_, s, pos, n);
+        }
+
+        size_type find_last_of(const CharT* s, size_type pos = npos) const noexcept{
+            return simple_stl::__str_find_last_of<Traits>(data_, size_, s, pos, traits_type::length(s));
+        }
+
+        size_type find_first_not_of(basic_string_view v, size_type pos = 0) const noexcept{
+            return simple_stl::__str_find_first_not_of<Traits>(data_, size_, v.data_, pos, v.size_);
+        }
+
+        size_type find_first_not_of(CharT c, size_type pos = 0) const noexcept{
+            return simple_stl::__str_find_first_not_of<Traits>(data_, size_, &c, pos, 1);
+        }
+
+        size_type find_first_not_of(const CharT* s, size_type pos, size_type n) const noexcept{
+            return simple_stl::__str_find_first_not_of<Traits>(data_, size_, s, pos, n);
+        }
+
+        size_type find_first_not_of(const CharT* s, size_type pos = 0) const noexcept{
+            return simple_stl::__str_find_first_not_of<Traits>(data_, size_, s, pos, traits_type::length(s));
+        }
+
+        size_type find_last_not_of(basic_string_view v, size_type pos = npos) const noexcept{
+            return simple_stl::__str_find_last_not_of<Traits>(data_, size_, v.data_, pos, v.size_);
+        }
+
+        size_type find_last_not_of(CharT c, size_type pos = npos) const noexcept{
+            return simple_stl::__str_find_last_not_of<Traits>(data_, size_, &c, pos, 1);
+        }
+
+        size_type find_last_not_of(const CharT* s, size_type pos, size_type n) const noexcept{
+            return simple_stl::__str_find_last_not_of<Traits>(data_, size_, s, pos, n);
+        }
+
+        size_type find_last_not_of(const CharT* s, size_type pos = npos) const noexcept{
+            return simple_stl::__str_find_last_not_of<Traits>(data_, size_, s, pos, traits_type::length(s));
+        }
+
+    private:
+        void __pos_check(size_type pos, const char* what) const{
+            if (pos > size_)
+                throw std::out_of_range(what);
+        }
+
+        // [pos, pos + n) 超出末尾时截到末尾
+        size_type __clamp(size_type pos, size_type n) const noexcept{
+            const size_type rest = size_ - pos;
+            return n < rest ? n : rest;
+        }
+    };
+
+    template<class CharT, class Traits>
+    const typename basic_string_view<CharT, Traits>::size_type basic_string_view<CharT, Traits>::npos;
+
+    typedef basic_string_view<char>     string_view;
+    typedef basic_string_view<wchar_t>  wstring_view;
+    typedef basic_string_view<char16_t> u16string_view;
+    typedef basic_string_view<char32_t> u32string_view;
+
+    /** 比较
+     * 另一侧可以是能隐式转换为 basic_string_view 的类型（const CharT*、basic_string），
+     * 以 __identity_view 阻止该侧参与模板实参推导
+     */
+    template<class View>
+    struct __identity_view { typedef View type; };
+
+    template<class CharT, class Traits>
+    inline bool operator==(basic_string_view<CharT, Traits> x, basic_string_view<CharT, Traits> y) noexcept{
+        return x.size() == y.size() && Traits::compare(x.data(), y.data(), x.size()) == 0;
+    }
+
+    template<class CharT, class Traits>
+    inline bool operator==(basic_string_view<CharT, Traits> x,
+                           typename __identity_view<basic_string_view<CharT, Traits> >::type y) noexcept{
+        return x.size() == y.size() && Traits::compare(x.data(), y.data(), x.size()) == 0;
+    }
+
+    template<class CharT, class Traits>
+    inline bool operator==(typename __identity_view<basic_string_view<CharT, Traits> >::type x,
+                           basic_string_view<CharT, Traits> y) noexcept{
+        return x.size() == y.size() && Traits::compare(x.data(), y.data(), x.size()) == 0;
+    }
+
+    template<class CharT, class Traits>
+    inline bool operator!=(basic_string_view<CharT, Traits> x, basic_string_view<CharT, Traits> y) noexcept{
+        return !(x == y);
+    }
+
+    template<class CharT, class Traits>
+    inline bool operator!=(basic_string_view<CharT, Traits> x,
+                           typename __identity_view<basic_string_view<CharT, Traits> >::type y) noexcept{
+        return !(x == y);
+    }
+
+    template<class CharT, class Traits>
+    inline bool operator!=(typename __identity_view<basic_string_view<CharT, Traits> >::type x,
+                           basic_string_view<CharT, Traits> y) noexcept{
+        return !(x == y);
+    }
+
+    template<class CharT, class Traits>
+    inline bool operator<(basic_string_view<CharT, Traits> x, basic_string_view<CharT, Traits> y) noexcept{
+        return x.compare(y) < 0;
+    }
+
+    template<class CharT, class Traits>
+    inline bool operator<(basic_string_view<CharT, Traits> x,
+                          typename __identity_view<basic_string_view<CharT, Traits> >::type y) noexcept{
+        return x.compare(y) < 0;
+    }
+
+    template<class CharT, class Traits>
+    inline bool operator<(typename __identity_view<basic_string_view<CharT, Traits> >::type x,
+                          basic_string_view<CharT, Traits> y) noexcept{
+        return x.compare(y) < 0;
+    }
+
+    template<class CharT, class Traits>
+    inline bool operator>(basic_string_view<CharT, Traits> x, basic_string_view<CharT, Traits> y) noexcept{
+        return x.compare(y) > 0;
+    }
+
+    template<class CharT, class Traits>
+    inline bool operator>(basic_string_view<CharT, Traits> x,
+                          typename __identity_view<basic_string_view<CharT, Traits> >::type y) noexcept{
+        return x.compare(y) > 0;
+    }
+
+    template<class CharT, class Traits>
+    inline bool operator>(typename __identity_view<basic_string_view<CharT, Traits> >::type x,
+                          basic_string_view<CharT, Traits> y) noexcept{
+        return x.compare(y) > 0;
+    }
+
+    template<class CharT, class Traits>
+    inline bool operator<=(basic_string_view<CharT, Traits> x, basic_string_view<CharT, Traits> y) noexcept{
+        return x.compare(y) <= 0;
+    }
+
+    template<class CharT, class Traits>
+    inline bool operator<=(basic_string_view<CharT, Traits> x,
+                           typename __identity_view<basic_string_view<CharT, Traits> >::type y) noexcept{
+        return x.compare(y) <= 0;
+    }
+
+    template<class CharT, class Traits>
+    inline bool operator<=(typename __identity_view<basic_string_view<CharT, Traits> >::type x,
+                           basic_string_view<CharT, Traits> y) noexcept{
+        return x.compare(y) <= 0;
+    }
+
+    template<class CharT, class Traits>
+    inline bool operator>=(basic_string_view<CharT, Traits> x, basic_string_view<CharT, Traits> y) noexcept{
+        return x.compare(y) >= 0;
+    }
+
+    template<class CharT, class Traits>
+    inline bool operator>=(basic_string_view<CharT, Traits> x,
+                           typename __identity_view<basic_string_view<CharT, Traits> >::type y) noexcept{
+        return x.compare(y) >= 0;
+    }
+
+    template<class CharT, class Traits>
+    inline bool operator>=(typename __identity_view<basic_string_view<CharT, Traits> >::type x,
+                           basic_string_view<CharT, Traits> y) noexcept{
+        return x.compare(y) >= 0;
+    }
+
+    template<class CharT, class Traits>
+    inline void swap(basic_string_view<CharT, Traits>& x, basic_string_view<CharT, Traits>& y) noexcept{
+        x.swap(y);
+    }
+
+    // 按字符原样写出，不经过 std::char_traits
+    template<class CharT, class Traits>
+    inline std::basic_ostream<CharT>& operator<<(std::basic_ostream<CharT>& os, basic_string_view<CharT, Traits> v){
+        return os.write(v.data(), static_cast<std::streamsize>(v.size()));
+    }
+
+    // 只为默认的 char_traits 提供，与 basic_string 的 hash 一致
+    template<class CharT>
+    struct hash<basic_string_view<CharT> >{
+        typedef basic_string_view<CharT>    argument_type;
+        typedef size_t                      result_type;
+        typedef void                        is_avalanching;
+        size_t operator()(basic_string_view<CharT> v) const noexcept{
+            return static_cast<size_t>(simple_stl::__hash_bytes(v.data(), v.size() * sizeof(CharT)));
+        }
+    };
+
+}   // simple_stl
+
+#endif //SIMPLESTL_STL_STRING_VIEW_H
@@ -16,6 +16,8 @@ namespace simple_stl{
     struct forward_iterator_tag: public input_iterator_tag{};
     struct bidirectional_iterator_tag: public forward_iterator_tag{};
     struct random_access_iterator_tag: public bidirectional_iterator_tag{};
+    // 元素在内存中连续存放，算法可以换成原生指针处理（memmove、SIMD 等）
+    struct contiguous_iterator_tag: public random_access_iterator_tag{};
 
     // iterator 模版基类，避免挂一漏万
     template<class Category, class T, class Distance=ptrdiff_t,
@@ -81,7 +83,7 @@ namespace simple_stl{
     // 针对原生指针T*的traits偏特化版本
     template<class T>
     struct iterator_traits<T*>{
-        typedef random_access_iterator_tag  iterator_category;
+        typedef contiguous_iterator_tag     iterator_category;
         typedef T                           value_type;
         typedef ptrdiff_t                   difference_type;
         typedef T*                          pointer;
@@ -91,11 +93,11 @@ namespace simple_stl{
     // 针对原生指针的const T*的traits偏特化版本
     template<class T>
     struct iterator_traits<const T*>{
-        typedef random_access_iterator_tag  iterator_category;
+        typedef contiguous_iterator_tag     iterator_category;
         typedef T                           value_type;
         typedef ptrdiff_t                   difference_type;
-        typedef T*                          pointer;
-        typedef T&                          reference;
+        typedef const T*                    pointer;
+        typedef const T&                    reference;
     };
 
 
@@ -123,6 +125,9 @@ namespace simple_stl{
     template <class Iterator>
     struct is_random_access_iterator : __has_iterator_category_convertible_to<Iterator, random_access_iterator_tag> {};
 
+    template <class Iterator>
+    struct is_contiguous_iterator : __has_iterator_category_convertible_to<Iterator, contiguous_iterator_tag> {};
+
     template <class Iterator>
     struct is_iterator : bool_constant_s<is_input_iterator<Iterator>::value ||is_output_iterator<Iterator>::value> {};
 
@@ -148,6 +153,36 @@ namespace simple_stl{
     }
 
 
+    // 分段迭代器：由若干段连续区间拼接而成，如 deque 的迭代器
+    // 迭代器以 typedef __true_type_s is_segmented_iterator 声明自身，并提供：
+    //  segment_iterator    在各段之间移动的迭代器
+    //  local_iterator      段内的迭代器，通常为原生指针
+    //  __segment(it) / __local(it)             拆分出所在段与段内位置
+    //  __begin(seg) / __end(seg)               段的首尾
+    //  __compose(seg, local)                   由段与段内位置合成迭代器
+    // 算法据此逐段处理，段内不必每次递增都检查是否越过段的边界
+    template<class Iterator, class = void>
+    struct segmented_iterator_traits{
+        typedef __false_type_s is_segmented_iterator;
+    };
+
+    template<class Iterator>
+    struct segmented_iterator_traits<Iterator,
+            typename __make_void<typename Iterator::is_segmented_iterator>::type>{
+        typedef typename Iterator::is_segmented_iterator    is_segmented_iterator;
+        typedef typename Iterator::segment_iterator         segment_iterator;
+        typedef typename Iterator::local_iterator           local_iterator;
+
+        static segment_iterator segment(const Iterator& it) { return Iterator::__segment(it); }
+        static local_iterator local(const Iterator& it) { return Iterator::__local(it); }
+        static local_iterator begin(segment_iterator s) { return Iterator::__begin(s); }
+        static local_iterator end(segment_iterator s) { return Iterator::__end(s); }
+        static Iterator compose(segment_iterator s, local_iterator l) { return Iterator::__compose(s, l); }
+    };
+
+    template<class Iterator>
+    struct is_segmented_iterator : segmented_iterator_traits<Iterator>::is_segmented_iterator {};
+
     // distance()函数组
     // input_iterator_tag版
     template<class InputIterator>
@@ -184,7 +219,7 @@ namespace simple_stl{
     inline void __advance(InputIterator& i, Distance n,
                           input_iterator_tag){
         // 单向，逐一前进
-        while (n--) i++;
+        while (n--) ++i;
     }
 
     // bidirectional_iterator_tag版
@@ -215,12 +250,111 @@ namespace simple_stl{
     }
 
 
+    // move_iterator：解引用得到右值引用，使拷贝算法变为移动
+    template<class Iterator>
+    class move_iterator{
+    public:
+        typedef Iterator                                                iterator_type;
+        typedef typename iterator_traits<Iterator>::iterator_category  iterator_category;
+        typedef typename iterator_traits<Iterator>::value_type         value_type;
+        typedef typename iterator_traits<Iterator>::difference_type    difference_type;
+        typedef Iterator                                                pointer;
+        typedef value_type&&                                            reference;
+
+    private:
+        Iterator current;
+
+    public:
+        move_iterator() : current() {}
+        explicit move_iterator(Iterator i) : current(i) {}
+
+        template<class U>
+        move_iterator(const move_iterator<U>& other) : current(other.base()) {}
+
+        Iterator base() const { return current; }
+
+        reference operator*() const { return static_cast<reference>(*current); }
+        pointer operator->() const { return current; }
+        reference operator[](difference_type n) const { return static_cast<reference>(current[n]); }
+
+        move_iterator& operator++() { ++current; return *this; }
+        move_iterator operator++(int) { move_iterator tmp = *this; ++current; return tmp; }
+        move_iterator& operator--() { --current; return *this; }
+        move_iterator operator--(int) { move_iterator tmp = *this; --current; return tmp; }
+
+        move_iterator operator+(difference_type n) const { return move_iterator(current + n); }
+        move_iterator operator-(difference_type n) const { return move_iterator(current - n); }
+        move_iterator& operator+=(difference_type n) { current += n; return *this; }
+        move_iterator& operator-=(difference_type n) { current -= n; return *this; }
+    };
+
+    template<class I1, class I2>
+    inline bool operator==(const move_iterator<I1>& x, const move_iterator<I2>& y){
+        return x.base() == y.base();
+    }
+
+    template<class I1, class I2>
+    inline bool operator!=(const move_iterator<I1>& x, const move_iterator<I2>& y){
+        return !(x == y);
+    }
+
+    template<class I1, class I2>
+    inline bool operator<(const move_iterator<I1>& x, const move_iterator<I2>& y){
+        return x.base() < y.base();
+    }
+
+    template<class I1, class I2>
+    inline typename move_iterator<I1>::difference_type
+    operator-(const move_iterator<I1>& x, const move_iterator<I2>& y){
+        return x.base() - y.base();
+    }
+
+    template<class Iterator>
+    inline move_iterator<Iterator> make_move_iterator(Iterator i){
+        return move_iterator<Iterator>(i);
+    }
+
+
+    // to_address()：连续迭代器所指元素的地址
+    // 原生指针即其本身；类迭代器的 operator->() 须返回原生指针或可继续展开的迭代器（如 move_iterator）
+    template<class T>
+    inline T* to_address(T* p) noexcept{
+        return p;
+    }
+
+    template<class Iterator>
+    inline auto to_address(const Iterator& it) noexcept -> decltype(simple_stl::to_address(it.operator->())){
+        return simple_stl::to_address(it.operator->());
+    }
 
+    // 连续迭代器换成原生指针交给算法的指针版本，结果再用 __rewrap_iter 换回原迭代器类型；
+    // 其余迭代器原样通过
+    template<class Iterator, bool = is_contiguous_iterator<Iterator>::value>
+    struct __unwrap_iter_impl{
+        typedef Iterator type;
 
+        static Iterator unwrap(const Iterator& it) { return it; }
+        static Iterator rewrap(const Iterator&, const Iterator& it) { return it; }
+    };
 
+    template<class Iterator>
+    struct __unwrap_iter_impl<Iterator, true>{
+        typedef decltype(simple_stl::to_address(std::declval<const Iterator&>())) type;
 
+        static type unwrap(const Iterator& it) { return simple_stl::to_address(it); }
+        static Iterator rewrap(const Iterator& orig, type p) { return orig + (p - simple_stl::to_address(orig)); }
+    };
 
+    template<class Iterator>
+    inline typename __unwrap_iter_impl<Iterator>::type __unwrap_iter(const Iterator& it){
+        return __unwrap_iter_impl<Iterator>::unwrap(it);
+    }
 
+    // orig 为换成指针前的某个迭代器，p 为同一区间内的指针
+    template<class Iterator>
+    inline Iterator __rewrap_iter(const Iterator& orig, typename __unwrap_iter_impl<Iterator>::type p){
+        return __unwrap_iter_impl<Iterator>::rewrap(orig, p);
+    }
 
 }   // simple_stl
 
@@ -17,128 +17,50 @@ namespace simple_stl{
 
     template <bool _b>
     using bool_constant_s = integral_constant_s<bool, _b>;
-    typedef bool_constant_s<true>   __true_type_s
-    typedef bool_constant_s<false>  __false_type_s
+    typedef bool_constant_s<true>   __true_type_s;
+    typedef bool_constant_s<false>  __false_type_s;
+
+    // 任意类型均映射为void，用于在偏特化中检测嵌套类型是否存在
+    template <class...>
+    struct __make_void {typedef void type;};
 
     // 萃取类型信息
+    // 默认值由编译器的平凡性判定得出，用户定义的平凡类型同样走批量处理的路径；
+    // 仍可为特定类型提供特化版本来覆盖默认值
     template<class Type>
     struct __type_traits_s{
         typedef __true_type_s   this_dummy_member_must_be_first;
 
-        typedef __false_type_s  have_trivial_default_constructor;
-        typedef __false_type_s  have_trivial_copy_constructor;
-        typedef __false_type_s  have_trivial_assignment_operator;
-        typedef __false_type_s  have_trivial_destructor;
-        typedef __false_type_s  is_POD_type;
-    };
-
-    // 为cpp基本类型提供特化版本
-    // 包括：char, signed char, unsigned char, short, unsigned short, int, unsigned int,
-    // long, unsigned long, float, double, long double
-    template<> struct __type_traits_s<char>{
-        typedef __true_type_s  have_trivial_default_constructor;
-        typedef __true_type_s  have_trivial_copy_constructor;
-        typedef __true_type_s  have_trivial_assignment_operator;
-        typedef __true_type_s  have_trivial_destructor;
-        typedef __true_type_s  is_POD_type;
-    };
-
-    template<> struct __type_traits_s<signed char>{
-        typedef __true_type_s  have_trivial_default_constructor;
-        typedef __true_type_s  have_trivial_copy_constructor;
-        typedef __true_type_s  have_trivial_assignment_operator;
-        typedef __true_type_s  have_trivial_destructor;
-        typedef __true_type_s  is_POD_type;
-    };
-
-    template<> struct __type_traits_s<unsigned char>{
-        typedef __true_type_s  have_trivial_default_constructor;
-        typedef __true_type_s  have_trivial_copy_constructor;
-        typedef __true_type_s  have_trivial_assignment_operator;
-        typedef __true_type_s  have_trivial_destructor;
-        typedef __true_type_s  is_POD_type;
-    };
-
-    template<> struct __type_traits_s<short>{
-        typedef __true_type_s  have_trivial_default_constructor;
-        typedef __true_type_s  have_trivial_copy_constructor;
-        typedef __true_type_s  have_trivial_assignment_operator;
-        typedef __true_type_s  have_trivial_destructor;
-        typedef __true_type_s  is_POD_type;
-    };
-
-    template<> struct __type_traits_s<unsigned short>{
-        typedef __true_type_s  have_trivial_default_constructor;
-        typedef __true_type_s  have_trivial_copy_constructor;
-        typedef __true_type_s  have_trivial_assignment_operator;
-        typedef __true_type_s  have_trivial_destructor;
-        typedef __true_type_s  is_POD_type;
-    };
-
-    template<> struct __type_traits_s<int>{
-        typedef __true_type_s  have_trivial_default_constructor;
-        typedef __true_type_s  have_trivial_copy_constructor;
-        typedef __true_type_s  have_trivial_assignment_operator;
-        typedef __true_type_s  have_trivial_destructor;
-        typedef __true_type_s  is_POD_type;
-    };
-
-    template<> struct __type_traits_s<unsigned int>{
-        typedef __true_type_s  have_trivial_default_constructor;
-        typedef __true_type_s  have_trivial_copy_constructor;
-        typedef __true_type_s  have_trivial_assignment_operator;
-        typedef __true_type_s  have_trivial_destructor;
-        typedef __true_type_s  is_POD_type;
-    };
-
-    template<> struct __type_traits_s<long>{
-        typedef __true_type_s  have_trivial_default_constructor;
-        typedef __true_type_s  have_trivial_copy_constructor;
-        typedef __true_type_s  have_trivial_assignment_operator;
-        typedef __true_type_s  have_trivial_destructor;
-        typedef __true_type_s  is_POD_type;
-    };
-
-    template<> struct __type_traits_s<unsigned long>{
-        typedef __true_type_s  have_trivial_default_constructor;
-        typedef __true_type_s  have_trivial_copy_constructor;
-        typedef __true_type_s  have_trivial_assignment_operator;
-        typedef __true_type_s  have_trivial_destructor;
-        typedef __true_type_s  is_POD_type;
+        typedef bool_constant_s<std::is_trivially_default_constructible<Type>::value>
+                have_trivial_default_constructor;
+        typedef bool_constant_s<std::is_trivially_copy_constructible<Type>::value>
+                have_trivial_copy_constructor;
+        typedef bool_constant_s<std::is_trivially_copy_assignable<Type>::value>
+                have_trivial_assignment_operator;
+        typedef bool_constant_s<std::is_trivially_destructible<Type>::value>
+                have_trivial_destructor;
+        typedef bool_constant_s<std::is_trivial<Type>::value>
+                is_POD_type;
     };
 
-    template<> struct __type_traits_s<float>{
-        typedef __true_type_s  have_trivial_default_constructor;
-        typedef __true_type_s  have_trivial_copy_constructor;
-        typedef __true_type_s  have_trivial_assignment_operator;
-        typedef __true_type_s  have_trivial_destructor;
-        typedef __true_type_s  is_POD_type;
-    };
 
-    template<> struct __type_traits_s<double>{
-        typedef __true_type_s  have_trivial_default_constructor;
-        typedef __true_type_s  have_trivial_copy_constructor;
-        typedef __true_type_s  have_trivial_assignment_operator;
-        typedef __true_type_s  have_trivial_destructor;
-        typedef __true_type_s  is_POD_type;
-    };
+    // is_trivially_relocatable：移动构造到新地址并析构旧对象，等价于按字节拷贝
+    // 平凡可拷贝的类型默认满足；其它类型（如仅持有堆指针的句柄类）可通过以下两种方式声明：
+    //  1. 特化 is_trivially_relocatable<T> 为 __true_type_s
+    //  2. 在类中定义 typedef __true_type_s trivially_relocatable;
+    template <class Tp, class = void>
+    struct __has_trivially_relocatable_tag : __false_type_s {};
 
-    template<> struct __type_traits_s<long double>{
-        typedef __true_type_s  have_trivial_default_constructor;
-        typedef __true_type_s  have_trivial_copy_constructor;
-        typedef __true_type_s  have_trivial_assignment_operator;
-        typedef __true_type_s  have_trivial_destructor;
-        typedef __true_type_s  is_POD_type;
-    };
+    template <class Tp>
+    struct __has_trivially_relocatable_tag<Tp,
+            typename __make_void<typename Tp::trivially_relocatable>::type>
+            : bool_constant_s<Tp::trivially_relocatable::value> {};
 
-    // 针对原生指针进行特化
-    template<class T> struct __type_traits_s<T*>{
-        typedef __true_type_s  have_trivial_default_constructor;
-        typedef __true_type_s  have_trivial_copy_constructor;
-        typedef __true_type_s  have_trivial_assignment_operator;
-        typedef __true_type_s  have_trivial_destructor;
-        typedef __true_type_s  is_POD_type;
-    };
+    template <class Tp>
+    struct is_trivially_relocatable
+            : bool_constant_s<(std::is_trivially_copyable<Tp>::value &&
+                               std::is_trivially_destructible<Tp>::value) ||
+                              __has_trivially_relocatable_tag<Tp>::value> {};
 
 
     template <class Tp> struct is_lvalue_reference      : public __false_type_s {};
@@ -167,6 +89,7 @@ namespace simple_stl{
 
 
 
+
 }   // simple_stl
 
 
@@ -12,6 +12,18 @@
 
 namespace simple_stl{
 
+    // 缓存行大小，并发结构据此将不同线程频繁写入的数据隔开，避免伪共享
+    static const size_t __cache_line_size = 64;
+
+    // 自旋等待时提示处理器，减少流水线与超线程上的资源争用
+    inline void __cpu_relax() noexcept{
+#if defined(__x86_64__) || defined(__i386__)
+        __builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+        asm volatile("yield" ::: "memory");
+#endif
+    }
+
     // move()：将左值转换为对应的右值引用类型
     template<class Tp>
     typename remove_reference<Tp>::type&& move(Tp&& _t) noexcept{
@@ -21,12 +33,12 @@ namespace simple_stl{
 
     // forward()：用来保存类型信息，返回实参的右值引用
     template <class Tp>
-    inline Tp&& forward(typename remove_reference<_Tp>::type& _t) noexcept{
+    inline Tp&& forward(typename remove_reference<Tp>::type& _t) noexcept{
         return static_cast<Tp&&>(_t);
     }
 
     template <class Tp>
-    inline Tp&& forward(typename remove_reference<_Tp>::type&& _t) noexcept{
+    inline Tp&& forward(typename remove_reference<Tp>::type&& _t) noexcept{
         static_assert(!is_lvalue_reference<Tp>::value, "cannot forward an rvalue as an lvalue");
         return static_cast<Tp&&>(_t);
     }
@@ -35,15 +47,15 @@ namespace simple_stl{
     // swap()
     template<class Tp>
     void swap(Tp& _l, Tp& _r){
-        Tp _t = move(_l);
-        _l = move(_r);
-        _r = move(_t);
+        Tp _t = simple_stl::move(_l);
+        _l = simple_stl::move(_r);
+        _r = simple_stl::move(_t);
     }
 
     template<class Tp, size_t Np>
     void swap(Tp (&_a)[Np], Tp (&_b)[Np]){
         for (size_t i = 0;  i!=Np ; ++i) {
-            swap(_a[i], _b[i]);
+            simple_stl::swap(_a[i], _b[i]);
         }
     }
 
@@ -142,7 +154,7 @@ namespace simple_stl{
                 std::is_constructible<T2, U2>::value &&
                 std::is_convertible<U1, T1>::value &&
                 std::is_convertible<U2, T2>::value, int>::type = 0>
-        constexpr pair(pair<U1, U2> const& _p)
+        constexpr pair(pair<U1, U2>&& _p)
         : first(simple_stl::forward<U1>(_p.first)),
         second(simple_stl::forward<U2>(_p.second)) {}
 
@@ -152,28 +164,17 @@ namespace simple_stl{
                 std::is_constructible<T2, U2>::value &&
                 (!std::is_convertible<U1, T1>::value ||
                  !std::is_convertible<U2, T2>::value), int>::type = 0>
-        explicit constexpr pair(pair<U1, U2> const& _p)
+        explicit constexpr pair(pair<U1, U2>&& _p)
         : first(simple_stl::forward<U1>(_p.first)),
         second(simple_stl::forward<U2>(_p.second)){}
 
         ~pair() = default;
 
 
-        pair& operator=(const pair& _r){
-            if (this != &_r){
-                first = _r.first;
-                second = _r.second;
-            }
-            return *this;
-        }
-
-        pair& operator=(pair&& _r){
-            if (this != &_r){
-                first = simple_stl::forward<first_type>(_r.first);
-                second = simple_stl::forward<second_type>(_r.second);
-            }
-            return *this;
-        }
+        // 逐成员赋值即可，使用默认版本：两个成员都可平凡拷贝时 pair 也可平凡拷贝，
+        // copy、sort 等才能走 memmove 的快速路径
+        pair& operator=(const pair&) = default;
+        pair& operator=(pair&&) = default;
 
         template<class U1, class U2>
         pair& operator=(const pair<U1, U2>& _r){
@@ -234,11 +235,25 @@ namespace simple_stl{
 
     }
 
+    // 两个成员都可平凡重定位时，pair 也可平凡重定位
+    template<class T1, class T2>
+    struct is_trivially_relocatable<pair<T1, T2> >
+            : bool_constant_s<is_trivially_relocatable<T1>::value &&
+                              is_trivially_relocatable<T2>::value> {};
+
     template<class T1, class T2>
     inline pair<T1, T2> make_pair(T1&& first, T2&& second){
         return pair<T1, T2>(simple_stl::forward<T1>(first), simple_stl::forward<T2>(second));
     }
 
+    // 标记输入区间已按键排好序：sorted_unique 表示键互不相同，sorted_equivalent 表示可以重复。
+    // 有序容器据此跳过查找与比较，线性时间建立
+    struct sorted_unique_t { explicit sorted_unique_t() = default; };
+    struct sorted_equivalent_t { explicit sorted_equivalent_t() = default; };
+
+    constexpr sorted_unique_t sorted_unique{};
+    constexpr sorted_equivalent_t sorted_equivalent{};
+
 }   // simple_stl
 
 #endif //SIMPLESTL_UTILITY_H
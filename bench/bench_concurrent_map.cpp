@@ -0,0 +1,93 @@
+/**
+ * Created by 史进 on 2023/6/24.
+ *
+ * 读多写少的共享缓存：t 个线程（1 到 48）在 64K 个键上查找，每 16 次操作中 1 次 insert_or_assign，
+ * 对比 shared_timed_mutex 保护的 unordered_map 与 concurrent_unordered_map
+ */
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+
+#include "../SimpleSTL/concurrent_unordered_map"
+#include "../SimpleSTL/unordered_map"
+#include "../SimpleSTL/vector"
+
+const uint64_t ops = 1 << 22;
+const uint64_t keys = 1 << 16;
+
+// 对照组：读写锁保护的哈希表
+class locked_map{
+private:
+    simple_stl::unordered_map<uint64_t, uint64_t> m_;
+    mutable std::shared_timed_mutex mutex_;
+
+public:
+    bool find(uint64_t k, uint64_t& v) const{
+        std::shared_lock<std::shared_timed_mutex> lock(mutex_);
+        auto it = m_.find(k);
+        if (it == m_.end())
+            return false;
+        v = it->second;
+        return true;
+    }
+
+    void insert_or_assign(uint64_t k, uint64_t v){
+        std::unique_lock<std::shared_timed_mutex> lock(mutex_);
+        m_[k] = v;
+    }
+};
+
+template<class Map>
+double run(Map& m, size_t threads, uint64_t& hits){
+    const uint64_t per_thread = ops / threads;
+    simple_stl::vector<std::thread> workers;
+    simple_stl::vector<uint64_t> counts(threads, 0);
+    auto start = std::chrono::steady_clock::now();
+    for (size_t t = 0; t < threads; ++t){
+        workers.push_back(std::thread([=, &m, &counts]{
+            uint64_t x = t * 0x9E3779B97F4A7C15ull + 1, n = 0, v;
+            for (uint64_t i = 0; i < per_thread; ++i){
+                x ^= x << 13;
+                x ^= x >> 7;
+                x ^= x << 17;
+                const uint64_t k = x % keys;
+                if ((i & 15) == 0)
+                    m.insert_or_assign(k, i);
+                else if (m.find(k, v))
+                    ++n;
+            }
+            counts[t] = n;
+        }));
+    }
+    for (size_t i = 0; i < workers.size(); ++i)
+        workers[i].join();
+    auto end = std::chrono::steady_clock::now();
+    hits = 0;
+    for (size_t t = 0; t < threads; ++t)
+        hits += counts[t];
+    return per_thread * threads / std::chrono::duration<double>(end - start).count() / 1e6;
+}
+
+int main(){
+    printf("M ops/s, 1/16 writes (hardware threads: %u)\n", std::thread::hardware_concurrency());
+    for (size_t t : {1, 2, 4, 8, 16, 32, 48}){
+        uint64_t h1 = 0, h2 = 0;
+
+        locked_map lm;
+        simple_stl::concurrent_unordered_map<uint64_t, uint64_t> cm;
+        for (uint64_t k = 0; k < keys; k += 2){
+            lm.insert_or_assign(k, k);
+            cm.insert_or_assign(k, k);
+        }
+
+        const double locked = run(lm, t, h1);
+        const double concurrent = run(cm, t, h2);
+        // 命中数随线程交错而变化，只用于防止查找被优化掉
+        printf("t=%-3zu shared_mutex+unordered_map %8.2f   concurrent_unordered_map %8.2f   (hits %llu / %llu)\n",
+               t, locked, concurrent, (unsigned long long)h1, (unsigned long long)h2);
+    }
+    return 0;
+}
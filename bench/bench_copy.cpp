@@ -0,0 +1,94 @@
+/**
+ * Created by 史进 on 2023/6/24.
+ *
+ * copy、move_backward、fill 的批量路径（memmove、memset、逐段处理）与逐个赋值的循环在 vector、deque 上的对比
+ */
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+
+#include "../SimpleSTL/algorithm"
+#include "../SimpleSTL/deque"
+#include "../SimpleSTL/vector"
+
+// 防止编译器将结果优化掉
+template<class T>
+void escape(T* p){
+    asm volatile("" : : "g"(p) : "memory");
+}
+
+// 对照组：逐个赋值，禁止编译器自动向量化
+template<class InputIterator, class OutputIterator>
+__attribute__((optimize("no-tree-vectorize")))
+OutputIterator loop_copy(InputIterator first, InputIterator last, OutputIterator result){
+    for ( ; first != last; ++first, ++result)
+        *result = *first;
+    return result;
+}
+
+template<class BidirectionalIterator>
+__attribute__((optimize("no-tree-vectorize")))
+BidirectionalIterator loop_move_backward(BidirectionalIterator first, BidirectionalIterator last,
+                                         BidirectionalIterator result){
+    while (first != last)
+        *--result = simple_stl::move(*--last);
+    return result;
+}
+
+template<class ForwardIterator, class T>
+__attribute__((optimize("no-tree-vectorize")))
+void loop_fill(ForwardIterator first, ForwardIterator last, const T& value){
+    for ( ; first != last; ++first)
+        *first = value;
+}
+
+template<class Function>
+double bench(Function f, int rounds){
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < rounds; ++i)
+        f();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::micro>(end - start).count() / rounds;
+}
+
+void report(const char* name, const char* container, size_t n, double loop_us, double stl_us){
+    printf("%-14s %-12s n=%-8zu loop %9.2f us  simple_stl %9.2f us  (%.2fx)\n",
+           name, container, n, loop_us, stl_us, loop_us / stl_us);
+}
+
+template<class Container>
+void run(const char* container, size_t n){
+    typedef typename Container::value_type T;
+    const int rounds = static_cast<int>(200000000 / (n * sizeof(T))) + 1;
+    Container a;
+    Container b;
+    for (size_t i = 0; i < n; ++i){
+        a.push_back(static_cast<T>(i));
+        b.push_back(T());
+    }
+
+    report("copy", container, n,
+           bench([&]{ loop_copy(a.begin(), a.end(), b.begin()); escape(&b[0]); }, rounds),
+           bench([&]{ simple_stl::copy(a.begin(), a.end(), b.begin()); escape(&b[0]); }, rounds));
+    // 区间内后移一格，源区间与目标区间重叠
+    report("move_backward", container, n,
+           bench([&]{ loop_move_backward(b.begin(), b.end() - 1, b.end()); escape(&b[0]); }, rounds),
+           bench([&]{ simple_stl::move_backward(b.begin(), b.end() - 1, b.end()); escape(&b[0]); }, rounds));
+    report("fill(0)", container, n,
+           bench([&]{ loop_fill(b.begin(), b.end(), T(0)); escape(&b[0]); }, rounds),
+           bench([&]{ simple_stl::fill(b.begin(), b.end(), T(0)); escape(&b[0]); }, rounds));
+    report("fill(7)", container, n,
+           bench([&]{ loop_fill(b.begin(), b.end(), T(7)); escape(&b[0]); }, rounds),
+           bench([&]{ simple_stl::fill(b.begin(), b.end(), T(7)); escape(&b[0]); }, rounds));
+}
+
+int main(){
+    for (size_t n : {64, 4096, 1000000}){
+        run<simple_stl::vector<uint8_t>>("vector<u8>", n);
+        run<simple_stl::vector<int32_t>>("vector<i32>", n);
+        run<simple_stl::deque<int32_t>>("deque<i32>", n);
+        run<simple_stl::vector<double>>("vector<f64>", n);
+        printf("\n");
+    }
+    return 0;
+}
@@ -0,0 +1,113 @@
+/**
+ * Created by 史进 on 2023/6/24.
+ *
+ * 线性查找（find、count、mismatch、min_element 等）的 SIMD 内核与逐个比较的循环在不同元素宽度上的对比
+ */
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "../SimpleSTL/algorithm"
+
+// 防止编译器将结果优化掉
+template<class T>
+void escape(T* p){
+    asm volatile("" : : "g"(p) : "memory");
+}
+
+// 对照组：逐个比较，禁止编译器自动向量化
+template<class T>
+__attribute__((optimize("no-tree-vectorize"))) const T* loop_find(const T* first, const T* last, T value){
+    for ( ; first != last; ++first)
+        if (*first == value)
+            return first;
+    return last;
+}
+
+template<class T>
+__attribute__((optimize("no-tree-vectorize"))) size_t loop_count(const T* first, const T* last, T value){
+    size_t n = 0;
+    for ( ; first != last; ++first)
+        n += *first == value;
+    return n;
+}
+
+template<class T>
+__attribute__((optimize("no-tree-vectorize"))) const T* loop_mismatch(const T* first1, const T* last1, const T* first2){
+    for ( ; first1 != last1 && *first1 == *first2; ++first1, ++first2) {}
+    return first1;
+}
+
+template<class T>
+__attribute__((optimize("no-tree-vectorize"))) const T* loop_max_element(const T* first, const T* last){
+    const T* result = first;
+    for (++first; first < last; ++first)
+        if (*result < *first)
+            result = first;
+    return result;
+}
+
+template<class Function>
+double bench(Function f, int rounds){
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < rounds; ++i)
+        f();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::micro>(end - start).count() / rounds;
+}
+
+void report(const char* name, const char* type, size_t n, double loop_us, double simd_us){
+    printf("%-12s %-8s n=%-8zu loop %9.2f us  simple_stl %9.2f us  (%.2fx)\n",
+           name, type, n, loop_us, simd_us, loop_us / simd_us);
+}
+
+template<class T>
+void run(const char* type, size_t n){
+    const int rounds = static_cast<int>(200000000 / (n * sizeof(T))) + 1;
+    std::mt19937_64 gen(42);
+    // 取值避开 0，目标值 0 只放在末尾，查找需扫描整个区间
+    std::vector<T> a(n), b(n);
+    for (size_t i = 0; i < n; ++i)
+        a[i] = static_cast<T>(gen() % 100 + 1);
+    a[n - 1] = 0;
+    b = a;
+    b[n - 1] = 1;
+    const T* first = a.data();
+    const T* last = first + n;
+    const T* r1 = nullptr;
+    const T* r2 = nullptr;
+    size_t c1 = 0;
+    size_t c2 = 0;
+
+    report("find", type, n,
+           bench([&]{ r1 = loop_find(first, last, T(0)); escape(&r1); }, rounds),
+           bench([&]{ r2 = simple_stl::find(first, last, T(0)); escape(&r2); }, rounds));
+    report("count", type, n,
+           bench([&]{ c1 = loop_count(first, last, T(7)); escape(&c1); }, rounds),
+           bench([&]{ c2 = static_cast<size_t>(simple_stl::count(first, last, T(7))); escape(&c2); }, rounds));
+    if (r1 != r2 || c1 != c2)
+        printf("error: %s find/count mismatch\n", type);
+    report("mismatch", type, n,
+           bench([&]{ r1 = loop_mismatch(first, last, b.data()); escape(&r1); }, rounds),
+           bench([&]{ r2 = simple_stl::mismatch(first, last, b.data()).first; escape(&r2); }, rounds));
+    report("max_element", type, n,
+           bench([&]{ r1 = loop_max_element(first, last); escape(&r1); }, rounds),
+           bench([&]{ r2 = simple_stl::max_element(first, last); escape(&r2); }, rounds));
+    if (r1 != r2)
+        printf("error: %s mismatch/max_element mismatch\n", type);
+}
+
+int main(){
+    for (size_t n : {64, 4096, 1000000}){
+        run<uint8_t>("uint8", n);
+        run<uint16_t>("uint16", n);
+        run<int32_t>("int32", n);
+        run<int64_t>("int64", n);
+        run<float>("float", n);
+        printf("\n");
+    }
+    return 0;
+}
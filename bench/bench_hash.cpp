@@ -0,0 +1,92 @@
+/**
+ * Created by 史进 on 2023/6/24.
+ *
+ * hash 的吞吐量：不同长度的字符串键 hash<string_view> 与 std::hash<std::string> 的对比，
+ * 以及整数哈希与 2 的幂步长的整数键在 unordered_flat_map 中的查找
+ */
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <random>
+#include <string>
+
+#include "../SimpleSTL/functional"
+#include "../SimpleSTL/string"
+#include "../SimpleSTL/string_view"
+#include "../SimpleSTL/unordered_flat_map"
+#include "../SimpleSTL/vector"
+
+// 防止编译器将结果优化掉
+template<class T>
+void escape(T* p){
+    asm volatile("" : : "g"(p) : "memory");
+}
+
+template<class Function>
+double bench(Function f, int rounds){
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < rounds; ++i)
+        f();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / rounds;
+}
+
+int main(){
+    std::mt19937 gen(42);
+    const size_t keys = 1024;
+    for (size_t len : {4, 8, 16, 24, 32, 64, 256, 4096}){
+        std::vector<std::string> a;
+        simple_stl::vector<simple_stl::string_view> b;
+        a.reserve(keys);
+        for (size_t i = 0; i < keys; ++i){
+            std::string k(len, ' ');
+            for (char& c : k)
+                c = static_cast<char>('a' + gen() % 26);
+            a.push_back(k);
+        }
+        for (size_t i = 0; i < keys; ++i)
+            b.push_back(simple_stl::string_view(a[i].data(), a[i].size()));
+
+        const int rounds = static_cast<int>(50000000 / (keys * (len + 16))) + 1;
+        size_t r1 = 0, r2 = 0;
+        const double std_ns = bench([&]{
+            for (size_t i = 0; i < keys; ++i)
+                r1 += std::hash<std::string>()(a[i]);
+            escape(&r1);
+        }, rounds) / keys;
+        const double stl_ns = bench([&]{
+            for (size_t i = 0; i < keys; ++i)
+                r2 += simple_stl::hash<simple_stl::string_view>()(b[i]);
+            escape(&r2);
+        }, rounds) / keys;
+        printf("hash(string) len=%-6zu std %7.2f ns (%6.2f GB/s)  simple_stl %7.2f ns (%6.2f GB/s)  (%.2fx)\n",
+               len, std_ns, len / std_ns, stl_ns, len / stl_ns, std_ns / stl_ns);
+    }
+    printf("\n");
+
+    {
+        const size_t n = 1 << 20;
+        size_t r = 0;
+        const double ns = bench([&]{
+            for (size_t i = 0; i < n; ++i)
+                r += simple_stl::hash<size_t>()(i);
+            escape(&r);
+        }, 20) / n;
+        printf("hash(size_t)          %7.2f ns\n", ns);
+    }
+
+    // 键为 i << 12：原样的哈希值低 12 位全为 0
+    for (size_t n : {1 << 10, 1 << 16, 1 << 20}){
+        simple_stl::unordered_flat_map<size_t, size_t> m;
+        for (size_t i = 0; i < n; ++i)
+            m[i << 12] = i;
+        size_t r = 0;
+        const double ns = bench([&]{
+            for (size_t i = 0; i < n; ++i)
+                r += m.find(i << 12)->second;
+            escape(&r);
+        }, static_cast<int>(20000000 / n) + 1) / n;
+        printf("flat_map find(i<<12)  n=%-8zu %7.2f ns\n", n, ns);
+    }
+    return 0;
+}
@@ -0,0 +1,102 @@
+/**
+ * Created by 史进 on 2023/6/24.
+ *
+ * 多生产者多消费者争用：t 个生产者与 t 个消费者（t 为 1 到 64）传递同样多的整数，
+ * 对比加锁的 deque（条件变量等待）与 mpmc_queue 的 push/pop（自旋后休眠）、try_push/try_pop（失败时让出时间片）
+ */
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+
+#include "../SimpleSTL/deque"
+#include "../SimpleSTL/mpmc_queue"
+#include "../SimpleSTL/vector"
+
+const uint64_t N = 1 << 21;
+const size_t capacity = 1024;
+
+// 对照组：有界的加锁队列
+class locked_queue{
+private:
+    simple_stl::deque<uint64_t> q_;
+    std::mutex m_;
+    std::condition_variable not_empty_;
+    std::condition_variable not_full_;
+
+public:
+    void push(uint64_t v){
+        std::unique_lock<std::mutex> lock(m_);
+        not_full_.wait(lock, [this]{ return q_.size() < capacity; });
+        q_.push_back(v);
+        lock.unlock();
+        not_empty_.notify_one();
+    }
+
+    void pop(uint64_t& v){
+        std::unique_lock<std::mutex> lock(m_);
+        not_empty_.wait(lock, [this]{ return !q_.empty(); });
+        v = q_.front();
+        q_.pop_front();
+        lock.unlock();
+        not_full_.notify_one();
+    }
+};
+
+template<class Push, class Pop>
+double run(size_t threads, Push push, Pop pop, uint64_t& sum){
+    const uint64_t per_thread = N / threads;
+    simple_stl::vector<std::thread> workers;
+    simple_stl::vector<uint64_t> sums(threads, 0);
+    auto start = std::chrono::steady_clock::now();
+    for (size_t t = 0; t < threads; ++t){
+        workers.push_back(std::thread([=]{
+            for (uint64_t i = 0; i < per_thread; ++i)
+                push(t * per_thread + i);
+        }));
+        workers.push_back(std::thread([=, &sums]{
+            uint64_t s = 0;
+            for (uint64_t i = 0; i < per_thread; ++i){
+                uint64_t v;
+                pop(v);
+                s += v;
+            }
+            sums[t] = s;
+        }));
+    }
+    for (size_t i = 0; i < workers.size(); ++i)
+        workers[i].join();
+    auto end = std::chrono::steady_clock::now();
+    sum = 0;
+    for (size_t t = 0; t < threads; ++t)
+        sum += sums[t];
+    return per_thread * threads / std::chrono::duration<double>(end - start).count() / 1e6;
+}
+
+int main(){
+    printf("threads = producers = consumers, M msgs/s (hardware threads: %u)\n", std::thread::hardware_concurrency());
+    for (size_t t : {1, 2, 4, 8, 16, 32, 64}){
+        const uint64_t total = N / t * t;
+        const uint64_t expect = total * (total - 1) / 2;
+        uint64_t s1 = 0, s2 = 0, s3 = 0;
+
+        locked_queue lq;
+        const double locked = run(t, [&](uint64_t v){ lq.push(v); }, [&](uint64_t& v){ lq.pop(v); }, s1);
+
+        simple_stl::mpmc_queue<uint64_t> bq(capacity);
+        const double blocking = run(t, [&](uint64_t v){ bq.push(v); }, [&](uint64_t& v){ bq.pop(v); }, s2);
+
+        simple_stl::mpmc_queue<uint64_t> tq(capacity);
+        const double trying = run(t,
+                [&](uint64_t v){ while (!tq.try_push(v)) std::this_thread::yield(); },
+                [&](uint64_t& v){ while (!tq.try_pop(v)) std::this_thread::yield(); }, s3);
+
+        printf("t=%-3zu mutex+deque %8.2f   mpmc push/pop %8.2f   mpmc try_push/try_pop %8.2f\n",
+               t, locked, blocking, trying);
+        if (s1 != expect || s2 != expect || s3 != expect)
+            printf("mismatch\n");
+    }
+    return 0;
+}
@@ -0,0 +1,79 @@
+/**
+ * Created by 史进 on 2023/6/23.
+ *
+ * 并行算法在 seq 与 par 下的对比：transform、reduce、inclusive_scan、sort
+ * 参数为工作线程数，缺省为 thread_pool::default_threads()
+ */
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+#include "../SimpleSTL/algorithm"
+#include "../SimpleSTL/numeric"
+#include "../SimpleSTL/execution"
+#include "../SimpleSTL/vector"
+
+namespace ex = simple_stl::execution;
+
+// 防止编译器将结果优化掉
+template<class T>
+void escape(T* p){
+    asm volatile("" : : "g"(p) : "memory");
+}
+
+template<class Function>
+double bench(Function f, int rounds){
+    double total = 0;
+    for (int i = 0; i < rounds; ++i){
+        auto start = std::chrono::steady_clock::now();
+        f();
+        auto end = std::chrono::steady_clock::now();
+        total += std::chrono::duration<double, std::milli>(end - start).count();
+    }
+    return total / rounds;
+}
+
+void report(const char* name, size_t n, double seq_ms, double par_ms){
+    printf("%-15s n=%-9zu seq %9.3f ms  par %9.3f ms  (%.2fx)\n", name, n, seq_ms, par_ms, seq_ms / par_ms);
+}
+
+int main(int argc, char** argv){
+    const size_t threads = argc > 1 ? static_cast<size_t>(atoi(argv[1])) : simple_stl::thread_pool::default_threads();
+    simple_stl::thread_pool pool(threads);
+    const ex::parallel_policy par = ex::par.on(pool);
+    printf("workers: %zu\n", pool.size());
+
+    std::mt19937_64 gen(42);
+    for (size_t n : {10000, 1000000, 10000000}){
+        const int rounds = n < 1000000 ? 200 : 5;
+        simple_stl::vector<double> in(n, 0.0);
+        simple_stl::vector<double> out(n, 0.0);
+        for (size_t i = 0; i < n; ++i)
+            in[i] = static_cast<double>(gen() % 1000000) / 1000.0;
+
+        auto heavy = [](double x){ return std::sqrt(x) * std::log1p(x); };
+        report("transform", n,
+               bench([&]{ simple_stl::transform(in.begin(), in.end(), out.begin(), heavy); escape(&out[0]); }, rounds),
+               bench([&]{ simple_stl::transform(par, in.begin(), in.end(), out.begin(), heavy); escape(&out[0]); }, rounds));
+
+        double sum = 0;
+        report("reduce", n,
+               bench([&]{ sum += simple_stl::reduce(in.begin(), in.end(), 0.0); }, rounds),
+               bench([&]{ sum += simple_stl::reduce(par, in.begin(), in.end(), 0.0); }, rounds));
+        escape(&sum);
+
+        report("inclusive_scan", n,
+               bench([&]{ simple_stl::inclusive_scan(in.begin(), in.end(), out.begin()); escape(&out[0]); }, rounds),
+               bench([&]{ simple_stl::inclusive_scan(par, in.begin(), in.end(), out.begin()); escape(&out[0]); }, rounds));
+
+        // 排序每轮重新拷贝输入，拷贝时间计入两边
+        report("sort", n,
+               bench([&]{ simple_stl::copy_n(in.begin(), n, out.begin()); simple_stl::sort(out.begin(), out.end()); }, rounds),
+               bench([&]{ simple_stl::copy_n(in.begin(), n, out.begin()); simple_stl::sort(par, out.begin(), out.end()); }, rounds));
+        if (!simple_stl::is_sorted(out.begin(), out.end()))
+            printf("error: sort n=%zu not sorted\n", n);
+    }
+    return 0;
+}
@@ -0,0 +1,87 @@
+/**
+ * Created by 史进 on 2023/6/22.
+ *
+ * radix_sort 与比较排序（simple_stl::sort、std::sort）在整数、浮点数与 pair 记录上的对比
+ */
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+
+#include "../SimpleSTL/algorithm"
+
+// 防止编译器将结果优化掉
+template<class T>
+void escape(T* p){
+    asm volatile("" : : "g"(p) : "memory");
+}
+
+// 每轮先把输入拷到工作区，只计排序本身的时间
+template<class T, class Sort>
+double bench(const T* src, T* work, size_t n, Sort sort, int rounds){
+    double total = 0;
+    for (int i = 0; i < rounds; ++i){
+        simple_stl::copy(src, src + n, work);
+        auto start = std::chrono::steady_clock::now();
+        sort(work, work + n);
+        escape(work);
+        auto end = std::chrono::steady_clock::now();
+        total += std::chrono::duration<double, std::milli>(end - start).count();
+    }
+    return total;
+}
+
+struct payload{
+    char bytes[8];
+};
+
+typedef simple_stl::pair<uint64_t, payload> record;
+
+template<class T>
+void set_key(T& x, uint64_t k) { x = static_cast<T>(k); }
+
+void set_key(double& x, uint64_t k) { x = static_cast<double>(static_cast<int64_t>(k)) / 1024.0; }
+
+void set_key(record& x, uint64_t k){
+    x.first = k;
+    memset(x.second.bytes, 0, sizeof(x.second.bytes));
+}
+
+template<class T, class Less>
+void run(const char* name, size_t n, int rounds, Less less){
+    T* src = static_cast<T*>(malloc(n * sizeof(T)));
+    T* work = static_cast<T*>(malloc(n * sizeof(T)));
+    std::mt19937_64 gen(42);
+    // 全范围随机键，以及高位全为 0 的窄范围键（只需少数几趟）
+    const char* patterns[] = {"random", "narrow"};
+
+    for (int p = 0; p < 2; ++p){
+        for (size_t i = 0; i < n; ++i)
+            set_key(src[i], p == 0 ? gen() : gen() % (1u << 20));
+        double std_ms = bench(src, work, n, [&](T* f, T* l){ std::sort(f, l, less); }, rounds);
+        double pdq_ms = bench(src, work, n, [&](T* f, T* l){ simple_stl::sort(f, l, less); }, rounds);
+        double radix_ms = bench(src, work, n, [](T* f, T* l){ simple_stl::radix_sort(f, l); }, rounds);
+        if (!simple_stl::is_sorted(work, work + n, less))
+            printf("error: %s %s not sorted\n", name, patterns[p]);
+        printf("%-8s n=%-9zu %-7s std::sort %9.2f ms  sort %9.2f ms  radix_sort %9.2f ms  (%.2fx / %.2fx)\n",
+               name, n, patterns[p], std_ms, pdq_ms, radix_ms, std_ms / radix_ms, pdq_ms / radix_ms);
+    }
+
+    free(src);
+    free(work);
+}
+
+int main(){
+    for (size_t n : {100000, 4000000}){
+        const int rounds = n < 1000000 ? 50 : 3;
+        run<uint32_t>("uint32", n, rounds, simple_stl::less<uint32_t>());
+        run<uint64_t>("uint64", n, rounds, simple_stl::less<uint64_t>());
+        run<int64_t>("int64", n, rounds, simple_stl::less<int64_t>());
+        run<double>("double", n, rounds, simple_stl::less<double>());
+        run<record>("record", n, rounds, [](const record& x, const record& y){ return x.first < y.first; });
+    }
+    return 0;
+}
@@ -0,0 +1,87 @@
+/**
+ * Created by 史进 on 2023/6/21.
+ *
+ * simple_stl::sort（pdqsort）与 std::sort 在有序、逆序、随机、大量重复四种输入下的对比
+ */
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+
+#include "../SimpleSTL/algorithm"
+
+// 带负载的记录，按 key 排序
+struct record{
+    unsigned long key;
+    char payload[24];
+
+    bool operator<(const record& r) const { return key < r.key; }
+};
+
+// 防止编译器将结果优化掉
+template<class T>
+void escape(T* p){
+    asm volatile("" : : "g"(p) : "memory");
+}
+
+// 每轮先把输入拷到工作区，只计排序本身的时间
+template<class T, class Sort>
+double bench(const T* src, T* work, size_t n, Sort sort, int rounds){
+    double total = 0;
+    for (int i = 0; i < rounds; ++i){
+        memcpy(work, src, n * sizeof(T));
+        auto start = std::chrono::steady_clock::now();
+        sort(work, work + n);
+        escape(work);
+        auto end = std::chrono::steady_clock::now();
+        total += std::chrono::duration<double, std::milli>(end - start).count();
+    }
+    return total;
+}
+
+template<class T>
+void set_key(T& x, unsigned long k) { x = static_cast<T>(k); }
+
+void set_key(record& x, unsigned long k){
+    x.key = k;
+    memset(x.payload, 0, sizeof(x.payload));
+}
+
+template<class T>
+void run(const char* name, size_t n, int rounds){
+    T* src = static_cast<T*>(malloc(n * sizeof(T)));
+    T* work = static_cast<T*>(malloc(n * sizeof(T)));
+    std::mt19937_64 gen(42);
+    const char* patterns[] = {"sorted", "reversed", "random", "dups"};
+
+    for (int p = 0; p < 4; ++p){
+        for (size_t i = 0; i < n; ++i){
+            switch (p){
+                case 0: set_key(src[i], i); break;
+                case 1: set_key(src[i], n - i); break;
+                case 2: set_key(src[i], gen() % 1000000000); break;
+                default: set_key(src[i], gen() % 16); break;
+            }
+        }
+        double std_ms = bench(src, work, n, [](T* f, T* l){ std::sort(f, l); }, rounds);
+        double pdq_ms = bench(src, work, n, [](T* f, T* l){ simple_stl::sort(f, l); }, rounds);
+        if (!simple_stl::is_sorted(work, work + n))
+            printf("error: %s %s not sorted\n", name, patterns[p]);
+        printf("%-8s n=%-9zu %-9s std::sort %9.2f ms  simple_stl::sort %9.2f ms  (%.2fx)\n",
+               name, n, patterns[p], std_ms, pdq_ms, std_ms / pdq_ms);
+    }
+
+    free(src);
+    free(work);
+}
+
+int main(){
+    run<int>("int", 1000, 2000);
+    run<int>("int", 1000000, 10);
+    run<double>("double", 1000000, 10);
+    run<unsigned long>("ulong", 1000000, 10);
+    run<record>("record", 1000000, 10);
+    return 0;
+}
@@ -0,0 +1,126 @@
+/**
+ * Created by 史进 on 2023/6/24.
+ *
+ * 两个线程之间传递整数：加锁的 deque、spsc_queue 逐个 try_push/try_pop、spsc_queue 成批 push_n/pop_n 的吞吐量
+ * （生产者与消费者应在不同核上运行，单核机器上结果主要反映线程切换）
+ */
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+
+#include "../SimpleSTL/deque"
+#include "../SimpleSTL/spsc_queue"
+
+const uint64_t N = 20000000;
+const size_t batch = 64;
+
+template<class Function>
+double bench(Function f){
+    auto start = std::chrono::steady_clock::now();
+    f();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(end - start).count();
+}
+
+void report(const char* name, double seconds){
+    printf("%-26s %8.2f M msgs/s\n", name, N / seconds / 1e6);
+}
+
+uint64_t run_locked(){
+    simple_stl::deque<uint64_t> q;
+    std::mutex m;
+    uint64_t sum = 0;
+    std::thread producer([&]{
+        for (uint64_t i = 0; i < N; ){
+            size_t k = 0;
+            {
+                std::lock_guard<std::mutex> lock(m);
+                // 与有界队列一致，最多积压 1024 个
+                for ( ; k < batch && q.size() < 1024 && i < N; ++k)
+                    q.push_back(i++);
+            }
+            if (k == 0)
+                std::this_thread::yield();
+        }
+    });
+    for (uint64_t got = 0; got < N; ){
+        size_t k = 0;
+        {
+            std::lock_guard<std::mutex> lock(m);
+            for ( ; !q.empty(); ++k){
+                sum += q.front();
+                q.pop_front();
+            }
+        }
+        got += k;
+        if (k == 0)
+            std::this_thread::yield();
+    }
+    producer.join();
+    return sum;
+}
+
+uint64_t run_single(){
+    simple_stl::spsc_queue<uint64_t> q(1024);
+    uint64_t sum = 0;
+    std::thread producer([&]{
+        for (uint64_t i = 0; i < N; )
+            if (q.try_push(i))
+                ++i;
+            else
+                std::this_thread::yield();
+    });
+    for (uint64_t got = 0; got < N; ){
+        uint64_t v;
+        if (q.try_pop(v)){
+            sum += v;
+            ++got;
+        }else{
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+    return sum;
+}
+
+uint64_t run_batch(){
+    simple_stl::spsc_queue<uint64_t> q(1024);
+    uint64_t sum = 0;
+    std::thread producer([&]{
+        uint64_t buf[batch];
+        for (uint64_t i = 0; i < N; ){
+            size_t k = 0;
+            for ( ; k < batch && i + k < N; ++k)
+                buf[k] = i + k;
+            const size_t n = q.push_n(buf, k);
+            i += n;
+            if (n == 0)
+                std::this_thread::yield();
+        }
+    });
+    uint64_t buf[batch];
+    for (uint64_t got = 0; got < N; ){
+        const size_t n = q.pop_n(buf, batch);
+        for (size_t k = 0; k < n; ++k)
+            sum += buf[k];
+        got += n;
+        if (n == 0)
+            std::this_thread::yield();
+    }
+    producer.join();
+    return sum;
+}
+
+int main(){
+    const uint64_t expect = N * (N - 1) / 2;
+    uint64_t r = 0;
+    report("mutex + deque", bench([&]{ r = run_locked(); }));
+    if (r != expect) printf("mismatch\n");
+    report("spsc try_push/try_pop", bench([&]{ r = run_single(); }));
+    if (r != expect) printf("mismatch\n");
+    report("spsc push_n/pop_n (64)", bench([&]{ r = run_batch(); }));
+    if (r != expect) printf("mismatch\n");
+    return 0;
+}
@@ -0,0 +1,89 @@
+/**
+ * Created by 史进 on 2023/6/24.
+ *
+ * string 与 std::string 的对比：短字符串的构造、拷贝与追加，长字符串的 find、rfind、find_first_of
+ */
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <string>
+
+#include "../SimpleSTL/string"
+#include "../SimpleSTL/vector"
+
+// 防止编译器将结果优化掉
+template<class T>
+void escape(T* p){
+    asm volatile("" : : "g"(p) : "memory");
+}
+
+template<class Function>
+double bench(Function f, int rounds){
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < rounds; ++i)
+        f();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::micro>(end - start).count() / rounds;
+}
+
+void report(const char* name, size_t n, double std_us, double stl_us){
+    printf("%-22s n=%-8zu std %9.2f us  simple_stl %9.2f us  (%.2fx)\n",
+           name, n, std_us, stl_us, std_us / stl_us);
+}
+
+// 构造 count 个长度为 len 的字符串并拷贝、追加一个字符
+template<class String>
+void build(const char* src, size_t len, size_t count){
+    simple_stl::vector<String> v;
+    v.reserve(count);
+    for (size_t i = 0; i < count; ++i){
+        String s(src, len);
+        String t(s);
+        t += 'x';
+        v.push_back(simple_stl::move(t));
+    }
+    escape(&v[0]);
+}
+
+template<class String>
+size_t search(const String& s, const char* set, size_t set_n, int which){
+    switch (which){
+        case 0: return s.find('#');
+        case 1: return s.rfind('#');
+        case 2: return s.find("needle#", 0, 7);
+        default: return s.find_first_of(set, 0, set_n);
+    }
+}
+
+int main(){
+    const char* src = "0123456789abcdefghijklmnopqrstuvwxyz";
+    for (size_t len : {8, 22, 30}){
+        const size_t count = 100000;
+        report(len <= 22 ? "construct(short)" : "construct(long)", len,
+               bench([&]{ build<std::string>(src, len, count); }, 20),
+               bench([&]{ build<simple_stl::string>(src, len, count); }, 20));
+    }
+    printf("\n");
+
+    std::mt19937 gen(42);
+    const char* names[] = {"find(char)", "rfind(char)", "find(substr)", "find_first_of(4)"};
+    const char set[] = "#$%&";
+    for (size_t n : {64, 4096, 1000000}){
+        // 目标字符只出现在不会被先找到的位置，整个字符串都要扫过
+        std::string a(n, 'a');
+        for (size_t i = 0; i < n; ++i)
+            a[i] = static_cast<char>('a' + gen() % 26);
+        const simple_stl::string b(a.data(), a.size());
+        const int rounds = static_cast<int>(200000000 / n) + 1;
+        for (int which = 0; which < 4; ++which){
+            size_t r1 = 0, r2 = 0;
+            report(names[which], n,
+                   bench([&]{ r1 += search(a, set, 4, which); escape(&r1); }, rounds),
+                   bench([&]{ r2 += search(b, set, 4, which); escape(&r2); }, rounds));
+            if (r1 != r2)
+                printf("mismatch\n");
+        }
+        printf("\n");
+    }
+    return 0;
+}
@@ -0,0 +1,69 @@
+/**
+ * Created by 史进 on 2023/6/10.
+ *
+ * uninitialized_* 对平凡类型的批量处理与逐一 construct 的对比
+ */
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+#include "../SimpleSTL/memory"
+
+using namespace simple_stl;
+
+template<class Func>
+double bench(Func f, int rounds){
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < rounds; ++i)
+        f();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+// 对照组：逐一 placement new
+template<class T>
+void construct_copy(const T* first, const T* last, T* result){
+    for ( ; first != last; ++first, ++result)
+        construct(result, *first);
+}
+
+template<class T>
+void construct_fill(T* first, T* last, const T& value){
+    for ( ; first != last; ++first)
+        construct(first, value);
+}
+
+// 防止编译器将结果优化掉
+template<class T>
+void escape(T* p){
+    asm volatile("" : : "g"(p) : "memory");
+}
+
+template<class T>
+void run(const char* name, size_t n, int rounds){
+    T* src = static_cast<T*>(malloc(n * sizeof(T)));
+    T* dst = static_cast<T*>(malloc(n * sizeof(T)));
+    for (size_t i = 0; i < n; ++i)
+        src[i] = static_cast<T>(i);
+
+    double loop_copy = bench([&]{ construct_copy(src, src + n, dst); escape(dst); }, rounds);
+    double fast_copy = bench([&]{ uninitialized_copy(src, src + n, dst); escape(dst); }, rounds);
+    double loop_fill = bench([&]{ construct_fill(dst, dst + n, T(7)); escape(dst); }, rounds);
+    double fast_fill = bench([&]{ uninitialized_fill_n(dst, n, T(7)); escape(dst); }, rounds);
+
+    printf("%-8s n=%-9zu copy: construct %8.2f ms  uninitialized %8.2f ms  (%.2fx)\n",
+           name, n, loop_copy, fast_copy, loop_copy / fast_copy);
+    printf("%-8s n=%-9zu fill: construct %8.2f ms  uninitialized %8.2f ms  (%.2fx)\n",
+           name, n, loop_fill, fast_fill, loop_fill / fast_fill);
+
+    free(src);
+    free(dst);
+}
+
+int main(){
+    run<char>("char", 1 << 20, 200);
+    run<int>("int", 1 << 20, 200);
+    run<double>("double", 1 << 20, 200);
+    run<int>("int", 1 << 10, 200000);
+    return 0;
+}
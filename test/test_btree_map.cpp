@@ -0,0 +1,131 @@
+/**
+ * Created by 史进 on 2023/6/24.
+ *
+ * btree_map 回归测试：键的拷贝构造会抛异常时，插入引起的节点分裂、删除引起的合并与借位
+ * 只移动键，不拷贝键；插入新键时拷贝失败，树保持不变
+ */
+#include <cstdio>
+#include <new>
+
+#include "../SimpleSTL/btree_map"
+#include "../SimpleSTL/string"
+
+static int failures = 0;
+
+#define CHECK(cond)                                                             \
+    do {                                                                        \
+        if (!(cond)){                                                           \
+            std::printf("%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #cond);\
+            ++failures;                                                         \
+        }                                                                       \
+    } while (0)
+
+// 拷贝构造在 throw_on_copy 为真时抛出 bad_alloc，移动构造不抛异常
+struct key{
+    static bool throw_on_copy;
+    static int copies;
+
+    int v;
+
+    explicit key(int x) : v(x) {}
+
+    key(const key& other) : v(other.v){
+        if (throw_on_copy)
+            throw std::bad_alloc();
+        ++copies;
+    }
+
+    key(key&& other) noexcept : v(other.v) {}
+
+    key& operator=(const key&) = default;
+    key& operator=(key&&) = default;
+
+    bool operator<(const key& other) const { return v < other.v; }
+};
+
+bool key::throw_on_copy = false;
+int key::copies = 0;
+
+static bool check_order(const simple_stl::btree_map<key, int>& m, int expected_size){
+    if (m.size() != static_cast<size_t>(expected_size))
+        return false;
+    int prev = -1, n = 0;
+    for (simple_stl::btree_map<key, int>::const_iterator it = m.begin(); it != m.end(); ++it, ++n){
+        if (it->first.v <= prev || it->second != it->first.v * 2)
+            return false;
+        prev = it->first.v;
+    }
+    return n == expected_size;
+}
+
+int main(){
+    {
+        simple_stl::btree_map<key, int> m;
+        key::throw_on_copy = true;
+        // 交错插入，使分裂发生在节点中间
+        for (int i = 0; i < 2000; ++i){
+            const int k = (i * 7919) % 2000;
+            m[key(k)] = k * 2;
+        }
+        CHECK(check_order(m, 2000));
+
+        // 删除一半，触发合并与借位
+        for (int i = 0; i < 2000; i += 2)
+            CHECK(m.erase(key(i)) == 1);
+        CHECK(check_order(m, 1000));
+
+        // 以左值插入新键需要拷贝键，拷贝失败时不插入
+        const key k(2);
+        bool thrown = false;
+        try {
+            m[k] = 4;
+        }catch(const std::bad_alloc&){
+            thrown = true;
+        }
+        CHECK(thrown);
+        CHECK(m.find(k) == m.end());
+        CHECK(check_order(m, 1000));
+
+        // 已存在的键不拷贝
+        const key existing(3);
+        m[existing] = 6;
+        CHECK(check_order(m, 1000));
+        key::throw_on_copy = false;
+    }
+    {
+        // 分裂、删除的搬移都不拷贝键
+        simple_stl::btree_map<key, int> m;
+        for (int i = 0; i < 1000; ++i)
+            m.emplace(key((i * 7919) % 1000), ((i * 7919) % 1000) * 2);
+        for (int i = 0; i < 1000; i += 3)
+            m.erase(key(i));
+        CHECK(key::copies == 0);
+    }
+    {
+        // 堆上存放的键：分裂与删除前后内容不变
+        simple_stl::btree_map<simple_stl::string, int> m;
+        for (int i = 0; i < 1000; ++i)
+            m[simple_stl::string(40, static_cast<char>('a' + i % 26)) + simple_stl::string(1, static_cast<char>('0' + i / 26 % 10)) +
+              simple_stl::string(1, static_cast<char>('0' + i / 260))] = i;
+        CHECK(m.size() == 1000);
+        int n = 0;
+        for (simple_stl::btree_map<simple_stl::string, int>::iterator it = m.begin(); it != m.end(); ){
+            if (n++ % 2 == 0)
+                it = m.erase(it);
+            else
+                ++it;
+        }
+        CHECK(m.size() == 500);
+        for (simple_stl::btree_map<simple_stl::string, int>::iterator it = m.begin(); it != m.end(); ++it){
+            const int i = it->second;
+            CHECK(it->first == simple_stl::string(40, static_cast<char>('a' + i % 26)) +
+                               simple_stl::string(1, static_cast<char>('0' + i / 26 % 10)) +
+                               simple_stl::string(1, static_cast<char>('0' + i / 260)));
+        }
+    }
+
+    if (failures != 0)
+        return 1;
+    std::printf("test_btree_map: ok\n");
+    return 0;
+}
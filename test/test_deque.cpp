@@ -0,0 +1,82 @@
+/**
+ * Created by 史进 on 2023/6/24.
+ *
+ * deque 回归测试：向尚未配置任何分段的空 deque 赋值、assign，以及空区间的 copy/move/fill_n、uninitialized_*
+ */
+#include <cstdio>
+
+#include "../SimpleSTL/algorithm"
+#include "../SimpleSTL/deque"
+#include "../SimpleSTL/memory"
+#include "../SimpleSTL/vector"
+
+static int failures = 0;
+
+#define CHECK(cond)                                                             \
+    do {                                                                        \
+        if (!(cond)){                                                           \
+            std::printf("%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #cond);\
+            ++failures;                                                         \
+        }                                                                       \
+    } while (0)
+
+static bool equal_to_range(const simple_stl::deque<int>& d, int first, int n){
+    if (d.size() != static_cast<size_t>(n))
+        return false;
+    for (int i = 0; i < n; ++i)
+        if (d[i] != first + i)
+            return false;
+    return true;
+}
+
+int main(){
+    {
+        simple_stl::deque<int> a, b;
+        b.push_back(1);
+        a = b;
+        CHECK(equal_to_range(a, 1, 1));
+    }
+    {
+        simple_stl::deque<int> a, b;
+        for (int i = 0; i < 1000; ++i)
+            b.push_back(i);
+        a = b;
+        CHECK(equal_to_range(a, 0, 1000));
+    }
+    {
+        simple_stl::deque<int> a, empty;
+        a = empty;
+        CHECK(a.empty());
+    }
+    {
+        simple_stl::vector<int> v;
+        for (int i = 0; i < 300; ++i)
+            v.push_back(i + 5);
+        simple_stl::deque<int> a;
+        a.assign(v.begin(), v.end());
+        CHECK(equal_to_range(a, 5, 300));
+        simple_stl::deque<int> c;
+        c.assign(v.begin(), v.begin());
+        CHECK(c.empty());
+        simple_stl::deque<int> f;
+        f.assign(static_cast<size_t>(200), 7);
+        CHECK(f.size() == 200 && f.front() == 7 && f.back() == 7);
+    }
+    {
+        // 空区间写入没有分段的 deque
+        simple_stl::deque<int> d;
+        int src[1] = {0};
+        CHECK(simple_stl::copy(src, src, d.begin()) == d.begin());
+        CHECK(simple_stl::move(src, src, d.begin()) == d.begin());
+        CHECK(simple_stl::copy_backward(src, src, d.end()) == d.end());
+        CHECK(simple_stl::move_backward(src, src, d.end()) == d.end());
+        CHECK(simple_stl::fill_n(d.begin(), 0, 1) == d.begin());
+        CHECK(simple_stl::uninitialized_copy(src, src, d.begin()) == d.begin());
+        CHECK(simple_stl::uninitialized_move(src, src, d.begin()) == d.begin());
+        CHECK(simple_stl::uninitialized_fill_n(d.begin(), 0, 1) == d.begin());
+        simple_stl::uninitialized_fill(d.begin(), d.end(), 1);
+    }
+    if (failures == 0)
+        std::printf("test_deque: ok\n");
+    return failures == 0 ? 0 : 1;
+}
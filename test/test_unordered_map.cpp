@@ -0,0 +1,104 @@
+/**
+ * Created by 史进 on 2023/6/24.
+ *
+ * unordered_map 回归测试：swap 与移动构造、移动赋值之后，原先取得的迭代器仍能遍历全部元素，
+ * 包括渐进式扩容进行中的情形
+ */
+#include <cstdio>
+
+#include "../SimpleSTL/unordered_map"
+#include "../SimpleSTL/unordered_set"
+
+static int failures = 0;
+
+#define CHECK(cond)                                                             \
+    do {                                                                        \
+        if (!(cond)){                                                           \
+            std::printf("%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #cond);\
+            ++failures;                                                         \
+        }                                                                       \
+    } while (0)
+
+typedef simple_stl::unordered_map<int, int> map_type;
+
+// 从 it 遍历到 end，返回经过的元素个数
+static size_t walk(map_type::const_iterator it, map_type::const_iterator end){
+    size_t n = 0;
+    for ( ; it != end; ++it)
+        ++n;
+    return n;
+}
+
+static void fill(map_type& m, int first, int n){
+    for (int i = first; i < first + n; ++i)
+        m[i] = i;
+}
+
+int main(){
+    {
+        map_type a, b;
+        fill(a, 0, 100);
+        fill(b, 1000, 3);
+        map_type::iterator it = a.begin();
+        a.swap(b);
+        CHECK(walk(it, b.end()) == 100);
+        CHECK(walk(b.begin(), b.end()) == 100);
+        CHECK(walk(a.begin(), a.end()) == 3);
+    }
+    {
+        // 交换到空容器，空容器尚未配置桶数组
+        map_type a, b;
+        fill(a, 0, 100);
+        map_type::iterator it = a.begin();
+        simple_stl::swap(a, b);
+        CHECK(walk(it, b.end()) == 100);
+        CHECK(a.empty() && a.begin() == a.end());
+        fill(a, 0, 10);
+        CHECK(a.size() == 10);
+    }
+    {
+        map_type a;
+        fill(a, 0, 100);
+        map_type::iterator it = a.begin();
+        map_type b(simple_stl::move(a));
+        CHECK(walk(it, b.end()) == 100);
+        CHECK(a.empty());
+        fill(a, 0, 5);
+        CHECK(walk(a.begin(), a.end()) == 5);
+
+        map_type c;
+        fill(c, 0, 7);
+        it = b.begin();
+        c = simple_stl::move(b);
+        CHECK(walk(it, c.end()) == 100);
+    }
+    {
+        // 渐进式扩容进行中：两个桶数组同时存在
+        map_type a, b;
+        a.set_rehash_step(1);
+        fill(a, 0, 600);
+        CHECK(a.rehashing());
+        map_type::iterator it = a.begin();
+        a.swap(b);
+        CHECK(walk(it, b.end()) == 600);
+        while (!b.migrate(4))
+            ;
+        CHECK(walk(b.begin(), b.end()) == 600);
+    }
+    {
+        simple_stl::unordered_set<int> a, b;
+        for (int i = 0; i < 50; ++i)
+            a.insert(i);
+        simple_stl::unordered_set<int>::iterator it = a.begin();
+        a.swap(b);
+        size_t n = 0;
+        for ( ; it != b.end(); ++it)
+            ++n;
+        CHECK(n == 50);
+    }
+
+    if (failures != 0)
+        return 1;
+    std::printf("test_unordered_map: ok\n");
+    return 0;
+}